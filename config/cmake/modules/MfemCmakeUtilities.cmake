@@ -46,6 +46,10 @@ endfunction()
 # Wrapper for add_executable
 macro(mfem_add_executable NAME)
   add_executable(${NAME} ${ARGN})
+  if (MFEM_USE_JIT AND NOT BUILD_SHARED_LIBS)
+    # Export the MFEM symbols to the kernels compiled at runtime (KernelJIT)
+    set_target_properties(${NAME} PROPERTIES ENABLE_EXPORTS ON)
+  endif()
   if (MFEM_USE_CUDA)
     set_target_properties(${NAME} PROPERTIES
       CUDA_RESOLVE_DEVICE_SYMBOLS ON)
@@ -851,7 +855,7 @@ function(mfem_export_mk_files)
       MFEM_USE_MPFR MFEM_USE_SIDRE MFEM_USE_FMS MFEM_USE_CONDUIT MFEM_USE_PUMI
       MFEM_USE_HIOP MFEM_USE_GSLIB MFEM_USE_CUDA MFEM_USE_HIP MFEM_USE_RAJA
       MFEM_USE_OCCA MFEM_USE_CEED MFEM_USE_CALIPER MFEM_USE_UMPIRE MFEM_USE_SIMD
-      MFEM_USE_ADIOS2 MFEM_USE_MKL_CPARDISO MFEM_USE_MKL_PARDISO
+      MFEM_USE_JIT MFEM_USE_ADIOS2 MFEM_USE_MKL_CPARDISO MFEM_USE_MKL_PARDISO
       MFEM_USE_ADFORWARD MFEM_USE_CODIPACK MFEM_USE_BENCHMARK MFEM_USE_PARELAG
       MFEM_USE_TRIBOL MFEM_USE_MOONOLITH MFEM_USE_ALGOIM MFEM_USE_ENZYME)
   foreach(var ${CONFIG_MK_BOOL_VARS})
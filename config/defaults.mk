@@ -164,6 +164,7 @@ MFEM_USE_CALIPER       = NO
 MFEM_USE_ALGOIM        = NO
 MFEM_USE_UMPIRE        = NO
 MFEM_USE_SIMD          = NO
+MFEM_USE_JIT           = NO
 MFEM_USE_ADIOS2        = NO
 MFEM_USE_MKL_CPARDISO  = NO
 MFEM_USE_MKL_PARDISO   = NO
@@ -267,6 +268,12 @@ OPENMP_LIB =
 # Used when MFEM_TIMER_TYPE = 2
 POSIX_CLOCKS_LIB = -lrt
 
+# Dynamic loading library, used for runtime compilation of kernels (KernelJIT)
+DL_LIB = $(if $(NOTMAC),-ldl,)
+# Linker flag exporting the symbols of executables, needed by the kernels
+# compiled at runtime when MFEM is a static library (KernelJIT)
+EXPORT_DYNAMIC = $(XLINKER)$(if $(NOTMAC),--export-dynamic,-export_dynamic)
+
 # SUNDIALS library configuration
 # For sundials_nvecmpiplusx and nvecparallel remember to build with MPI_ENABLE=ON
 # and modify cmake variables for hypre for sundials
@@ -13,6 +13,7 @@
 
 #include "fem.hpp"
 #include "../general/device.hpp"
+#include "../general/forall.hpp"
 #include "../mesh/nurbs.hpp"
 #include <cmath>
 
@@ -143,6 +144,23 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
    }
 }
 
+void BilinearForm::SetPADataPrecision(PADataPrecision precision,
+                                      bool keep_full)
+{
+   for (BilinearFormIntegrator *integ : domain_integs)
+   {
+      integ->SetPADataPrecision(precision, keep_full);
+   }
+}
+
+void BilinearForm::UseFullPrecisionPA(bool full)
+{
+   for (BilinearFormIntegrator *integ : domain_integs)
+   {
+      integ->UseFullPrecisionPA(full);
+   }
+}
+
 void BilinearForm::EnableStaticCondensation()
 {
    delete static_cond;
@@ -764,6 +782,77 @@ void BilinearForm::Assemble(int skip_zeros)
 #endif
 }
 
+void BilinearForm::ReassembleValues(int skip_zeros)
+{
+   if (ext)
+   {
+      // With FA, the existing sparse matrix is reused by Assemble()
+      ext->Assemble();
+      return;
+   }
+
+   MFEM_VERIFY(mat && mat->Finalized(), "the form must be assembled and "
+               "finalized before calling ReassembleValues()");
+   MFEM_VERIFY(!static_cond && !hybridization, "static condensation and "
+               "hybridization are not supported by ReassembleValues()");
+   MFEM_VERIFY(fes->GetConformingProlongation() == NULL,
+               "non-conforming spaces are not supported by ReassembleValues()");
+
+   if (mat_e && ess_elim_map.Size() == 0) { BuildEssentialEliminationMap(); }
+
+   *mat = 0.0;
+   Assemble(skip_zeros);
+
+   if (mat_e) { ApplyEssentialEliminationMap(); }
+}
+
+void BilinearForm::BuildEssentialEliminationMap()
+{
+   const int *I = mat->HostReadI(), *J = mat->HostReadJ();
+   const int *I_e = mat_e->HostReadI(), *J_e = mat_e->HostReadJ();
+   ess_elim_map.SetSize(2*I_e[height]);
+   for (int r = 0; r < height; r++)
+   {
+      for (int q = I_e[r]; q < I_e[r+1]; q++)
+      {
+         const int c = J_e[q];
+         int p = I[r];
+         for (; p < I[r+1] && J[p] != c; p++) { }
+         MFEM_VERIFY(p < I[r+1], "the eliminated entry (" << r << ", " << c
+                     << ") is not in the sparsity pattern of the matrix");
+         ess_elim_map[2*q] = (r == c) ? -1 - p : p;
+         ess_elim_map[2*q+1] = q;
+      }
+   }
+}
+
+void BilinearForm::ApplyEssentialEliminationMap()
+{
+   // See SparseMatrix::EliminateRowCol(int, SparseMatrix &, DiagonalPolicy)
+   const real_t diag = (diag_policy == DIAG_ONE) ? 1.0 : 0.0;
+   const int n = ess_elim_map.Size()/2;
+   const auto d_map = ess_elim_map.Read();
+   auto d_A = mat->ReadWriteData();
+   auto d_Ae = mat_e->ReadWriteData();
+   // Each entry of the matrix is eliminated once, so the entries can be
+   // processed independently
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int k)
+   {
+      const int sp = d_map[2*k], q = d_map[2*k+1];
+      if (sp >= 0)
+      {
+         d_Ae[q] = d_A[sp];
+         d_A[sp] = 0.0;
+      }
+      else
+      {
+         const int p = -1 - sp;
+         d_Ae[q] = d_A[p] - diag;
+         d_A[p] = diag;
+      }
+   });
+}
+
 void BilinearForm::ConformingAssemble()
 {
    // Do not remove zero entries to preserve the symmetric structure of the
@@ -1226,6 +1315,7 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
 
    delete mat_e;
    mat_e = NULL;
+   ess_elim_map.DeleteAll();
    FreeElementMatrices();
    delete static_cond;
    static_cond = NULL;
@@ -89,6 +89,19 @@ protected:
        Full Assembly (FA). */
    bool sort_sparse_matrix = false;
 
+   /** Indicates if the fused action is used when possible with Partial
+       Assembly (PA), see EnableFusedPartialAssembly(). */
+   bool fused_pa = false;
+
+   /** Indicates if the element matrices are applied with the batched linear
+       algebra backend with Element Assembly (EA), see
+       EnableBatchedElementAssembly(). */
+   bool batched_ea = false;
+
+   /** Indicates if the element matrices are stored in symmetric packed form
+       with Element Assembly (EA), see EnableSymmetricElementAssembly(). */
+   bool symmetric_ea = false;
+
    /** @brief Indicates the Mesh::sequence corresponding to the current state of
        the BilinearForm. */
    long sequence;
@@ -134,9 +147,22 @@ protected:
 
    int precompute_sparsity;
 
+   /** @brief Positions of the entries of #mat_e in the data arrays of #mat and
+       #mat_e, see ReassembleValues(). Pairs (p, q), with p encoded as -1-p for
+       the diagonal entries. */
+   Array<int> ess_elim_map;
+
    /// Allocate appropriate SparseMatrix and assign it to #mat
    void AllocMat();
 
+   /** @brief Build #ess_elim_map from the sparsity patterns of #mat and
+       #mat_e. */
+   void BuildEssentialEliminationMap();
+
+   /** @brief Redo the elimination of the essential dofs of the last
+       FormSystemMatrix() call on the values of #mat, using #ess_elim_map. */
+   void ApplyEssentialEliminationMap();
+
    /** @brief For partially conforming trial and/or test FE spaces, complete the
        assembly process by performing $ P^t A P $ where $ A $ is the
        internal sparse matrix and $ P $ is the conforming prolongation
@@ -211,6 +237,74 @@ public:
       sort_sparse_matrix = enable_it;
    }
 
+   /** @brief Use a fused action when using AssemblyLevel::PARTIAL.
+
+       In the fused mode, the element restriction, the integrator kernel, and
+       the transpose of the element restriction are applied in a single pass:
+       the element degrees of freedom are gathered directly from the input
+       L-vector and the element contributions are added directly to the output
+       L-vector, without forming the intermediate E-vectors. This reduces the
+       memory traffic of the action, at the cost of atomic additions when the
+       kernels run in parallel.
+
+       The fused action is used only if all domain integrators support it (see
+       BilinearFormIntegrator::SupportsFusedPA()), none of them is restricted
+       to a subset of the mesh attributes, and the space is scalar. Otherwise,
+       the regular action is used. */
+   void EnableFusedPartialAssembly(bool enable_it = true)
+   {
+      fused_pa = enable_it;
+   }
+
+   /// Returns true if the fused partially assembled action was requested.
+   bool FusedPartialAssemblyIsEnabled() const { return fused_pa; }
+
+   /** @brief Apply the element matrices of Element Assembly (EA) as one
+       strided batch of small matrix products, using the active backend of
+       BatchedLinAlg (e.g. MAGMA or cuBLAS/hipBLAS batched GEMM on GPUs, or the
+       native register-blocked kernels). */
+   void EnableBatchedElementAssembly(bool enable_it = true)
+   {
+      batched_ea = enable_it;
+   }
+
+   /// Returns true if the batched EA action was requested.
+   bool BatchedElementAssemblyIsEnabled() const { return batched_ea; }
+
+   /** @brief Store the element matrices of Element Assembly (EA) in symmetric
+       packed form (the upper triangle of each matrix), halving the memory of
+       the EA data. This takes precedence over
+       EnableBatchedElementAssembly().
+
+       The element matrices must be symmetric, e.g. with the mass and diffusion
+       integrators; this is checked only in debug builds. This method must be
+       called before Assemble() and has no effect with other assembly
+       levels. */
+   void EnableSymmetricElementAssembly(bool enable_it = true)
+   {
+      symmetric_ea = enable_it;
+   }
+
+   /// Returns true if the symmetric packed EA storage was requested.
+   bool SymmetricElementAssemblyIsEnabled() const { return symmetric_ea; }
+
+   /** @brief Set the precision used to store the partial assembly data of the
+       domain integrators, see BilinearFormIntegrator::SetPADataPrecision().
+
+       This method must be called after adding the integrators, and before
+       Assemble(). The full precision data is kept only if @a keep_full is
+       true, which is needed by UseFullPrecisionPA(). */
+   void SetPADataPrecision(PADataPrecision precision, bool keep_full = false);
+
+   /** @brief Use (if @a full is true) the full precision partial assembly data
+       of the domain integrators in the action, see
+       BilinearFormIntegrator::UseFullPrecisionPA().
+
+       For example, the reduced precision action can be used for most of the
+       iterations of a solver, and the full precision one for the computation
+       of the final residual. */
+   void UseFullPrecisionPA(bool full = true);
+
    /// Returns the assembly level
    AssemblyLevel GetAssemblyLevel() const { return assembly; }
 
@@ -449,6 +543,28 @@ public:
    /// Assembles the form i.e. sums over all domain/bdr integrators.
    void Assemble(int skip_zeros = 1);
 
+   /** @brief Recompute the values of the assembled form, e.g. after a change
+       of the coefficients, keeping the sparsity pattern of the matrix.
+
+       The form must have been assembled before. With AssemblyLevel::LEGACY,
+       the matrix must have been finalized (e.g. by FormSystemMatrix()), and
+       its sparsity pattern (the I and J arrays) is kept: the pattern must
+       contain all the entries of the new element matrices, e.g. by assembling
+       the first time with @a skip_zeros = 0. If FormSystemMatrix() was
+       called, the essential dofs are eliminated again, in parallel, with the
+       positions of the eliminated entries recorded at the first call, and a
+       subsequent FormSystemMatrix() or FormLinearSystem() with the same
+       essential dofs returns the updated matrix at no additional cost.
+
+       With AssemblyLevel::FULL, the values of the matrix are recomputed in
+       parallel with the existing row offsets, see
+       ElementRestriction::FillJAndData(). With the other assembly levels,
+       this is the same as Assemble().
+
+       Static condensation, hybridization and non-conforming spaces are not
+       supported with AssemblyLevel::LEGACY. */
+   virtual void ReassembleValues(int skip_zeros = 1);
+
    /** @brief Assemble the diagonal of the bilinear form into @a diag. Note that
        @a diag is a tdof Vector.
 
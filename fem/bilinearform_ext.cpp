@@ -17,6 +17,9 @@
 #include "pbilinearform.hpp"
 #include "pgridfunc.hpp"
 #include "ceed/interface/util.hpp"
+#include "../linalg/batched/batched.hpp"
+
+#include <vector>
 
 namespace mfem
 {
@@ -549,7 +552,18 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    MFEM_VERIFY(!(somePatchwise && !allPatchwise),
                "All or none of the integrators should be patchwise");
 
-   if (DeviceCanUseCeed() || !elem_restrict || allPatchwise)
+   const ElementRestriction *fused_restrict = GetFusedRestriction();
+
+   if (fused_restrict)
+   {
+      y.UseDevice(true); // typically this is a large vector, so store on device
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultFusedPA(fused_restrict->GatherMap(), x, y);
+      }
+   }
+   else if (DeviceCanUseCeed() || !elem_restrict || allPatchwise)
    {
       y.UseDevice(true); // typically this is a large vector, so store on device
       y = 0.0;
@@ -694,6 +708,79 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void PABilinearFormExtension::ArrayMult(const Array<const Vector *> &X,
+                                        Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(), "Number of columns mismatch!");
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   Array<Array<int>*> &elem_markers = *a->GetDBFI_Marker();
+   const int iSz = integrators.Size();
+   const int nv = X.Size();
+
+   // The batched action is used only with unmarked domain integrators acting
+   // on E-vectors; everything else is applied one vector at a time.
+   bool batched = nv > 1 && iSz > 0 && elem_restrict && !DeviceCanUseCeed() &&
+                  !GetFusedRestriction() && a->GetBBFI()->Size() == 0 &&
+                  a->GetFBFI()->Size() == 0 && a->GetBFBFI()->Size() == 0;
+   for (int i = 0; batched && i < iSz; ++i)
+   {
+      batched = !elem_markers[i] && !integrators[i]->Patchwise();
+   }
+   if (!batched)
+   {
+      Operator::ArrayMult(X, Y);
+      return;
+   }
+
+   const int ne_size = elem_restrict->Height();
+   localXs.SetSize(nv*ne_size, Device::GetDeviceMemoryType());
+   localYs.SetSize(nv*ne_size, Device::GetDeviceMemoryType());
+   localXs.UseDevice(true);
+   localYs.UseDevice(true);
+   std::vector<Vector> xe(nv), ye(nv);
+   Array<const Vector *> Xe(nv);
+   Array<Vector *> Ye(nv);
+   for (int k = 0; k < nv; k++)
+   {
+      xe[k].MakeRef(localXs, k*ne_size, ne_size);
+      ye[k].MakeRef(localYs, k*ne_size, ne_size);
+      elem_restrict->Mult(*X[k], xe[k]);
+      Xe[k] = &xe[k];
+      Ye[k] = &ye[k];
+   }
+   localYs = 0.0;
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->ArrayAddMultPA(Xe, Ye);
+   }
+   for (int k = 0; k < nv; k++)
+   {
+      elem_restrict->MultTranspose(ye[k], *Y[k]);
+   }
+}
+
+const ElementRestriction *PABilinearFormExtension::GetFusedRestriction() const
+{
+   if (!a->FusedPartialAssemblyIsEnabled() || DeviceCanUseCeed()) { return NULL; }
+   if (trial_fes->GetVDim() != 1) { return NULL; }
+   const ElementRestriction *el_restrict =
+      dynamic_cast<const ElementRestriction*>(elem_restrict);
+   if (!el_restrict) { return NULL; }
+
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   Array<Array<int>*> &elem_markers = *a->GetDBFI_Marker();
+   if (integrators.Size() == 0) { return NULL; }
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (elem_markers[i] || integrators[i]->Patchwise() ||
+          !integrators[i]->SupportsFusedPA())
+      {
+         return NULL;
+      }
+   }
+   return el_restrict;
+}
+
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -849,6 +936,7 @@ void PABilinearFormExtension::AddMultWithMarkers(
 // Data and methods for element-assembled bilinear forms
 EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
    : PABilinearFormExtension(form),
+     ea_packed(false),
      factorize_face_terms(false)
 {
    if ( form->FESpace()->IsDGSpace() )
@@ -866,6 +954,7 @@ void EABilinearFormExtension::Assemble()
 
    ea_data.SetSize(ne*elemDofs*elemDofs, Device::GetMemoryType());
    ea_data.UseDevice(true);
+   ea_packed = false;
 
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int integratorCount = integrators.Size();
@@ -924,39 +1013,141 @@ void EABilinearFormExtension::Assemble()
       auto restFbdr = dynamic_cast<const L2FaceRestriction*>(bdr_face_restrict_lex);
       restFbdr->AddFaceMatricesToElementMatrices(ea_data_bdr, ea_data);
    }
+
+   // The full element matrices are needed to build the matrix with FA
+   if (a->SymmetricElementAssemblyIsEnabled() &&
+       a->GetAssemblyLevel() == AssemblyLevel::ELEMENT)
+   {
+      PackSymmetricElementMatrices();
+   }
 }
 
-void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
+void EABilinearFormExtension::PackSymmetricElementMatrices()
 {
-   // Apply the Element Restriction
-   const bool useRestrict = !DeviceCanUseCeed() && elem_restrict;
-   if (!useRestrict)
+   const int NDOFS = elemDofs;
+   const int NPACK = NDOFS*(NDOFS+1)/2;
+
+#ifdef MFEM_DEBUG
    {
-      y.UseDevice(true); // typically this is a large vector, so store on device
-      y = 0.0;
+      const auto A = Reshape(ea_data.HostRead(), NDOFS, NDOFS, ne);
+      for (int e = 0; e < ne; e++)
+      {
+         real_t max_a = 0.0, max_diff = 0.0;
+         for (int j = 0; j < NDOFS; j++)
+         {
+            for (int i = 0; i < NDOFS; i++)
+            {
+               max_a = std::max(max_a, std::abs(A(i, j, e)));
+               max_diff = std::max(max_diff, std::abs(A(i, j, e) - A(j, i, e)));
+            }
+         }
+         MFEM_VERIFY(max_diff <= 1e-12*max_a,
+                     "element matrix " << e << " is not symmetric");
+      }
    }
-   else
+#endif
+
+   Vector packed(ne*NPACK, Device::GetMemoryType());
+   packed.UseDevice(true);
+   const auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, ne);
+   auto S = Reshape(packed.Write(), NPACK, ne);
+   mfem::forall(ne*NDOFS, [=] MFEM_HOST_DEVICE (int glob_j)
    {
-      elem_restrict->Mult(x, localX);
-      localY = 0.0;
+      const int e = glob_j/NDOFS;
+      const int j = glob_j%NDOFS;
+      for (int i = 0; i <= j; i++)
+      {
+         S(i + j*(j+1)/2, e) = A(i, j, e);
+      }
+   });
+   ea_data.Swap(packed);
+   ea_packed = true;
+}
+
+void EABilinearFormExtension::AddMultElementMatrices(const Vector &x,
+                                                     Vector &y,
+                                                     const bool transpose) const
+{
+   const int NDOFS = elemDofs;
+   auto X = Reshape(x.Read(), NDOFS, ne);
+   auto Y = Reshape(y.ReadWrite(), NDOFS, ne);
+   if (ea_packed)
+   {
+      // Entry (i,j), i <= j, is at index i + j*(j+1)/2 of the packed matrix
+      const int NPACK = NDOFS*(NDOFS+1)/2;
+      auto S = Reshape(ea_data.Read(), NPACK, ne);
+      mfem::forall(ne*NDOFS, [=] MFEM_HOST_DEVICE (int glob_j)
+      {
+         const int e = glob_j/NDOFS;
+         const int j = glob_j%NDOFS;
+         const int col_j = j*(j+1)/2;
+         real_t res = 0.0;
+         for (int i = 0; i < j; i++)
+         {
+            res += S(i + col_j, e)*X(i, e);
+         }
+         for (int i = j; i < NDOFS; i++)
+         {
+            res += S(j + i*(i+1)/2, e)*X(i, e);
+         }
+         Y(j, e) += res;
+      });
    }
-   // Apply the Element Matrices
+   else if (a->BatchedElementAssemblyIsEnabled())
+   {
+      // Column-major view of the element matrices: A_e is the transpose of
+      // the matrix number e of the tensor
+      DenseTensor A;
+      A.UseExternalData(nullptr, NDOFS, NDOFS, ne);
+      A.GetMemory().MakeAlias(ea_data.GetMemory(), 0, ea_data.Size());
+      if (transpose) { BatchedLinAlg::AddMult(A, x, y); }
+      else { BatchedLinAlg::AddMultTranspose(A, x, y); }
+   }
+   else
    {
-      const int NDOFS = elemDofs;
-      auto X = Reshape(useRestrict?localX.Read():x.Read(), NDOFS, ne);
-      auto Y = Reshape(useRestrict?localY.ReadWrite():y.ReadWrite(), NDOFS, ne);
       auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, ne);
       mfem::forall(ne*NDOFS, [=] MFEM_HOST_DEVICE (int glob_j)
       {
          const int e = glob_j/NDOFS;
          const int j = glob_j%NDOFS;
          real_t res = 0.0;
-         for (int i = 0; i < NDOFS; i++)
+         if (transpose)
          {
-            res += A(i, j, e)*X(i, e);
+            for (int i = 0; i < NDOFS; i++)
+            {
+               res += A(j, i, e)*X(i, e);
+            }
+         }
+         else
+         {
+            for (int i = 0; i < NDOFS; i++)
+            {
+               res += A(i, j, e)*X(i, e);
+            }
          }
          Y(j, e) += res;
       });
+   }
+}
+
+void EABilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   // Apply the Element Restriction
+   const bool useRestrict = !DeviceCanUseCeed() && elem_restrict;
+   if (!useRestrict)
+   {
+      y.UseDevice(true); // typically this is a large vector, so store on device
+      y = 0.0;
+   }
+   else
+   {
+      elem_restrict->Mult(x, localX);
+      localY = 0.0;
+   }
+   // Apply the Element Matrices
+   {
+      if (useRestrict) { AddMultElementMatrices(localX, localY, false); }
+      else { AddMultElementMatrices(x, y, false); }
       // Apply the Element Restriction transposed
       if (useRestrict)
       {
@@ -1070,21 +1261,8 @@ void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
    }
    // Apply the Element Matrices transposed
    {
-      const int NDOFS = elemDofs;
-      auto X = Reshape(useRestrict?localX.Read():x.Read(), NDOFS, ne);
-      auto Y = Reshape(useRestrict?localY.ReadWrite():y.ReadWrite(), NDOFS, ne);
-      auto A = Reshape(ea_data.Read(), NDOFS, NDOFS, ne);
-      mfem::forall(ne*NDOFS, [=] MFEM_HOST_DEVICE (int glob_j)
-      {
-         const int e = glob_j/NDOFS;
-         const int j = glob_j%NDOFS;
-         real_t res = 0.0;
-         for (int i = 0; i < NDOFS; i++)
-         {
-            res += A(j, i, e)*X(i, e);
-         }
-         Y(j, e) += res;
-      });
+      if (useRestrict) { AddMultElementMatrices(localX, localY, true); }
+      else { AddMultElementMatrices(x, y, true); }
       // Apply the Element Restriction transposed
       if (useRestrict)
       {
@@ -1182,6 +1360,14 @@ void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
    }
 }
 
+void EABilinearFormExtension::ArrayMult(const Array<const Vector *> &X,
+                                        Array<Vector *> &Y) const
+{
+   // Also used by FABilinearFormExtension, whose Mult() uses the assembled
+   // matrix
+   Operator::ArrayMult(X, Y);
+}
+
 // Data and methods for fully-assembled bilinear forms
 FABilinearFormExtension::FABilinearFormExtension(BilinearForm *form)
    : EABilinearFormExtension(form),
@@ -72,6 +72,7 @@ protected:
    Array<int> elem_attributes, bdr_attributes;
    mutable Vector tmp_evec; // Work array
    mutable Vector localX, localY;
+   mutable Vector localXs, localYs; // E-vectors of ArrayMult()
    mutable Vector int_face_X, int_face_Y;
    mutable Vector bdr_face_X, bdr_face_Y;
    mutable Vector int_face_dXdn, int_face_dYdn;
@@ -93,11 +94,20 @@ public:
                          int copy_interior = 0) override;
    void Mult(const Vector &x, Vector &y) const override;
    void MultTranspose(const Vector &x, Vector &y) const override;
+   /** @brief Action on multiple vectors. With (unmarked) domain integrators
+       only, each integrator is applied to all vectors together with
+       BilinearFormIntegrator::ArrayAddMultPA(). */
+   void ArrayMult(const Array<const Vector *> &X,
+                  Array<Vector *> &Y) const override;
    void Update() override;
 
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
 
+   /// @brief Returns the ElementRestriction used by the fused action, or NULL
+   /// if the fused action cannot be used with the current integrators.
+   const ElementRestriction *GetFusedRestriction() const;
+
    /// @brief Accumulate the action (or transpose) of the integrator on @a x
    /// into @a y, taking into account the (possibly null) @a markers array.
    ///
@@ -141,19 +151,34 @@ class EABilinearFormExtension : public PABilinearFormExtension
 protected:
    int ne;
    int elemDofs;
-   // The element matrices are stored row major
+   // The element matrices are stored row major, or in symmetric packed form
+   // (the upper triangles, column by column) if ea_packed is true
    Vector ea_data;
+   bool ea_packed;
    int nf_int, nf_bdr;
    int faceDofs;
    Vector ea_data_int, ea_data_ext, ea_data_bdr;
    bool factorize_face_terms;
 
+   /// Replace the element matrices in ea_data by their symmetric packed form.
+   void PackSymmetricElementMatrices();
+
+   /** @brief Apply the element matrices (or their transposes) to the E-vector
+       @a x, adding the result to the E-vector @a y. */
+   void AddMultElementMatrices(const Vector &x, Vector &y,
+                               const bool transpose) const;
+
 public:
    EABilinearFormExtension(BilinearForm *form);
 
    void Assemble() override;
    void Mult(const Vector &x, Vector &y) const override;
    void MultTranspose(const Vector &x, Vector &y) const override;
+   /** @brief Action on multiple vectors, applied one vector at a time with
+       Mult(). The batched partial assembly action of the base class is not
+       used, since the integrators' PA data may not be set up. */
+   void ArrayMult(const Array<const Vector *> &X,
+                  Array<Vector *> &Y) const override;
 };
 
 /// Data and methods for fully-assembled bilinear forms
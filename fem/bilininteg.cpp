@@ -115,6 +115,30 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
               "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::ArrayAddMultPA(const Array<const Vector *> &X,
+                                            Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(), "Number of columns mismatch!");
+   for (int k = 0; k < X.Size(); k++)
+   {
+      AddMultPA(*X[k], *Y[k]);
+   }
+}
+
+int BilinearFormIntegrator::ArrayPAChunkSize(int bytes_per_elem)
+{
+   // Target size of the partial assembly data of a chunk
+   constexpr int chunk_bytes = 256*1024;
+   return std::max(1, chunk_bytes/std::max(1, bytes_per_elem));
+}
+
+void BilinearFormIntegrator::AddMultFusedPA(const Array<int> &, const Vector &,
+                                            Vector &) const
+{
+   MFEM_ABORT("BilinearFormIntegrator::AddMultFusedPA(...)\n"
+              "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &fes)
 {
    MFEM_ABORT("BilinearFormIntegrator::AssembleMF(...)\n"
@@ -13,6 +13,7 @@
 #define MFEM_BILININTEG
 
 #include "../config/config.hpp"
+#include "../general/bfloat16.hpp"
 #include "nonlininteg.hpp"
 #include "fespace.hpp"
 #include "ceed/interface/util.hpp"
@@ -24,10 +25,30 @@
 namespace mfem
 {
 
+/// Precision used to store the partial assembly data of the integrators, see
+/// BilinearFormIntegrator::SetPADataPrecision().
+enum class PADataPrecision
+{
+   FULL,    ///< real_t, the default
+   SINGLE,  ///< float
+   BFLOAT16 ///< bfloat16
+};
+
 /// Abstract base class BilinearFormIntegrator
 class BilinearFormIntegrator : public NonlinearFormIntegrator
 {
 protected:
+   PADataPrecision pa_precision = PADataPrecision::FULL;
+   bool pa_keep_full_precision = false;
+   bool pa_full_precision = false;
+
+   /** @brief Return the number of elements in the chunks used by
+       ArrayAddMultPA() implementations, which apply the partial assembly data
+       of a chunk of elements to all vectors before moving on to the next one.
+       The chunks are small enough for the data of a chunk, of
+       @a bytes_per_elem bytes per element, to stay in the cache. */
+   static int ArrayPAChunkSize(int bytes_per_elem);
+
    BilinearFormIntegrator(const IntegrationRule *ir = NULL)
       : NonlinearFormIntegrator(ir) { }
 
@@ -63,6 +84,32 @@ public:
 
    virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
 
+   /** @brief Set the precision used to store the partial assembly data, which
+       takes effect in the next call to AssemblePA().
+
+       With a reduced precision, AddMultPA() reads the quadrature point data in
+       that precision and performs all the computations in real_t. This reduces
+       the memory traffic of the action, at the cost of its accuracy. The full
+       precision data is freed after the conversion, unless @a keep_full is
+       true, see UseFullPrecisionPA(). Currently supported by
+       DiffusionIntegrator; other integrators use full precision. */
+   void SetPADataPrecision(PADataPrecision precision, bool keep_full = false)
+   {
+      pa_precision = precision;
+      pa_keep_full_precision = keep_full;
+   }
+
+   /// Return the precision set with SetPADataPrecision().
+   PADataPrecision GetPADataPrecision() const { return pa_precision; }
+
+   /** @brief Use (if @a full is true) the full precision partial assembly data
+       in AddMultPA(), even if a reduced precision was set with
+       SetPADataPrecision(), e.g. for the last iterations of a solver or the
+       computation of residuals. No reassembly is needed to switch between the
+       two, but the full precision data must have been kept, see the parameter
+       @a keep_full of SetPADataPrecision(). */
+   void UseFullPrecisionPA(bool full = true) { pa_full_precision = full; }
+
    /// Assemble diagonal and add it to Vector @a diag.
    virtual void AssembleDiagonalPA(Vector &diag);
 
@@ -90,6 +137,30 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /// Method for partially assembled action on multiple vectors.
+   /** Perform the action AddMultPA() on each of the E-vectors @a X[k], adding
+       the result to @a Y[k]. Integrators can override this method to read
+       their partial assembly data once for all vectors. The default
+       implementation calls AddMultPA() for each vector. */
+   virtual void ArrayAddMultPA(const Array<const Vector *> &X,
+                               Array<Vector *> &Y) const;
+
+   /// Returns true if the integrator implements AddMultFusedPA() for the
+   /// configuration set up by the last call to AssemblePA().
+   virtual bool SupportsFusedPA() const { return false; }
+
+   /// Method for fused partially assembled action.
+   /** Perform the action of the integrator on the L-vector @a x and add the
+       result to the L-vector @a y. The element degrees of freedom are gathered
+       using the (signed) element-to-dof @a gather_map of the lexicographic
+       ElementRestriction, see ElementRestriction::GatherMap(), so that no
+       intermediate E-vectors are formed.
+
+       This method can be called only after the method AssemblePA() has been
+       called, and only if SupportsFusedPA() returns true. */
+   virtual void AddMultFusedPA(const Array<int> &gather_map, const Vector &x,
+                               Vector &y) const;
+
    /// Method defining element assembly.
    /** The result of the element assembly is added to the @a emat Vector if
        @a add is true. Otherwise, if @a add is false, we set @a emat. */
@@ -2154,8 +2225,41 @@ public:
                                       const Array<real_t>&, const Vector&, Vector&,
                                       const int, const int);
 
+   using FusedApplyKernelType = void(*)(const int, const bool,
+                                        const Array<real_t>&,
+                                        const Array<real_t>&,
+                                        const Array<real_t>&,
+                                        const Array<real_t>&, const Vector&,
+                                        const Array<int>&, const Vector&,
+                                        Vector&, const int, const int);
+
+   using SingleApplyKernelType = void(*)(const int, const bool,
+                                         const Array<real_t>&,
+                                         const Array<real_t>&,
+                                         const Array<real_t>&,
+                                         const Array<real_t>&,
+                                         const Array<float>&, const Vector&,
+                                         Vector&, const int, const int);
+
+   using BF16ApplyKernelType = void(*)(const int, const bool,
+                                       const Array<real_t>&,
+                                       const Array<real_t>&,
+                                       const Array<real_t>&,
+                                       const Array<real_t>&,
+                                       const Array<bfloat16>&, const Vector&,
+                                       Vector&, const int, const int);
+
    MFEM_REGISTER_KERNELS(ApplyPAKernels, ApplyKernelType, (int, int, int));
    MFEM_REGISTER_KERNELS(DiagonalPAKernels, DiagonalKernelType, (int, int, int));
+   MFEM_REGISTER_KERNELS(FusedApplyPAKernels, FusedApplyKernelType,
+                         (int, int, int));
+   /// Kernels using reduced precision PA data, see SetPADataPrecision().
+   MFEM_REGISTER_KERNELS(SingleApplyPAKernels, SingleApplyKernelType,
+                         (int, int, int));
+   MFEM_REGISTER_KERNELS(BF16ApplyPAKernels, BF16ApplyKernelType,
+                         (int, int, int));
+   /// Host kernels vectorized across batches of elements (CPU and OpenMP).
+   MFEM_REGISTER_KERNELS(SimdApplyPAKernels, ApplyKernelType, (int, int, int));
    static struct Kernels { Kernels(); } kernels;
 
 protected:
@@ -2178,6 +2282,16 @@ private:
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
    bool symmetric = true; ///< False if using a nonsymmetric matrix coefficient
+   Array<float> pa_data_single;  ///< pa_data in single precision, if used
+   Array<bfloat16> pa_data_bf16; ///< pa_data in bfloat16, if used
+
+   // Set up the reduced precision copy of pa_data, see SetPADataPrecision().
+   // Unless the full precision data is kept, pa_data is then freed.
+   void SetupReducedPrecisionPAData();
+
+   // Return pa_data, or, if it was freed, the conversion to real_t of the
+   // reduced precision data in @a tmp.
+   const Vector &GetFullPrecisionPAData(Vector &tmp) const;
 
    // Data for NURBS patch PA
 
@@ -2306,8 +2420,19 @@ public:
 
    void AddMultPA(const Vector&, Vector&) const override;
 
+   /** @brief Partially assembled action on multiple vectors. On the host, the
+       full precision quadrature data is applied in chunks of elements to all
+       vectors, so that it is read from memory only once. */
+   void ArrayAddMultPA(const Array<const Vector *> &X,
+                       Array<Vector *> &Y) const override;
+
    void AddMultTransposePA(const Vector&, Vector&) const override;
 
+   bool SupportsFusedPA() const override;
+
+   void AddMultFusedPA(const Array<int> &gather_map, const Vector &x,
+                       Vector &y) const override;
+
    void AddMultNURBSPA(const Vector&, Vector&) const override;
 
    void AddMultPatchPA(const int patch, const Vector &x, Vector &y) const;
@@ -2324,6 +2449,12 @@ public:
    {
       ApplyPAKernels::Specialization<DIM,D1D,Q1D>::Add();
       DiagonalPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+      FusedApplyPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+      SingleApplyPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+      BF16ApplyPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+#ifdef MFEM_USE_SIMD
+      SimdApplyPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+#endif
    }
 };
 
@@ -2356,6 +2487,8 @@ public:
 
    MFEM_REGISTER_KERNELS(ApplyPAKernels, ApplyKernelType, (int, int, int));
    MFEM_REGISTER_KERNELS(DiagonalPAKernels, DiagonalKernelType, (int, int, int));
+   /// Host kernels vectorized across batches of elements (CPU and OpenMP).
+   MFEM_REGISTER_KERNELS(SimdApplyPAKernels, ApplyKernelType, (int, int, int));
    static struct Kernels { Kernels(); } kernels;
 
 public:
@@ -2394,6 +2527,12 @@ public:
 
    void AddMultPA(const Vector&, Vector&) const override;
 
+   /** @brief Partially assembled action on multiple vectors. On the host, the
+       quadrature data is applied in chunks of elements to all vectors, so
+       that it is read from memory only once. */
+   void ArrayAddMultPA(const Array<const Vector *> &X,
+                       Array<Vector *> &Y) const override;
+
    void AddMultTransposePA(const Vector&, Vector&) const override;
 
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
@@ -2409,6 +2548,9 @@ public:
    {
       ApplyPAKernels::Specialization<DIM,D1D,Q1D>::Add();
       DiagonalPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+#ifdef MFEM_USE_SIMD
+      SimdApplyPAKernels::Specialization<DIM,D1D,Q1D>::Add();
+#endif
    }
 };
 
@@ -28,6 +28,7 @@
 #include "fespace.hpp"
 #include "gridfunc.hpp"
 #include "kdtree.hpp"
+#include "pacache.hpp"
 #include "linearform.hpp"
 #include "nonlinearform.hpp"
 #include "bilinearform.hpp"
@@ -246,7 +246,11 @@ void DiffusionIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                      Vector &ea_data,
                                      const bool add)
 {
+   // The element matrices are computed from the full precision data
+   const PADataPrecision precision = pa_precision;
+   pa_precision = PADataPrecision::FULL;
    AssemblePA(fes);
+   pa_precision = precision;
    ne = fes.GetMesh()->GetNE();
    const Array<real_t> &B = maps->B;
    const Array<real_t> &G = maps->G;
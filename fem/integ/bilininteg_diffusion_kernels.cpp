@@ -39,6 +39,19 @@ DiffusionIntegrator::Kernels::Kernels()
    DiffusionIntegrator::AddSpecialization<3,6,7>();
    DiffusionIntegrator::AddSpecialization<3,7,8>();
    DiffusionIntegrator::AddSpecialization<3,8,9>();
+   // Runtime compilation of other specializations, see KernelJIT
+   constexpr const char *header = "fem/integ/bilininteg_diffusion_kernels.hpp";
+   ApplyPAKernels::SetJitSource("DiffusionIntegrator::ApplyPAKernels", header);
+   DiagonalPAKernels::SetJitSource("DiffusionIntegrator::DiagonalPAKernels",
+                                   header);
+   FusedApplyPAKernels::SetJitSource("DiffusionIntegrator::FusedApplyPAKernels",
+                                     header);
+   SimdApplyPAKernels::SetJitSource("DiffusionIntegrator::SimdApplyPAKernels",
+                                    header);
+   SingleApplyPAKernels::SetJitSource(
+      "DiffusionIntegrator::SingleApplyPAKernels", header);
+   BF16ApplyPAKernels::SetJitSource("DiffusionIntegrator::BF16ApplyPAKernels",
+                                    header);
 }
 
 namespace internal
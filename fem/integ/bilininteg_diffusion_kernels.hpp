@@ -19,6 +19,7 @@
 #include "../../linalg/dtensor.hpp"
 #include "../../linalg/vector.hpp"
 #include "../bilininteg.hpp"
+#include "bilininteg_simd_kernels.hpp"
 
 namespace mfem
 {
@@ -521,6 +522,116 @@ void OccaPADiffusionApply3D(const int D1D,
                             Vector &Y);
 #endif // MFEM_USE_OCCA
 
+// PA Diffusion Apply 2D kernel acting on the single element @a e. The element
+// degrees of freedom are read from @a X and the result is added to @a Y.
+template<int T_D1D = 0, int T_Q1D = 0>
+MFEM_HOST_DEVICE inline
+void PADiffusionApply2D_Element(const int e,
+                                const bool symmetric,
+                                const ConstDeviceMatrix &B,
+                                const ConstDeviceMatrix &G,
+                                const ConstDeviceMatrix &Bt,
+                                const ConstDeviceMatrix &Gt,
+                                const ConstDeviceCube &D,
+                                const ConstDeviceMatrix &X,
+                                const DeviceMatrix &Y,
+                                const int d1d = 0,
+                                const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   // the following variables are evaluated at compile time
+   constexpr int max_D1D = T_D1D ? T_D1D : DofQuadLimits::MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : DofQuadLimits::MAX_Q1D;
+
+   real_t grad[max_Q1D][max_Q1D][2];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         grad[qy][qx][0] = 0.0;
+         grad[qy][qx][1] = 0.0;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      real_t gradX[max_Q1D][2];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         gradX[qx][0] = 0.0;
+         gradX[qx][1] = 0.0;
+      }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         const real_t s = X(dx,dy);
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] += s * B(qx,dx);
+            gradX[qx][1] += s * G(qx,dx);
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         const real_t wy  = B(qy,dy);
+         const real_t wDy = G(qy,dy);
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][0] += gradX[qx][1] * wy;
+            grad[qy][qx][1] += gradX[qx][0] * wDy;
+         }
+      }
+   }
+   // Calculate Dxy, xDy in plane
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const int q = qx + qy * Q1D;
+
+         const real_t O11 = D(q,0,e);
+         const real_t O21 = D(q,1,e);
+         const real_t O12 = symmetric ? O21 : D(q,2,e);
+         const real_t O22 = symmetric ? D(q,2,e) : D(q,3,e);
+
+         const real_t gradX = grad[qy][qx][0];
+         const real_t gradY = grad[qy][qx][1];
+
+         grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
+         grad[qy][qx][1] = (O21 * gradX) + (O22 * gradY);
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      real_t gradX[max_D1D][2];
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         gradX[dx][0] = 0;
+         gradX[dx][1] = 0;
+      }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const real_t gX = grad[qy][qx][0];
+         const real_t gY = grad[qy][qx][1];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const real_t wx  = Bt(dx,qx);
+            const real_t wDx = Gt(dx,qx);
+            gradX[dx][0] += gX * wDx;
+            gradX[dx][1] += gY * wx;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         const real_t wy  = Bt(dy,qy);
+         const real_t wDy = Gt(dy,qy);
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            Y(dx,dy) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+         }
+      }
+   }
+}
+
 // PA Diffusion Apply 2D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
 inline void PADiffusionApply2D(const int NE,
@@ -549,109 +660,23 @@ inline void PADiffusionApply2D(const int NE,
    mfem::forall(NE, [=] MFEM_HOST_DEVICE (int e)
    {
       const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      // the following variables are evaluated at compile time
-      constexpr int max_D1D = T_D1D ? T_D1D : DofQuadLimits::MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : DofQuadLimits::MAX_Q1D;
-
-      real_t grad[max_Q1D][max_Q1D][2];
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            grad[qy][qx][0] = 0.0;
-            grad[qy][qx][1] = 0.0;
-         }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         real_t gradX[max_Q1D][2];
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            gradX[qx][0] = 0.0;
-            gradX[qx][1] = 0.0;
-         }
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            const real_t s = X(dx,dy,e);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               gradX[qx][0] += s * B(qx,dx);
-               gradX[qx][1] += s * G(qx,dx);
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            const real_t wy  = B(qy,dy);
-            const real_t wDy = G(qy,dy);
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               grad[qy][qx][0] += gradX[qx][1] * wy;
-               grad[qy][qx][1] += gradX[qx][0] * wDy;
-            }
-         }
-      }
-      // Calculate Dxy, xDy in plane
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const int q = qx + qy * Q1D;
-
-            const real_t O11 = D(q,0,e);
-            const real_t O21 = D(q,1,e);
-            const real_t O12 = symmetric ? O21 : D(q,2,e);
-            const real_t O22 = symmetric ? D(q,2,e) : D(q,3,e);
-
-            const real_t gradX = grad[qy][qx][0];
-            const real_t gradY = grad[qy][qx][1];
-
-            grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
-            grad[qy][qx][1] = (O21 * gradX) + (O22 * gradY);
-         }
-      }
-      for (int qy = 0; qy < Q1D; ++qy)
-      {
-         real_t gradX[max_D1D][2];
-         for (int dx = 0; dx < D1D; ++dx)
-         {
-            gradX[dx][0] = 0;
-            gradX[dx][1] = 0;
-         }
-         for (int qx = 0; qx < Q1D; ++qx)
-         {
-            const real_t gX = grad[qy][qx][0];
-            const real_t gY = grad[qy][qx][1];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               const real_t wx  = Bt(dx,qx);
-               const real_t wDx = Gt(dx,qx);
-               gradX[dx][0] += gX * wDx;
-               gradX[dx][1] += gY * wx;
-            }
-         }
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            const real_t wy  = Bt(dy,qy);
-            const real_t wDy = Gt(dy,qy);
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               Y(dx,dy,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
-            }
-         }
-      }
+      const auto Xe = Reshape(&X(0,0,e), D1D, D1D);
+      const auto Ye = Reshape(&Y(0,0,e), D1D, D1D);
+      PADiffusionApply2D_Element<T_D1D,T_Q1D>(e, symmetric, B, G, Bt, Gt, D,
+                                              Xe, Ye, d1d, q1d);
    });
 }
 
-// Shared memory PA Diffusion Apply 2D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+// Shared memory PA Diffusion Apply 2D kernel. The PA data container type TD
+// is Vector, or Array<float> or Array<bfloat16> for reduced precision data.
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 inline void SmemPADiffusionApply2D(const int NE,
                                    const bool symmetric,
                                    const Array<real_t> &b_,
                                    const Array<real_t> &g_,
                                    const Array<real_t> &bt_,
                                    const Array<real_t> &gt_,
-                                   const Vector &d_,
+                                   const TD &d_,
                                    const Vector &x_,
                                    Vector &y_,
                                    const int d1d = 0,
@@ -682,14 +707,15 @@ inline void SmemPADiffusionApply2D(const int NE,
       real_t (*G)[MD1] = (real_t (*)[MD1]) (sBG+1);
       real_t (*Bt)[MQ1] = (real_t (*)[MQ1]) (sBG+0);
       real_t (*Gt)[MQ1] = (real_t (*)[MQ1]) (sBG+1);
+      constexpr int MDQ = (MQ1 > MD1) ? MQ1 : MD1;
       MFEM_SHARED real_t Xz[NBZ][MD1][MD1];
-      MFEM_SHARED real_t GD[2][NBZ][MD1][MQ1];
-      MFEM_SHARED real_t GQ[2][NBZ][MD1][MQ1];
+      MFEM_SHARED real_t GD[2][NBZ][MDQ][MDQ];
+      MFEM_SHARED real_t GQ[2][NBZ][MDQ][MDQ];
       real_t (*X)[MD1] = (real_t (*)[MD1])(Xz + tidz);
-      real_t (*DQ0)[MD1] = (real_t (*)[MD1])(GD[0] + tidz);
-      real_t (*DQ1)[MD1] = (real_t (*)[MD1])(GD[1] + tidz);
-      real_t (*QQ0)[MD1] = (real_t (*)[MD1])(GQ[0] + tidz);
-      real_t (*QQ1)[MD1] = (real_t (*)[MD1])(GQ[1] + tidz);
+      real_t (*DQ0)[MDQ] = (real_t (*)[MDQ])(GD[0] + tidz);
+      real_t (*DQ1)[MDQ] = (real_t (*)[MDQ])(GD[1] + tidz);
+      real_t (*QQ0)[MDQ] = (real_t (*)[MDQ])(GQ[0] + tidz);
+      real_t (*QQ1)[MDQ] = (real_t (*)[MDQ])(GQ[1] + tidz);
       MFEM_FOREACH_THREAD(dy,y,D1D)
       {
          MFEM_FOREACH_THREAD(dx,x,D1D)
@@ -803,208 +829,341 @@ inline void SmemPADiffusionApply2D(const int NE,
    });
 }
 
-// PA Diffusion Apply 3D kernel
+// PA Diffusion Apply 3D kernel acting on the single element @a e. The element
+// degrees of freedom are read from @a X and the result is added to @a Y.
 template<int T_D1D = 0, int T_Q1D = 0>
-inline void PADiffusionApply3D(const int NE,
-                               const bool symmetric,
-                               const Array<real_t> &b,
-                               const Array<real_t> &g,
-                               const Array<real_t> &bt,
-                               const Array<real_t> &gt,
-                               const Vector &d_,
-                               const Vector &x_,
-                               Vector &y_,
-                               int d1d = 0, int q1d = 0)
+MFEM_HOST_DEVICE inline
+void PADiffusionApply3D_Element(const int e,
+                                const bool symmetric,
+                                const ConstDeviceMatrix &B,
+                                const ConstDeviceMatrix &G,
+                                const ConstDeviceMatrix &Bt,
+                                const ConstDeviceMatrix &Gt,
+                                const ConstDeviceCube &D,
+                                const ConstDeviceCube &X,
+                                const DeviceCube &Y,
+                                const int d1d = 0,
+                                const int q1d = 0)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
    const int Q1D = T_Q1D ? T_Q1D : q1d;
-   MFEM_VERIFY(D1D <= DeviceDofQuadLimits::Get().MAX_D1D, "");
-   MFEM_VERIFY(Q1D <= DeviceDofQuadLimits::Get().MAX_Q1D, "");
-   auto B = Reshape(b.Read(), Q1D, D1D);
-   auto G = Reshape(g.Read(), Q1D, D1D);
-   auto Bt = Reshape(bt.Read(), D1D, Q1D);
-   auto Gt = Reshape(gt.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
-   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
-   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   mfem::forall(NE, [=] MFEM_HOST_DEVICE (int e)
+   constexpr int max_D1D = T_D1D ? T_D1D : DofQuadLimits::MAX_D1D;
+   constexpr int max_Q1D = T_Q1D ? T_Q1D : DofQuadLimits::MAX_Q1D;
+   real_t grad[max_Q1D][max_Q1D][max_Q1D][3];
+   for (int qz = 0; qz < Q1D; ++qz)
    {
-      const int D1D = T_D1D ? T_D1D : d1d;
-      const int Q1D = T_Q1D ? T_Q1D : q1d;
-      constexpr int max_D1D = T_D1D ? T_D1D : DofQuadLimits::MAX_D1D;
-      constexpr int max_Q1D = T_Q1D ? T_Q1D : DofQuadLimits::MAX_Q1D;
-      real_t grad[max_Q1D][max_Q1D][max_Q1D][3];
-      for (int qz = 0; qz < Q1D; ++qz)
+      for (int qy = 0; qy < Q1D; ++qy)
       {
-         for (int qy = 0; qy < Q1D; ++qy)
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qz][qy][qx][0] = 0.0;
+            grad[qz][qy][qx][1] = 0.0;
+            grad[qz][qy][qx][2] = 0.0;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      real_t gradXY[max_Q1D][max_Q1D][3];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
          {
+            gradXY[qy][qx][0] = 0.0;
+            gradXY[qy][qx][1] = 0.0;
+            gradXY[qy][qx][2] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         real_t gradX[max_Q1D][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const real_t s = X(dx,dy,dz);
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               grad[qz][qy][qx][0] = 0.0;
-               grad[qz][qy][qx][1] = 0.0;
-               grad[qz][qy][qx][2] = 0.0;
+               gradX[qx][0] += s * B(qx,dx);
+               gradX[qx][1] += s * G(qx,dx);
             }
          }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         real_t gradXY[max_Q1D][max_Q1D][3];
          for (int qy = 0; qy < Q1D; ++qy)
          {
+            const real_t wy  = B(qy,dy);
+            const real_t wDy = G(qy,dy);
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               gradXY[qy][qx][0] = 0.0;
-               gradXY[qy][qx][1] = 0.0;
-               gradXY[qy][qx][2] = 0.0;
+               const real_t wx  = gradX[qx][0];
+               const real_t wDx = gradX[qx][1];
+               gradXY[qy][qx][0] += wDx * wy;
+               gradXY[qy][qx][1] += wx  * wDy;
+               gradXY[qy][qx][2] += wx  * wy;
             }
          }
-         for (int dy = 0; dy < D1D; ++dy)
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         const real_t wz  = B(qz,dz);
+         const real_t wDz = G(qz,dz);
+         for (int qy = 0; qy < Q1D; ++qy)
          {
-            real_t gradX[max_Q1D][2];
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               gradX[qx][0] = 0.0;
-               gradX[qx][1] = 0.0;
+               grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+               grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+               grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
             }
+         }
+      }
+   }
+   // Calculate Dxyz, xDyz, xyDz in plane
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + (qy + qz * Q1D) * Q1D;
+            const real_t O11 = D(q,0,e);
+            const real_t O12 = D(q,1,e);
+            const real_t O13 = D(q,2,e);
+            const real_t O21 = symmetric ? O12 : D(q,3,e);
+            const real_t O22 = symmetric ? D(q,3,e) : D(q,4,e);
+            const real_t O23 = symmetric ? D(q,4,e) : D(q,5,e);
+            const real_t O31 = symmetric ? O13 : D(q,6,e);
+            const real_t O32 = symmetric ? O23 : D(q,7,e);
+            const real_t O33 = symmetric ? D(q,5,e) : D(q,8,e);
+            const real_t gradX = grad[qz][qy][qx][0];
+            const real_t gradY = grad[qz][qy][qx][1];
+            const real_t gradZ = grad[qz][qy][qx][2];
+            grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
+            grad[qz][qy][qx][1] = (O21*gradX)+(O22*gradY)+(O23*gradZ);
+            grad[qz][qy][qx][2] = (O31*gradX)+(O32*gradY)+(O33*gradZ);
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      real_t gradXY[max_D1D][max_D1D][3];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradXY[dy][dx][0] = 0;
+            gradXY[dy][dx][1] = 0;
+            gradXY[dy][dx][2] = 0;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         real_t gradX[max_D1D][3];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0;
+            gradX[dx][1] = 0;
+            gradX[dx][2] = 0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const real_t gX = grad[qz][qy][qx][0];
+            const real_t gY = grad[qz][qy][qx][1];
+            const real_t gZ = grad[qz][qy][qx][2];
             for (int dx = 0; dx < D1D; ++dx)
             {
-               const real_t s = X(dx,dy,dz,e);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  gradX[qx][0] += s * B(qx,dx);
-                  gradX[qx][1] += s * G(qx,dx);
-               }
-            }
-            for (int qy = 0; qy < Q1D; ++qy)
-            {
-               const real_t wy  = B(qy,dy);
-               const real_t wDy = G(qy,dy);
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  const real_t wx  = gradX[qx][0];
-                  const real_t wDx = gradX[qx][1];
-                  gradXY[qy][qx][0] += wDx * wy;
-                  gradXY[qy][qx][1] += wx  * wDy;
-                  gradXY[qy][qx][2] += wx  * wy;
-               }
+               const real_t wx  = Bt(dx,qx);
+               const real_t wDx = Gt(dx,qx);
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+               gradX[dx][2] += gZ * wx;
             }
          }
-         for (int qz = 0; qz < Q1D; ++qz)
+         for (int dy = 0; dy < D1D; ++dy)
          {
-            const real_t wz  = B(qz,dz);
-            const real_t wDz = G(qz,dz);
-            for (int qy = 0; qy < Q1D; ++qy)
+            const real_t wy  = Bt(dy,qy);
+            const real_t wDy = Gt(dy,qy);
+            for (int dx = 0; dx < D1D; ++dx)
             {
-               for (int qx = 0; qx < Q1D; ++qx)
-               {
-                  grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
-                  grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
-                  grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
-               }
+               gradXY[dy][dx][0] += gradX[dx][0] * wy;
+               gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+               gradXY[dy][dx][2] += gradX[dx][2] * wy;
             }
          }
       }
-      // Calculate Dxyz, xDyz, xyDz in plane
-      for (int qz = 0; qz < Q1D; ++qz)
+      for (int dz = 0; dz < D1D; ++dz)
       {
-         for (int qy = 0; qy < Q1D; ++qy)
+         const real_t wz  = Bt(dz,qz);
+         const real_t wDz = Gt(dz,qz);
+         for (int dy = 0; dy < D1D; ++dy)
          {
-            for (int qx = 0; qx < Q1D; ++qx)
+            for (int dx = 0; dx < D1D; ++dx)
             {
-               const int q = qx + (qy + qz * Q1D) * Q1D;
-               const real_t O11 = D(q,0,e);
-               const real_t O12 = D(q,1,e);
-               const real_t O13 = D(q,2,e);
-               const real_t O21 = symmetric ? O12 : D(q,3,e);
-               const real_t O22 = symmetric ? D(q,3,e) : D(q,4,e);
-               const real_t O23 = symmetric ? D(q,4,e) : D(q,5,e);
-               const real_t O31 = symmetric ? O13 : D(q,6,e);
-               const real_t O32 = symmetric ? O23 : D(q,7,e);
-               const real_t O33 = symmetric ? D(q,5,e) : D(q,8,e);
-               const real_t gradX = grad[qz][qy][qx][0];
-               const real_t gradY = grad[qz][qy][qx][1];
-               const real_t gradZ = grad[qz][qy][qx][2];
-               grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
-               grad[qz][qy][qx][1] = (O21*gradX)+(O22*gradY)+(O23*gradZ);
-               grad[qz][qy][qx][2] = (O31*gradX)+(O32*gradY)+(O33*gradZ);
+               Y(dx,dy,dz) +=
+                  ((gradXY[dy][dx][0] * wz) +
+                   (gradXY[dy][dx][1] * wz) +
+                   (gradXY[dy][dx][2] * wDz));
             }
          }
       }
-      for (int qz = 0; qz < Q1D; ++qz)
+   }
+}
+
+// PA Diffusion Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0>
+inline void PADiffusionApply3D(const int NE,
+                               const bool symmetric,
+                               const Array<real_t> &b,
+                               const Array<real_t> &g,
+                               const Array<real_t> &bt,
+                               const Array<real_t> &gt,
+                               const Vector &d_,
+                               const Vector &x_,
+                               Vector &y_,
+                               int d1d = 0, int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= DeviceDofQuadLimits::Get().MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= DeviceDofQuadLimits::Get().MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
+   auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
+   mfem::forall(NE, [=] MFEM_HOST_DEVICE (int e)
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const auto Xe = Reshape(&X(0,0,0,e), D1D, D1D, D1D);
+      const auto Ye = Reshape(&Y(0,0,0,e), D1D, D1D, D1D);
+      PADiffusionApply3D_Element<T_D1D,T_Q1D>(e, symmetric, B, G, Bt, Gt, D,
+                                              Xe, Ye, d1d, q1d);
+   });
+}
+
+// Fused PA Diffusion Apply 2D kernel: the element degrees of freedom are
+// gathered from the L-vector x_ through the (signed) element-to-dof map
+// gather_map_, and the element contributions are added directly to the
+// L-vector y_, without forming intermediate E-vectors.
+template<int T_D1D = 0, int T_Q1D = 0>
+inline void PADiffusionApplyFused2D(const int NE,
+                                    const bool symmetric,
+                                    const Array<real_t> &b_,
+                                    const Array<real_t> &g_,
+                                    const Array<real_t> &bt_,
+                                    const Array<real_t> &gt_,
+                                    const Vector &d_,
+                                    const Array<int> &gather_map_,
+                                    const Vector &x_,
+                                    Vector &y_,
+                                    const int d1d = 0,
+                                    const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= DeviceDofQuadLimits::Get().MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= DeviceDofQuadLimits::Get().MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
+   auto M = Reshape(gather_map_.Read(), D1D*D1D, NE);
+   auto X = x_.Read();
+   auto Y = y_.ReadWrite();
+   mfem::forall(NE, [=] MFEM_HOST_DEVICE (int e)
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : DofQuadLimits::MAX_D1D;
+      real_t xe[max_D1D*max_D1D], ye[max_D1D*max_D1D];
+      for (int i = 0; i < D1D*D1D; ++i)
+      {
+         const int gid = M(i,e);
+         const int j = gid >= 0 ? gid : -1-gid;
+         xe[i] = gid >= 0 ? X[j] : -X[j];
+         ye[i] = 0.0;
+      }
+      const real_t *cxe = xe;
+      PADiffusionApply2D_Element<T_D1D,T_Q1D>(e, symmetric, B, G, Bt, Gt, D,
+                                              Reshape(cxe, D1D, D1D),
+                                              Reshape(ye, D1D, D1D), d1d, q1d);
+      for (int i = 0; i < D1D*D1D; ++i)
       {
-         real_t gradXY[max_D1D][max_D1D][3];
-         for (int dy = 0; dy < D1D; ++dy)
-         {
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradXY[dy][dx][0] = 0;
-               gradXY[dy][dx][1] = 0;
-               gradXY[dy][dx][2] = 0;
-            }
-         }
-         for (int qy = 0; qy < Q1D; ++qy)
-         {
-            real_t gradX[max_D1D][3];
-            for (int dx = 0; dx < D1D; ++dx)
-            {
-               gradX[dx][0] = 0;
-               gradX[dx][1] = 0;
-               gradX[dx][2] = 0;
-            }
-            for (int qx = 0; qx < Q1D; ++qx)
-            {
-               const real_t gX = grad[qz][qy][qx][0];
-               const real_t gY = grad[qz][qy][qx][1];
-               const real_t gZ = grad[qz][qy][qx][2];
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  const real_t wx  = Bt(dx,qx);
-                  const real_t wDx = Gt(dx,qx);
-                  gradX[dx][0] += gX * wDx;
-                  gradX[dx][1] += gY * wx;
-                  gradX[dx][2] += gZ * wx;
-               }
-            }
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               const real_t wy  = Bt(dy,qy);
-               const real_t wDy = Gt(dy,qy);
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  gradXY[dy][dx][0] += gradX[dx][0] * wy;
-                  gradXY[dy][dx][1] += gradX[dx][1] * wDy;
-                  gradXY[dy][dx][2] += gradX[dx][2] * wy;
-               }
-            }
-         }
-         for (int dz = 0; dz < D1D; ++dz)
-         {
-            const real_t wz  = Bt(dz,qz);
-            const real_t wDz = Gt(dz,qz);
-            for (int dy = 0; dy < D1D; ++dy)
-            {
-               for (int dx = 0; dx < D1D; ++dx)
-               {
-                  Y(dx,dy,dz,e) +=
-                     ((gradXY[dy][dx][0] * wz) +
-                      (gradXY[dy][dx][1] * wz) +
-                      (gradXY[dy][dx][2] * wDz));
-               }
-            }
-         }
+         const int gid = M(i,e);
+         const int j = gid >= 0 ? gid : -1-gid;
+         AtomicAdd(Y[j], gid >= 0 ? ye[i] : -ye[i]);
       }
    });
 }
 
-// Shared memory PA Diffusion Apply 3D kernel
+// Fused PA Diffusion Apply 3D kernel, see PADiffusionApplyFused2D.
 template<int T_D1D = 0, int T_Q1D = 0>
+inline void PADiffusionApplyFused3D(const int NE,
+                                    const bool symmetric,
+                                    const Array<real_t> &b_,
+                                    const Array<real_t> &g_,
+                                    const Array<real_t> &bt_,
+                                    const Array<real_t> &gt_,
+                                    const Vector &d_,
+                                    const Array<int> &gather_map_,
+                                    const Vector &x_,
+                                    Vector &y_,
+                                    const int d1d = 0,
+                                    const int q1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= DeviceDofQuadLimits::Get().MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= DeviceDofQuadLimits::Get().MAX_Q1D, "");
+   auto B = Reshape(b_.Read(), Q1D, D1D);
+   auto G = Reshape(g_.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt_.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt_.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
+   auto M = Reshape(gather_map_.Read(), D1D*D1D*D1D, NE);
+   auto X = x_.Read();
+   auto Y = y_.ReadWrite();
+   mfem::forall(NE, [=] MFEM_HOST_DEVICE (int e)
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : DofQuadLimits::MAX_D1D;
+      constexpr int max_DOF = max_D1D*max_D1D*max_D1D;
+      real_t xe[max_DOF], ye[max_DOF];
+      for (int i = 0; i < D1D*D1D*D1D; ++i)
+      {
+         const int gid = M(i,e);
+         const int j = gid >= 0 ? gid : -1-gid;
+         xe[i] = gid >= 0 ? X[j] : -X[j];
+         ye[i] = 0.0;
+      }
+      const real_t *cxe = xe;
+      PADiffusionApply3D_Element<T_D1D,T_Q1D>(e, symmetric, B, G, Bt, Gt, D,
+                                              Reshape(cxe, D1D, D1D, D1D),
+                                              Reshape(ye, D1D, D1D, D1D),
+                                              d1d, q1d);
+      for (int i = 0; i < D1D*D1D*D1D; ++i)
+      {
+         const int gid = M(i,e);
+         const int j = gid >= 0 ? gid : -1-gid;
+         AtomicAdd(Y[j], gid >= 0 ? ye[i] : -ye[i]);
+      }
+   });
+}
+
+// Shared memory PA Diffusion Apply 3D kernel. The PA data container type TD
+// is Vector, or Array<float> or Array<bfloat16> for reduced precision data.
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 inline void SmemPADiffusionApply3D(const int NE,
                                    const bool symmetric,
                                    const Array<real_t> &b_,
                                    const Array<real_t> &g_,
                                    const Array<real_t> &,
                                    const Array<real_t> &,
-                                   const Vector &d_,
+                                   const TD &d_,
                                    const Vector &x_,
                                    Vector &y_,
                                    const int d1d = 0,
@@ -1221,12 +1380,309 @@ inline void SmemPADiffusionApply3D(const int NE,
    });
 }
 
+// Host-only PA Diffusion Apply 2D kernel vectorized across batches of
+// elements, see SimdElements.
+template<int T_D1D, int T_Q1D>
+inline void SimdPADiffusionApply2D(const int NE,
+                                   const bool symmetric,
+                                   const Array<real_t> &b_,
+                                   const Array<real_t> &g_,
+                                   const Array<real_t> &bt_,
+                                   const Array<real_t> &gt_,
+                                   const Vector &d_,
+                                   const Vector &x_,
+                                   Vector &y_,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   MFEM_CONTRACT_VAR(bt_);
+   MFEM_CONTRACT_VAR(gt_);
+   MFEM_CONTRACT_VAR(d1d);
+   MFEM_CONTRACT_VAR(q1d);
+   using vreal_t = SimdElements::vreal_t;
+   constexpr int S = SimdElements::size;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g_.HostRead(), Q1D, D1D);
+   const int NC = symmetric ? 3 : 4;
+   const auto D = Reshape(d_.HostRead(), Q1D*Q1D, NC, NE);
+   const auto X = Reshape(x_.HostRead(), D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, NE);
+   SimdBatchForall(SimdElements::NumBatches(NE), [&](int eb)
+   {
+      int el[S];
+      for (int l = 0; l < S; ++l) { el[l] = SimdElements::Element(eb,l,NE); }
+      vreal_t BX[D1D][Q1D], GX[D1D][Q1D], grad[Q1D][Q1D][2];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         vreal_t u[D1D];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            for (int l = 0; l < S; ++l)
+            {
+               u[dx][l] = X(dx,dy,el[l]);
+            }
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            BX[dy][qx] = 0.0;
+            GX[dy][qx] = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               BX[dy][qx].fma(u[dx], B(qx,dx));
+               GX[dy][qx].fma(u[dx], G(qx,dx));
+            }
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            vreal_t gX, gY;
+            gX = 0.0;
+            gY = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               gX.fma(GX[dy][qx], B(qy,dy));
+               gY.fma(BX[dy][qx], G(qy,dy));
+            }
+            const int q = qx + qy * Q1D;
+            // Symmetric: D = [O11 O21 O22], otherwise D = [O11 O21 O12 O22].
+            vreal_t O[4];
+            for (int k = 0; k < NC; ++k)
+            {
+               for (int l = 0; l < S; ++l) { O[k][l] = D(q,k,el[l]); }
+            }
+            if (symmetric)
+            {
+               grad[qy][qx][0] = O[0]*gX + O[1]*gY;
+               grad[qy][qx][1] = O[1]*gX + O[2]*gY;
+            }
+            else
+            {
+               grad[qy][qx][0] = O[0]*gX + O[2]*gY;
+               grad[qy][qx][1] = O[1]*gX + O[3]*gY;
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            BX[dy][qx] = 0.0;
+            GX[dy][qx] = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               GX[dy][qx].fma(grad[qy][qx][0], B(qy,dy));
+               BX[dy][qx].fma(grad[qy][qx][1], G(qy,dy));
+            }
+         }
+      }
+      const int nl = SimdElements::NumLanes(eb, NE);
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            vreal_t u;
+            u = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               u.fma(GX[dy][qx], G(qx,dx));
+               u.fma(BX[dy][qx], B(qx,dx));
+            }
+            for (int l = 0; l < nl; ++l) { Y(dx,dy,eb*S+l) += u[l]; }
+         }
+      }
+   });
+}
+
+// Host-only PA Diffusion Apply 3D kernel vectorized across batches of
+// elements, see SimdElements.
+template<int T_D1D, int T_Q1D>
+inline void SimdPADiffusionApply3D(const int NE,
+                                   const bool symmetric,
+                                   const Array<real_t> &b_,
+                                   const Array<real_t> &g_,
+                                   const Array<real_t> &bt_,
+                                   const Array<real_t> &gt_,
+                                   const Vector &d_,
+                                   const Vector &x_,
+                                   Vector &y_,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   MFEM_CONTRACT_VAR(bt_);
+   MFEM_CONTRACT_VAR(gt_);
+   MFEM_CONTRACT_VAR(d1d);
+   MFEM_CONTRACT_VAR(q1d);
+   using vreal_t = SimdElements::vreal_t;
+   constexpr int S = SimdElements::size;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const auto G = Reshape(g_.HostRead(), Q1D, D1D);
+   const int NC = symmetric ? 6 : 9;
+   const auto D = Reshape(d_.HostRead(), Q1D*Q1D*Q1D, NC, NE);
+   const auto X = Reshape(x_.HostRead(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, D1D, NE);
+   SimdBatchForall(SimdElements::NumBatches(NE), [&](int eb)
+   {
+      int el[S];
+      for (int l = 0; l < S; ++l) { el[l] = SimdElements::Element(eb,l,NE); }
+      // Interpolated values (B) and derivatives (G) after contracting the x,
+      // then the y, dimensions.
+      vreal_t BX[D1D][D1D][Q1D], GX[D1D][D1D][Q1D];
+      vreal_t BBX[D1D][Q1D][Q1D], BGX[D1D][Q1D][Q1D], GBX[D1D][Q1D][Q1D];
+      vreal_t grad[Q1D][Q1D][Q1D][3];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            vreal_t u[D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int l = 0; l < S; ++l)
+               {
+                  u[dx][l] = X(dx,dy,dz,el[l]);
+               }
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BX[dz][dy][qx] = 0.0;
+               GX[dz][dy][qx] = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  BX[dz][dy][qx].fma(u[dx], B(qx,dx));
+                  GX[dz][dy][qx].fma(u[dx], G(qx,dx));
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BBX[dz][qy][qx] = 0.0;
+               BGX[dz][qy][qx] = 0.0;
+               GBX[dz][qy][qx] = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  BBX[dz][qy][qx].fma(BX[dz][dy][qx], B(qy,dy));
+                  BGX[dz][qy][qx].fma(GX[dz][dy][qx], B(qy,dy));
+                  GBX[dz][qy][qx].fma(BX[dz][dy][qx], G(qy,dy));
+               }
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t gX, gY, gZ;
+               gX = 0.0;
+               gY = 0.0;
+               gZ = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  gX.fma(BGX[dz][qy][qx], B(qz,dz));
+                  gY.fma(GBX[dz][qy][qx], B(qz,dz));
+                  gZ.fma(BBX[dz][qy][qx], G(qz,dz));
+               }
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               // Symmetric: D = [O11 O12 O13 O22 O23 O33], otherwise the 9
+               // entries of the matrix in row-major order.
+               vreal_t O[9];
+               for (int k = 0; k < NC; ++k)
+               {
+                  for (int l = 0; l < S; ++l) { O[k][l] = D(q,k,el[l]); }
+               }
+               if (symmetric)
+               {
+                  grad[qz][qy][qx][0] = O[0]*gX + O[1]*gY + O[2]*gZ;
+                  grad[qz][qy][qx][1] = O[1]*gX + O[3]*gY + O[4]*gZ;
+                  grad[qz][qy][qx][2] = O[2]*gX + O[4]*gY + O[5]*gZ;
+               }
+               else
+               {
+                  grad[qz][qy][qx][0] = O[0]*gX + O[1]*gY + O[2]*gZ;
+                  grad[qz][qy][qx][1] = O[3]*gX + O[4]*gY + O[5]*gZ;
+                  grad[qz][qy][qx][2] = O[6]*gX + O[7]*gY + O[8]*gZ;
+               }
+            }
+         }
+      }
+      // Apply the transposed operators, contracting the z, then the y, and
+      // finally the x dimensions.
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BGX[dz][qy][qx] = 0.0;
+               GBX[dz][qy][qx] = 0.0;
+               BBX[dz][qy][qx] = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  BGX[dz][qy][qx].fma(grad[qz][qy][qx][0], B(qz,dz));
+                  GBX[dz][qy][qx].fma(grad[qz][qy][qx][1], B(qz,dz));
+                  BBX[dz][qy][qx].fma(grad[qz][qy][qx][2], G(qz,dz));
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               GX[dz][dy][qx] = 0.0;
+               BX[dz][dy][qx] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  GX[dz][dy][qx].fma(BGX[dz][qy][qx], B(qy,dy));
+                  BX[dz][dy][qx].fma(GBX[dz][qy][qx], G(qy,dy));
+                  BX[dz][dy][qx].fma(BBX[dz][qy][qx], B(qy,dy));
+               }
+            }
+         }
+      }
+      const int nl = SimdElements::NumLanes(eb, NE);
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t u;
+               u = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u.fma(GX[dz][dy][qx], G(qx,dx));
+                  u.fma(BX[dz][dy][qx], B(qx,dx));
+               }
+               for (int l = 0; l < nl; ++l) { Y(dx,dy,dz,eb*S+l) += u[l]; }
+            }
+         }
+      }
+   });
+}
+
 } // namespace internal
 
 namespace
 {
 using ApplyKernelType = DiffusionIntegrator::ApplyKernelType;
 using DiagonalKernelType = DiffusionIntegrator::DiagonalKernelType;
+using FusedApplyKernelType = DiffusionIntegrator::FusedApplyKernelType;
+using SingleApplyKernelType = DiffusionIntegrator::SingleApplyKernelType;
+using BF16ApplyKernelType = DiffusionIntegrator::BF16ApplyKernelType;
 }
 
 template<int DIM, int T_D1D, int T_Q1D>
@@ -1245,6 +1701,73 @@ ApplyKernelType DiffusionIntegrator::ApplyPAKernels::Fallback(int DIM, int, int)
    else { MFEM_ABORT(""); }
 }
 
+template<int DIM, int T_D1D, int T_Q1D>
+SingleApplyKernelType DiffusionIntegrator::SingleApplyPAKernels::Kernel()
+{
+   using TD = Array<float>;
+   if (DIM == 2) { return internal::SmemPADiffusionApply2D<T_D1D,T_Q1D,TD>; }
+   else if (DIM == 3) { return internal::SmemPADiffusionApply3D<T_D1D,T_Q1D,TD>; }
+   else { MFEM_ABORT(""); }
+}
+
+inline SingleApplyKernelType
+DiffusionIntegrator::SingleApplyPAKernels::Fallback(int DIM, int, int)
+{
+   using TD = Array<float>;
+   if (DIM == 2) { return internal::SmemPADiffusionApply2D<0,0,TD>; }
+   else if (DIM == 3) { return internal::SmemPADiffusionApply3D<0,0,TD>; }
+   else { MFEM_ABORT(""); }
+}
+
+template<int DIM, int T_D1D, int T_Q1D>
+BF16ApplyKernelType DiffusionIntegrator::BF16ApplyPAKernels::Kernel()
+{
+   using TD = Array<bfloat16>;
+   if (DIM == 2) { return internal::SmemPADiffusionApply2D<T_D1D,T_Q1D,TD>; }
+   else if (DIM == 3) { return internal::SmemPADiffusionApply3D<T_D1D,T_Q1D,TD>; }
+   else { MFEM_ABORT(""); }
+}
+
+inline BF16ApplyKernelType
+DiffusionIntegrator::BF16ApplyPAKernels::Fallback(int DIM, int, int)
+{
+   using TD = Array<bfloat16>;
+   if (DIM == 2) { return internal::SmemPADiffusionApply2D<0,0,TD>; }
+   else if (DIM == 3) { return internal::SmemPADiffusionApply3D<0,0,TD>; }
+   else { MFEM_ABORT(""); }
+}
+
+template<int DIM, int T_D1D, int T_Q1D>
+ApplyKernelType DiffusionIntegrator::SimdApplyPAKernels::Kernel()
+{
+   if (DIM == 2) { return internal::SimdPADiffusionApply2D<T_D1D,T_Q1D>; }
+   else if (DIM == 3) { return internal::SimdPADiffusionApply3D<T_D1D,T_Q1D>; }
+   else { MFEM_ABORT(""); }
+}
+
+inline
+ApplyKernelType DiffusionIntegrator::SimdApplyPAKernels::Fallback(int DIM, int,
+                                                                  int)
+{
+   return ApplyPAKernels::Fallback(DIM, 0, 0);
+}
+
+template<int DIM, int T_D1D, int T_Q1D>
+FusedApplyKernelType DiffusionIntegrator::FusedApplyPAKernels::Kernel()
+{
+   if (DIM == 2) { return internal::PADiffusionApplyFused2D<T_D1D,T_Q1D>; }
+   else if (DIM == 3) { return internal::PADiffusionApplyFused3D<T_D1D,T_Q1D>; }
+   else { MFEM_ABORT(""); }
+}
+
+inline FusedApplyKernelType
+DiffusionIntegrator::FusedApplyPAKernels::Fallback(int DIM, int, int)
+{
+   if (DIM == 2) { return internal::PADiffusionApplyFused2D; }
+   else if (DIM == 3) { return internal::PADiffusionApplyFused3D; }
+   else { MFEM_ABORT(""); }
+}
+
 template<int DIM, int D1D, int Q1D>
 DiagonalKernelType DiffusionIntegrator::DiagonalPAKernels::Kernel()
 {
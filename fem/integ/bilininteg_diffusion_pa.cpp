@@ -12,6 +12,7 @@
 #include "../bilininteg.hpp"
 #include "../gridfunc.hpp"
 #include "../qfunction.hpp"
+#include "../pacache.hpp"
 #include "../../mesh/nurbs.hpp"
 #include "../ceed/integrators/diffusion/diffusion.hpp"
 #include "bilininteg_diffusion_kernels.hpp"
@@ -27,10 +28,15 @@ void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
    }
    else
    {
-      if (pa_data.Size() == 0) { AssemblePA(*fespace); }
+      if (pa_data.Size() == 0 && pa_data_single.Size() == 0 &&
+          pa_data_bf16.Size() == 0)
+      {
+         AssemblePA(*fespace);
+      }
       const Array<real_t> &B = maps->B;
       const Array<real_t> &G = maps->G;
-      const Vector &Dv = pa_data;
+      Vector tmp;
+      const Vector &Dv = GetFullPrecisionPAData(tmp);
       DiagonalPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, B, G, Dv,
                              diag, dofs1D, quad1D);
    }
@@ -50,6 +56,11 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
       const Array<real_t> &Bt = maps->Bt;
       const Array<real_t> &Gt = maps->Gt;
       const Vector &Dv = pa_data;
+      const bool reduced =
+         pa_precision != PADataPrecision::FULL && !pa_full_precision;
+      MFEM_VERIFY(reduced || Dv.Size() > 0 || pa_data_single.Size() +
+                  pa_data_bf16.Size() == 0, "the full precision PA data was "
+                  "not kept, see SetPADataPrecision()");
 
 #ifdef MFEM_USE_OCCA
       if (DeviceCanUseOcca())
@@ -68,11 +79,91 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
       }
 #endif // MFEM_USE_OCCA
 
+      if (reduced && pa_precision == PADataPrecision::SINGLE)
+      {
+         SingleApplyPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, B, G, Bt,
+                                   Gt, pa_data_single, x, y, dofs1D, quad1D);
+         return;
+      }
+      if (reduced && pa_precision == PADataPrecision::BFLOAT16)
+      {
+         BF16ApplyPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, B, G, Bt,
+                                 Gt, pa_data_bf16, x, y, dofs1D, quad1D);
+         return;
+      }
+      if (internal::SimdPAKernelsEnabled())
+      {
+         SimdApplyPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, B, G, Bt,
+                                 Gt, Dv, x, y, dofs1D, quad1D);
+         return;
+      }
       ApplyPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, B, G, Bt,
                           Gt, Dv, x, y, dofs1D, quad1D);
    }
 }
 
+void DiffusionIntegrator::ArrayAddMultPA(const Array<const Vector *> &X,
+                                         Array<Vector *> &Y) const
+{
+   const bool full = pa_precision == PADataPrecision::FULL || pa_full_precision;
+   if (X.Size() < 2 || ne == 0 || !full || DeviceCanUseCeed() ||
+       Device::Allows(Backend::DEVICE_MASK | Backend::OCCA_MASK))
+   {
+      BilinearFormIntegrator::ArrayAddMultPA(X, Y);
+      return;
+   }
+   MFEM_ASSERT(X.Size() == Y.Size(), "Number of columns mismatch!");
+   const Array<real_t> &B = maps->B;
+   const Array<real_t> &G = maps->G;
+   const Array<real_t> &Bt = maps->Bt;
+   const Array<real_t> &Gt = maps->Gt;
+   const bool simd = internal::SimdPAKernelsEnabled();
+   const int nd = X[0]->Size()/ne;    // E-vector entries per element
+   const int nq = pa_data.Size()/ne;  // quadrature data per element
+   const int chunk = ArrayPAChunkSize(nq*sizeof(real_t));
+   Vector D, x, y;
+   for (int e0 = 0; e0 < ne; e0 += chunk)
+   {
+      const int ne_c = std::min(chunk, ne - e0);
+      D.MakeRef(const_cast<Vector&>(pa_data), e0*nq, ne_c*nq);
+      for (int k = 0; k < X.Size(); k++)
+      {
+         x.MakeRef(const_cast<Vector&>(*X[k]), e0*nd, ne_c*nd);
+         y.MakeRef(*Y[k], e0*nd, ne_c*nd);
+         if (simd)
+         {
+            SimdApplyPAKernels::Run(dim, dofs1D, quad1D, ne_c, symmetric, B, G,
+                                    Bt, Gt, D, x, y, dofs1D, quad1D);
+         }
+         else
+         {
+            ApplyPAKernels::Run(dim, dofs1D, quad1D, ne_c, symmetric, B, G, Bt,
+                                Gt, D, x, y, dofs1D, quad1D);
+         }
+      }
+   }
+}
+
+bool DiffusionIntegrator::SupportsFusedPA() const
+{
+   // The fused kernels only use the full precision PA data
+   const bool full = pa_precision == PADataPrecision::FULL || pa_full_precision;
+   return !DeviceCanUseCeed() && pa_data.Size() > 0 && (dim == 2 || dim == 3) &&
+          full;
+}
+
+void DiffusionIntegrator::AddMultFusedPA(const Array<int> &gather_map,
+                                         const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(SupportsFusedPA(), "fused PA action is not supported");
+   const Array<real_t> &B = maps->B;
+   const Array<real_t> &G = maps->G;
+   const Array<real_t> &Bt = maps->Bt;
+   const Array<real_t> &Gt = maps->Gt;
+   FusedApplyPAKernels::Run(dim, dofs1D, quad1D, ne, symmetric, B, G, Bt, Gt,
+                            pa_data, gather_map, x, y, dofs1D, quad1D);
+}
+
 void DiffusionIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
 {
    if (symmetric)
@@ -119,7 +210,6 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    const int nq = ir->GetNPoints();
    dim = mesh->Dimension();
    ne = fes.GetNE();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS, mt);
    const int sdim = mesh->SpaceDimension();
    maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
    dofs1D = maps->ndof;
@@ -138,8 +228,90 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    const int pa_size = symmetric ? symmDims : dims*dims;
 
    pa_data.SetSize(pa_size * nq * ne, mt);
+
+   // The key includes the coefficient values, so that integrators with
+   // different coefficients do not share entries.
+   std::string cache_key;
+   if (pa_cache)
+   {
+      cache_key = "diffusion_" + pa_cache_tag + "_" +
+                  PADataCache::Fingerprint(*mesh, *ir) + "_" +
+                  std::to_string(coeff_dim) + "_" +
+                  PADataCache::Fingerprint(coeff);
+      if (pa_cache->Load(cache_key, pa_data, mt))
+      {
+         SetupReducedPrecisionPAData();
+         return;
+      }
+   }
+
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS, mt);
    internal::PADiffusionSetup(dim, sdim, dofs1D, quad1D, coeff_dim, ne,
                               ir->GetWeights(), geom->J, coeff, pa_data);
+   if (pa_cache) { pa_cache->Save(cache_key, pa_data); }
+   SetupReducedPrecisionPAData();
+}
+
+void DiffusionIntegrator::SetupReducedPrecisionPAData()
+{
+   const int n = pa_data.Size();
+   const MemoryType mt = pa_data.GetMemory().GetMemoryType();
+   const bool use_dev = pa_data.UseDevice();
+   const auto D = pa_data.Read(use_dev);
+   pa_data_single.DeleteAll();
+   pa_data_bf16.DeleteAll();
+   if (pa_precision == PADataPrecision::SINGLE)
+   {
+      pa_data_single.SetSize(n, mt);
+      auto S = pa_data_single.Write(use_dev);
+      mfem::forall_switch(use_dev, n, [=] MFEM_HOST_DEVICE (int i)
+      {
+         S[i] = static_cast<float>(D[i]);
+      });
+   }
+   else if (pa_precision == PADataPrecision::BFLOAT16)
+   {
+      pa_data_bf16.SetSize(n, mt);
+      auto S = pa_data_bf16.Write(use_dev);
+      mfem::forall_switch(use_dev, n, [=] MFEM_HOST_DEVICE (int i)
+      {
+         S[i] = bfloat16(D[i]);
+      });
+   }
+   if (pa_precision != PADataPrecision::FULL && !pa_keep_full_precision)
+   {
+      pa_data.Destroy();
+   }
+}
+
+const Vector &DiffusionIntegrator::GetFullPrecisionPAData(Vector &tmp) const
+{
+   if (pa_data.Size() > 0) { return pa_data; }
+   const bool single = pa_data_single.Size() > 0;
+   const int n = single ? pa_data_single.Size() : pa_data_bf16.Size();
+   const bool use_dev = single ? pa_data_single.UseDevice() :
+                        pa_data_bf16.UseDevice();
+   tmp.SetSize(n, single ? pa_data_single.GetMemory().GetMemoryType() :
+               pa_data_bf16.GetMemory().GetMemoryType());
+   tmp.UseDevice(use_dev);
+   auto T = tmp.Write(use_dev);
+   if (single)
+   {
+      const auto S = pa_data_single.Read(use_dev);
+      mfem::forall_switch(use_dev, n, [=] MFEM_HOST_DEVICE (int i)
+      {
+         T[i] = S[i];
+      });
+   }
+   else
+   {
+      const auto S = pa_data_bf16.Read(use_dev);
+      mfem::forall_switch(use_dev, n, [=] MFEM_HOST_DEVICE (int i)
+      {
+         T[i] = S[i];
+      });
+   }
+   return tmp;
 }
 
 void DiffusionIntegrator::AssembleNURBSPA(const FiniteElementSpace &fes)
@@ -37,6 +37,12 @@ MassIntegrator::Kernels::Kernels()
    MassIntegrator::AddSpecialization<3,6,7>();
    MassIntegrator::AddSpecialization<3,7,8>();
    MassIntegrator::AddSpecialization<3,8,9>();
+   // Runtime compilation of other specializations, see KernelJIT
+   constexpr const char *header = "fem/integ/bilininteg_mass_kernels.hpp";
+   ApplyPAKernels::SetJitSource("MassIntegrator::ApplyPAKernels", header);
+   DiagonalPAKernels::SetJitSource("MassIntegrator::DiagonalPAKernels", header);
+   SimdApplyPAKernels::SetJitSource("MassIntegrator::SimdApplyPAKernels",
+                                    header);
 }
 
 namespace internal
@@ -18,6 +18,7 @@
 #include "../../linalg/dtensor.hpp"
 #include "../../linalg/vector.hpp"
 #include "../bilininteg.hpp"
+#include "bilininteg_simd_kernels.hpp"
 
 namespace mfem
 {
@@ -1132,16 +1133,230 @@ inline void SmemPAMassApply3D(const int NE,
    });
 }
 
-} // namespace internal
+// Host-only PA Mass Apply 2D kernel vectorized across batches of elements,
+// see SimdElements.
+template<int T_D1D, int T_Q1D>
+inline void SimdPAMassApply2D(const int NE,
+                              const Array<real_t> &b_,
+                              const Array<real_t> &bt_,
+                              const Vector &d_,
+                              const Vector &x_,
+                              Vector &y_,
+                              const int d1d = 0,
+                              const int q1d = 0)
+{
+   MFEM_CONTRACT_VAR(bt_);
+   MFEM_CONTRACT_VAR(d1d);
+   MFEM_CONTRACT_VAR(q1d);
+   using vreal_t = SimdElements::vreal_t;
+   constexpr int S = SimdElements::size;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const auto D = Reshape(d_.HostRead(), Q1D, Q1D, NE);
+   const auto X = Reshape(x_.HostRead(), D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, NE);
+   SimdBatchForall(SimdElements::NumBatches(NE), [&](int eb)
+   {
+      int el[S];
+      for (int l = 0; l < S; ++l) { el[l] = SimdElements::Element(eb,l,NE); }
+      vreal_t DQ[D1D][Q1D], QQ[Q1D][Q1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         vreal_t u[D1D];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            for (int l = 0; l < S; ++l)
+            {
+               u[dx][l] = X(dx,dy,el[l]);
+            }
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            DQ[dy][qx] = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               DQ[dy][qx].fma(u[dx], B(qx,dx));
+            }
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            vreal_t u;
+            u = 0.0;
+            for (int dy = 0; dy < D1D; ++dy) { u.fma(DQ[dy][qx], B(qy,dy)); }
+            vreal_t w;
+            for (int l = 0; l < S; ++l)
+            {
+               w[l] = D(qx,qy,el[l]);
+            }
+            QQ[qy][qx] = u*w;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            DQ[dx][qy] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               DQ[dx][qy].fma(QQ[qy][qx], B(qx,dx));
+            }
+         }
+      }
+      const int nl = SimdElements::NumLanes(eb, NE);
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            vreal_t u;
+            u = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy) { u.fma(DQ[dx][qy], B(qy,dy)); }
+            for (int l = 0; l < nl; ++l) { Y(dx,dy,eb*S+l) += u[l]; }
+         }
+      }
+   });
+}
 
-namespace
+// Host-only PA Mass Apply 3D kernel vectorized across batches of elements,
+// see SimdElements.
+template<int T_D1D, int T_Q1D>
+inline void SimdPAMassApply3D(const int NE,
+                              const Array<real_t> &b_,
+                              const Array<real_t> &bt_,
+                              const Vector &d_,
+                              const Vector &x_,
+                              Vector &y_,
+                              const int d1d = 0,
+                              const int q1d = 0)
 {
-using ApplyKernelType = MassIntegrator::ApplyKernelType;
-using DiagonalKernelType = MassIntegrator::DiagonalKernelType;
+   MFEM_CONTRACT_VAR(bt_);
+   MFEM_CONTRACT_VAR(d1d);
+   MFEM_CONTRACT_VAR(q1d);
+   using vreal_t = SimdElements::vreal_t;
+   constexpr int S = SimdElements::size;
+   constexpr int D1D = T_D1D;
+   constexpr int Q1D = T_Q1D;
+   const auto B = Reshape(b_.HostRead(), Q1D, D1D);
+   const auto D = Reshape(d_.HostRead(), Q1D, Q1D, Q1D, NE);
+   const auto X = Reshape(x_.HostRead(), D1D, D1D, D1D, NE);
+   auto Y = Reshape(y_.HostReadWrite(), D1D, D1D, D1D, NE);
+   SimdBatchForall(SimdElements::NumBatches(NE), [&](int eb)
+   {
+      int el[S];
+      for (int l = 0; l < S; ++l) { el[l] = SimdElements::Element(eb,l,NE); }
+      vreal_t DDQ[D1D][D1D][Q1D], DQQ[D1D][Q1D][Q1D], QQQ[Q1D][Q1D][Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            vreal_t u[D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               for (int l = 0; l < S; ++l)
+               {
+                  u[dx][l] = X(dx,dy,dz,el[l]);
+               }
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               DDQ[dz][dy][qx] = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  DDQ[dz][dy][qx].fma(u[dx], B(qx,dx));
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               DQQ[dz][qy][qx] = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  DQQ[dz][qy][qx].fma(DDQ[dz][dy][qx], B(qy,dy));
+               }
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               vreal_t u;
+               u = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  u.fma(DQQ[dz][qy][qx], B(qz,dz));
+               }
+               vreal_t w;
+               for (int l = 0; l < S; ++l)
+               {
+                  w[l] = D(qx,qy,qz,el[l]);
+               }
+               QQQ[qz][qy][qx] = u*w;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               DQQ[dz][qy][qx] = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  DQQ[dz][qy][qx].fma(QQQ[qz][qy][qx], B(qz,dz));
+               }
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               DDQ[dz][dy][qx] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  DDQ[dz][dy][qx].fma(DQQ[dz][qy][qx], B(qy,dy));
+               }
+            }
+         }
+      }
+      const int nl = SimdElements::NumLanes(eb, NE);
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               vreal_t u;
+               u = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  u.fma(DDQ[dz][dy][qx], B(qx,dx));
+               }
+               for (int l = 0; l < nl; ++l) { Y(dx,dy,dz,eb*S+l) += u[l]; }
+            }
+         }
+      }
+   });
 }
 
+} // namespace internal
+
 template<int DIM, int T_D1D, int T_Q1D>
-ApplyKernelType MassIntegrator::ApplyPAKernels::Kernel()
+MassIntegrator::ApplyKernelType MassIntegrator::ApplyPAKernels::Kernel()
 {
    if (DIM == 1) { return internal::PAMassApply1D; }
    else if (DIM == 2) { return internal::SmemPAMassApply2D<T_D1D,T_Q1D>; }
@@ -1149,8 +1364,8 @@ ApplyKernelType MassIntegrator::ApplyPAKernels::Kernel()
    else { MFEM_ABORT(""); }
 }
 
-inline ApplyKernelType MassIntegrator::ApplyPAKernels::Fallback(
-   int DIM, int, int)
+inline MassIntegrator::ApplyKernelType
+MassIntegrator::ApplyPAKernels::Fallback(int DIM, int, int)
 {
    if (DIM == 1) { return internal::PAMassApply1D; }
    else if (DIM == 2) { return internal::PAMassApply2D; }
@@ -1159,7 +1374,22 @@ inline ApplyKernelType MassIntegrator::ApplyPAKernels::Fallback(
 }
 
 template<int DIM, int T_D1D, int T_Q1D>
-DiagonalKernelType MassIntegrator::DiagonalPAKernels::Kernel()
+MassIntegrator::ApplyKernelType MassIntegrator::SimdApplyPAKernels::Kernel()
+{
+   if (DIM == 1) { return internal::PAMassApply1D; }
+   else if (DIM == 2) { return internal::SimdPAMassApply2D<T_D1D,T_Q1D>; }
+   else if (DIM == 3) { return internal::SimdPAMassApply3D<T_D1D,T_Q1D>; }
+   else { MFEM_ABORT(""); }
+}
+
+inline MassIntegrator::ApplyKernelType
+MassIntegrator::SimdApplyPAKernels::Fallback(int DIM, int, int)
+{
+   return ApplyPAKernels::Fallback(DIM, 0, 0);
+}
+
+template<int DIM, int T_D1D, int T_Q1D>
+MassIntegrator::DiagonalKernelType MassIntegrator::DiagonalPAKernels::Kernel()
 {
    if (DIM == 1) { return internal::PAMassAssembleDiagonal1D; }
    else if (DIM == 2) { return internal::SmemPAMassAssembleDiagonal2D<T_D1D,T_Q1D>; }
@@ -1167,8 +1397,8 @@ DiagonalKernelType MassIntegrator::DiagonalPAKernels::Kernel()
    else { MFEM_ABORT(""); }
 }
 
-inline DiagonalKernelType MassIntegrator::DiagonalPAKernels::Fallback(
-   int DIM, int, int)
+inline MassIntegrator::DiagonalKernelType
+MassIntegrator::DiagonalPAKernels::Fallback(int DIM, int, int)
 {
    if (DIM == 1) { return internal::PAMassAssembleDiagonal1D; }
    else if (DIM == 2) { return internal::PAMassAssembleDiagonal2D; }
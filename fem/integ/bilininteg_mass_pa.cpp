@@ -13,6 +13,7 @@
 #include "../bilininteg.hpp"
 #include "../gridfunc.hpp"
 #include "../qfunction.hpp"
+#include "../pacache.hpp"
 #include "../ceed/integrators/mass/mass.hpp"
 #include "bilininteg_mass_kernels.hpp"
 
@@ -52,14 +53,26 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    dim = mesh->Dimension();
    ne = fes.GetMesh()->GetNE();
    nq = ir->GetNPoints();
-   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::DETERMINANTS, mt);
    maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
-   pa_data.SetSize(ne*nq, mt);
 
    QuadratureSpace qs(*mesh, *ir);
    CoefficientVector coeff(Q, qs, CoefficientStorage::COMPRESSED);
+   pa_data.SetSize(ne*nq, mt);
+
+   // The key includes the coefficient values, so that integrators with
+   // different coefficients do not share entries.
+   std::string cache_key;
+   if (pa_cache)
+   {
+      cache_key = "mass_" + pa_cache_tag + "_" + std::to_string(map_type) +
+                  "_" + PADataCache::Fingerprint(*mesh, *ir) + "_" +
+                  PADataCache::Fingerprint(coeff);
+      if (pa_cache->Load(cache_key, pa_data, mt)) { return; }
+   }
+
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::DETERMINANTS, mt);
 
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
    if (dim==2)
@@ -113,6 +126,7 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
          }
       });
    }
+   if (pa_cache) { pa_cache->Save(cache_key, pa_data); }
 }
 
 void MassIntegrator::AssemblePABoundary(const FiniteElementSpace &fes)
@@ -229,10 +243,55 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
          MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
       }
 #endif // MFEM_USE_OCCA
+      if (internal::SimdPAKernelsEnabled())
+      {
+         return SimdApplyPAKernels::Run(dim, D1D, Q1D, ne, B, Bt, D, x, y,
+                                        D1D, Q1D);
+      }
       ApplyPAKernels::Run(dim, D1D, Q1D, ne, B, Bt, D, x, y, D1D, Q1D);
    }
 }
 
+void MassIntegrator::ArrayAddMultPA(const Array<const Vector *> &X,
+                                    Array<Vector *> &Y) const
+{
+   if (X.Size() < 2 || ne == 0 || DeviceCanUseCeed() ||
+       Device::Allows(Backend::DEVICE_MASK | Backend::OCCA_MASK))
+   {
+      BilinearFormIntegrator::ArrayAddMultPA(X, Y);
+      return;
+   }
+   MFEM_ASSERT(X.Size() == Y.Size(), "Number of columns mismatch!");
+   const int D1D = dofs1D;
+   const int Q1D = quad1D;
+   const Array<real_t> &B = maps->B;
+   const Array<real_t> &Bt = maps->Bt;
+   const bool simd = internal::SimdPAKernelsEnabled();
+   const int nd = X[0]->Size()/ne;    // E-vector entries per element
+   const int nq = pa_data.Size()/ne;  // quadrature data per element
+   const int chunk = ArrayPAChunkSize(nq*sizeof(real_t));
+   Vector D, x, y;
+   for (int e0 = 0; e0 < ne; e0 += chunk)
+   {
+      const int ne_c = std::min(chunk, ne - e0);
+      D.MakeRef(const_cast<Vector&>(pa_data), e0*nq, ne_c*nq);
+      for (int k = 0; k < X.Size(); k++)
+      {
+         x.MakeRef(const_cast<Vector&>(*X[k]), e0*nd, ne_c*nd);
+         y.MakeRef(*Y[k], e0*nd, ne_c*nd);
+         if (simd)
+         {
+            SimdApplyPAKernels::Run(dim, D1D, Q1D, ne_c, B, Bt, D, x, y, D1D,
+                                    Q1D);
+         }
+         else
+         {
+            ApplyPAKernels::Run(dim, D1D, Q1D, ne_c, B, Bt, D, x, y, D1D, Q1D);
+         }
+      }
+   }
+}
+
 void MassIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
 {
    // Mass integrator is symmetric
@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BILININTEG_SIMD_KERNELS_HPP
+#define MFEM_BILININTEG_SIMD_KERNELS_HPP
+
+#include "../../config/config.hpp"
+#include "../../general/device.hpp"
+#include "../../linalg/simd.hpp"
+
+namespace mfem
+{
+
+namespace internal
+{
+
+// Helpers for the host-only PA kernels that vectorize across elements: each
+// SIMD lane of SimdElements::vreal_t holds the data of a different element, so
+// the sum-factorization loops of a batch of SimdElements::size elements are
+// performed with SIMD arithmetic.
+struct SimdElements
+{
+   static constexpr int size = MFEM_SIMD_BYTES/sizeof(real_t) > 1 ?
+                               MFEM_SIMD_BYTES/sizeof(real_t) : 1;
+   using vreal_t = AutoSIMD<real_t, size, size*sizeof(real_t)>;
+
+   /// Number of batches needed to cover @a NE elements.
+   static int NumBatches(const int NE) { return (NE + size - 1) / size; }
+
+   /** @brief Index of the element in lane @a l of batch @a eb. Lanes past the
+       last element are clamped to it, so that loads stay in bounds; results
+       for these lanes must not be stored. */
+   static int Element(const int eb, const int l, const int NE)
+   {
+      const int e = eb*size + l;
+      return e < NE ? e : NE - 1;
+   }
+
+   /// Number of valid lanes in batch @a eb.
+   static int NumLanes(const int eb, const int NE)
+   {
+      const int n = NE - eb*size;
+      return n < size ? n : size;
+   }
+};
+
+/** @brief Returns true if the element-batched SIMD kernels should be used with
+    the current configuration, i.e. when MFEM is built with MFEM_USE_SIMD and
+    kernels run on the host with the native CPU or OpenMP backends. */
+inline bool SimdPAKernelsEnabled()
+{
+#ifdef MFEM_USE_SIMD
+   return !Device::Allows(Backend::DEVICE_MASK | Backend::RAJA_MASK |
+                          Backend::OCCA_MASK | Backend::CEED_MASK);
+#else
+   return false;
+#endif
+}
+
+/// Host loop over @a NB element batches, threaded with the OpenMP backend.
+template <typename BODY>
+inline void SimdBatchForall(const int NB, BODY &&body)
+{
+#ifdef MFEM_USE_OPENMP
+   if (Device::Allows(Backend::OMP_MASK))
+   {
+      #pragma omp parallel for
+      for (int eb = 0; eb < NB; eb++) { body(eb); }
+      return;
+   }
+#endif
+   for (int eb = 0; eb < NB; eb++) { body(eb); }
+}
+
+} // namespace internal
+
+} // namespace mfem
+
+#endif
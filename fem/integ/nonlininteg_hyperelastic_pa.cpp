@@ -0,0 +1,240 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../../general/forall.hpp"
+#include "../nonlininteg.hpp"
+#include "../qfunction.hpp"
+
+namespace mfem
+{
+
+// The methods below run on the host: the HyperelasticModel interface evaluates
+// P and its derivative on DenseMatrix objects, at one quadrature point at a
+// time. The E-vectors have the layout (dof x dim x ne), so the data of each
+// element is viewed as a (dof x dim) DenseMatrix, as in the legacy methods.
+
+HyperelasticNLFIntegrator::~HyperelasticNLFIntegrator()
+{
+   delete pa_state;
+   delete pa_qspace;
+}
+
+void HyperelasticNLFIntegrator::PAShapeGradients(int q, int e,
+                                                 DenseMatrix &DS) const
+{
+   const DenseMatrix DSh_q(const_cast<real_t*>(pa_dshape.HostRead()) +
+                           q*dof*dim, dof, dim);
+   const DenseMatrix Jrt_qe(const_cast<real_t*>(pa_Jrt.HostRead()) +
+                            (q + nq*e)*dim*dim, dim, dim);
+   DS.SetSize(dof, dim);
+   Mult(DSh_q, Jrt_qe, DS);
+}
+
+void HyperelasticNLFIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   mesh = fes.GetMesh();
+   ne = fes.GetNE();
+   delete pa_state;
+   pa_state = nullptr;
+   delete pa_qspace;
+   pa_qspace = nullptr;
+   if (ne == 0) { return; }
+
+   const FiniteElement &el = *fes.GetFE(0);
+   dim = el.GetDim();
+   dof = el.GetDof();
+   MFEM_VERIFY(fes.GetVDim() == dim && mesh->SpaceDimension() == dim,
+               "PA requires vdim == dim == space dimension!");
+   const TensorBasisElement *tbe = dynamic_cast<const TensorBasisElement*>(&el);
+   MFEM_VERIFY(tbe, "PA requires tensor-product elements!");
+   const Array<int> &dof_map = tbe->GetDofMap();
+
+   pa_ir = IntRule ? IntRule :
+           &IntRules.Get(el.GetGeomType(), 2*el.GetOrder() + 3); // <---
+   nq = pa_ir->GetNPoints();
+
+   // Reference gradients, in the lexicographic ordering of the E-vectors
+   pa_dshape.SetSize(dof*dim*nq);
+   DSh.SetSize(dof, dim);
+   for (int q = 0; q < nq; q++)
+   {
+      el.CalcDShape(pa_ir->IntPoint(q), DSh);
+      for (int c = 0; c < dim; c++)
+      {
+         for (int d = 0; d < dof; d++)
+         {
+            const int nd = (dof_map.Size() == 0) ? d : dof_map[d];
+            pa_dshape(d + dof*(c + dim*q)) = DSh(nd, c);
+         }
+      }
+   }
+
+   const int flags = GeometricFactors::JACOBIANS |
+                     GeometricFactors::DETERMINANTS;
+   const GeometricFactors *geom = mesh->GetGeometricFactors(*pa_ir, flags);
+   const auto J = Reshape(geom->J.HostRead(), nq, dim, dim, ne);
+   const auto detJ = Reshape(geom->detJ.HostRead(), nq, ne);
+   pa_Jrt.SetSize(dim*dim*nq*ne);
+   pa_weights.SetSize(nq*ne);
+   Jpr.SetSize(dim);
+   for (int e = 0; e < ne; e++)
+   {
+      for (int q = 0; q < nq; q++)
+      {
+         for (int j = 0; j < dim; j++)
+         {
+            for (int i = 0; i < dim; i++) { Jpr(i,j) = J(q,i,j,e); }
+         }
+         Jrt.UseExternalData(pa_Jrt.GetData() + (q + nq*e)*dim*dim, dim, dim);
+         CalcInverse(Jpr, Jrt);
+         pa_weights(q + nq*e) = pa_ir->IntPoint(q).weight * detJ(q,e);
+      }
+   }
+   Jrt.ClearExternalData();
+}
+
+real_t HyperelasticNLFIntegrator::GetLocalStateEnergyPA(const Vector &x) const
+{
+   const real_t *X = x.HostRead();
+   const real_t *W = pa_weights.HostRead();
+   DenseMatrix DS_q, Jpt_q(dim);
+   real_t energy = 0.0;
+   for (int e = 0; e < ne; e++)
+   {
+      const DenseMatrix Xe(const_cast<real_t*>(X) + e*dof*dim, dof, dim);
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      model->SetTransformation(T);
+      for (int q = 0; q < nq; q++)
+      {
+         T.SetIntPoint(&pa_ir->IntPoint(q));
+         PAShapeGradients(q, e, DS_q);
+         MultAtB(Xe, DS_q, Jpt_q);
+         energy += W[q + nq*e] * model->EvalW(Jpt_q);
+      }
+   }
+   return energy;
+}
+
+void HyperelasticNLFIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   const real_t *X = x.HostRead();
+   real_t *Y = y.HostReadWrite();
+   const real_t *W = pa_weights.HostRead();
+   DenseMatrix DS_q, Jpt_q(dim), P_q(dim);
+   for (int e = 0; e < ne; e++)
+   {
+      const DenseMatrix Xe(const_cast<real_t*>(X) + e*dof*dim, dof, dim);
+      DenseMatrix Ye(Y + e*dof*dim, dof, dim);
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      model->SetTransformation(T);
+      for (int q = 0; q < nq; q++)
+      {
+         T.SetIntPoint(&pa_ir->IntPoint(q));
+         PAShapeGradients(q, e, DS_q);
+         MultAtB(Xe, DS_q, Jpt_q);
+         model->EvalP(Jpt_q, P_q);
+         P_q *= W[q + nq*e];
+         AddMultABt(DS_q, P_q, Ye);
+      }
+   }
+}
+
+void HyperelasticNLFIntegrator::AssembleGradPA(const Vector &x,
+                                               const FiniteElementSpace &fes)
+{
+   if (mesh != fes.GetMesh() || pa_Jrt.Size() == 0) { AssemblePA(fes); }
+   if (ne == 0) { return; }
+   if (!pa_state)
+   {
+      pa_qspace = new QuadratureSpace(*mesh, *pa_ir);
+      pa_state = new QuadratureFunction(pa_qspace, dim*dim);
+   }
+
+   // Store the deformation gradients, which define the linearization
+   const real_t *X = x.HostRead();
+   real_t *S = pa_state->HostWrite();
+   DenseMatrix DS_q;
+   for (int e = 0; e < ne; e++)
+   {
+      const DenseMatrix Xe(const_cast<real_t*>(X) + e*dof*dim, dof, dim);
+      for (int q = 0; q < nq; q++)
+      {
+         DenseMatrix Jpt_q(S + (q + nq*e)*dim*dim, dim, dim);
+         PAShapeGradients(q, e, DS_q);
+         MultAtB(Xe, DS_q, Jpt_q);
+      }
+   }
+}
+
+void HyperelasticNLFIntegrator::AddMultGradPA(const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(pa_state || ne == 0, "AssembleGradPA() has not been called!");
+   const real_t *X = x.HostRead();
+   real_t *Y = y.HostReadWrite();
+   const real_t *S = pa_state ? pa_state->HostRead() : nullptr;
+   const real_t *W = pa_weights.HostRead();
+   DenseMatrix DS_q, dJpt_q(dim), dP_q(dim);
+   for (int e = 0; e < ne; e++)
+   {
+      const DenseMatrix Xe(const_cast<real_t*>(X) + e*dof*dim, dof, dim);
+      DenseMatrix Ye(Y + e*dof*dim, dof, dim);
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      model->SetTransformation(T);
+      for (int q = 0; q < nq; q++)
+      {
+         const DenseMatrix Jpt_q(const_cast<real_t*>(S) + (q + nq*e)*dim*dim,
+                                 dim, dim);
+         T.SetIntPoint(&pa_ir->IntPoint(q));
+         PAShapeGradients(q, e, DS_q);
+         MultAtB(Xe, DS_q, dJpt_q);
+         model->EvalDP(Jpt_q, dJpt_q, dP_q);
+         dP_q *= W[q + nq*e];
+         AddMultABt(DS_q, dP_q, Ye);
+      }
+   }
+}
+
+void HyperelasticNLFIntegrator::AssembleGradDiagonalPA(Vector &diag) const
+{
+   MFEM_VERIFY(pa_state || ne == 0, "AssembleGradPA() has not been called!");
+   real_t *D = diag.HostReadWrite();
+   const real_t *S = pa_state ? pa_state->HostRead() : nullptr;
+   const real_t *W = pa_weights.HostRead();
+   DenseMatrix DS_q, dJpt_q(dim), dP_q(dim);
+   for (int e = 0; e < ne; e++)
+   {
+      DenseMatrix De(D + e*dof*dim, dof, dim);
+      ElementTransformation &T = *mesh->GetElementTransformation(e);
+      model->SetTransformation(T);
+      for (int q = 0; q < nq; q++)
+      {
+         const DenseMatrix Jpt_q(const_cast<real_t*>(S) + (q + nq*e)*dim*dim,
+                                 dim, dim);
+         T.SetIntPoint(&pa_ir->IntPoint(q));
+         PAShapeGradients(q, e, DS_q);
+         // Apply the linearization to the unit vector of each (dof, component)
+         for (int c = 0; c < dim; c++)
+         {
+            for (int d = 0; d < dof; d++)
+            {
+               dJpt_q = 0.0;
+               for (int l = 0; l < dim; l++) { dJpt_q(c,l) = DS_q(d,l); }
+               model->EvalDP(Jpt_q, dJpt_q, dP_q);
+               real_t s = 0.0;
+               for (int k = 0; k < dim; k++) { s += DS_q(d,k)*dP_q(c,k); }
+               De(d,c) += W[q + nq*e] * s;
+            }
+         }
+      }
+   }
+}
+
+} // namespace mfem
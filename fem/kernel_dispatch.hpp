@@ -14,9 +14,13 @@
 
 #include "../config/config.hpp"
 #include "kernel_reporter.hpp"
+#include "kernel_jit.hpp"
 #include <unordered_map>
 #include <tuple>
 #include <cstddef>
+#ifdef MFEM_USE_JIT
+#include <mutex>
+#endif
 
 namespace mfem
 {
@@ -40,7 +44,8 @@ namespace mfem
 // functions depending on the parameters.
 //
 // Specialized functions can be registered using the static AddSpecialization
-// member function.
+// member function. Other specializations can be compiled at runtime, see
+// KernelJIT and KernelDispatchTable::SetJitSource.
 
 #define MFEM_EXPAND(X) X // Workaround needed for MSVC compiler
 
@@ -126,26 +131,72 @@ class KernelDispatchTable<Kernels,
          internal::KernelTypeList<Params...>,
          internal::KernelTypeList<OptParams...>>
 {
-   std::unordered_map<std::tuple<Params...>,
-       Signature,
-       KernelDispatchKeyHash<Params...>> table;
+   using KeyType = std::tuple<Params...>;
+   using TableType = std::unordered_map<KeyType, Signature,
+         KernelDispatchKeyHash<Params...>>;
+
+   // The registered specializations. The table is only modified during static
+   // initialization, so Run() can read it without locking.
+   TableType table;
+
+   // Name of the dispatch table and header defining its Kernel() member
+   // function template, used for JIT compilation, see SetJitSource.
+   std::string jit_name;
+   const char *jit_header = nullptr;
+
+#ifdef MFEM_USE_JIT
+   // The JIT compiled specializations (nullptr if the compilation failed),
+   // guarded by jit_mutex since Run() may be called from several threads.
+   TableType jit_table;
+   std::mutex jit_mutex;
+#endif
+
+   // Return the kernel specialization for the given parameters compiled with
+   // KernelJIT, or nullptr if JIT compilation is not enabled or failed. Each
+   // specialization is compiled at most once.
+   Signature JitKernel(Params... params)
+   {
+#ifdef MFEM_USE_JIT
+      if (!jit_header || sizeof...(OptParams) > 0 || !KernelJIT::IsEnabled())
+      {
+         return nullptr;
+      }
+      std::lock_guard<std::mutex> lock(jit_mutex);
+      const KeyType key = std::make_tuple(params...);
+      const auto it = jit_table.find(key);
+      if (it != jit_table.end()) { return it->second; }
+      const std::string kernel = jit_name + "::Kernel<" +
+                                 KernelJIT::TemplateArgs(params...) + ">()";
+      void *ptr = KernelJIT::GetKernel(jit_header, kernel);
+      Signature k = ptr ? reinterpret_cast<Signature>(ptr) : nullptr;
+      jit_table[key] = k;
+      return k;
+#else
+      return nullptr;
+#endif
+   }
 
 public:
    /// @brief Run the kernel with the given dispatch parameters and arguments.
    ///
    /// If a compile-time specialized version of the kernel with the given
-   /// parameters has been registered, it will be called. Otherwise, the
-   /// fallback kernel will be called.
+   /// parameters has been registered, it will be called. Otherwise, if JIT
+   /// compilation is enabled, the specialization is compiled at runtime (see
+   /// KernelJIT). Otherwise, the fallback kernel will be called.
    template<typename... Args>
    static void Run(Params... params, Args&&... args)
    {
       const auto &table = Kernels::Get().table;
-      const std::tuple<Params...> key = std::make_tuple(params...);
+      const KeyType key = std::make_tuple(params...);
       const auto it = table.find(key);
       if (it != table.end())
       {
          it->second(std::forward<Args>(args)...);
       }
+      else if (Signature kernel = Kernels::Get().JitKernel(params...))
+      {
+         kernel(std::forward<Args>(args)...);
+      }
       else
       {
          KernelReporter::ReportFallback(Kernels::Get().kernel_name, params...);
@@ -153,6 +204,21 @@ public:
       }
    }
 
+   /// @brief Enable the JIT compilation of the specializations that are not
+   /// registered, see KernelJIT. Has no effect unless MFEM is configured with
+   /// MFEM_USE_JIT=YES.
+   ///
+   /// @a name is the name of the dispatch table, qualified from namespace
+   /// mfem, e.g. "MassIntegrator::ApplyPAKernels", and @a header is the path
+   /// of the MFEM header defining its Kernel() member function template,
+   /// relative to the MFEM source directory. JIT compilation is not supported
+   /// for tables with optional (non-dispatch) parameters.
+   static void SetJitSource(const char *name, const char *header)
+   {
+      Kernels::Get().jit_name = name;
+      Kernels::Get().jit_header = header;
+   }
+
    /// Register a specialized kernel for dispatch.
    template <Params... PARAMS>
    struct Specialization
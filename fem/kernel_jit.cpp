@@ -0,0 +1,471 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "kernel_jit.hpp"
+#include "../general/error.hpp"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <algorithm>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <vector>
+
+// JIT compilation is only supported on POSIX systems.
+#if defined(MFEM_USE_JIT) && !defined(_WIN32)
+#define MFEM_KERNEL_JIT
+#endif
+
+#ifdef MFEM_KERNEL_JIT
+#include <dirent.h>    // opendir, readdir
+#include <dlfcn.h>     // dlopen, dlsym
+#include <fcntl.h>     // open
+#include <spawn.h>     // posix_spawnp
+#include <sys/stat.h>  // mkdir, stat
+#include <sys/wait.h>  // waitpid
+#include <unistd.h>    // getpid, gethostname, usleep
+
+extern char **environ;
+#endif
+
+// The compiler and flags used to build MFEM, defined by the build system.
+#ifndef MFEM_JIT_DEFAULT_CXX
+#define MFEM_JIT_DEFAULT_CXX "c++"
+#endif
+#ifndef MFEM_JIT_DEFAULT_FLAGS
+#define MFEM_JIT_DEFAULT_FLAGS "-O3 -std=c++14"
+#endif
+
+namespace mfem
+{
+
+#ifdef MFEM_KERNEL_JIT
+static bool FileExists(const std::string &name)
+{
+   struct stat m_stat;
+   return stat(name.c_str(), &m_stat) == 0;
+}
+
+// Create the directory @a dir_name and its parents; returns true on success.
+static bool CreateDirectory(const std::string &dir_name)
+{
+   std::string::size_type pos = 0;
+   do
+   {
+      pos = dir_name.find('/', pos+1);
+      const std::string subdir = dir_name.substr(0, pos);
+      if (mkdir(subdir.c_str(), 0777) && errno != EEXIST) { return false; }
+   }
+   while (pos != std::string::npos);
+   return true;
+}
+
+// Split @a str at white spaces.
+static std::vector<std::string> SplitWords(const std::string &str)
+{
+   std::vector<std::string> words;
+   std::istringstream in(str);
+   std::string word;
+   while (in >> word) { words.push_back(word); }
+   return words;
+}
+
+// Run the command @a args without a shell, writing its standard output and
+// error to the file @a output; returns true if the command succeeded.
+static bool RunCommand(const std::vector<std::string> &args,
+                       const std::string &output)
+{
+   if (args.empty()) { return false; }
+   std::vector<char*> argv;
+   for (const std::string &arg : args)
+   {
+      argv.push_back(const_cast<char*>(arg.c_str()));
+   }
+   argv.push_back(nullptr);
+
+   posix_spawn_file_actions_t actions;
+   posix_spawn_file_actions_init(&actions);
+   posix_spawn_file_actions_addopen(&actions, 1, output.c_str(),
+                                    O_WRONLY | O_CREAT | O_TRUNC, 0644);
+   posix_spawn_file_actions_adddup2(&actions, 1, 2);
+   pid_t pid;
+   int status = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(),
+                             environ);
+   posix_spawn_file_actions_destroy(&actions);
+   if (status != 0) { return false; }
+   while (waitpid(pid, &status, 0) < 0)
+   {
+      if (errno != EINTR) { return false; }
+   }
+   return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Host name and process id, identifying the files of this process in a cache
+// directory shared by several processes, possibly on different hosts.
+static std::string ProcessId()
+{
+   char host[256] = "";
+   gethostname(host, sizeof(host) - 1);
+   return std::string(host) + "." + std::to_string(getpid());
+}
+
+// 64-bit FNV-1a hash. Unlike std::hash, its value does not depend on the
+// standard library implementation, so it can be used to name the cache files.
+static std::uint64_t StableHash(const std::string &str)
+{
+   std::uint64_t hash = 14695981039346656037ULL;
+   for (const char c : str)
+   {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+   }
+   return hash;
+}
+
+// Return the contents of the file @a name, or an empty string if it cannot be
+// read.
+static std::string ReadFile(const std::string &name)
+{
+   std::ifstream file(name);
+   std::ostringstream contents;
+   if (file) { contents << file.rdbuf(); }
+   return contents.str();
+}
+
+// Append to @a contents the contents of @a header and, recursively, of the
+// existing files it includes with #include "...", each file once.
+static void ReadHeaders(const std::string &file, std::set<std::string> &seen,
+                        std::string &contents)
+{
+   // Canonical path, so that each file is only visited once.
+   char *real = realpath(file.c_str(), nullptr);
+   if (!real) { return; }
+   const std::string header = real;
+   free(real);
+   if (!seen.insert(header).second) { return; }
+   const std::string text = ReadFile(header);
+   contents += header + '\n' + text;
+   const std::string::size_type slash = header.rfind('/');
+   const std::string dir =
+      (slash == std::string::npos) ? "" : header.substr(0, slash + 1);
+   std::istringstream lines(text);
+   std::string line;
+   while (std::getline(lines, line))
+   {
+      // Match: [spaces] # [spaces] include [spaces] "name"
+      const auto skip = [&line](std::string::size_type p)
+      { return std::min(line.find_first_not_of(" \t", p), line.size()); };
+      std::string::size_type pos = skip(0);
+      if (line.compare(pos, 1, "#") != 0) { continue; }
+      pos = skip(pos + 1);
+      if (line.compare(pos, 7, "include") != 0) { continue; }
+      pos = skip(pos + 7);
+      if (line.compare(pos, 1, "\"") != 0) { continue; }
+      const std::string::size_type end = line.find('"', pos + 1);
+      if (end == std::string::npos) { continue; }
+      const std::string name = line.substr(pos + 1, end - pos - 1);
+      ReadHeaders(dir + name, seen, contents);
+   }
+}
+#endif
+
+KernelJIT::KernelJIT()
+{
+   const char *env = getenv("MFEM_JIT");
+   if (env && std::string(env) != "NO") { enabled = true; }
+   env = getenv("MFEM_JIT_CXX");
+   cxx = env ? env : MFEM_JIT_DEFAULT_CXX;
+   env = getenv("MFEM_JIT_FLAGS");
+   flags = env ? env : MFEM_JIT_DEFAULT_FLAGS;
+   env = getenv("MFEM_JIT_CACHE");
+   if (env) { cache_dir = env; }
+   else
+   {
+      env = getenv("HOME");
+      cache_dir = env ? std::string(env) + "/.cache/mfem/jit" : "mfem_jit";
+   }
+}
+
+KernelJIT &KernelJIT::Instance()
+{
+   static KernelJIT instance;
+   return instance;
+}
+
+#ifdef MFEM_KERNEL_JIT
+bool KernelJIT::Compile(const std::string &src, const std::string &lib,
+                        const std::string &log) const
+{
+   // Use process specific files and rename the library when it is complete, so
+   // that other processes never load a partially written library.
+   const std::string base =
+      lib.substr(0, lib.size() - 3) + "." + ProcessId();
+   const std::string cpp = base + ".cpp";
+   const std::string tmp = base + ".so";
+   const std::string tmp_log = base + ".log";
+   {
+      std::ofstream cpp_file(cpp);
+      cpp_file << src;
+   }
+   std::vector<std::string> args = SplitWords(cxx);
+   for (const std::string &flag : SplitWords(flags)) { args.push_back(flag); }
+   for (const char *arg : {"-fPIC", "-shared", "-o"})
+   {
+      args.push_back(arg);
+   }
+   args.push_back(tmp);
+   args.push_back(cpp);
+
+   const bool ok = RunCommand(args, tmp_log) &&
+                   std::rename(tmp.c_str(), lib.c_str()) == 0;
+   std::remove(cpp.c_str());
+   std::remove(tmp.c_str());
+   if (ok)
+   {
+      std::remove(tmp_log.c_str());
+      std::remove(log.c_str());
+   }
+   else
+   {
+      std::rename(tmp_log.c_str(), log.c_str());
+   }
+   return ok;
+}
+
+bool KernelJIT::CheckCompiler()
+{
+   if (!cxx_checked)
+   {
+      cxx_checked = true;
+      const char *tmpdir = getenv("TMPDIR");
+      std::string out = std::string(tmpdir ? tmpdir : "/tmp") +
+                        "/mfem_jit_version.XXXXXX";
+      const int fd = mkstemp(&out[0]);
+      if (fd < 0) { return false; }
+      close(fd);
+      std::vector<std::string> args = SplitWords(cxx);
+      args.push_back("--version");
+      if (RunCommand(args, out)) { cxx_version = ReadFile(out); }
+      std::remove(out.c_str());
+   }
+   return !cxx_version.empty();
+}
+
+const std::string &KernelJIT::HeaderHash(const std::string &header)
+{
+   auto it = header_hashes.find(header);
+   if (it == header_hashes.end())
+   {
+      std::set<std::string> seen;
+      std::string contents;
+      ReadHeaders(header, seen, contents);
+      std::ostringstream hash;
+      hash << std::hex << StableHash(contents);
+      it = header_hashes.emplace(header, hash.str()).first;
+   }
+   return it->second;
+}
+
+void *KernelJIT::Load(const std::string &src)
+{
+   if (!CheckCompiler())
+   {
+      MFEM_WARNING("cannot run the JIT compiler " << cxx);
+      return nullptr;
+   }
+   if (!CreateDirectory(cache_dir))
+   {
+      MFEM_WARNING("cannot create the JIT cache directory " << cache_dir);
+      return nullptr;
+   }
+
+   // The key of the cache entry: any change in the compiler, its flags, MFEM
+   // or the kernel source results in a new entry.
+   std::ostringstream key_src;
+   key_src << cxx << '\n' << cxx_version << '\n' << flags << '\n'
+           << MFEM_VERSION << '\n'
+#ifdef MFEM_GIT_STRING
+           << MFEM_GIT_STRING << '\n'
+#endif
+           << src;
+   std::ostringstream key;
+   key << std::hex << StableHash(key_src.str());
+
+   const std::string base = cache_dir + "/mfem_jit_" + key.str();
+   const std::string lib = base + ".so";
+   const std::string lock = base + ".lock";
+   const std::string log = base + ".log";
+   // Only the process that creates the lock file compiles the kernel, the
+   // other processes wait until the library appears in the cache.
+   bool waited = false;
+   while (!FileExists(lib))
+   {
+      const int fd = open(lock.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644);
+      if (fd >= 0)
+      {
+         close(fd);
+         // If we waited for another process and it left a log instead of the
+         // library, its compilation failed: do not try again.
+         const bool ok = !(waited && FileExists(log)) && Compile(src, lib, log);
+         std::remove(lock.c_str());
+         if (!ok)
+         {
+            MFEM_WARNING("JIT compilation failed, see " << log);
+            return nullptr;
+         }
+      }
+      else if (errno == EEXIST)
+      {
+         // A lock older than ten minutes was left by an interrupted process.
+         waited = true;
+         struct stat lock_stat;
+         if (stat(lock.c_str(), &lock_stat) == 0 &&
+             std::difftime(std::time(nullptr), lock_stat.st_mtime) > 600.0)
+         {
+            std::remove(lock.c_str());
+         }
+         else
+         {
+            usleep(100000);
+         }
+      }
+      else
+      {
+         MFEM_WARNING("cannot create the JIT lock file " << lock);
+         return nullptr;
+      }
+   }
+
+   void *handle = dlopen(lib.c_str(), RTLD_NOW | RTLD_LOCAL);
+   if (!handle)
+   {
+      MFEM_WARNING("cannot load JIT kernel: " << dlerror());
+      return nullptr;
+   }
+   using KernelGetter = void *(*)();
+   KernelGetter getter =
+      reinterpret_cast<KernelGetter>(dlsym(handle, "mfem_jit_kernel"));
+   if (!getter)
+   {
+      MFEM_WARNING("cannot find JIT kernel: " << dlerror());
+      return nullptr;
+   }
+   num_loaded++;
+   return getter();
+}
+#endif
+
+bool KernelJIT::HasCompiler()
+{
+#ifdef MFEM_KERNEL_JIT
+   KernelJIT &jit = Instance();
+   std::lock_guard<std::mutex> lock(jit.mutex);
+   return jit.CheckCompiler();
+#else
+   return false;
+#endif
+}
+
+void KernelJIT::SetCacheDir(const std::string &dir)
+{
+   KernelJIT &jit = Instance();
+   std::lock_guard<std::mutex> lock(jit.mutex);
+   jit.cache_dir = dir;
+}
+
+std::string KernelJIT::GetCacheDir()
+{
+   KernelJIT &jit = Instance();
+   std::lock_guard<std::mutex> lock(jit.mutex);
+   return jit.cache_dir;
+}
+
+int KernelJIT::GetNumLoaded()
+{
+   KernelJIT &jit = Instance();
+   std::lock_guard<std::mutex> lock(jit.mutex);
+   return jit.num_loaded;
+}
+
+void KernelJIT::ClearCache()
+{
+#ifdef MFEM_KERNEL_JIT
+   const std::string dir = GetCacheDir();
+   DIR *d = opendir(dir.c_str());
+   if (!d) { return; }
+   while (const struct dirent *entry = readdir(d))
+   {
+      const std::string name = entry->d_name;
+      if (name.compare(0, 9, "mfem_jit_") == 0)
+      {
+         std::remove((dir + "/" + name).c_str());
+      }
+   }
+   closedir(d);
+   rmdir(dir.c_str());
+#endif
+}
+
+void *KernelJIT::GetKernel(const char *header, const std::string &kernel)
+{
+#ifndef MFEM_KERNEL_JIT
+   MFEM_CONTRACT_VAR(header);
+   MFEM_CONTRACT_VAR(kernel);
+   return nullptr;
+#else
+   KernelJIT &jit = Instance();
+   if (!jit.enabled) { return nullptr; }
+   std::lock_guard<std::mutex> lock(jit.mutex);
+
+   // Prefer the headers of the source directory, which match the build of the
+   // library; the installed headers may belong to a different build.
+   std::string path = std::string(MFEM_SOURCE_DIR "/") + header;
+   const bool source = FileExists(path);
+   if (!source)
+   {
+      path = std::string(MFEM_INSTALL_DIR "/include/mfem/") + header;
+      if (!FileExists(path))
+      {
+         MFEM_WARNING("cannot find " << header
+                      << " in MFEM_SOURCE_DIR or MFEM_INSTALL_DIR");
+         return nullptr;
+      }
+   }
+
+   std::ostringstream src;
+   src << "// Generated by mfem::KernelJIT\n"
+       // Changes in the headers change the source, and hence the cache key.
+       << "// Headers hash: " << jit.HeaderHash(path) << "\n";
+#ifdef MFEM_CONFIG_FILE
+   if (source)
+   {
+      src << "#define MFEM_CONFIG_FILE \"" << MFEM_CONFIG_FILE << "\"\n";
+   }
+#endif
+   src << "#include \"" << path << "\"\n"
+       << "namespace mfem\n{\n"
+       << "extern \"C\" void *mfem_jit_kernel()\n{\n"
+       << "   return reinterpret_cast<void*>(" << kernel << ");\n"
+       << "}\n}\n";
+
+   auto it = jit.kernels.find(src.str());
+   if (it != jit.kernels.end()) { return it->second; }
+   void *ptr = jit.Load(src.str());
+   jit.kernels[src.str()] = ptr;
+   return ptr;
+#endif
+}
+
+} // namespace mfem
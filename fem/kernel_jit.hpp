@@ -0,0 +1,143 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_KERNEL_JIT_HPP
+#define MFEM_KERNEL_JIT_HPP
+
+#include "../config/config.hpp"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+namespace mfem
+{
+
+/// @brief Singleton class compiling specialized kernels at runtime.
+///
+/// When a KernelDispatchTable has no specialization for the requested
+/// parameters, and the table was given the header declaring its kernels (see
+/// KernelDispatchTable::SetJitSource), the specialization is compiled with the
+/// host compiler into a shared object, loaded with dlopen(), and added to the
+/// table. The shared objects are kept in an on-disk cache keyed by the kernel,
+/// the compiler version, the compiler flags and the MFEM version, so each
+/// specialization is compiled only once. The cache key also includes the
+/// contents of the kernel header and of the MFEM headers it includes, so
+/// editing them results in a recompilation. The headers are taken from the
+/// MFEM source directory, matching the build of the library, and from the
+/// MFEM install directory only when the source directory is not available.
+///
+/// The following environment variables control the JIT compilation:
+/// - MFEM_JIT: enables the JIT compilation when set to a value other than
+///   'NO'. It can also be enabled with KernelJIT::Enable().
+/// - MFEM_JIT_CXX: the host compiler, default: the compiler used to build MFEM.
+/// - MFEM_JIT_FLAGS: the compiler flags, default: the flags used to build MFEM,
+///   including the OpenMP and third-party include flags.
+/// - MFEM_JIT_CACHE: the cache directory, default: '$HOME/.cache/mfem/jit'.
+///
+/// The compiler command is not run through a shell: MFEM_JIT_CXX and
+/// MFEM_JIT_FLAGS are split at white spaces and quotes are not interpreted.
+///
+/// When several processes (e.g. MPI ranks) need the same kernel, one of them
+/// compiles it while the others wait for the shared object to appear in the
+/// cache.
+///
+/// @note The compiled kernels reference symbols of the MFEM library, so they
+/// can only be loaded when MFEM is built as a shared library, or when the
+/// executable exports the MFEM symbols. The executables built with MFEM are
+/// linked with -rdynamic (or the equivalent linker flag) when MFEM is a static
+/// library, and applications should do the same, e.g. by using MFEM_EXT_LIBS
+/// from config.mk. When compiling or loading fails, a warning is printed once
+/// and the dispatch table uses the fallback kernel.
+///
+/// @note JIT compilation requires MFEM to be configured with MFEM_USE_JIT=YES
+/// and is only available on POSIX systems. Otherwise, GetKernel() always
+/// returns nullptr.
+///
+/// @note GetKernel() can be called from several threads, the compilations are
+/// serialized.
+class KernelJIT
+{
+   std::atomic<bool> enabled{false};
+   // The members below are guarded by @a mutex.
+   std::mutex mutex;
+   std::string cxx, flags, cache_dir, cxx_version;
+   bool cxx_checked = false;
+   // Loaded (or failed, nullptr) kernels, indexed by their source.
+   std::map<std::string, void*> kernels;
+   // Hashes of the contents of the kernel headers, see HeaderHash().
+   std::map<std::string, std::string> header_hashes;
+   int num_loaded = 0;
+   KernelJIT();
+   static KernelJIT &Instance();
+   // Run the compiler with --version once, setting cxx_version and
+   // cxx_checked; returns true if the compiler could be run.
+   bool CheckCompiler();
+   // Return the hash of the contents of @a header and of the headers it
+   // includes with #include "...", recursively.
+   const std::string &HeaderHash(const std::string &header);
+   // Compile (or retrieve from the cache) and load the given source.
+   void *Load(const std::string &src);
+   // Compile @a src into the shared object @a lib, writing the compiler output
+   // to @a log; returns true on success.
+   bool Compile(const std::string &src, const std::string &lib,
+                const std::string &log) const;
+public:
+   /// Enable JIT compilation of missing kernel specializations.
+   static void Enable() { Instance().enabled = true; }
+   /// Disable JIT compilation of missing kernel specializations.
+   static void Disable() { Instance().enabled = false; }
+   /// Return true if JIT compilation is enabled.
+   static bool IsEnabled() { return Instance().enabled; }
+   /** @brief Return true if the JIT compiler (MFEM_JIT_CXX) can be run. Always
+       false if MFEM is not configured with MFEM_USE_JIT=YES. */
+   static bool HasCompiler();
+   /// Set the directory of the on-disk cache of compiled kernels.
+   static void SetCacheDir(const std::string &dir);
+   /// Get the directory of the on-disk cache of compiled kernels.
+   static std::string GetCacheDir();
+   /** @brief Remove the compiled kernels from the on-disk cache, and the cache
+       directory if it is then empty. Kernels that are already loaded remain
+       valid. */
+   static void ClearCache();
+   /// Return the number of JIT compiled kernels loaded by this process.
+   static int GetNumLoaded();
+
+   /** @brief Return the kernel given by the expression @a kernel, e.g.
+       "MassIntegrator::ApplyPAKernels::Kernel<3,4,5>()", compiled in namespace
+       mfem with the MFEM header @a header, relative to the MFEM source (or
+       install include) directory.
+
+       Returns nullptr if the kernel could not be compiled or loaded. */
+   static void *GetKernel(const char *header, const std::string &kernel);
+
+   /// Return the template argument list corresponding to @a params.
+   template <typename... Params>
+   static std::string TemplateArgs(Params... params)
+   {
+      std::ostringstream o;
+      const char *sep = "";
+      using expand = int[];
+      (void) expand {0, (o << sep, TemplateArg(o, params), sep = ",", 0)...};
+      return o.str();
+   }
+
+private:
+   static void TemplateArg(std::ostream &o, bool p)
+   { o << (p ? "true" : "false"); }
+   template <typename T>
+   static void TemplateArg(std::ostream &o, T p) { o << int(p); }
+};
+
+} // namespace mfem
+
+#endif
@@ -167,6 +167,37 @@ real_t BlockNonlinearFormIntegrator::GetElementEnergy(
 }
 
 
+void HyperelasticModel::EvalDP(const DenseMatrix &Jpt, const DenseMatrix &dJpt,
+                               DenseMatrix &dP) const
+{
+   const int dim = Jpt.Width();
+
+   // With DS = I, the entry (k+i*dim, l+j*dim) of the matrix computed by
+   // AssembleH() is the derivative of P(i,k) with respect to Jpt(j,l).
+   DI.Diag(1.0, dim);
+   DH.SetSize(dim*dim);
+   DH = 0.0;
+   AssembleH(Jpt, DI, 1.0, DH);
+
+   dP.SetSize(dim);
+   for (int i = 0; i < dim; i++)
+   {
+      for (int k = 0; k < dim; k++)
+      {
+         real_t s = 0.0;
+         for (int j = 0; j < dim; j++)
+         {
+            for (int l = 0; l < dim; l++)
+            {
+               s += DH(k+i*dim, l+j*dim)*dJpt(j,l);
+            }
+         }
+         dP(i,k) = s;
+      }
+   }
+}
+
+
 real_t InverseHarmonicModel::EvalW(const DenseMatrix &J) const
 {
    Z.SetSize(J.Width());
@@ -383,6 +414,43 @@ void NeoHookeanModel::AssembleH(const DenseMatrix &J, const DenseMatrix &DS,
             }
 }
 
+void NeoHookeanModel::EvalDP(const DenseMatrix &J, const DenseMatrix &dJ,
+                             DenseMatrix &dP) const
+{
+   int dim = J.Width();
+
+   if (have_coeffs)
+   {
+      EvalCoeffs();
+   }
+
+   Z.SetSize(dim);
+   G.SetSize(dim);
+   C.SetSize(dim);
+
+   real_t detJ = J.Det();
+   real_t sJ = detJ/g;
+   real_t a  = mu*pow(detJ, -2.0/dim);
+   real_t bc = a*(J*J)/dim;
+   real_t b  = bc - K*sJ*(sJ - 1.0);
+   real_t c  = 2.0*bc/dim + K*sJ*(2.0*sJ - 1.0);
+
+   CalcAdjugateTranspose(J, Z);
+   Z *= (1.0/detJ); // Z = J^{-t}
+
+   // Same terms as in AssembleH(), applied to dJ:
+   // dP = a dJ - (2a/dim) ((Z:dJ) J + (J:dJ) Z) + c (Z:dJ) Z + b Z dJ^t Z
+   const real_t Z_dJ = Z*dJ, J_dJ = J*dJ;
+   MultABt(Z, dJ, G);
+   Mult(G, Z, C);
+
+   dP.SetSize(dim);
+   dP.Set(a, dJ);
+   dP.Add(-2.0*a/dim*Z_dJ, J);
+   dP.Add(-2.0*a/dim*J_dJ + c*Z_dJ, Z);
+   dP.Add(b, C);
+}
+
 
 real_t HyperelasticNLFIntegrator::GetElementEnergy(const FiniteElement &el,
                                                    ElementTransformation &Ttr,
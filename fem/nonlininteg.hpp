@@ -21,6 +21,10 @@
 namespace mfem
 {
 
+class PADataCache;
+class QuadratureSpace;
+class QuadratureFunction;
+
 /** @brief This class is used to express the local action of a general nonlinear
     finite element operator. In addition it may provide the capability to
     assemble the local gradient operator and to compute the local energy. */
@@ -48,6 +52,10 @@ protected:
 
    MemoryType pa_mt = MemoryType::DEFAULT;
 
+   // Optional on-disk cache of the PA data, not owned, see SetPADataCache().
+   PADataCache *pa_cache = nullptr;
+   std::string pa_cache_tag;
+
    NonlinearFormIntegrator(const IntegrationRule *ir = NULL)
       : IntRule(ir), ceedOp(NULL) { }
 
@@ -71,6 +79,20 @@ public:
    /// in PA extensions.
    void SetPAMemoryType(MemoryType mt) { pa_mt = mt; }
 
+   /** @brief Set the on-disk cache used to store the partial assembly data and
+       to load it instead of computing it again in AssemblePA(). Use NULL to
+       disable the cache.
+
+       The cache entries are keyed by the integrator type, the mesh geometry,
+       the integration rule and the values of the coefficients at the
+       quadrature points, which are computed in AssemblePA() also when the
+       data is loaded. The optional @a tag is added to the keys, to separate
+       entries depending on anything else. The cache is not owned by the
+       integrator. Currently supported by MassIntegrator and
+       DiffusionIntegrator. */
+   void SetPADataCache(PADataCache *cache, const std::string &tag = "")
+   { pa_cache = cache; pa_cache_tag = tag; }
+
    /// Get the integration rule of the integrator (possibly NULL).
    const IntegrationRule *GetIntegrationRule() const { return IntRule; }
 
@@ -217,6 +239,7 @@ class HyperelasticModel
 protected:
    ElementTransformation *Ttr; /**< Reference-element to target-element
                                     transformation. */
+   mutable DenseMatrix DI, DH; // used by the default EvalDP()
 
 public:
    HyperelasticModel() : Ttr(NULL) { }
@@ -254,6 +277,21 @@ public:
    */
    virtual void AssembleH(const DenseMatrix &Jpt, const DenseMatrix &DS,
                           const real_t weight, DenseMatrix &A) const = 0;
+
+   /** @brief Evaluate the derivative of the 1st Piola-Kirchhoff stress tensor
+       in the direction @a dJpt, dP = (dP/dJpt) : dJpt.
+       @param[in] Jpt   Represents the target->physical transformation
+                        Jacobian matrix.
+       @param[in] dJpt  Direction of the derivative (dim x dim).
+       @param[out] dP   The derivative of P (dim x dim).
+
+       This method is used by the matrix-free gradient of
+       HyperelasticNLFIntegrator. The default implementation extracts the
+       derivative from AssembleH(), called with the identity as the gradient of
+       the basis matrix; derived classes can override it with a direct
+       formula. */
+   virtual void EvalDP(const DenseMatrix &Jpt, const DenseMatrix &dJpt,
+                       DenseMatrix &dP) const;
 };
 
 
@@ -307,6 +345,9 @@ public:
 
    void AssembleH(const DenseMatrix &J, const DenseMatrix &DS,
                   const real_t weight, DenseMatrix &A) const override;
+
+   void EvalDP(const DenseMatrix &J, const DenseMatrix &dJ,
+               DenseMatrix &dP) const override;
 };
 
 
@@ -316,6 +357,14 @@ public:
     @a model's strain energy density function, and Jpt is the Jacobian of the
     target->physical coordinates transformation. The target configuration is
     given by the current mesh at the time of the evaluation of the integrator.
+
+    With AssemblyLevel::PARTIAL, the gradient is not assembled:
+    AssembleGradPA() stores the deformation gradients Jpt at the quadrature
+    points in a QuadratureFunction, see GetPAState(), and AddMultGradPA()
+    applies the linearization using HyperelasticModel::EvalDP(). Partial
+    assembly requires tensor-product elements, with vdim equal to the mesh
+    dimension. In that case, the target configuration is the one of the mesh
+    at the time of the call to AssemblePA().
 */
 class HyperelasticNLFIntegrator : public NonlinearFormIntegrator
 {
@@ -334,9 +383,34 @@ private:
    //        output - the result of AssembleElementVector() (dof x dim).
    DenseMatrix DSh, DS, Jrt, Jpr, Jpt, P, PMatI, PMatO;
 
+   // PA extension
+   Mesh *mesh;                    ///< Not owned
+   const IntegrationRule *pa_ir;  ///< Not owned
+   int dim, ne, nq, dof;
+   /// Reference shape function gradients (dof x dim x nq), with the dofs in
+   /// the lexicographic ordering of the E-vectors.
+   Vector pa_dshape;
+   /// Jacobians Jrt (dim x dim x nq x ne) and quadrature weights times
+   /// det(Jtr) (nq x ne) of the target configuration.
+   Vector pa_Jrt, pa_weights;
+   QuadratureSpace *pa_qspace;    ///< Owned
+   QuadratureFunction *pa_state;  ///< Owned, Jpt at the quadrature points
+
+   // Set DS to the gradients of the shape functions in the target
+   // configuration at the quadrature point q of element e.
+   void PAShapeGradients(int q, int e, DenseMatrix &DS) const;
+
 public:
    /** @param[in] m  HyperelasticModel that will be integrated. */
-   HyperelasticNLFIntegrator(HyperelasticModel *m) : model(m) { }
+   HyperelasticNLFIntegrator(HyperelasticModel *m)
+      : model(m), mesh(nullptr), pa_ir(nullptr), dim(0), ne(0), nq(0), dof(0),
+        pa_qspace(nullptr), pa_state(nullptr) { }
+
+   HyperelasticNLFIntegrator(const HyperelasticNLFIntegrator &) = delete;
+   HyperelasticNLFIntegrator &operator=(const HyperelasticNLFIntegrator &) =
+      delete;
+
+   ~HyperelasticNLFIntegrator() override;
 
    /** @brief Computes the integral of W(Jacobian(Trt)) over a target zone
        @param[in] el     Type of FiniteElement.
@@ -353,6 +427,25 @@ public:
    void AssembleElementGrad(const FiniteElement &el,
                             ElementTransformation &Ttr,
                             const Vector &elfun, DenseMatrix &elmat) override;
+
+   using NonlinearFormIntegrator::AssemblePA;
+
+   void AssemblePA(const FiniteElementSpace &fes) override;
+
+   real_t GetLocalStateEnergyPA(const Vector &x) const override;
+
+   void AddMultPA(const Vector &x, Vector &y) const override;
+
+   void AssembleGradPA(const Vector &x, const FiniteElementSpace &fes) override;
+
+   void AddMultGradPA(const Vector &x, Vector &y) const override;
+
+   void AssembleGradDiagonalPA(Vector &diag) const override;
+
+   /** @brief Return the linearization state set by AssembleGradPA(): the
+       deformation gradients Jpt (dim x dim, column-major) at the quadrature
+       points, or NULL if AssembleGradPA() has not been called. */
+   const QuadratureFunction *GetPAState() const { return pa_state; }
 };
 
 /** Hyperelastic incompressible Neo-Hookean integrator with the PK1 stress
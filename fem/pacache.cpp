@@ -0,0 +1,359 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "pacache.hpp"
+#include "gridfunc.hpp"
+#include "../mesh/mesh.hpp"
+#include "../general/binaryio.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // mkdir, fstat
+#include <unistd.h>    // close, getpid, gethostname
+#else
+#include <direct.h>    // _mkdir
+#include <process.h>   // _getpid
+#define getpid _getpid
+#define mkdir(dir, mode) _mkdir(dir)
+#endif
+
+namespace mfem
+{
+
+namespace
+{
+
+// 64-bit FNV-1a hash, used for the fingerprints of the cache keys.
+class Fingerprinter
+{
+   uint64_t hash = 14695981039346656037ULL;
+
+   void Mix(uint64_t word)
+   {
+      hash ^= word;
+      hash *= 1099511628211ULL;
+   }
+
+public:
+   template <typename T>
+   void Append(const T &value)
+   {
+      uint64_t word = 0;
+      static_assert(sizeof(T) <= sizeof(word), "invalid type");
+      std::copy(reinterpret_cast<const char*>(&value),
+                reinterpret_cast<const char*>(&value) + sizeof(T),
+                reinterpret_cast<char*>(&word));
+      Mix(word);
+   }
+
+   template <typename T>
+   void Append(const T *values, const int n)
+   {
+      for (int i = 0; i < n; i++) { Append(values[i]); }
+   }
+
+   std::string Str() const
+   {
+      std::ostringstream os;
+      os << std::hex;
+      os.width(16);
+      os.fill('0');
+      os << hash;
+      return os.str();
+   }
+};
+
+// Magic string and version of the cache files.
+const char magic[8] = {'M','F','E','M','P','A','D','C'};
+const uint32_t version = 1;
+const uint64_t alignment = 64;
+
+uint64_t Align(const uint64_t offset)
+{
+   return (offset + alignment - 1) / alignment * alignment;
+}
+
+// Size of the header before padding.
+uint64_t HeaderBytes(const uint64_t num_arrays)
+{
+   return sizeof(magic) + 2*sizeof(uint32_t) + (1 + num_arrays)*sizeof(uint64_t);
+}
+
+void Pad(std::ostream &os, const uint64_t size)
+{
+   for (uint64_t i = size; i < Align(size); i++) { os.put('\0'); }
+}
+
+} // anonymous namespace
+
+PADataCache::PADataCache(const std::string &dir_name, bool use_mmap_)
+   : dir(dir_name), use_mmap(use_mmap_)
+{
+   // create directories recursively
+   std::string::size_type pos = 0;
+   int err_flag = 0;
+   do
+   {
+      pos = dir.find('/', pos+1);
+      const std::string subdir = dir.substr(0, pos);
+      err_flag = mkdir(subdir.c_str(), 0777);
+      err_flag = (err_flag && (errno != EEXIST)) ? 1 : 0;
+   }
+   while (pos != std::string::npos);
+   MFEM_VERIFY(!err_flag, "error creating the cache directory " << dir);
+#ifdef _WIN32
+   use_mmap = false;
+#endif
+}
+
+PADataCache::~PADataCache()
+{
+#ifndef _WIN32
+   for (const std::pair<void*, size_t> &m : mappings)
+   {
+      munmap(m.first, m.second);
+   }
+#endif
+}
+
+std::string PADataCache::FileName(const std::string &key) const
+{
+   return dir + "/" + key + ".padata";
+}
+
+std::string PADataCache::Fingerprint(const Mesh &mesh,
+                                     const IntegrationRule &ir)
+{
+   Fingerprinter fp;
+   fp.Append(mesh.Dimension());
+   fp.Append(mesh.SpaceDimension());
+   fp.Append(mesh.GetNE());
+   for (int e = 0; e < mesh.GetNE(); e++)
+   {
+      fp.Append(int(mesh.GetElementGeometry(e)));
+   }
+   const GridFunction *nodes = mesh.GetNodes();
+   if (nodes)
+   {
+      const FiniteElementSpace *nfes = nodes->FESpace();
+      fp.Append(nfes->GetMaxElementOrder());
+      fp.Append(int(nfes->GetOrdering()));
+      fp.Append(nodes->Size());
+      fp.Append(nodes->HostRead(), nodes->Size());
+   }
+   else
+   {
+      fp.Append(mesh.GetNV());
+      for (int v = 0; v < mesh.GetNV(); v++)
+      {
+         fp.Append(mesh.GetVertex(v), mesh.SpaceDimension());
+      }
+      for (int e = 0; e < mesh.GetNE(); e++)
+      {
+         const Element *el = mesh.GetElement(e);
+         fp.Append(el->GetVertices(), el->GetNVertices());
+      }
+   }
+   fp.Append(ir.GetNPoints());
+   fp.Append(ir.GetOrder());
+   for (int i = 0; i < ir.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = ir.IntPoint(i);
+      fp.Append(ip.x);
+      fp.Append(ip.y);
+      fp.Append(ip.z);
+      fp.Append(ip.weight);
+   }
+   return fp.Str();
+}
+
+std::string PADataCache::Fingerprint(const Vector &data)
+{
+   Fingerprinter fp;
+   fp.Append(data.Size());
+   fp.Append(data.HostRead(), data.Size());
+   return fp.Str();
+}
+
+bool PADataCache::Exists(const std::string &key) const
+{
+   std::ifstream is(FileName(key));
+   return is.good();
+}
+
+void PADataCache::Save(const std::string &key,
+                       const std::vector<const Vector*> &data) const
+{
+   const std::string fname = FileName(key);
+   // Write to a temporary file first, so that readers never see partially
+   // written entries. The name of the temporary file is unique among the
+   // processes, possibly on different hosts, sharing the cache directory.
+   std::ostringstream tmp_suffix;
+#ifndef _WIN32
+   char host[256] = "";
+   gethostname(host, sizeof(host) - 1);
+   tmp_suffix << '.' << host;
+#endif
+   tmp_suffix << '.' << getpid() << ".tmp";
+   const std::string tmp_fname = fname + tmp_suffix.str();
+   {
+      std::ofstream os(tmp_fname, std::ios::binary);
+      MFEM_VERIFY(os.good(), "error opening " << tmp_fname);
+      const uint64_t num_arrays = data.size();
+      os.write(magic, sizeof(magic));
+      bin_io::write<uint32_t>(os, version);
+      bin_io::write<uint32_t>(os, sizeof(real_t));
+      bin_io::write<uint64_t>(os, num_arrays);
+      for (const Vector *v : data) { bin_io::write<uint64_t>(os, v->Size()); }
+      Pad(os, HeaderBytes(num_arrays));
+      for (const Vector *v : data)
+      {
+         const uint64_t bytes = v->Size()*sizeof(real_t);
+         os.write(reinterpret_cast<const char*>(v->HostRead()), bytes);
+         Pad(os, bytes);
+      }
+      MFEM_VERIFY(os.good(), "error writing " << tmp_fname);
+   }
+   if (std::rename(tmp_fname.c_str(), fname.c_str()) != 0)
+   {
+      // Another process may have saved the same entry concurrently (on some
+      // systems, rename fails when the target exists): its data is the same.
+      std::remove(tmp_fname.c_str());
+      MFEM_VERIFY(Exists(key), "error renaming " << tmp_fname);
+   }
+}
+
+bool PADataCache::Load(const std::string &key, const std::vector<Vector*> &data,
+                       MemoryType mt) const
+{
+   const std::string fname = FileName(key);
+   std::ifstream is(fname, std::ios::binary);
+   if (!is.good()) { return false; }
+
+   char file_magic[sizeof(magic)];
+   is.read(file_magic, sizeof(magic));
+   if (!is.good() || !std::equal(magic, magic + sizeof(magic), file_magic))
+   {
+      return false;
+   }
+   const uint32_t file_version = bin_io::read<uint32_t>(is);
+   const uint32_t real_size = bin_io::read<uint32_t>(is);
+   const uint64_t num_arrays = bin_io::read<uint64_t>(is);
+   if (!is.good() || file_version != version || real_size != sizeof(real_t) ||
+       num_arrays != data.size())
+   {
+      return false;
+   }
+   std::vector<uint64_t> sizes(num_arrays), offsets(num_arrays);
+   uint64_t offset = Align(HeaderBytes(num_arrays));
+   for (uint64_t i = 0; i < num_arrays; i++)
+   {
+      sizes[i] = bin_io::read<uint64_t>(is);
+      offsets[i] = offset;
+      offset += Align(sizes[i]*sizeof(real_t));
+      if (sizes[i] != uint64_t(data[i]->Size())) { return false; }
+   }
+   if (!is.good()) { return false; }
+
+#ifndef _WIN32
+   if (use_mmap)
+   {
+      const int fd = open(fname.c_str(), O_RDONLY);
+      if (fd < 0) { return false; }
+      struct stat st;
+      if (fstat(fd, &st) != 0 || uint64_t(st.st_size) < offset)
+      {
+         close(fd);
+         return false;
+      }
+      const size_t length = st.st_size;
+      void *addr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                        fd, 0);
+      close(fd);
+      if (addr == MAP_FAILED) { return false; }
+      mappings.emplace_back(addr, length);
+      for (uint64_t i = 0; i < num_arrays; i++)
+      {
+         real_t *ptr = reinterpret_cast<real_t*>(static_cast<char*>(addr) +
+                                                 offsets[i]);
+         data[i]->NewDataAndSize(ptr, int(sizes[i]));
+      }
+      return true;
+   }
+#endif
+
+   is.seekg(0, std::ios::end);
+   if (!is.good() || uint64_t(is.tellg()) < offset) { return false; }
+
+   // Read into temporary vectors, so that data is unchanged on failure.
+   std::vector<Vector> arrays(num_arrays);
+   for (uint64_t i = 0; i < num_arrays; i++)
+   {
+      arrays[i].SetSize(int(sizes[i]), mt);
+      is.seekg(offsets[i]);
+      is.read(reinterpret_cast<char*>(arrays[i].HostWrite()),
+              sizes[i]*sizeof(real_t));
+      if (!is.good()) { return false; }
+   }
+   for (uint64_t i = 0; i < num_arrays; i++) { data[i]->Swap(arrays[i]); }
+   return true;
+}
+
+static std::string GeometricFactorsKey(const Mesh &mesh,
+                                       const IntegrationRule &ir, int flags)
+{
+   return "geom_" + PADataCache::Fingerprint(mesh, ir) + "_" +
+          std::to_string(flags);
+}
+
+void PADataCache::Save(const GeometricFactors &geom) const
+{
+   Save(GeometricFactorsKey(*geom.mesh, *geom.IntRule, geom.computed_factors),
+        std::vector<const Vector*> {&geom.X, &geom.J, &geom.detJ});
+}
+
+GeometricFactors *PADataCache::LoadGeometricFactors(const Mesh &mesh,
+                                                    const IntegrationRule &ir,
+                                                    int flags,
+                                                    MemoryType mt) const
+{
+   const std::string key = GeometricFactorsKey(mesh, ir, flags);
+   if (!Exists(key)) { return nullptr; }
+   GeometricFactors *geom = new GeometricFactors;
+   geom->mesh = &mesh;
+   geom->IntRule = &ir;
+   geom->computed_factors = flags;
+   const MemoryType my_mt = (mt != MemoryType::DEFAULT) ? mt :
+                            Device::GetDeviceMemoryType();
+   // Expected sizes, see GeometricFactors::Compute()
+   const int dim = mesh.Dimension(), sdim = mesh.SpaceDimension();
+   const int nq_ne = ir.GetNPoints()*mesh.GetNE();
+   if (flags & GeometricFactors::COORDINATES) { geom->X.SetSize(sdim*nq_ne); }
+   if (flags & GeometricFactors::JACOBIANS) { geom->J.SetSize(dim*sdim*nq_ne); }
+   if (flags & GeometricFactors::DETERMINANTS) { geom->detJ.SetSize(nq_ne); }
+   if (!Load(key, std::vector<Vector*> {&geom->X, &geom->J, &geom->detJ},
+             my_mt))
+   {
+      delete geom;
+      return nullptr;
+   }
+   return geom;
+}
+
+} // namespace mfem
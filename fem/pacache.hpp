@@ -0,0 +1,128 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PACACHE_HPP
+#define MFEM_PACACHE_HPP
+
+#include "../config/config.hpp"
+#include "../linalg/vector.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mfem
+{
+
+class Mesh;
+class IntegrationRule;
+class GeometricFactors;
+
+/** @brief On-disk cache of partial assembly setup data: geometric factors and
+    quadrature point data of the integrators.
+
+    Each entry is stored in a separate file of the cache directory, named
+    after its key. Keys combine a fingerprint of the mesh nodes and of the
+    integration rule (see Fingerprint()), so that an entry is only reused for
+    the same geometry and quadrature.
+
+    The files consist of a header, padded to a multiple of 64 bytes, followed
+    by the raw arrays in the native byte order, each one starting at a 64-byte
+    aligned offset. This allows the entries to be memory-mapped instead of
+    read, see PADataCache(). Files are written to a temporary file which is
+    then renamed, so concurrent processes (e.g. MPI ranks) can share a cache.
+
+    The cache is used by the Mesh for its geometric factors, see
+    Mesh::SetPADataCache(), and by the integrators supporting it for their
+    partial assembly data, see BilinearFormIntegrator::SetPADataCache(). */
+class PADataCache
+{
+protected:
+   std::string dir;
+   bool use_mmap;
+   // Memory-mapped entries (address and length), unmapped in the destructor.
+   mutable std::vector<std::pair<void*, size_t>> mappings;
+
+   std::string FileName(const std::string &key) const;
+
+public:
+   /// Create a cache storing its files in the directory @a dir_name.
+   /** The directory is created if it does not exist.
+
+       If @a use_mmap is true, the loaded arrays reference private (copy on
+       write) memory mappings of the cache files instead of copies of their
+       data, so only the pages which are accessed are read from disk. In that
+       case, the cache object must outlive the objects using the loaded data.
+       Memory mapping is only available on POSIX systems, elsewhere the data is
+       always read. */
+   PADataCache(const std::string &dir_name, bool use_mmap = false);
+
+   PADataCache(const PADataCache &) = delete;
+   PADataCache &operator=(const PADataCache &) = delete;
+
+   ~PADataCache();
+
+   /// Return the cache directory.
+   const std::string &GetDirectory() const { return dir; }
+
+   /** @brief Return a fingerprint of the geometry of @a mesh (element
+       geometries and nodes) and of the integration rule @a ir. */
+   static std::string Fingerprint(const Mesh &mesh, const IntegrationRule &ir);
+
+   /** @brief Return a fingerprint of the size and the values of @a data, e.g.
+       of the values of a coefficient at the quadrature points. */
+   static std::string Fingerprint(const Vector &data);
+
+   /// Return true if an entry with the given @a key exists.
+   bool Exists(const std::string &key) const;
+
+   /// Store the arrays @a data under the given @a key.
+   void Save(const std::string &key,
+             const std::vector<const Vector*> &data) const;
+
+   /// Store the array @a data under the given @a key.
+   void Save(const std::string &key, const Vector &data) const
+   { Save(key, std::vector<const Vector*> {&data}); }
+
+   /** @brief Load the arrays stored under @a key into @a data, with memory
+       type @a mt. Returns false, leaving @a data unchanged, if there is no
+       (valid) entry with the given @a key.
+
+       The vectors in @a data must have the expected sizes of the stored
+       arrays: entries with a different number of arrays or with arrays of
+       different sizes, e.g. truncated or written for other data, are not
+       valid.
+
+       When memory mapping is enabled, @a mt is ignored and the arrays use host
+       memory; they are copied to the device on first use, as usual. */
+   bool Load(const std::string &key, const std::vector<Vector*> &data,
+             MemoryType mt = MemoryType::DEFAULT) const;
+
+   /// Load the array stored under @a key into @a data, see Load().
+   bool Load(const std::string &key, Vector &data,
+             MemoryType mt = MemoryType::DEFAULT) const
+   { return Load(key, std::vector<Vector*> {&data}, mt); }
+
+   /// Store the geometric factors @a geom.
+   void Save(const GeometricFactors &geom) const;
+
+   /** @brief Return the geometric factors with the given parameters if they
+       are in the cache, otherwise return NULL. The returned object is owned by
+       the caller. */
+   GeometricFactors *LoadGeometricFactors(const Mesh &mesh,
+                                          const IntegrationRule &ir,
+                                          int flags,
+                                          MemoryType mt = MemoryType::DEFAULT)
+   const;
+};
+
+} // namespace mfem
+
+#endif
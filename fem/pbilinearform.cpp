@@ -16,6 +16,10 @@
 #include "fem.hpp"
 #include "../general/sort_pairs.hpp"
 
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 namespace mfem
 {
 
@@ -281,6 +285,452 @@ void ParBilinearForm::Assemble(int skip_zeros)
    }
 }
 
+/* Numeric-only computation of the parallel matrix A = P^T a P, where a is the
+   local matrix and P is the prolongation (Dof_TrueDof_Matrix), into the values
+   of an existing HypreParMatrix A, followed by the elimination of the
+   essential true dofs into an existing HypreParMatrix Ae, see
+   ParBilinearForm::ReassembleValues().
+
+   Each entry a_kl contributes p_ki a_kl p_lj to A_ij for all nonzeros p_ki and
+   p_lj. The destinations of the contributions are computed once: an entry of
+   the diagonal or off-diagonal block of A when row i is owned by this
+   processor, and an entry of a send buffer otherwise. The owner of row i adds
+   the received values to the entries of A found when the buffers were first
+   exchanged. The entries of Ae are mapped to the entries of A they were
+   eliminated from. */
+class ParBilinearForm::ParallelReassembly
+{
+   MPI_Comm comm;
+   // Number of nonzeros of the local matrix, and of the diagonal and
+   // off-diagonal blocks of A
+   int a_nnz, diag_nnz, offd_nnz;
+   // The contributions: index in the data of the local matrix, coefficient
+   // p_ki p_lj, and destination, see Add()
+   Array<int> c_src, c_dst;
+   Array<real_t> c_coef;
+   // Contributions sent to send_ranks[r] are summed in the entries
+   // send_offsets[r] to send_offsets[r+1]-1 of send_buf. The values received
+   // from recv_ranks[r] are added to the destinations recv_dst[recv_offsets[r]]
+   // to recv_dst[recv_offsets[r+1]-1].
+   Array<int> send_ranks, send_offsets, recv_ranks, recv_offsets, recv_dst;
+   Vector send_buf, recv_buf;
+   // Positions in A (see Add()) of the entries of diag(Ae), then offd(Ae)
+   Array<int> elim_dst;
+
+   static const int tag = 46801;
+
+   // Return the destination of A_ij for the local row i and the global column
+   // j: an index in the data of diag(A), or diag_nnz plus an index in the data
+   // of offd(A). Returns -1 if the entry is not in the sparsity pattern of A.
+   int Find(hypre_ParCSRMatrix *A, int i, HYPRE_BigInt j) const;
+
+   // Add v to the destination dst: an entry of diag(A), offd(A) or send_buf,
+   // in this order.
+   void Add(real_t *diag, real_t *offd, int dst, real_t v)
+   {
+      if (dst < diag_nnz) { diag[dst] += v; }
+      else if (dst < diag_nnz + offd_nnz) { offd[dst - diag_nnz] += v; }
+      else { send_buf(dst - diag_nnz - offd_nnz) += v; }
+   }
+
+public:
+   /** Compute the destinations of the contributions of the local matrix @a a
+       to @a A, given the prolongation @a P, and the positions in @a A of the
+       entries eliminated into @a Ae. */
+   ParallelReassembly(const SparseMatrix &a, const HypreParMatrix &P,
+                      HypreParMatrix &A, HypreParMatrix &Ae);
+
+   /** Compute the values of @a A from the local matrix @a a, then eliminate
+       the essential true dofs into @a Ae, see the constructor. */
+   void Assemble(const SparseMatrix &a, HypreParMatrix &A, HypreParMatrix &Ae);
+};
+
+int ParBilinearForm::ParallelReassembly::Find(hypre_ParCSRMatrix *A, int i,
+                                              HYPRE_BigInt j) const
+{
+   hypre_CSRMatrix *diag = hypre_ParCSRMatrixDiag(A);
+   hypre_CSRMatrix *offd = hypre_ParCSRMatrixOffd(A);
+   const HYPRE_BigInt j_diag = j - hypre_ParCSRMatrixFirstColDiag(A);
+   if (j_diag >= 0 && j_diag < hypre_CSRMatrixNumCols(diag))
+   {
+      const HYPRE_Int *I = hypre_CSRMatrixI(diag), *J = hypre_CSRMatrixJ(diag);
+      for (HYPRE_Int k = I[i]; k < I[i+1]; k++)
+      {
+         if (J[k] == j_diag) { return k; }
+      }
+      return -1;
+   }
+   const HYPRE_BigInt *col_map = hypre_ParCSRMatrixColMapOffd(A);
+   const HYPRE_Int num_cols = hypre_CSRMatrixNumCols(offd);
+   const HYPRE_BigInt *c = std::lower_bound(col_map, col_map + num_cols, j);
+   if (c == col_map + num_cols || *c != j) { return -1; }
+   const HYPRE_Int j_offd = HYPRE_Int(c - col_map);
+   const HYPRE_Int *I = hypre_CSRMatrixI(offd), *J = hypre_CSRMatrixJ(offd);
+   for (HYPRE_Int k = I[i]; k < I[i+1]; k++)
+   {
+      if (J[k] == j_offd) { return diag_nnz + k; }
+   }
+   return -1;
+}
+
+ParBilinearForm::ParallelReassembly::ParallelReassembly(
+   const SparseMatrix &a, const HypreParMatrix &P, HypreParMatrix &A,
+   HypreParMatrix &Ae)
+   : comm(A.GetComm())
+{
+   int nranks, myid;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &myid);
+
+   P.HostRead();
+   A.HostRead();
+   Ae.HostRead();
+   hypre_ParCSRMatrix *A_par = A;
+   diag_nnz = hypre_CSRMatrixNumNonzeros(hypre_ParCSRMatrixDiag(A_par));
+   offd_nnz = hypre_CSRMatrixNumNonzeros(hypre_ParCSRMatrixOffd(A_par));
+   a_nnz = a.NumNonZeroElems();
+
+   // The rows of P with global column indices
+   hypre_ParCSRMatrix *P_par = const_cast<HypreParMatrix&>(P);
+   hypre_CSRMatrix *P_diag = hypre_ParCSRMatrixDiag(P_par);
+   hypre_CSRMatrix *P_offd = hypre_ParCSRMatrixOffd(P_par);
+   const HYPRE_BigInt P_first_col = hypre_ParCSRMatrixFirstColDiag(P_par);
+   const HYPRE_BigInt *P_col_map = hypre_ParCSRMatrixColMapOffd(P_par);
+   const int P_rows = hypre_CSRMatrixNumRows(P_diag);
+   MFEM_VERIFY(a.Height() == P_rows && a.Width() == P_rows,
+               "incompatible local matrix");
+   Array<int> P_I(P_rows + 1);
+   Array<HYPRE_BigInt> P_J;
+   Array<real_t> P_V;
+   P_I[0] = 0;
+   for (int k = 0; k < P_rows; k++)
+   {
+      for (int b = 0; b < 2; b++)
+      {
+         hypre_CSRMatrix *blk = b ? P_offd : P_diag;
+         const HYPRE_Int *I = hypre_CSRMatrixI(blk);
+         if (!I) { continue; }
+         const HYPRE_Int *J = hypre_CSRMatrixJ(blk);
+         const real_t *V = hypre_CSRMatrixData(blk);
+         for (HYPRE_Int m = I[k]; m < I[k+1]; m++)
+         {
+            P_J.Append(b ? P_col_map[J[m]] : P_first_col + J[m]);
+            P_V.Append(V[m]);
+         }
+      }
+      P_I[k+1] = P_J.Size();
+   }
+
+   // The first row of A owned by each processor
+   const HYPRE_BigInt first_row = hypre_ParCSRMatrixFirstRowIndex(A_par);
+   std::vector<HYPRE_BigInt> row_starts(nranks + 1);
+   MPI_Allgather(const_cast<HYPRE_BigInt*>(&first_row), 1, HYPRE_MPI_BIG_INT,
+                 row_starts.data(), 1, HYPRE_MPI_BIG_INT, comm);
+   row_starts[nranks] = hypre_ParCSRMatrixGlobalNumRows(A_par);
+
+   // Destinations of the contributions to local rows; the contributions to
+   // rows owned by other processors are numbered -1-r, where r is the index
+   // of (owner, i, j) in 'remote'.
+   typedef std::tuple<int, HYPRE_BigInt, HYPRE_BigInt> RemoteEntry;
+   std::vector<RemoteEntry> remote;
+   const int *a_I = a.HostReadI(), *a_J = a.HostReadJ();
+   bool found = true;
+   for (int k = 0; k < P_rows && found; k++)
+   {
+      for (int m = a_I[k]; m < a_I[k+1] && found; m++)
+      {
+         const int l = a_J[m];
+         for (int pi = P_I[k]; pi < P_I[k+1] && found; pi++)
+         {
+            const HYPRE_BigInt i = P_J[pi];
+            const int owner = int(std::upper_bound(row_starts.begin(),
+                                                   row_starts.end(), i) -
+                                  row_starts.begin()) - 1;
+            for (int pj = P_I[l]; pj < P_I[l+1]; pj++)
+            {
+               const HYPRE_BigInt j = P_J[pj];
+               int dst;
+               if (owner == myid)
+               {
+                  dst = Find(A_par, int(i - first_row), j);
+                  if (dst < 0) { found = false; break; }
+               }
+               else
+               {
+                  dst = -1 - int(remote.size());
+                  remote.emplace_back(owner, i, j);
+               }
+               c_src.Append(m);
+               c_coef.Append(P_V[pi]*P_V[pj]);
+               c_dst.Append(dst);
+            }
+         }
+      }
+   }
+
+   // Number the distinct remote entries, grouped by owner, and set the
+   // destinations of the remote contributions in send_buf
+   std::vector<RemoteEntry> keys(remote);
+   std::sort(keys.begin(), keys.end());
+   keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+   for (int c = 0; c < c_dst.Size(); c++)
+   {
+      if (c_dst[c] >= 0) { continue; }
+      const RemoteEntry &e = remote[-1 - c_dst[c]];
+      const int slot = int(std::lower_bound(keys.begin(), keys.end(), e) -
+                           keys.begin());
+      c_dst[c] = diag_nnz + offd_nnz + slot;
+   }
+   remote.clear();
+   send_buf.SetSize(int(keys.size()));
+   std::vector<int> send_counts(nranks, 0), recv_counts(nranks);
+   for (const RemoteEntry &e : keys) { send_counts[std::get<0>(e)]++; }
+   MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT,
+                comm);
+   send_offsets.Append(0);
+   recv_offsets.Append(0);
+   for (int r = 0; r < nranks; r++)
+   {
+      if (send_counts[r])
+      {
+         send_ranks.Append(r);
+         send_offsets.Append(send_offsets.Last() + send_counts[r]);
+      }
+      if (recv_counts[r])
+      {
+         recv_ranks.Append(r);
+         recv_offsets.Append(recv_offsets.Last() + recv_counts[r]);
+      }
+   }
+   recv_buf.SetSize(recv_offsets.Last());
+
+   // Send the (i, j) indices of the remote entries to their owners, which
+   // find their destinations in A
+   std::vector<HYPRE_BigInt> send_ij(2*keys.size());
+   for (size_t e = 0; e < keys.size(); e++)
+   {
+      send_ij[2*e] = std::get<1>(keys[e]);
+      send_ij[2*e+1] = std::get<2>(keys[e]);
+   }
+   keys.clear();
+   std::vector<HYPRE_BigInt> recv_ij(2*recv_offsets.Last());
+   std::vector<MPI_Request> requests(recv_ranks.Size() + send_ranks.Size());
+   for (int r = 0; r < recv_ranks.Size(); r++)
+   {
+      MPI_Irecv(recv_ij.data() + 2*recv_offsets[r],
+                2*(recv_offsets[r+1] - recv_offsets[r]), HYPRE_MPI_BIG_INT,
+                recv_ranks[r], tag, comm, &requests[r]);
+   }
+   for (int r = 0; r < send_ranks.Size(); r++)
+   {
+      MPI_Isend(send_ij.data() + 2*send_offsets[r],
+                2*(send_offsets[r+1] - send_offsets[r]), HYPRE_MPI_BIG_INT,
+                send_ranks[r], tag, comm, &requests[recv_ranks.Size() + r]);
+   }
+   MPI_Waitall(int(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+   recv_dst.SetSize(recv_offsets.Last());
+   for (int e = 0; e < recv_dst.Size(); e++)
+   {
+      recv_dst[e] = Find(A_par, int(recv_ij[2*e] - first_row), recv_ij[2*e+1]);
+      if (recv_dst[e] < 0) { found = false; }
+   }
+
+   // All the contributions must have an entry in A
+   int all_found = found;
+   MPI_Allreduce(MPI_IN_PLACE, &all_found, 1, MPI_INT, MPI_MIN, comm);
+   MFEM_VERIFY(all_found, "the sparsity pattern of the parallel matrix changed");
+
+   // The positions in A of the entries eliminated into Ae
+   hypre_ParCSRMatrix *Ae_par = Ae;
+   hypre_CSRMatrix *Ae_diag = hypre_ParCSRMatrixDiag(Ae_par);
+   hypre_CSRMatrix *Ae_offd = hypre_ParCSRMatrixOffd(Ae_par);
+   const HYPRE_BigInt Ae_first_col = hypre_ParCSRMatrixFirstColDiag(Ae_par);
+   const HYPRE_BigInt *Ae_col_map = hypre_ParCSRMatrixColMapOffd(Ae_par);
+   for (int b = 0; b < 2; b++)
+   {
+      hypre_CSRMatrix *blk = b ? Ae_offd : Ae_diag;
+      const HYPRE_Int *I = hypre_CSRMatrixI(blk);
+      if (!I) { continue; }
+      const HYPRE_Int *J = hypre_CSRMatrixJ(blk);
+      for (int i = 0; i < hypre_CSRMatrixNumRows(blk); i++)
+      {
+         for (HYPRE_Int m = I[i]; m < I[i+1]; m++)
+         {
+            const HYPRE_BigInt j = b ? Ae_col_map[J[m]] : Ae_first_col + J[m];
+            elim_dst.Append(Find(A_par, i, j));
+            MFEM_VERIFY(elim_dst.Last() >= 0, "invalid eliminated matrix");
+         }
+      }
+   }
+}
+
+void ParBilinearForm::ParallelReassembly::Assemble(const SparseMatrix &a,
+                                                   HypreParMatrix &A,
+                                                   HypreParMatrix &Ae)
+{
+   MFEM_VERIFY(a.NumNonZeroElems() == a_nnz,
+               "the sparsity pattern of the local matrix changed");
+   A.HostReadWrite();
+   Ae.HostReadWrite();
+   hypre_ParCSRMatrix *A_par = A, *Ae_par = Ae;
+   real_t *diag = hypre_CSRMatrixData(hypre_ParCSRMatrixDiag(A_par));
+   real_t *offd = hypre_CSRMatrixData(hypre_ParCSRMatrixOffd(A_par));
+   std::fill(diag, diag + diag_nnz, real_t(0));
+   std::fill(offd, offd + offd_nnz, real_t(0));
+   send_buf = 0.0;
+
+   // Contributions
+   const real_t *a_data = a.HostReadData();
+   for (int c = 0; c < c_src.Size(); c++)
+   {
+      Add(diag, offd, c_dst[c], c_coef[c]*a_data[c_src[c]]);
+   }
+
+   // Contributions to the rows owned by other processors
+   std::vector<MPI_Request> requests(recv_ranks.Size() + send_ranks.Size());
+   for (int r = 0; r < recv_ranks.Size(); r++)
+   {
+      MPI_Irecv(recv_buf.GetData() + recv_offsets[r],
+                recv_offsets[r+1] - recv_offsets[r], MFEM_MPI_REAL_T,
+                recv_ranks[r], tag, comm, &requests[r]);
+   }
+   for (int r = 0; r < send_ranks.Size(); r++)
+   {
+      MPI_Isend(send_buf.GetData() + send_offsets[r],
+                send_offsets[r+1] - send_offsets[r], MFEM_MPI_REAL_T,
+                send_ranks[r], tag, comm, &requests[recv_ranks.Size() + r]);
+   }
+   MPI_Waitall(int(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+   for (int e = 0; e < recv_dst.Size(); e++)
+   {
+      Add(diag, offd, recv_dst[e], recv_buf(e));
+   }
+
+   // Elimination: the eliminated values are moved to Ae, and the diagonal
+   // entries of the eliminated rows are set to one
+   hypre_CSRMatrix *Ae_diag = hypre_ParCSRMatrixDiag(Ae_par);
+   hypre_CSRMatrix *Ae_offd = hypre_ParCSRMatrixOffd(Ae_par);
+   int e = 0;
+   for (int b = 0; b < 2; b++)
+   {
+      hypre_CSRMatrix *blk = b ? Ae_offd : Ae_diag;
+      const HYPRE_Int *I = hypre_CSRMatrixI(blk);
+      if (!I) { continue; }
+      const HYPRE_Int *J = hypre_CSRMatrixJ(blk);
+      real_t *Ae_data = hypre_CSRMatrixData(blk);
+      for (int i = 0; i < hypre_CSRMatrixNumRows(blk); i++)
+      {
+         for (HYPRE_Int m = I[i]; m < I[i+1]; m++, e++)
+         {
+            const int dst = elim_dst[e];
+            real_t &a_ij = (dst < diag_nnz) ? diag[dst] : offd[dst - diag_nnz];
+            const real_t d = (!b && J[m] == i) ? 1.0 : 0.0;
+            Ae_data[m] = a_ij - d;
+            a_ij = d;
+         }
+      }
+   }
+}
+
+void ParBilinearForm::ResetReassembly()
+{
+   delete p_reassembly;
+   p_reassembly = NULL;
+}
+
+ParBilinearForm::~ParBilinearForm()
+{
+   delete p_reassembly;
+}
+
+void ParBilinearForm::ReassembleValues(int skip_zeros)
+{
+   if (ext)
+   {
+      BilinearForm::ReassembleValues(skip_zeros);
+      return;
+   }
+
+   MFEM_VERIFY(!static_cond && !hybridization, "static condensation and "
+               "hybridization are not supported by ReassembleValues()");
+   MFEM_VERIFY(p_mat.Ptr() != NULL, "FormSystemMatrix() must be called "
+               "before ReassembleValues()");
+   MFEM_VERIFY(p_mat.Type() == Operator::Hypre_ParCSR,
+               "only Operator::Hypre_ParCSR is supported");
+
+   // The local matrix was deleted by the first FormSystemMatrix(): it is
+   // allocated once more here, and then kept
+   if (mat) { *mat = 0.0; }
+   Assemble(skip_zeros);
+   const int remove_zeros = 0;
+   Finalize(remove_zeros);
+   keep_local_mat = true;
+
+   HypreParMatrix &A = *p_mat.As<HypreParMatrix>();
+   if (interior_face_integs.Size() == 0)
+   {
+      if (!p_reassembly)
+      {
+         p_reassembly = new ParallelReassembly(
+            *mat, *pfes->Dof_TrueDof_Matrix(), A,
+            *p_mat_e.As<HypreParMatrix>());
+      }
+      p_reassembly->Assemble(*mat, A, *p_mat_e.As<HypreParMatrix>());
+      return;
+   }
+
+   // With interior face integrators, the local matrix has columns for the
+   // face-neighbor dofs: assemble the parallel matrix again
+   OperatorHandle A_new(Operator::Hypre_ParCSR);
+   ParallelAssemble(A_new, mat);
+
+   // The parallel matrix has the same structure as the first one (including
+   // the eliminated entries, which are kept as zeros), copy its values
+   HypreParMatrix &B = *A_new.As<HypreParMatrix>();
+   A.HostReadWrite();
+   B.HostRead();
+   hypre_ParCSRMatrix *a = A, *b = B;
+   hypre_CSRMatrix *a_blocks[2] = { hypre_ParCSRMatrixDiag(a),
+                                    hypre_ParCSRMatrixOffd(a)
+                                  };
+   hypre_CSRMatrix *b_blocks[2] = { hypre_ParCSRMatrixDiag(b),
+                                    hypre_ParCSRMatrixOffd(b)
+                                  };
+   // Compare the full structure of the diagonal and off-diagonal blocks: the
+   // same number of nonzeros could still correspond to a different pattern
+   const int num_cols_offd = hypre_CSRMatrixNumCols(a_blocks[1]);
+   bool same = hypre_ParCSRMatrixNumCols(a) == hypre_ParCSRMatrixNumCols(b) &&
+               num_cols_offd == hypre_CSRMatrixNumCols(b_blocks[1]);
+   if (same && num_cols_offd > 0)
+   {
+      const HYPRE_BigInt *a_cmap = hypre_ParCSRMatrixColMapOffd(a);
+      same = std::equal(a_cmap, a_cmap + num_cols_offd,
+                        hypre_ParCSRMatrixColMapOffd(b));
+   }
+   for (int k = 0; k < 2 && same; k++)
+   {
+      const int nrows = hypre_CSRMatrixNumRows(a_blocks[k]);
+      const int nnz = hypre_CSRMatrixNumNonzeros(a_blocks[k]);
+      same = nrows == hypre_CSRMatrixNumRows(b_blocks[k]) &&
+             nnz == hypre_CSRMatrixNumNonzeros(b_blocks[k]);
+      if (!same) { break; }
+      const HYPRE_Int *a_I = hypre_CSRMatrixI(a_blocks[k]);
+      const HYPRE_Int *a_J = hypre_CSRMatrixJ(a_blocks[k]);
+      same = std::equal(a_I, a_I + nrows + 1, hypre_CSRMatrixI(b_blocks[k])) &&
+             std::equal(a_J, a_J + nnz, hypre_CSRMatrixJ(b_blocks[k]));
+   }
+   MFEM_VERIFY(same, "the sparsity pattern of the parallel matrix changed");
+   for (int k = 0; k < 2; k++)
+   {
+      const int nnz = hypre_CSRMatrixNumNonzeros(a_blocks[k]);
+      const real_t *b_data = hypre_CSRMatrixData(b_blocks[k]);
+      std::copy(b_data, b_data + nnz, hypre_CSRMatrixData(a_blocks[k]));
+   }
+   A_new.Clear();
+
+   p_mat_e.EliminateRowsCols(p_mat, p_ess_tdof_list);
+}
+
 void ParBilinearForm::AssembleDiagonal(Vector &diag) const
 {
    MFEM_ASSERT(diag.Size() == fes->GetTrueVSize(),
@@ -376,7 +826,7 @@ real_t ParBilinearForm::ParInnerProduct(const ParGridFunction &x,
    real_t loc = InnerProduct(x, y);
    real_t glob = 0.;
 
-   MPI_Allreduce(&loc, &glob, 1, MPITypeMap<real_t>::mpi_type, MPI_SUM,
+   MPI_Allreduce(&loc, &glob, 1, MFEM_MPI_REAL_T, MPI_SUM,
                  pfes->GetComm());
 
    return glob;
@@ -513,19 +963,32 @@ void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
    }
    else
    {
-      if (mat)
+      if (mat && !keep_local_mat)
       {
          const int remove_zeros = 0;
          Finalize(remove_zeros);
          MFEM_VERIFY(p_mat.Ptr() == NULL && p_mat_e.Ptr() == NULL,
                      "The ParBilinearForm must be updated with Update() before "
                      "re-assembling the ParBilinearForm.");
+         ResetReassembly();
          ParallelAssemble(p_mat, mat);
          delete mat;
          mat = NULL;
          delete mat_e;
          mat_e = NULL;
          p_mat_e.EliminateRowsCols(p_mat, ess_tdof_list);
+         ess_tdof_list.Copy(p_ess_tdof_list);
+      }
+      else if (mat && ess_tdof_list != p_ess_tdof_list)
+      {
+         // The local matrix was kept by ReassembleValues() and the essential
+         // true dofs changed: eliminate them from a new parallel matrix
+         ResetReassembly();
+         p_mat.Clear();
+         p_mat_e.Clear();
+         ParallelAssemble(p_mat, mat);
+         p_mat_e.EliminateRowsCols(p_mat, ess_tdof_list);
+         ess_tdof_list.Copy(p_ess_tdof_list);
       }
       if (hybridization)
       {
@@ -583,8 +1046,11 @@ void ParBilinearForm::Update(FiniteElementSpace *nfes)
       MFEM_VERIFY(pfes != NULL, "nfes must be a ParFiniteElementSpace!");
    }
 
+   ResetReassembly();
    p_mat.Clear();
    p_mat_e.Clear();
+   p_ess_tdof_list.DeleteAll();
+   keep_local_mat = false;
 }
 
 
@@ -38,6 +38,20 @@ protected:
 
    bool keep_nbr_block;
 
+   /// Essential true dofs eliminated from #p_mat, see ReassembleValues().
+   Array<int> p_ess_tdof_list;
+
+   /** Indicates if the local matrix is kept after FormSystemMatrix(), set by
+       ReassembleValues(). */
+   bool keep_local_mat = false;
+
+   /// Numeric-only assembly of #p_mat and #p_mat_e, see ReassembleValues().
+   class ParallelReassembly;
+   ParallelReassembly *p_reassembly = NULL;
+
+   /// Delete #p_reassembly, called when #p_mat or #p_mat_e are rebuilt.
+   void ResetReassembly();
+
    // Allocate mat - called when (mat == NULL && fbfi.Size() > 0)
    void pAllocMat();
 
@@ -90,6 +104,32 @@ public:
    /// Assemble the local matrix
    void Assemble(int skip_zeros = 1);
 
+   /** @brief Recompute the values of the parallel matrix returned by
+       FormSystemMatrix(), keeping its sparsity pattern.
+
+       FormSystemMatrix() must have been called before. The local matrix is
+       assembled again (with its sparsity pattern kept from the first call to
+       this method on), and the product P^T A P is computed directly into the
+       values of the existing HypreParMatrix. The essential true dofs of the
+       last FormSystemMatrix() call are then eliminated again, with the values
+       of the eliminated entries stored in the existing matrix used by
+       EliminateBC(). The destinations of the contributions of the local
+       matrix, and the positions of the eliminated entries, are computed on the
+       first call and reused by the next ones. The HypreParMatrix object and
+       its CSR structure are kept, so solvers and preconditioners using it can
+       be set up again with the same sparsity pattern. A subsequent call to
+       FormSystemMatrix() with different essential true dofs builds a new
+       HypreParMatrix.
+
+       With interior face integrators, the parallel matrix is assembled again
+       with ParallelAssemble() and its values are copied into the existing
+       HypreParMatrix.
+
+       Only the Operator::Hypre_ParCSR type is supported, without static
+       condensation or hybridization. With AssemblyLevel::FULL, this is
+       BilinearForm::ReassembleValues(). */
+   void ReassembleValues(int skip_zeros = 1) override;
+
    /** @brief Assemble the diagonal of the bilinear form into @a diag. Note that
        @a diag is a true-dof Vector.
 
@@ -240,7 +280,7 @@ public:
 
    void EliminateVDofsInRHS(const Array<int> &vdofs, const Vector &x, Vector &b);
 
-   virtual ~ParBilinearForm() { }
+   virtual ~ParBilinearForm();
 };
 
 /// Class for parallel bilinear form using different test and trial FE spaces.
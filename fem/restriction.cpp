@@ -166,9 +166,12 @@ void ElementRestriction::TAddMultTranspose(const Vector& x, Vector& y) const
          real_t dof_value = 0;
          for (int j = offset; j < next_offset; ++j)
          {
-            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
-            dof_value += ((d_indices[j] >= 0) ? d_x(idx_j % nd, c, idx_j / nd) :
-                          -d_x(idx_j % nd, c, idx_j / nd));
+            const int sidx_j = d_indices[j];  // signed
+            const bool plus = sidx_j >= 0;
+            const int idx_j = plus ? sidx_j : -1 - sidx_j;
+            const int e = idx_j / nd;
+            const real_t value = d_x(idx_j - e*nd, c, e);
+            dof_value += plus ? value : -value;
          }
          if (ADD) { d_y(t?c:i,t?i:c) += dof_value; }
          else { d_y(t?c:i,t?i:c) = dof_value; }
@@ -310,79 +313,120 @@ static MFEM_HOST_DEVICE int GetMinElt(const int *my_elts, const int nbElts,
    return min_el;
 }
 
-/** Returns the index where a non-zero entry should be added and increment the
-    number of non-zeros for the row i_L. */
-static MFEM_HOST_DEVICE int GetAndIncrementNnzIndex(const int i_L, int* I)
-{
-   int ind = AtomicAdd(I[i_L],1);
-   return ind;
-}
-
-int ElementRestriction::FillI(SparseMatrix &mat) const
-{
-   static constexpr int Max = MaxNbNbr;
-   const int all_dofs = ndofs;
-   const int vd = vdim;
-   const int elt_dofs = dof;
-   auto I = mat.ReadWriteI();
-   auto d_offsets = offsets.Read();
-   auto d_indices = indices.Read();
-   auto d_gather_map = gather_map.Read();
-   mfem::forall(vd*all_dofs+1, [=] MFEM_HOST_DEVICE (int i_L)
-   {
-      I[i_L] = 0;
-   });
-   mfem::forall(ne*elt_dofs, [=] MFEM_HOST_DEVICE (int l_dof)
-   {
-      const int e = l_dof/elt_dofs;
-      const int i = l_dof%elt_dofs;
-
-      int i_elts[Max];
-      const int i_gm = e*elt_dofs + i;
-      const int i_L = d_gather_map[i_gm];
-      const int i_offset = d_offsets[i_L];
-      const int i_next_offset = d_offsets[i_L+1];
-      const int i_nbElts = i_next_offset - i_offset;
-      MFEM_ASSERT_KERNEL(
-         i_nbElts <= Max,
-         "The connectivity of this mesh is beyond the max, increase the "
-         "MaxNbNbr variable to comply with your mesh.");
-      for (int e_i = 0; e_i < i_nbElts; ++e_i)
-      {
-         const int i_E = d_indices[i_offset+e_i];
-         i_elts[e_i] = i_E/elt_dofs;
-      }
+/** Decodes the signed index @a s_E of an E-vector dof into its element @a e and
+    its local index @a i_loc in the element, and returns its sign. */
+static MFEM_HOST_DEVICE real_t DecodeEDof(const int s_E, const int elt_dofs,
+                                          int &e, int &i_loc)
+{
+   const bool plus = s_E >= 0;
+   const int i_E = plus ? s_E : -1 - s_E;
+   e = i_E/elt_dofs;
+   i_loc = i_E%elt_dofs;
+   return plus ? 1.0 : -1.0;
+}
+
+/** Visits the non-zero entries of the row @a i_L of the matrix assembled from
+    the element matrices, in a fixed order. The function @a f is called with
+    the position of the entry in the row, its column, and the value
+    sum_e s_i s_j A_e(j,i) over the elements e sharing the dofs i_L and j_L.
+    This is used by one thread per row, so no atomic operation is needed. */
+template <int Max, typename F>
+static MFEM_HOST_DEVICE int ForallRowEntries(const int i_L, const int elt_dofs,
+                                             const int ne,
+                                             const int *d_offsets,
+                                             const int *d_indices,
+                                             const int *d_gather_map,
+                                             const real_t *d_ea, F &&f)
+{
+   int i_elts[Max];
+   int i_B[Max];
+   real_t i_S[Max];
+   const int i_offset = d_offsets[i_L];
+   const int i_nbElts = d_offsets[i_L+1] - i_offset;
+   MFEM_ASSERT_KERNEL(
+      i_nbElts <= Max,
+      "The connectivity of this mesh is beyond the max, increase the "
+      "MaxNbNbr variable to comply with your mesh.");
+   for (int e_i = 0; e_i < i_nbElts; ++e_i)
+   {
+      i_S[e_i] = DecodeEDof(d_indices[i_offset+e_i], elt_dofs,
+                            i_elts[e_i], i_B[e_i]);
+   }
+   const auto mat_ea = Reshape(d_ea, elt_dofs, elt_dofs, ne);
+   int nnz = 0;
+   for (int k = 0; k < i_nbElts; k++)
+   {
+      const int e = i_elts[k];
       for (int j = 0; j < elt_dofs; j++)
       {
-         const int j_gm = e*elt_dofs + j;
-         const int j_L = d_gather_map[j_gm];
+         const int sj_L = d_gather_map[e*elt_dofs + j];
+         const int j_L = (sj_L >= 0) ? sj_L : -1 - sj_L;
          const int j_offset = d_offsets[j_L];
-         const int j_next_offset = d_offsets[j_L+1];
-         const int j_nbElts = j_next_offset - j_offset;
+         const int j_nbElts = d_offsets[j_L+1] - j_offset;
          MFEM_ASSERT_KERNEL(
             j_nbElts <= Max,
             "The connectivity of this mesh is beyond the max, increase the "
             "MaxNbNbr variable to comply with your mesh.");
          if (i_nbElts == 1 || j_nbElts == 1) // no assembly required
          {
-            GetAndIncrementNnzIndex(i_L, I);
+            const real_t s_j = (sj_L >= 0) ? 1.0 : -1.0;
+            const real_t val = d_ea ? i_S[k]*s_j*mat_ea(j, i_B[k], e) : 0.0;
+            f(nnz++, j_L, val);
          }
          else // assembly required
          {
             int j_elts[Max];
+            int j_B[Max];
+            real_t j_S[Max];
             for (int e_j = 0; e_j < j_nbElts; ++e_j)
             {
-               const int j_E = d_indices[j_offset+e_j];
-               const int elt = j_E/elt_dofs;
-               j_elts[e_j] = elt;
+               j_S[e_j] = DecodeEDof(d_indices[j_offset+e_j], elt_dofs,
+                                     j_elts[e_j], j_B[e_j]);
             }
-            int min_e = GetMinElt(i_elts, i_nbElts, j_elts, j_nbElts);
-            if (e == min_e) // add the nnz only once
+            const int min_e = GetMinElt(i_elts, i_nbElts, j_elts, j_nbElts);
+            if (e != min_e) { continue; } // add the nnz only once
+            real_t val = 0.0;
+            if (d_ea)
             {
-               GetAndIncrementNnzIndex(i_L, I);
+               for (int m = 0; m < i_nbElts; m++)
+               {
+                  for (int l = 0; l < j_nbElts; l++)
+                  {
+                     if (i_elts[m] == j_elts[l])
+                     {
+                        val += i_S[m]*j_S[l]*mat_ea(j_B[l], i_B[m], i_elts[m]);
+                     }
+                  }
+               }
             }
+            f(nnz++, j_L, val);
          }
       }
+   }
+   return nnz;
+}
+
+int ElementRestriction::FillI(SparseMatrix &mat) const
+{
+   static constexpr int Max = MaxNbNbr;
+   const int all_dofs = ndofs;
+   const int vd = vdim;
+   const int elt_dofs = dof;
+   const int nE = ne;
+   auto I = mat.WriteI();
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_gather_map = gather_map.Read();
+   mfem::forall(vd*all_dofs+1, [=] MFEM_HOST_DEVICE (int i_L)
+   {
+      I[i_L] = 0;
+   });
+   // One thread per row: count the non-zeros without atomic operations
+   mfem::forall(all_dofs, [=] MFEM_HOST_DEVICE (int i_L)
+   {
+      I[i_L] = ForallRowEntries<Max>(i_L, elt_dofs, nE, d_offsets, d_indices,
+                                     d_gather_map, nullptr,
+                                     [](int, int, real_t) { });
    });
    // We need to sum the entries of I, we do it on CPU as it is very sequential.
    auto h_I = mat.HostReadWriteI();
@@ -404,95 +448,43 @@ void ElementRestriction::FillJAndData(const Vector &ea_data,
 {
    static constexpr int Max = MaxNbNbr;
    const int all_dofs = ndofs;
-   const int vd = vdim;
    const int elt_dofs = dof;
-   auto I = mat.ReadWriteI();
+   const int nE = ne;
+   auto I = mat.ReadI();
    auto J = mat.WriteJ();
    auto Data = mat.WriteData();
    auto d_offsets = offsets.Read();
    auto d_indices = indices.Read();
    auto d_gather_map = gather_map.Read();
-   auto mat_ea = Reshape(ea_data.Read(), elt_dofs, elt_dofs, ne);
-   mfem::forall(ne*elt_dofs, [=] MFEM_HOST_DEVICE (int l_dof)
-   {
-      const int e = l_dof/elt_dofs;
-      const int i = l_dof%elt_dofs;
-
-      int i_elts[Max];
-      int i_B[Max];
-      const int i_gm = e*elt_dofs + i;
-      const int i_L = d_gather_map[i_gm];
-      const int i_offset = d_offsets[i_L];
-      const int i_next_offset = d_offsets[i_L+1];
-      const int i_nbElts = i_next_offset - i_offset;
-      MFEM_ASSERT_KERNEL(
-         i_nbElts <= Max,
-         "The connectivity of this mesh is beyond the max, increase the "
-         "MaxNbNbr variable to comply with your mesh.");
-      for (int e_i = 0; e_i < i_nbElts; ++e_i)
+   auto d_ea = ea_data.Read();
+   // One thread per row: the entries of the row are written directly at their
+   // final position in J and Data, then sorted by column index
+   mfem::forall(all_dofs, [=] MFEM_HOST_DEVICE (int i_L)
+   {
+      const int row = I[i_L];
+      const int nnz = ForallRowEntries<Max>(
+                         i_L, elt_dofs, nE, d_offsets, d_indices, d_gather_map,
+                         d_ea,
+                         [=](int k, int j_L, real_t val)
       {
-         const int i_E = d_indices[i_offset+e_i];
-         i_elts[e_i] = i_E/elt_dofs;
-         i_B[e_i]    = i_E%elt_dofs;
-      }
-      for (int j = 0; j < elt_dofs; j++)
+         J[row + k] = j_L;
+         Data[row + k] = val;
+      });
+      // Insertion sort, the rows are short and partially sorted
+      for (int k = row + 1; k < row + nnz; k++)
       {
-         const int j_gm = e*elt_dofs + j;
-         const int j_L = d_gather_map[j_gm];
-         const int j_offset = d_offsets[j_L];
-         const int j_next_offset = d_offsets[j_L+1];
-         const int j_nbElts = j_next_offset - j_offset;
-         if (i_nbElts == 1 || j_nbElts == 1) // no assembly required
+         const int j_L = J[k];
+         const real_t val = Data[k];
+         int l = k - 1;
+         for (; l >= row && J[l] > j_L; l--)
          {
-            const int nnz = GetAndIncrementNnzIndex(i_L, I);
-            J[nnz] = j_L;
-            Data[nnz] = mat_ea(j,i,e);
-         }
-         else // assembly required
-         {
-            int j_elts[Max];
-            int j_B[Max];
-            for (int e_j = 0; e_j < j_nbElts; ++e_j)
-            {
-               const int j_E = d_indices[j_offset+e_j];
-               const int elt = j_E/elt_dofs;
-               j_elts[e_j] = elt;
-               j_B[e_j]    = j_E%elt_dofs;
-            }
-            int min_e = GetMinElt(i_elts, i_nbElts, j_elts, j_nbElts);
-            if (e == min_e) // add the nnz only once
-            {
-               real_t val = 0.0;
-               for (int k = 0; k < i_nbElts; k++)
-               {
-                  const int e_i = i_elts[k];
-                  const int i_Bloc = i_B[k];
-                  for (int l = 0; l < j_nbElts; l++)
-                  {
-                     const int e_j = j_elts[l];
-                     const int j_Bloc = j_B[l];
-                     if (e_i == e_j)
-                     {
-                        val += mat_ea(j_Bloc, i_Bloc, e_i);
-                     }
-                  }
-               }
-               const int nnz = GetAndIncrementNnzIndex(i_L, I);
-               J[nnz] = j_L;
-               Data[nnz] = val;
-            }
+            J[l+1] = J[l];
+            Data[l+1] = Data[l];
          }
+         J[l+1] = j_L;
+         Data[l+1] = val;
       }
    });
-   // We need to shift again the entries of I, we do it on CPU as it is very
-   // sequential.
-   auto h_I = mat.HostReadWriteI();
-   const int size = vd*all_dofs;
-   for (int i = 0; i < size; i++)
-   {
-      h_I[size-i] = h_I[size-(i+1)];
-   }
-   h_I[0] = 0;
 }
 
 L2ElementRestriction::L2ElementRestriction(const FiniteElementSpace &fes)
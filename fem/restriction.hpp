@@ -84,10 +84,16 @@ public:
    void FillSparseMatrix(const Vector &mat_ea, SparseMatrix &mat) const;
 
    /** Fill the I array of SparseMatrix corresponding to the sparsity pattern
-       given by this ElementRestriction. */
+       given by this ElementRestriction. The rows are counted in parallel, one
+       thread per row, without atomic operations. */
    int FillI(SparseMatrix &mat) const;
    /** Fill the J and Data arrays of SparseMatrix corresponding to the sparsity
-       pattern given by this ElementRestriction, and the values of ea_data. */
+       pattern given by this ElementRestriction, and the values of ea_data.
+
+       The I array must have been filled with FillI(). It is not modified, so
+       this method can be called again to update the values of the matrix
+       with new element matrices. Each row is filled by one thread, directly
+       at its final position, and the column indices are sorted. */
    void FillJAndData(const Vector &ea_data, SparseMatrix &mat) const;
    /// @private Not part of the public interface (device kernel limitation).
    ///
@@ -0,0 +1,64 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BFLOAT16_HPP
+#define MFEM_BFLOAT16_HPP
+
+#include "../config/config.hpp"
+#include "backends.hpp"
+#include <cstdint>
+#include <cstring>
+
+namespace mfem
+{
+
+/** @brief Storage type for "brain floating point" numbers: the 16 most
+    significant bits of an IEEE single precision number (8 exponent bits and 7
+    mantissa bits).
+
+    This type is meant for reduced precision storage only: values are
+    converted to and from real_t, and all arithmetic is performed in real_t. */
+struct bfloat16
+{
+   uint16_t bits;
+
+   bfloat16() = default;
+
+   /// Convert @a x to the nearest bfloat16 number (ties to even).
+   MFEM_HOST_DEVICE explicit bfloat16(real_t x)
+   {
+      const float f = static_cast<float>(x);
+      uint32_t u;
+      memcpy(&u, &f, sizeof(u));
+      if ((u & 0x7fffffffu) > 0x7f800000u) // NaN: keep it a quiet NaN
+      {
+         bits = static_cast<uint16_t>((u >> 16) | 0x0040u);
+      }
+      else
+      {
+         u += 0x7fffu + ((u >> 16) & 1u);
+         bits = static_cast<uint16_t>(u >> 16);
+      }
+   }
+
+   /// Convert to real_t (exact).
+   MFEM_HOST_DEVICE operator real_t() const
+   {
+      const uint32_t u = static_cast<uint32_t>(bits) << 16;
+      float f;
+      memcpy(&f, &u, sizeof(f));
+      return static_cast<real_t>(f);
+   }
+};
+
+} // namespace mfem
+
+#endif
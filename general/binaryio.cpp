@@ -100,6 +100,42 @@ void DecodeBase64(const char *src, size_t len, std::vector<char> &buf)
    buf.resize(out - (unsigned char *)buf.data());
 }
 
+bool IsBase64Char(char c)
+{
+   return b64table[(unsigned char)c] != 255;
+}
+
+size_t DecodeBase64Groups(const char *src, size_t nchars, char *dest)
+{
+   const unsigned char *in = (const unsigned char *)src;
+   unsigned char *out = (unsigned char *)dest;
+   const long long ngroups = nchars/4;
+   long long npadded = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for reduction(+:npadded)
+#endif
+   for (long long g = 0; g < ngroups; g++)
+   {
+      const unsigned char *c = in + 4*g;
+      const unsigned char c0 = b64table[c[0]], c1 = b64table[c[1]];
+      const unsigned char c2 = b64table[c[2]], c3 = b64table[c[3]];
+      out[3*g] = (c0 << 2) | (c1 >> 4);
+      out[3*g+1] = (c1 << 4) | (c2 >> 2);
+      out[3*g+2] = (c2 << 6) | c3;
+      if (c[3] == '=') { npadded++; }
+   }
+   if (npadded == 0) { return 3*ngroups; }
+
+   // Remove the padded bytes, which can only be at the end of a block
+   size_t nbytes = 0;
+   for (long long g = 0; g < ngroups; g++)
+   {
+      const int pad = (in[4*g+3] == '=') + (in[4*g+2] == '=');
+      for (int k = 0; k < 3 - pad; k++) { out[nbytes++] = out[3*g+k]; }
+   }
+   return nbytes;
+}
+
 size_t NumBase64Chars(size_t nbytes) { return ((4*nbytes/3) + 3) & ~3; }
 
 } // namespace mfem::bin_io
@@ -67,6 +67,20 @@ void WriteBase64(std::ostream &out, const void *bytes, size_t nbytes);
 /// needed.
 void DecodeBase64(const char *src, size_t len, std::vector<char> &buf);
 
+/// @brief Return true if @a c belongs to the base-64 alphabet, including the
+/// padding character '='.
+bool IsBase64Char(char c);
+
+/// @brief Decode the @a nchars base-64 characters in the buffer @a src into the
+/// buffer @a dest, and return the number of decoded bytes.
+///
+/// Unlike DecodeBase64(), all characters must belong to the base-64 alphabet
+/// and @a nchars must be a multiple of 4; @a dest must have room for 3*nchars/4
+/// bytes. Padded groups of four characters may appear anywhere in @a src, as in
+/// a sequence of separately encoded blocks. With OpenMP, the groups are decoded
+/// in parallel.
+size_t DecodeBase64Groups(const char *src, size_t nchars, char *dest);
+
 /// @brief Return the number of characters needed to encode @a nbytes in
 /// base-64.
 ///
@@ -0,0 +1,588 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "amg.hpp"
+#include "solvers.hpp"
+#include "../general/forall.hpp"
+#include "../fem/multigrid.hpp"
+#include "../fem/gridfunc.hpp"
+#include <cmath>
+#include <iomanip>
+
+namespace mfem
+{
+
+// Coarsest levels up to this size are solved with a dense LU factorization,
+// larger ones (if the coarsening stops early) with the Chebyshev smoother.
+static const int amg_max_dense_size = 1000;
+
+// Index of the unknown @a c of the node @a node
+static MFEM_HOST_DEVICE inline
+int AMGNodeDof(int node, int c, int nf, int nn, bool bynodes)
+{
+   return bynodes ? c*nn + node : node*nf + c;
+}
+
+// Node of the unknown @a dof
+static MFEM_HOST_DEVICE inline
+int AMGDofNode(int dof, int nf, int nn, bool bynodes)
+{
+   return bynodes ? dof % nn : dof / nf;
+}
+
+// Index of the local row @a r of the aggregate whose nodes start at @a nodes
+static MFEM_HOST_DEVICE inline
+int AMGAggDof(int r, const int *nodes, int nf, int nn, bool bynodes)
+{
+   return AMGNodeDof(nodes[r/nf], r%nf, nf, nn, bynodes);
+}
+
+// Estimate of the largest eigenvalue of D^{-1} A, where D is the diagonal @a d
+static real_t AMGSpectralRadius(const SparseMatrix &A, const Vector &d)
+{
+   Array<int> no_ess_tdofs;
+   OperatorJacobiSmoother invD(d, no_ess_tdofs, 1.0);
+   ProductOperator DA(&invD, &A, false, false);
+   PowerMethod power_method;
+   Vector v(A.Height());
+   return power_method.EstimateLargestEigenvalue(DA, v, 20, 1e-3);
+}
+
+SmoothedAggregationAMG::SmoothedAggregationAMG()
+   : Solver(),
+     num_functions(1),
+     order_bynodes(false),
+     fespace(NULL),
+     strength_threshold(0.08),
+     smoother_order(2),
+     max_coarse_size(100),
+     max_levels(25),
+     use_w_cycle(false),
+     print_level(0),
+     mg(NULL)
+{ }
+
+SmoothedAggregationAMG::SmoothedAggregationAMG(const SparseMatrix &A)
+   : SmoothedAggregationAMG()
+{
+   SetOperator(A);
+}
+
+SmoothedAggregationAMG::~SmoothedAggregationAMG()
+{
+   Clear();
+}
+
+void SmoothedAggregationAMG::Clear()
+{
+   // The smoothers reference the matrices and the diagonals
+   delete mg;
+   mg = NULL;
+   for (int l = 1; l < matrices.Size(); l++) { delete matrices[l]; }
+   matrices.SetSize(0);
+   for (int l = 0; l < diagonals.Size(); l++) { delete diagonals[l]; }
+   diagonals.SetSize(0);
+}
+
+void SmoothedAggregationAMG::SetSystemsOptions(int dim, bool order_bynodes_)
+{
+   MFEM_VERIFY(dim > 0, "invalid number of unknowns per node: " << dim);
+   num_functions = dim;
+   order_bynodes = order_bynodes_;
+}
+
+void SmoothedAggregationAMG::SetNearNullspace(const DenseMatrix &B)
+{
+   user_nullspace = B;
+   fespace = NULL;
+}
+
+void SmoothedAggregationAMG::SetElasticityOptions(FiniteElementSpace *fespace_)
+{
+   fespace = fespace_;
+   SetSystemsOptions(fespace->GetVDim(),
+                     fespace->GetOrdering() == Ordering::byNODES);
+}
+
+void SmoothedAggregationAMG::ComputeRigidBodyModes(DenseMatrix &B) const
+{
+   const int dim = fespace->GetVDim();
+   MFEM_VERIFY(dim == fespace->GetMesh()->SpaceDimension(),
+               "the vector dimension of the space must be the space dimension");
+
+   // The translations, followed by the rotations in the planes (0,1), (1,2)
+   // and (2,0)
+   const int nmodes = dim*(dim+1)/2;
+   B.SetSize(fespace->GetTrueVSize(), nmodes);
+   GridFunction mode(fespace);
+   Vector tmode;
+   for (int k = 0; k < nmodes; k++)
+   {
+      VectorFunctionCoefficient coeff(dim, [=](const Vector &x, Vector &v)
+      {
+         v = 0.0;
+         if (k < dim)
+         {
+            v(k) = 1.0;
+         }
+         else
+         {
+            const int i = k - dim, j = (i + 1) % dim;
+            v(i) = -x(j);
+            v(j) = x(i);
+         }
+      });
+      mode.ProjectCoefficient(coeff);
+      mode.GetTrueDofs(tmode);
+      B.SetCol(k, tmode);
+   }
+}
+
+int SmoothedAggregationAMG::Aggregate(const SparseMatrix &A, int nf,
+                                      bool bynodes, Array<int> &agg) const
+{
+   const int n = A.Height(), nn = n/nf;
+   MFEM_VERIFY(nn*nf == n, "the number of unknowns per node, " << nf
+               << ", does not divide the size of the matrix, " << n);
+
+   // Connections between the nodes: the matrix itself for scalar problems,
+   // otherwise the Frobenius norms of the nodal blocks, E^T (A.*A) E where E
+   // maps the unknowns to their nodes.
+   const SparseMatrix *N = &A;
+   SparseMatrix *N_owned = NULL;
+   if (nf > 1)
+   {
+      SparseMatrix A2(A);
+      const int nnz = A2.NumNonZeroElems();
+      real_t *d_A2 = A2.ReadWriteData();
+      mfem::forall(nnz, [=] MFEM_HOST_DEVICE (int k)
+      {
+         d_A2[k] = d_A2[k]*d_A2[k];
+      });
+
+      SparseMatrix E(n, nn, 1);
+      int *d_EJ = E.WriteJ();
+      real_t *d_E = E.WriteData();
+      mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+      {
+         d_EJ[i] = AMGDofNode(i, nf, nn, bynodes);
+         d_E[i] = 1.0;
+      });
+
+      SparseMatrix *Et = Transpose(E);
+      SparseMatrix *A2E = mfem::Mult(A2, E);
+      N_owned = mfem::Mult(*Et, *A2E);
+      delete A2E;
+      delete Et;
+
+      const int nnz_N = N_owned->NumNonZeroElems();
+      real_t *d_N = N_owned->ReadWriteData();
+      mfem::forall(nnz_N, [=] MFEM_HOST_DEVICE (int k)
+      {
+         d_N[k] = sqrt(d_N[k]);
+      });
+      N = N_owned;
+   }
+
+   // Strong connections: |n_ij| >= theta sqrt(|n_ii n_jj|)
+   const int *d_I = N->ReadI();
+   const int *d_J = N->ReadJ();
+   const real_t *d_N = N->ReadData();
+   Vector diag(nn);
+   real_t *d_diag = diag.Write();
+   mfem::forall(nn, [=] MFEM_HOST_DEVICE (int i)
+   {
+      d_diag[i] = 0.0;
+      for (int k = d_I[i]; k < d_I[i+1]; k++)
+      {
+         if (d_J[k] == i) { d_diag[i] = fabs(d_N[k]); }
+      }
+   });
+   const real_t theta = strength_threshold;
+   Array<int> S_I(nn+1);
+   int *d_SI = S_I.Write();
+   const real_t *d_d = diag.Read();
+   mfem::forall(nn, [=] MFEM_HOST_DEVICE (int i)
+   {
+      int count = 0;
+      for (int k = d_I[i]; k < d_I[i+1]; k++)
+      {
+         const int j = d_J[k];
+         const real_t a = fabs(d_N[k]);
+         if (j != i && a > 0.0 && a >= theta*sqrt(d_d[i]*d_d[j]))
+         {
+            count++;
+         }
+      }
+      d_SI[i+1] = count;
+      if (i == 0) { d_SI[0] = 0; }
+   });
+   S_I.HostReadWrite();
+   S_I.PartialSum();
+   Array<int> S_J(S_I[nn]);
+   const int *d_SIr = S_I.Read();
+   int *d_SJ = S_J.Write();
+   mfem::forall(nn, [=] MFEM_HOST_DEVICE (int i)
+   {
+      int s = d_SIr[i];
+      for (int k = d_I[i]; k < d_I[i+1]; k++)
+      {
+         const int j = d_J[k];
+         const real_t a = fabs(d_N[k]);
+         if (j != i && a > 0.0 && a >= theta*sqrt(d_d[i]*d_d[j]))
+         {
+            d_SJ[s++] = j;
+         }
+      }
+   });
+   delete N_owned;
+
+   // Greedy aggregation, see Vanek, Mandel and Brezina, "Algebraic multigrid
+   // by smoothed aggregation for second and fourth order elliptic problems",
+   // Computing 56 (1996). Nodes without strong connections, e.g. eliminated
+   // essential dofs, are not aggregated.
+   const int *SI = S_I.HostRead(), *SJ = S_J.HostRead();
+   const int unassigned = -2;
+   agg.SetSize(nn);
+   for (int i = 0; i < nn; i++)
+   {
+      agg[i] = (SI[i] == SI[i+1]) ? -1 : unassigned;
+   }
+   // 1. Aggregates of the nodes whose neighbors are all unassigned
+   int nagg = 0;
+   for (int i = 0; i < nn; i++)
+   {
+      if (agg[i] != unassigned) { continue; }
+      bool free = true;
+      for (int k = SI[i]; k < SI[i+1] && free; k++)
+      {
+         free = (agg[SJ[k]] == unassigned);
+      }
+      if (!free) { continue; }
+      agg[i] = nagg;
+      for (int k = SI[i]; k < SI[i+1]; k++) { agg[SJ[k]] = nagg; }
+      nagg++;
+   }
+   // 2. Add the remaining nodes to a neighboring aggregate from step 1
+   Array<int> agg1(agg);
+   for (int i = 0; i < nn; i++)
+   {
+      if (agg[i] != unassigned) { continue; }
+      for (int k = SI[i]; k < SI[i+1]; k++)
+      {
+         if (agg1[SJ[k]] >= 0) { agg[i] = agg1[SJ[k]]; break; }
+      }
+   }
+   // 3. Aggregate the nodes that are still unassigned with their unassigned
+   //    neighbors
+   for (int i = 0; i < nn; i++)
+   {
+      if (agg[i] != unassigned) { continue; }
+      agg[i] = nagg;
+      for (int k = SI[i]; k < SI[i+1]; k++)
+      {
+         if (agg[SJ[k]] == unassigned) { agg[SJ[k]] = nagg; }
+      }
+      nagg++;
+   }
+   return nagg;
+}
+
+SparseMatrix *SmoothedAggregationAMG::TentativeProlongator(
+   int nf, bool bynodes, const Array<int> &agg, int nagg, const DenseMatrix &B,
+   DenseMatrix &Bc)
+{
+   const int nn = agg.Size(), n = nn*nf, nns = B.Width(), nc = nagg*nns;
+   MFEM_VERIFY(B.Height() == n, "invalid near-nullspace size: " << B.Height()
+               << ", expected " << n);
+
+   // Nodes of each aggregate
+   Array<int> agg_ptr(nagg+1), agg_nodes;
+   agg_ptr = 0;
+   for (int i = 0; i < nn; i++)
+   {
+      if (agg[i] >= 0) { agg_ptr[agg[i]+1]++; }
+   }
+   agg_ptr.PartialSum();
+   agg_nodes.SetSize(agg_ptr[nagg]);
+   for (int i = 0; i < nn; i++)
+   {
+      if (agg[i] >= 0) { agg_nodes[agg_ptr[agg[i]]++] = i; }
+   }
+   for (int a = nagg; a > 0; a--) { agg_ptr[a] = agg_ptr[a-1]; }
+   agg_ptr[0] = 0;
+
+   // The rows of the aggregated unknowns have nns entries, the columns of the
+   // coarse unknowns of their aggregate
+   int *I = new int[n+1];
+   I[0] = 0;
+   for (int dof = 0; dof < n; dof++)
+   {
+      const bool aggregated = agg[AMGDofNode(dof, nf, nn, bynodes)] >= 0;
+      I[dof+1] = I[dof] + (aggregated ? nns : 0);
+   }
+   int *J = new int[I[n]];
+   SparseMatrix *P = new SparseMatrix(I, J, NULL, n, nc, true, true, true);
+
+   const int *d_agg = agg.Read();
+   const int *d_I = P->ReadI();
+   int *d_J = P->WriteJ();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int dof)
+   {
+      const int a = d_agg[AMGDofNode(dof, nf, nn, bynodes)];
+      for (int k = 0; k < d_I[dof+1] - d_I[dof]; k++)
+      {
+         d_J[d_I[dof] + k] = a*nns + k;
+      }
+   });
+
+   // QR factorizations of the near-nullspace restricted to the aggregates,
+   // by modified Gram-Schmidt: Q gives the values of P and R the coarse
+   // near-nullspace. Linearly dependent columns, e.g. in aggregates with
+   // fewer unknowns than nns, are set to zero.
+   Bc.SetSize(nc, nns);
+   const int *d_ptr = agg_ptr.Read();
+   const int *d_nodes = agg_nodes.Read();
+   const real_t *d_B = B.Read();
+   real_t *d_P = P->WriteData();
+   real_t *d_Bc = Bc.Write();
+   mfem::forall(nagg, [=] MFEM_HOST_DEVICE (int a)
+   {
+      const int beg = d_ptr[a], m = (d_ptr[a+1] - beg)*nf;
+      const int *nodes = d_nodes + beg;
+      for (int k = 0; k < nns; k++)
+      {
+         for (int r = 0; r < m; r++)
+         {
+            const int dof = AMGAggDof(r, nodes, nf, nn, bynodes);
+            d_P[d_I[dof] + k] = d_B[dof + k*n];
+         }
+      }
+      for (int k = 0; k < nns; k++)
+      {
+         real_t norm0 = 0.0;
+         for (int r = 0; r < m; r++)
+         {
+            const real_t q = d_P[d_I[AMGAggDof(r, nodes, nf, nn, bynodes)] + k];
+            norm0 += q*q;
+         }
+         for (int j = 0; j < k; j++)
+         {
+            real_t dot = 0.0;
+            for (int r = 0; r < m; r++)
+            {
+               const int o = d_I[AMGAggDof(r, nodes, nf, nn, bynodes)];
+               dot += d_P[o + j]*d_P[o + k];
+            }
+            for (int r = 0; r < m; r++)
+            {
+               const int o = d_I[AMGAggDof(r, nodes, nf, nn, bynodes)];
+               d_P[o + k] -= dot*d_P[o + j];
+            }
+            d_Bc[a*nns + j + k*nc] = dot;
+         }
+         real_t norm = 0.0;
+         for (int r = 0; r < m; r++)
+         {
+            const real_t q = d_P[d_I[AMGAggDof(r, nodes, nf, nn, bynodes)] + k];
+            norm += q*q;
+         }
+         norm = (norm > 1e-20*norm0) ? sqrt(norm) : 0.0;
+         const real_t scale = (norm > 0.0) ? 1.0/norm : 0.0;
+         for (int r = 0; r < m; r++)
+         {
+            d_P[d_I[AMGAggDof(r, nodes, nf, nn, bynodes)] + k] *= scale;
+         }
+         d_Bc[a*nns + k + k*nc] = norm;
+         for (int j = k+1; j < nns; j++) { d_Bc[a*nns + j + k*nc] = 0.0; }
+      }
+   });
+   return P;
+}
+
+void SmoothedAggregationAMG::SetOperator(const Operator &op)
+{
+   const SparseMatrix *A = dynamic_cast<const SparseMatrix*>(&op);
+   MFEM_VERIFY(A != NULL, "SmoothedAggregationAMG requires a SparseMatrix");
+   MFEM_VERIFY(A->Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(A->Height() == A->Width(), "the matrix must be square");
+
+   Clear();
+   height = width = A->Height();
+
+   // Near-nullspace of the finest level
+   int nf = num_functions;
+   bool bynodes = order_bynodes;
+   DenseMatrix B;
+   if (fespace)
+   {
+      ComputeRigidBodyModes(B);
+   }
+   else if (user_nullspace.Width() > 0)
+   {
+      B = user_nullspace;
+   }
+   else
+   {
+      // The constant vector of each component
+      const int n = height, nn = n/nf;
+      B.SetSize(n, nf);
+      real_t *d_B = B.Write();
+      mfem::forall(n, [=] MFEM_HOST_DEVICE (int dof)
+      {
+         const int c = bynodes ? dof/nn : dof%nf;
+         for (int k = 0; k < nf; k++) { d_B[dof + k*n] = (k == c) ? 1.0 : 0.0; }
+      });
+   }
+   MFEM_VERIFY(B.Height() == height, "invalid near-nullspace size: "
+               << B.Height() << ", expected " << height);
+
+   Array<Solver*> smoothers;
+   Array<Operator*> prolongations;
+   matrices.Append(const_cast<SparseMatrix*>(A));
+   while (matrices.Size() < max_levels &&
+          matrices.Last()->Height() > max_coarse_size)
+   {
+      const SparseMatrix &Al = *matrices.Last();
+      Array<int> agg;
+      const int nagg = Aggregate(Al, nf, bynodes, agg);
+      if (nagg == 0 || nagg*B.Width() >= Al.Height()) { break; }
+
+      DenseMatrix Bc;
+      SparseMatrix *Pt = TentativeProlongator(nf, bynodes, agg, nagg, B, Bc);
+
+      // Smoothed prolongator P = (I - omega D^{-1} A) Pt with
+      // omega = 4/(3 rho(D^{-1} A))
+      Vector *diag = new Vector;
+      Al.GetDiag(*diag);
+      diagonals.Append(diag);
+      const real_t rho = AMGSpectralRadius(Al, *diag);
+      SparseMatrix *APt = mfem::Mult(Al, *Pt);
+      {
+         const int *d_I = APt->ReadI();
+         const real_t *d_diag = diag->Read();
+         real_t *d_APt = APt->ReadWriteData();
+         mfem::forall(Al.Height(), [=] MFEM_HOST_DEVICE (int i)
+         {
+            const real_t s = (d_diag[i] != 0.0) ? 1.0/d_diag[i] : 0.0;
+            for (int k = d_I[i]; k < d_I[i+1]; k++) { d_APt[k] *= s; }
+         });
+      }
+      SparseMatrix *P = Add(1.0, *Pt, -4.0/(3.0*rho), *APt);
+      delete APt;
+      delete Pt;
+
+      // Galerkin coarse operator. Coarse unknowns corresponding to the zero
+      // columns of the tentative prolongator are decoupled by setting their
+      // (zero) diagonal entries to one.
+      SparseMatrix *R = Transpose(*P);
+      SparseMatrix *AP = mfem::Mult(Al, *P);
+      SparseMatrix *Ac = mfem::Mult(*R, *AP);
+      delete AP;
+      delete R;
+      {
+         const int *d_I = Ac->ReadI();
+         const int *d_J = Ac->ReadJ();
+         real_t *d_Ac = Ac->ReadWriteData();
+         mfem::forall(Ac->Height(), [=] MFEM_HOST_DEVICE (int i)
+         {
+            for (int k = d_I[i]; k < d_I[i+1]; k++)
+            {
+               if (d_J[k] == i && d_Ac[k] == 0.0) { d_Ac[k] = 1.0; }
+            }
+         });
+      }
+
+      smoothers.Append(new OperatorChebyshevSmoother(Al, *diag, no_ess_tdofs,
+                                                     smoother_order, rho));
+      prolongations.Append(P);
+      matrices.Append(Ac);
+      B.Swap(Bc);
+      nf = B.Width();
+      bynodes = false;
+   }
+
+   // Coarsest level solver
+   const SparseMatrix &Ac = *matrices.Last();
+   if (Ac.Height() <= amg_max_dense_size)
+   {
+      DenseMatrix Ac_dense;
+      Ac.ToDenseMatrix(Ac_dense);
+      smoothers.Append(new DenseMatrixInverse(Ac_dense));
+   }
+   else
+   {
+      Vector *diag = new Vector;
+      Ac.GetDiag(*diag);
+      diagonals.Append(diag);
+      smoothers.Append(new OperatorChebyshevSmoother(
+                          Ac, *diag, no_ess_tdofs, smoother_order,
+                          AMGSpectralRadius(Ac, *diag)));
+   }
+
+   // Multigrid cycle, with the levels ordered from the coarsest
+   const int nl = matrices.Size();
+   Array<Operator*> mg_operators(nl), mg_prolongations(nl-1);
+   Array<Solver*> mg_smoothers(nl);
+   Array<bool> own_operators(nl), own_smoothers(nl), own_prolongations(nl-1);
+   for (int l = 0; l < nl; l++)
+   {
+      mg_operators[nl-1-l] = matrices[l];
+      mg_smoothers[nl-1-l] = smoothers[l];
+      if (l < nl-1) { mg_prolongations[nl-2-l] = prolongations[l]; }
+   }
+   own_operators = false;
+   own_smoothers = true;
+   own_prolongations = true;
+   mg = new Multigrid(mg_operators, mg_smoothers, mg_prolongations,
+                      own_operators, own_smoothers, own_prolongations);
+   mg->SetCycleType(use_w_cycle ? MultigridBase::CycleType::WCYCLE :
+                    MultigridBase::CycleType::VCYCLE, 1, 1);
+
+   if (print_level > 0)
+   {
+      mfem::out << "\nSmoothedAggregationAMG hierarchy:\n"
+                << " level        rows         nnz\n";
+      for (int l = 0; l < nl; l++)
+      {
+         mfem::out << std::setw(6) << l
+                   << std::setw(12) << matrices[l]->Height()
+                   << std::setw(12) << matrices[l]->NumNonZeroElems() << '\n';
+      }
+      mfem::out << "Operator complexity: " << GetOperatorComplexity() << '\n';
+   }
+}
+
+real_t SmoothedAggregationAMG::GetOperatorComplexity() const
+{
+   if (matrices.Size() == 0) { return 0.0; }
+   real_t nnz = 0.0;
+   for (int l = 0; l < matrices.Size(); l++)
+   {
+      nnz += matrices[l]->NumNonZeroElems();
+   }
+   return nnz / matrices[0]->NumNonZeroElems();
+}
+
+void SmoothedAggregationAMG::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(mg, "SmoothedAggregationAMG: SetOperator must be called first");
+   mg->Mult(b, x);
+}
+
+void SmoothedAggregationAMG::ArrayMult(const Array<const Vector*> &B,
+                                       Array<Vector*> &X) const
+{
+   MFEM_VERIFY(mg, "SmoothedAggregationAMG: SetOperator must be called first");
+   mg->ArrayMult(B, X);
+}
+
+} // namespace mfem
@@ -0,0 +1,157 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_AMG
+#define MFEM_AMG
+
+#include "../config/config.hpp"
+#include "sparsemat.hpp"
+#include "densemat.hpp"
+
+namespace mfem
+{
+
+class Multigrid;
+class FiniteElementSpace;
+
+/// Smoothed aggregation algebraic multigrid for a serial SparseMatrix.
+/** The hierarchy is built in SetOperator() by greedy aggregation of the nodes
+    of the strength of connection graph, a tentative prolongator obtained from
+    the local QR factorizations of the near-nullspace vectors on the aggregates,
+    and one damped Jacobi step applied to the tentative prolongator. The coarse
+    operators are the Galerkin products P^T A P. Each application of the solver
+    performs one multigrid cycle (see MultigridBase) with Chebyshev smoothing
+    (see OperatorChebyshevSmoother) and a direct solve on the coarsest level.
+
+    For systems of PDEs, the unknowns of the same node are aggregated together,
+    see SetSystemsOptions(). The near-nullspace defaults to the constant vector
+    of each component and can be set with SetNearNullspace() or, for linear
+    elasticity, SetElasticityOptions().
+
+    The options must be set before SetOperator(). The sparse matrix products
+    and the smoother kernels of the setup and of the cycles are multithreaded
+    with the OpenMP backend. */
+class SmoothedAggregationAMG : public Solver
+{
+public:
+   /// Create the solver; the hierarchy is built by SetOperator().
+   SmoothedAggregationAMG();
+
+   /// Create the solver and build the hierarchy for the matrix @a A.
+   SmoothedAggregationAMG(const SparseMatrix &A);
+
+   /// Build the hierarchy for @a op, which must be a finalized SparseMatrix.
+   /** The matrix @a op is not copied and must stay valid while the solver is
+       used. */
+   void SetOperator(const Operator &op) override;
+
+   /// Perform one multigrid cycle. The initial guess @a x is ignored.
+   void Mult(const Vector &b, Vector &x) const override;
+
+   /// Perform one multigrid cycle for each of the vectors in @a B.
+   void ArrayMult(const Array<const Vector*> &B,
+                  Array<Vector*> &X) const override;
+
+   /** @brief Treat the matrix as a system with @a dim unknowns per node,
+       ordered by nodes if @a order_bynodes is true or by vdim otherwise. */
+   void SetSystemsOptions(int dim, bool order_bynodes = false);
+
+   /** @brief Set the near-nullspace vectors (the columns of @a B), used to
+       build the tentative prolongators. The rows of @a B correspond to the
+       rows of the matrix. */
+   void SetNearNullspace(const DenseMatrix &B);
+
+   /** @brief Set the options for linear elasticity discretized on @a fespace:
+       nodal aggregation with the ordering of @a fespace, and the rigid body
+       modes as the near-nullspace. */
+   /** The rigid body modes are recomputed in each call to SetOperator(), so
+       @a fespace must stay valid while the solver is set up. */
+   void SetElasticityOptions(FiniteElementSpace *fespace);
+
+   /** @brief Set the strength threshold @a theta: the nodes i and j are
+       strongly connected if |a_ij| >= theta sqrt(|a_ii a_jj|). */
+   /** The default value is 0.08. Larger values give smaller aggregates,
+       which increases the cost of the coarse levels. */
+   void SetStrengthThreshold(real_t theta) { strength_threshold = theta; }
+
+   /// Set the order of the Chebyshev smoothers (default 2).
+   void SetSmootherOrder(int order) { smoother_order = order; }
+
+   /// Set the maximum size of the coarsest level (default 100).
+   void SetMaxCoarseSize(int size) { max_coarse_size = size; }
+
+   /// Set the maximum number of levels (default 25).
+   void SetMaxLevels(int levels) { max_levels = levels; }
+
+   /// Use W-cycles instead of V-cycles (the default) if @a w_cycle is true.
+   void SetWCycle(bool w_cycle = true) { use_w_cycle = w_cycle; }
+
+   /// Print the hierarchy after the setup if @a print_level is positive.
+   void SetPrintLevel(int print_level_) { print_level = print_level_; }
+
+   /// Return the number of levels of the hierarchy.
+   int GetNumLevels() const { return matrices.Size(); }
+
+   /// Return the matrix of the given @a level, 0 being the finest level.
+   const SparseMatrix &GetLevelMatrix(int level) const
+   { return *matrices[level]; }
+
+   /** @brief Return the ratio of the number of nonzeros of all levels to the
+       number of nonzeros of the finest level. */
+   real_t GetOperatorComplexity() const;
+
+   ~SmoothedAggregationAMG();
+
+protected:
+   int num_functions;
+   bool order_bynodes;
+   DenseMatrix user_nullspace;
+   FiniteElementSpace *fespace;
+
+   real_t strength_threshold;
+   int smoother_order;
+   int max_coarse_size;
+   int max_levels;
+   bool use_w_cycle;
+   int print_level;
+
+   /// Level matrices, finest first. The finest one is not owned.
+   Array<SparseMatrix*> matrices;
+   /// Diagonals of the level matrices, referenced by the smoothers.
+   Array<Vector*> diagonals;
+   /// Empty list of essential dofs, referenced by the smoothers.
+   Array<int> no_ess_tdofs;
+   /// The multigrid cycle, built from the hierarchy.
+   Multigrid *mg;
+
+   /// Delete the hierarchy.
+   void Clear();
+
+   /// Compute the rigid body modes of #fespace.
+   void ComputeRigidBodyModes(DenseMatrix &B) const;
+
+   /** @brief Aggregate the nodes of the matrix @a A with @a nf unknowns per
+       node. Returns the number of aggregates; @a agg is the aggregate of each
+       node, or -1 for nodes without strong connections. */
+   int Aggregate(const SparseMatrix &A, int nf, bool bynodes,
+                 Array<int> &agg) const;
+
+   /** @brief Compute the tentative prolongator of the aggregates @a agg and
+       the near-nullspace @a B, and the coarse near-nullspace @a Bc. */
+   static SparseMatrix *TentativeProlongator(int nf, bool bynodes,
+                                             const Array<int> &agg, int nagg,
+                                             const DenseMatrix &B,
+                                             DenseMatrix &Bc);
+};
+
+} // namespace mfem
+
+#endif
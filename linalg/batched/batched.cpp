@@ -62,6 +62,12 @@ void BatchedLinAlg::Mult(const DenseTensor &A, const Vector &x, Vector &y)
    Get(Instance().active_backend).Mult(A, x, y);
 }
 
+void BatchedLinAlg::AddMultTranspose(const DenseTensor &A, const Vector &x,
+                                     Vector &y, real_t alpha, real_t beta)
+{
+   Get(Instance().active_backend).AddMultTranspose(A, x, y, alpha, beta);
+}
+
 void BatchedLinAlg::Invert(DenseTensor &A)
 {
    Get(Instance().active_backend).Invert(A);
@@ -67,6 +67,14 @@ public:
                        real_t alpha = 1.0, real_t beta = 1.0);
    /// Computes $y = A x$ (e.g. by calling @ref AddMult "AddMult(A,x,y,1,0)").
    static void Mult(const DenseTensor &A, const Vector &x, Vector &y);
+   /// @brief Computes $y = \alpha A^T x + \beta y$.
+   ///
+   /// $A$ is a block diagonal matrix, represented by the DenseTensor @a A with
+   /// shape (m, n, n_mat). $x$ has shape (m, k, n_mat), and $y$ has shape
+   /// (n, k, n_mat).
+   static void AddMultTranspose(const DenseTensor &A, const Vector &x,
+                                Vector &y, real_t alpha = 1.0,
+                                real_t beta = 1.0);
    /// @brief Replaces the block diagonal matrix $A$ with its inverse $A^{-1}$.
    ///
    /// $A$ is represented by the DenseTensor @a A with shape (m, m, n_mat).
@@ -114,6 +122,10 @@ public:
                         real_t alpha = 1.0, real_t beta = 1.0) const = 0;
    /// See BatchedLinAlg::Mult.
    virtual void Mult(const DenseTensor &A, const Vector &x, Vector &y) const;
+   /// See BatchedLinAlg::AddMultTranspose.
+   virtual void AddMultTranspose(const DenseTensor &A, const Vector &x,
+                                 Vector &y, real_t alpha = 1.0,
+                                 real_t beta = 1.0) const = 0;
    /// See BatchedLinAlg::Invert.
    virtual void Invert(DenseTensor &A) const = 0;
    /// See BatchedLinAlg::LUFactor.
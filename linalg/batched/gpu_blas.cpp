@@ -102,6 +102,29 @@ void GPUBlasBatchedLinAlg::AddMult(const DenseTensor &A, const Vector &x,
    MFEM_VERIFY(status == MFEM_BLAS_SUCCESS, "GPU BLAS error.");
 }
 
+void GPUBlasBatchedLinAlg::AddMultTranspose(const DenseTensor &A,
+                                            const Vector &x, Vector &y,
+                                            real_t alpha, real_t beta) const
+{
+   const int m = A.SizeI();
+   const int n = A.SizeJ();
+   const int n_mat = A.SizeK();
+   const int k = x.Size() / m / n_mat;
+
+   auto d_A = mfem::Reshape(A.Read(), m, n, n_mat);
+   auto d_x = mfem::Reshape(x.Read(), m, k, n_mat);
+   auto d_y = mfem::Reshape(beta == 0.0 ? y.Write() : y.ReadWrite(), n, k, n_mat);
+
+   const auto op_t = MFEM_CU_or_HIP(BLAS_OP_T);
+   const auto op_n = MFEM_CU_or_HIP(BLAS_OP_N);
+
+   const blasStatus_t status = MFEM_GPUBLAS_PREFIX(gemmStridedBatched)(
+                                  GPUBlas::Handle(), op_t, op_n, n, k, m, &alpha,
+                                  d_A, m, m*n, d_x, m, m*k, &beta, d_y, n, n*k,
+                                  n_mat);
+   MFEM_VERIFY(status == MFEM_BLAS_SUCCESS, "GPU BLAS error.");
+}
+
 void GPUBlasBatchedLinAlg::LUFactor(DenseTensor &A, Array<int> &P) const
 {
    const int n = A.SizeI();
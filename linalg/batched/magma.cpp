@@ -70,6 +70,24 @@ void MagmaBatchedLinAlg::AddMult(const DenseTensor &A, const Vector &x,
       beta, d_y, m, m*k, n_mat, Magma::Queue());
 }
 
+void MagmaBatchedLinAlg::AddMultTranspose(const DenseTensor &A,
+                                          const Vector &x, Vector &y,
+                                          real_t alpha, real_t beta) const
+{
+   const int m = A.SizeI();
+   const int n = A.SizeJ();
+   const int n_mat = A.SizeK();
+   const int k = x.Size() / m / n_mat;
+
+   auto d_A = mfem::Reshape(A.Read(), m, n, n_mat);
+   auto d_x = mfem::Reshape(x.Read(), m, k, n_mat);
+   auto d_y = mfem::Reshape(beta == 0.0 ? y.Write() : y.ReadWrite(), n, k, n_mat);
+
+   MFEM_MAGMABLAS_PREFIX(gemm_batched_strided)(
+      MagmaTrans, MagmaNoTrans, n, k, m, alpha, d_A, m, m*n, d_x, m, m*k,
+      beta, d_y, n, n*k, n_mat, Magma::Queue());
+}
+
 void MagmaBatchedLinAlg::LUFactor(DenseTensor &A, Array<int> &P) const
 {
    const int n = A.SizeI();
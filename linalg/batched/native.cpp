@@ -17,6 +17,93 @@
 namespace mfem
 {
 
+namespace
+{
+
+// y = alpha A x + beta y, with A of size m x n and the k columns of x and y
+// stored contiguously. Four columns of A are processed at a time, so that each
+// entry of y is read and written once per block of columns.
+MFEM_HOST_DEVICE inline
+void BlockedAddMult(const int m, const int n, const int k, const real_t *A,
+                    const real_t *x, real_t *y, const real_t alpha,
+                    const real_t beta)
+{
+   for (int r = 0; r < k; r++)
+   {
+      const real_t *xr = x + r*n;
+      real_t *yr = y + r*m;
+      if (beta == 0.0) { for (int i = 0; i < m; i++) { yr[i] = 0.0; } }
+      else if (beta != 1.0) { for (int i = 0; i < m; i++) { yr[i] *= beta; } }
+      int j = 0;
+      for (; j + 4 <= n; j += 4)
+      {
+         const real_t x0 = alpha*xr[j], x1 = alpha*xr[j+1];
+         const real_t x2 = alpha*xr[j+2], x3 = alpha*xr[j+3];
+         const real_t *A0 = A + j*m, *A1 = A0 + m, *A2 = A1 + m, *A3 = A2 + m;
+         for (int i = 0; i < m; i++)
+         {
+            yr[i] += A0[i]*x0 + A1[i]*x1 + A2[i]*x2 + A3[i]*x3;
+         }
+      }
+      for (; j < n; j++)
+      {
+         const real_t xj = alpha*xr[j];
+         const real_t *Aj = A + j*m;
+         for (int i = 0; i < m; i++) { yr[i] += Aj[i]*xj; }
+      }
+   }
+}
+
+// y = alpha A^t x + beta y, with A of size m x n. The dot products with four
+// columns of A are computed at a time, so that each entry of x is read once
+// per block of columns.
+MFEM_HOST_DEVICE inline
+void BlockedAddMultTranspose(const int m, const int n, const int k,
+                             const real_t *A, const real_t *x, real_t *y,
+                             const real_t alpha, const real_t beta)
+{
+   for (int r = 0; r < k; r++)
+   {
+      const real_t *xr = x + r*m;
+      real_t *yr = y + r*n;
+      int j = 0;
+      for (; j + 4 <= n; j += 4)
+      {
+         const real_t *A0 = A + j*m, *A1 = A0 + m, *A2 = A1 + m, *A3 = A2 + m;
+         real_t s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+         for (int i = 0; i < m; i++)
+         {
+            const real_t xi = xr[i];
+            s0 += A0[i]*xi;
+            s1 += A1[i]*xi;
+            s2 += A2[i]*xi;
+            s3 += A3[i]*xi;
+         }
+         if (beta == 0.0)
+         {
+            yr[j] = alpha*s0; yr[j+1] = alpha*s1;
+            yr[j+2] = alpha*s2; yr[j+3] = alpha*s3;
+         }
+         else
+         {
+            yr[j] = alpha*s0 + beta*yr[j];
+            yr[j+1] = alpha*s1 + beta*yr[j+1];
+            yr[j+2] = alpha*s2 + beta*yr[j+2];
+            yr[j+3] = alpha*s3 + beta*yr[j+3];
+         }
+      }
+      for (; j < n; j++)
+      {
+         const real_t *Aj = A + j*m;
+         real_t s = 0.0;
+         for (int i = 0; i < m; i++) { s += Aj[i]*xr[i]; }
+         yr[j] = (beta == 0.0) ? alpha*s : alpha*s + beta*yr[j];
+      }
+   }
+}
+
+} // namespace
+
 void NativeBatchedLinAlg::AddMult(const DenseTensor &A, const Vector &x,
                                   Vector &y, real_t alpha, real_t beta) const
 {
@@ -31,8 +118,8 @@ void NativeBatchedLinAlg::AddMult(const DenseTensor &A, const Vector &x,
 
    mfem::forall(n_mat, [=] MFEM_HOST_DEVICE (int i)
    {
-      kernels::AddMult(m, k, n, &d_A(0,0,i), &d_x(0,0,i), &d_y(0,0,i),
-                       alpha, beta);
+      BlockedAddMult(m, n, k, &d_A(0,0,i), &d_x(0,0,i), &d_y(0,0,i),
+                     alpha, beta);
    });
 
    // Alternative approach, threading also over the second index. Which one is
@@ -46,6 +133,26 @@ void NativeBatchedLinAlg::AddMult(const DenseTensor &A, const Vector &x,
    // });
 }
 
+void NativeBatchedLinAlg::AddMultTranspose(const DenseTensor &A,
+                                           const Vector &x, Vector &y,
+                                           real_t alpha, real_t beta) const
+{
+   const int m = A.SizeI();
+   const int n = A.SizeJ();
+   const int n_mat = A.SizeK();
+   const int k = x.Size() / m / n_mat;
+
+   auto d_A = mfem::Reshape(A.Read(), m, n, n_mat);
+   auto d_x = mfem::Reshape(x.Read(), m, k, n_mat);
+   auto d_y = mfem::Reshape(beta == 0.0 ? y.Write() : y.ReadWrite(), n, k, n_mat);
+
+   mfem::forall(n_mat, [=] MFEM_HOST_DEVICE (int i)
+   {
+      BlockedAddMultTranspose(m, n, k, &d_A(0,0,i), &d_x(0,0,i), &d_y(0,0,i),
+                              alpha, beta);
+   });
+}
+
 void NativeBatchedLinAlg::Invert(DenseTensor &A) const
 {
    MFEM_ABORT("");
@@ -24,6 +24,7 @@
 #include "blockmatrix.hpp"
 #include "blockoperator.hpp"
 #include "sparsesmoothers.hpp"
+#include "amg.hpp"
 #include "densemat.hpp"
 #include "symmat.hpp"
 #include "ode.hpp"
@@ -15,6 +15,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 namespace mfem
 {
@@ -616,6 +617,13 @@ void ConstrainedOperator::ConstrainedMult(const Vector &x, Vector &y,
       A->Mult(z, y);
    }
 
+   ConstrainOutput(x, y);
+}
+
+void ConstrainedOperator::ConstrainOutput(const Vector &x, Vector &y) const
+{
+   const int csz = constraint_list.Size();
+   auto idx = constraint_list.Read();
    auto d_x = x.Read();
    // Use read+write access - we are modifying sub-vector of y
    auto d_y = y.ReadWrite();
@@ -664,6 +672,38 @@ void ConstrainedOperator::AddMult(const Vector &x, Vector &y,
    y.Add(a, w);
 }
 
+void ConstrainedOperator::ArrayMult(const Array<const Vector *> &X,
+                                    Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(),
+               "Number of columns mismatch in ConstrainedOperator::ArrayMult!");
+   const int csz = constraint_list.Size();
+   if (csz == 0)
+   {
+      A->ArrayMult(X, Y);
+      return;
+   }
+
+   const int nv = X.Size();
+   Z.SetSize(nv*width, GetMemoryType(mem_class));
+   Z.UseDevice(true);
+   std::vector<Vector> z_k(nv);
+   Array<const Vector *> Zp(nv);
+   auto idx = constraint_list.Read();
+   for (int k = 0; k < nv; k++)
+   {
+      z_k[k].MakeRef(Z, k*width, width);
+      z_k[k] = *X[k];
+      auto d_z = z_k[k].ReadWrite();
+      mfem::forall(csz, [=] MFEM_HOST_DEVICE (int i) { d_z[idx[i]] = 0.0; });
+      Zp[k] = &z_k[k];
+   }
+
+   A->ArrayMult(Zp, Y);
+
+   for (int k = 0; k < nv; k++) { ConstrainOutput(*X[k], *Y[k]); }
+}
+
 RectangularConstrainedOperator::RectangularConstrainedOperator(
    Operator *A,
    const Array<int> &trial_list,
@@ -995,9 +995,13 @@ protected:
    Operator *A;                 ///< The unconstrained Operator.
    bool own_A;                  ///< Ownership flag for A.
    mutable Vector z, w;         ///< Auxiliary vectors.
+   mutable Vector Z;            ///< Auxiliary storage for ArrayMult().
    MemoryClass mem_class;
    DiagonalPolicy diag_policy;  ///< Diagonal policy for constrained dofs
 
+   /// Set the constrained entries of the output @a y of the action on @a x.
+   void ConstrainOutput(const Vector &x, Vector &y) const;
+
 public:
    /** @brief Constructor from a general Operator and a list of essential
        indices/dofs.
@@ -1047,6 +1051,12 @@ public:
 
    void MultTranspose(const Vector &x, Vector &y) const override;
 
+   /** @brief Constrained operator action on multiple vectors, see Mult(). The
+       unconstrained operator is applied to all vectors with a single call to
+       its ArrayMult(). */
+   void ArrayMult(const Array<const Vector *> &X,
+                  Array<Vector *> &Y) const override;
+
    /** @brief Implementation of Mult or MultTranspose.
     *  TODO - Generalize to allow constraining rows and columns differently.
    */
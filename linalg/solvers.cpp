@@ -20,6 +20,12 @@
 #include <algorithm>
 #include <cmath>
 #include <set>
+#include <typeinfo>
+#include <vector>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace mfem
 {
@@ -69,6 +75,55 @@ real_t IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::StartDots(int n, const Vector *const *x,
+                                const Vector *const *y, real_t *dots) const
+{
+   // Consecutive inner products with the same y[i] are computed in one pass
+   for (int i = 0, j; i < n; i = j)
+   {
+      for (j = i + 1; j < n && y[j] == y[i]; j++) { }
+      if (j - i == 1)
+      {
+         dots[i] = (*x[i]) * (*y[i]);
+      }
+      else
+      {
+         y[i]->MultiDot(j - i, x + i, dots + i, dots_work);
+      }
+   }
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MFEM_ASSERT(dots_request == MPI_REQUEST_NULL,
+                  "a reduction is already in progress");
+      MPI_Iallreduce(MPI_IN_PLACE, dots, n, MFEM_MPI_REAL_T, MPI_SUM, comm,
+                     &dots_request);
+   }
+#endif
+}
+
+void IterativeSolver::WaitDots() const
+{
+#ifdef MFEM_USE_MPI
+   if (dots_request != MPI_REQUEST_NULL)
+   {
+      MPI_Wait(&dots_request, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
+real_t IterativeSolver::AddDot(real_t a, const Vector &x, Vector &y) const
+{
+   real_t dot = y.AddDot(a, x, y, dots_work);
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, &dot, 1, MFEM_MPI_REAL_T, MPI_SUM, comm);
+   }
+#endif
+   return dot;
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
    print_options = FromLegacyPrintLevel(print_lvl);
@@ -690,36 +745,1034 @@ void SLI(const Operator &A, const Vector &b, Vector &x,
    sli.Mult(b, x);
 }
 
-void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
-         int print_iter, int max_num_iter,
-         real_t RTOLERANCE, real_t ATOLERANCE)
+void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
+         int print_iter, int max_num_iter,
+         real_t RTOLERANCE, real_t ATOLERANCE)
+{
+   MFEM_PERF_FUNCTION;
+
+   SLISolver sli;
+   sli.SetPrintLevel(print_iter);
+   sli.SetMaxIter(max_num_iter);
+   sli.SetRelTol(sqrt(RTOLERANCE));
+   sli.SetAbsTol(sqrt(ATOLERANCE));
+   sli.SetOperator(A);
+   sli.SetPreconditioner(B);
+   sli.Mult(b, x);
+}
+
+
+void MixedPrecisionRefinementSolver::SetOperator(const Operator &op)
+{
+   IterativeSolver::SetOperator(op);
+   r.SetSize(height);
+   c.SetSize(height);
+
+   const SparseMatrix *A = dynamic_cast<const SparseMatrix*>(&op);
+   if (!A)
+   {
+      mat_values.DeleteAll();
+      inv_diag.DeleteAll();
+      return;
+   }
+   MFEM_VERIFY(A->Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(height == width, "the matrix must be square");
+   const int n = height, nnz = A->NumNonZeroElems();
+   const int *d_I = A->ReadI();
+   const int *d_J = A->ReadJ();
+   const real_t *d_A = A->ReadData();
+   mat_values.SetSize(nnz);
+   inv_diag.SetSize(n);
+   float *d_values = mat_values.Write();
+   float *d_inv_diag = inv_diag.Write();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+   {
+      real_t diag = 0.0;
+      for (int k = d_I[i]; k < d_I[i+1]; k++)
+      {
+         d_values[k] = (float) d_A[k];
+         if (d_J[k] == i) { diag = d_A[k]; }
+      }
+      d_inv_diag[i] = (diag != 0.0) ? (float) (1.0/diag) : 1.0f;
+   });
+   fr.SetSize(n);
+   fx.SetSize(n);
+   fz.SetSize(n);
+   fp.SetSize(n);
+   fq.SetSize(n);
+}
+
+real_t MixedPrecisionRefinementSolver::FloatDot(const Array<float> &x,
+                                                const Array<float> &y) const
+{
+   // Sums over blocks of entries in float, reduced in real_t
+   const int n = x.Size(), bs = 256, nb = (n + bs - 1)/bs;
+   partials.SetSize(nb);
+   partials.UseDevice(true);
+   const float *d_x = x.Read(), *d_y = y.Read();
+   real_t *d_partials = partials.Write();
+   mfem::forall(nb, [=] MFEM_HOST_DEVICE (int b)
+   {
+      const int end = (b + 1)*bs < n ? (b + 1)*bs : n;
+      float sum = 0.0f;
+      for (int i = b*bs; i < end; i++) { sum += d_x[i]*d_y[i]; }
+      d_partials[b] = sum;
+   });
+   return partials.Sum();
+}
+
+int MixedPrecisionRefinementSolver::FloatCG(const Vector &r_,
+                                            Vector &c_) const
+{
+   const SparseMatrix &A = static_cast<const SparseMatrix &>(*oper);
+   const int n = height;
+   const int *d_I = A.ReadI();
+   const int *d_J = A.ReadJ();
+   const float *d_A = mat_values.Read();
+   const float *d_inv_diag = inv_diag.Read();
+
+   // Scale the residual to avoid underflow in single precision
+   const real_t scale = r_.Normlinf();
+   if (scale == 0.0) { c_ = 0.0; return 0; }
+   const real_t inv_scale = 1.0/scale;
+   {
+      const real_t *d_r = r_.Read();
+      float *d_fr = fr.Write(), *d_fx = fx.Write();
+      float *d_fz = fz.Write(), *d_fp = fp.Write();
+      mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+      {
+         d_fr[i] = (float) (d_r[i]*inv_scale);
+         d_fx[i] = 0.0f;
+         d_fz[i] = d_inv_diag[i]*d_fr[i];
+         d_fp[i] = d_fz[i];
+      });
+   }
+   real_t nom = FloatDot(fr, fz);
+   const real_t r0 = nom*inner_rel_tol*inner_rel_tol;
+   int it = 0;
+   while (it < inner_max_iter && nom > r0)
+   {
+      const float *d_fp = fp.Read();
+      float *d_fq = fq.Write();
+      mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+      {
+         float sum = 0.0f;
+         for (int k = d_I[i]; k < d_I[i+1]; k++)
+         {
+            sum += d_A[k]*d_fp[d_J[k]];
+         }
+         d_fq[i] = sum;
+      });
+      const real_t den = FloatDot(fp, fq);
+      if (den <= 0.0) { break; }
+      const float alpha = (float) (nom/den);
+      float *d_fx = fx.ReadWrite(), *d_fr = fr.ReadWrite();
+      float *d_fz = fz.Write();
+      const float *d_fq_r = fq.Read();
+      mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+      {
+         d_fx[i] += alpha*d_fp[i];
+         d_fr[i] -= alpha*d_fq_r[i];
+         d_fz[i] = d_inv_diag[i]*d_fr[i];
+      });
+      it++;
+      const real_t betanom = FloatDot(fr, fz);
+      const float beta = (float) (betanom/nom);
+      nom = betanom;
+      if (nom <= r0) { break; }
+      float *d_fp_rw = fp.ReadWrite();
+      const float *d_fz_r = fz.Read();
+      mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+      {
+         d_fp_rw[i] = d_fz_r[i] + beta*d_fp_rw[i];
+      });
+   }
+
+   const float *d_fx = fx.Read();
+   real_t *d_c = c_.Write();
+   mfem::forall(n, [=] MFEM_HOST_DEVICE (int i)
+   {
+      d_c[i] = d_fx[i]*scale;
+   });
+   return it;
+}
+
+void MixedPrecisionRefinementSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(inner_solver || mat_values.Size() > 0 || height == 0,
+               "MixedPrecisionRefinementSolver requires a SparseMatrix "
+               "operator or an inner solver");
+   r.UseDevice(true);
+   c.UseDevice(true);
+   inner_iterations = 0;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   real_t nom = sqrt(Dot(r, r));
+   initial_norm = nom;
+   if (print_options.iterations || print_options.first_and_last)
+   {
+      mfem::out << "   Iteration : " << setw(3) << right << 0 << "  ||r|| = "
+                << nom << (print_options.first_and_last ? " ..." : "") << '\n';
+   }
+   Monitor(0, nom, r, x);
+
+   const real_t r0 = std::max(nom*rel_tol, abs_tol);
+   converged = (nom <= r0);
+   final_iter = 0;
+   for (int i = 1; !converged && i <= max_iter; i++)
+   {
+      // x = x + c, with c an approximate solution of A c = r
+      if (inner_solver)
+      {
+         c = 0.0;
+         inner_solver->Mult(r, c);
+      }
+      else
+      {
+         inner_iterations += FloatCG(r, c);
+      }
+      x += c;
+
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+      nom = sqrt(Dot(r, r));
+      converged = (nom <= r0);
+      final_iter = i;
+
+      if (print_options.iterations || (print_options.first_and_last &&
+                                       (converged || i == max_iter)))
+      {
+         mfem::out << "   Iteration : " << setw(3) << right << i
+                   << "  ||r|| = " << nom << '\n';
+      }
+      Monitor(i, nom, r, x);
+   }
+
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "Mixed precision refinement: Number of iterations: "
+                << final_iter << '\n';
+      if (!inner_solver)
+      {
+         mfem::out << "Number of inner iterations: " << inner_iterations
+                   << '\n';
+      }
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "Mixed precision refinement: No convergence!" << '\n';
+   }
+   final_norm = nom;
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+
+void CGSolver::UpdateVectors()
+{
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+
+   r.SetSize(width, mt); r.UseDevice(true);
+   d.SetSize(width, mt); d.UseDevice(true);
+   z.SetSize(width, mt); z.UseDevice(true);
+}
+
+void CGSolver::Mult(const Vector &b, Vector &x) const
+{
+   int i;
+   real_t r0, den, nom, nom0, betanom, alpha, beta;
+
+   x.UseDevice(true);
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+
+   if (prec)
+   {
+      prec->Mult(r, z); // z = B r
+      d = z;
+   }
+   else
+   {
+      d = r;
+   }
+   nom0 = nom = Dot(d, r);
+   if (nom0 >= 0.0) { initial_norm = sqrt(nom0); }
+   MFEM_VERIFY(IsFinite(nom), "nom = " << nom);
+   if (print_options.iterations || print_options.first_and_last)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                << nom << (print_options.first_and_last ? " ...\n" : "\n");
+   }
+   Monitor(0, nom, r, x);
+
+   if (nom < 0.0)
+   {
+      if (print_options.warnings)
+      {
+         mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
+                   << nom << '\n';
+      }
+      converged = false;
+      final_iter = 0;
+      initial_norm = nom;
+      final_norm = nom;
+      return;
+   }
+   r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
+   if (nom <= r0)
+   {
+      converged = true;
+      final_iter = 0;
+      final_norm = sqrt(nom);
+      return;
+   }
+
+   oper->Mult(d, z);  // z = A d
+   den = Dot(z, d);
+   MFEM_VERIFY(IsFinite(den), "den = " << den);
+   if (den <= 0.0)
+   {
+      if (Dot(d, d) > 0.0 && print_options.warnings)
+      {
+         mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
+                   << den << '\n';
+      }
+      if (den == 0.0)
+      {
+         converged = false;
+         final_iter = 0;
+         final_norm = sqrt(nom);
+         return;
+      }
+   }
+
+   // Without a preconditioner, the update of r is fused with its norm, unless
+   // the inner product is customized in a derived class
+   const bool fused = !prec && typeid(*this) == typeid(CGSolver);
+
+   // start iteration
+   converged = false;
+   final_iter = max_iter;
+   for (i = 1; true; )
+   {
+      alpha = nom/den;
+      add(x,  alpha, d, x);     //  x = x + alpha d
+      if (fused)
+      {
+         betanom = AddDot(-alpha, z, r); //  r = r - alpha A d, (r, r)
+      }
+      else
+      {
+         add(r, -alpha, z, r);  //  r = r - alpha A d
+         if (prec)
+         {
+            prec->Mult(r, z);   //  z = B r
+            betanom = Dot(r, z);
+         }
+         else
+         {
+            betanom = Dot(r, r);
+         }
+      }
+      MFEM_VERIFY(IsFinite(betanom), "betanom = " << betanom);
+      if (betanom < 0.0)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
+                      << betanom << '\n';
+         }
+         converged = false;
+         final_iter = i;
+         break;
+      }
+
+      if (print_options.iterations)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << betanom << std::endl;
+      }
+
+      Monitor(i, betanom, r, x);
+
+      if (betanom <= r0)
+      {
+         converged = true;
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      beta = betanom/nom;
+      if (prec)
+      {
+         add(z, beta, d, d);   //  d = z + beta d
+      }
+      else
+      {
+         add(r, beta, d, d);
+      }
+      oper->Mult(d, z);       //  z = A d
+      den = Dot(d, z);
+      MFEM_VERIFY(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (Dot(d, d) > 0.0 && print_options.warnings)
+         {
+            mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
+                      << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      nom = betanom;
+   }
+   if (print_options.first_and_last && !print_options.iterations)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                << betanom << '\n';
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "PCG: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_options.summary || print_options.iterations ||
+       print_options.first_and_last)
+   {
+      const auto arf = pow (betanom/nom0, 0.5/final_iter);
+      mfem::out << "Average reduction factor = " << arf << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "PCG: No convergence!" << '\n';
+   }
+
+   final_norm = sqrt(betanom);
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+// Apply the operator @a op to the columns @a cols of the array @a x, storing
+// the results in the same columns of @a y, with a single call to ArrayMult().
+static void ArrayMultColumns(const Operator &op, const Array<int> &cols,
+                             const Vector *x, Vector *y)
+{
+   Array<const Vector *> X(cols.Size());
+   Array<Vector *> Y(cols.Size());
+   for (int i = 0; i < cols.Size(); i++)
+   {
+      X[i] = x + cols[i];
+      Y[i] = y + cols[i];
+   }
+   op.ArrayMult(X, Y);
+}
+
+void CGSolver::ArrayMult(const Array<const Vector *> &B,
+                         Array<Vector *> &X) const
+{
+   MFEM_ASSERT(B.Size() == X.Size(), "Number of columns mismatch!");
+   const int nv = B.Size();
+   const MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+   std::vector<Vector> R(nv), D(nv), Z(nv);
+   std::vector<real_t> nom(nv), r0(nv);
+   Array<int> active(nv);  // the systems that are still iterating
+   for (int k = 0; k < nv; k++)
+   {
+      R[k].SetSize(width, mt); R[k].UseDevice(true);
+      D[k].SetSize(width, mt); D[k].UseDevice(true);
+      Z[k].SetSize(width, mt); Z[k].UseDevice(true);
+      X[k]->UseDevice(true);
+      active[k] = k;
+   }
+
+   if (iterative_mode)
+   {
+      Array<const Vector *> Xp(nv);
+      Array<Vector *> Rp(nv);
+      for (int k = 0; k < nv; k++) { Xp[k] = X[k]; Rp[k] = &R[k]; }
+      oper->ArrayMult(Xp, Rp);
+      for (int k = 0; k < nv; k++) { subtract(*B[k], R[k], R[k]); } // r = b - A x
+   }
+   else
+   {
+      for (int k = 0; k < nv; k++)
+      {
+         R[k] = *B[k];
+         *X[k] = 0.0;
+      }
+   }
+   if (prec) { ArrayMultColumns(*prec, active, R.data(), Z.data()); }
+
+   initial_norm = final_norm = 0.0;
+   final_iter = 0;
+   converged = true;
+   // Record the final state of system k and remove it from the iteration
+   auto finish = [&](int k, int iter, real_t norm, bool conv)
+   {
+      final_iter = std::max(final_iter, iter);
+      final_norm = std::max(final_norm, norm);
+      converged = converged && conv;
+      if (print_options.warnings && !conv)
+      {
+         mfem::out << "PCG: Right-hand side " << k << " did not converge.\n";
+      }
+   };
+
+   int j = 0;
+   for (int k = 0; k < nv; k++)
+   {
+      D[k] = prec ? Z[k] : R[k];
+      nom[k] = Dot(D[k], R[k]);
+      MFEM_VERIFY(IsFinite(nom[k]), "nom = " << nom[k]);
+      if (nom[k] < 0.0)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "PCG: The preconditioner is not positive definite. "
+                      << "(Br, r) = " << nom[k] << '\n';
+         }
+         finish(k, 0, 0.0, false);
+         continue;
+      }
+      initial_norm = std::max(initial_norm, sqrt(nom[k]));
+      r0[k] = std::max(nom[k]*rel_tol*rel_tol, abs_tol*abs_tol);
+      if (nom[k] <= r0[k])
+      {
+         finish(k, 0, sqrt(nom[k]), true);
+         continue;
+      }
+      active[j++] = k;
+   }
+   active.SetSize(j);
+
+   for (int i = 1; active.Size() > 0; i++)
+   {
+      ArrayMultColumns(*oper, active, D.data(), Z.data());  // z = A d
+      j = 0;
+      for (int k : active)
+      {
+         const real_t den = Dot(Z[k], D[k]);
+         MFEM_VERIFY(IsFinite(den), "den = " << den);
+         if (den <= 0.0)
+         {
+            if (Dot(D[k], D[k]) > 0.0 && print_options.warnings)
+            {
+               mfem::out << "PCG: The operator is not positive definite. "
+                         << "(Ad, d) = " << den << '\n';
+            }
+            if (den == 0.0)
+            {
+               finish(k, i-1, sqrt(nom[k]), false);
+               continue;
+            }
+         }
+         const real_t alpha = nom[k]/den;
+         X[k]->Add(alpha, D[k]);   //  x = x + alpha d
+         R[k].Add(-alpha, Z[k]);   //  r = r - alpha A d
+         active[j++] = k;
+      }
+      active.SetSize(j);
+
+      if (prec) { ArrayMultColumns(*prec, active, R.data(), Z.data()); }
+      j = 0;
+      for (int k : active)
+      {
+         const real_t betanom = prec ? Dot(R[k], Z[k]) : Dot(R[k], R[k]);
+         MFEM_VERIFY(IsFinite(betanom), "betanom = " << betanom);
+         if (betanom < 0.0)
+         {
+            if (print_options.warnings)
+            {
+               mfem::out << "PCG: The preconditioner is not positive definite. "
+                         << "(Br, r) = " << betanom << '\n';
+            }
+            finish(k, i, sqrt(nom[k]), false);
+            continue;
+         }
+         if (betanom <= r0[k] || i >= max_iter)
+         {
+            finish(k, i, sqrt(betanom), betanom <= r0[k]);
+            continue;
+         }
+         const real_t beta = betanom/nom[k];
+         nom[k] = betanom;
+         add(prec ? Z[k] : R[k], beta, D[k], D[k]);  //  d = z + beta d
+         active[j++] = k;
+      }
+      active.SetSize(j);
+   }
+
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "PCG: Number of iterations: " << final_iter
+                << " (" << nv << " right-hand sides)\n";
+   }
+}
+
+void PipelinedCGSolver::UpdateVectors()
+{
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+
+   r.SetSize(width, mt); r.UseDevice(true);
+   u.SetSize(width, mt); u.UseDevice(true);
+   w.SetSize(width, mt); w.UseDevice(true);
+   m.SetSize(width, mt); m.UseDevice(true);
+   n.SetSize(width, mt); n.UseDevice(true);
+   p.SetSize(width, mt); p.UseDevice(true);
+   s.SetSize(width, mt); s.UseDevice(true);
+   q.SetSize(width, mt); q.UseDevice(true);
+   z.SetSize(width, mt); z.UseDevice(true);
+}
+
+void PipelinedCGSolver::UpdateIterates(bool first, real_t alpha, real_t beta,
+                                       Vector &x) const
+{
+   // All recurrences are fused in a single pass over the vectors:
+   //    z = n + beta z,  s = w + beta s,  p = u + beta p,  q = m + beta q,
+   //    x = x + alpha p, r = r - alpha s, u = u - alpha q, w = w - alpha z,
+   // where beta = 0 in the first iteration. Without a preconditioner u is r
+   // and m is w, and q is not used.
+   const bool use_dev = x.UseDevice() || r.UseDevice();
+   const int N = width;
+   auto d_n = n.Read(use_dev);
+   auto d_z = z.ReadWrite(use_dev);
+   auto d_s = s.ReadWrite(use_dev);
+   auto d_p = p.ReadWrite(use_dev);
+   auto d_x = x.ReadWrite(use_dev);
+   auto d_r = r.ReadWrite(use_dev);
+   auto d_w = w.ReadWrite(use_dev);
+   real_t *d_u = prec ? u.ReadWrite(use_dev) : d_r;
+   const real_t *d_m = prec ? m.Read(use_dev) : nullptr;
+   real_t *d_q = prec ? q.ReadWrite(use_dev) : nullptr;
+   mfem::forall_switch(use_dev, N, [=] MFEM_HOST_DEVICE (int j)
+   {
+      const real_t z_j = first ? d_n[j] : d_n[j] + beta*d_z[j];
+      const real_t s_j = first ? d_w[j] : d_w[j] + beta*d_s[j];
+      const real_t p_j = first ? d_u[j] : d_u[j] + beta*d_p[j];
+      d_z[j] = z_j;
+      d_s[j] = s_j;
+      d_p[j] = p_j;
+      d_x[j] += alpha*p_j;
+      d_r[j] -= alpha*s_j;
+      if (d_q)
+      {
+         const real_t q_j = first ? d_m[j] : d_m[j] + beta*d_q[j];
+         d_q[j] = q_j;
+         d_u[j] -= alpha*q_j;
+      }
+      d_w[j] -= alpha*z_j;
+   });
+}
+
+void PipelinedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   // Notation of Algorithm 4 in Ghysels and Vanroose: u = B r, w = A u,
+   // m = B w, n = A m, and the recurrences p = u + beta p, s = A p = w + beta s,
+   // q = B s = m + beta q, z = A q = n + beta z.
+   real_t r0 = 0.0, nom0 = 0.0, gamma = 0.0, gamma_old = 0.0, delta;
+   real_t alpha = 0.0, beta, den;
+
+   x.UseDevice(true);
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+
+   // Without a preconditioner, u = r, m = w and q = s
+   Vector &u_ = prec ? u : r;
+   Vector &m_ = prec ? m : w;
+
+   if (prec) { prec->Mult(r, u); } // u = B r
+   oper->Mult(u_, w);              // w = A u
+
+   const Vector *dx[2] = { &r, &w }, *dy[2] = { &u_, &u_ };
+   real_t dots[2];
+
+   converged = false;
+   final_iter = max_iter;
+   for (int i = 0; true; i++)
+   {
+      StartDots(2, dx, dy, dots);  // (r, u), (w, u)
+      if (prec) { prec->Mult(w, m); } // m = B w
+      oper->Mult(m_, n);              // n = A m
+      WaitDots();
+      gamma = dots[0];
+      delta = dots[1];
+      MFEM_VERIFY(IsFinite(gamma), "gamma = " << gamma);
+
+      if (i == 0)
+      {
+         nom0 = gamma;
+         if (nom0 >= 0.0) { initial_norm = sqrt(nom0); }
+         if (print_options.iterations || print_options.first_and_last)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << gamma << (print_options.first_and_last ? " ...\n" : "\n");
+         }
+         r0 = std::max(gamma*rel_tol*rel_tol, abs_tol*abs_tol);
+      }
+      else if (print_options.iterations)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << gamma << std::endl;
+      }
+      Monitor(i, gamma, r, x);
+
+      if (gamma < 0.0)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "PPCG: The preconditioner is not positive definite. "
+                      << "(Br, r) = " << gamma << '\n';
+         }
+         converged = false;
+         final_iter = i;
+         if (i == 0)
+         {
+            initial_norm = final_norm = gamma;
+            return;
+         }
+         break;
+      }
+      if (gamma <= r0)
+      {
+         converged = true;
+         final_iter = i;
+         break;
+      }
+      if (i >= max_iter)
+      {
+         break;
+      }
+
+      beta = (i > 0) ? gamma/gamma_old : 0.0;
+      den = (i > 0) ? delta - beta*gamma/alpha : delta;  // (A p, p)
+      MFEM_VERIFY(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "PPCG: The operator is not positive definite. "
+                      << "(Ad, d) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      alpha = gamma/den;
+      gamma_old = gamma;
+
+      UpdateIterates(i == 0, alpha, beta, x);
+   }
+   if (print_options.first_and_last && !print_options.iterations)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                << gamma << '\n';
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "PPCG: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_options.summary || print_options.iterations ||
+       print_options.first_and_last)
+   {
+      const auto arf = pow (gamma/nom0, 0.5/final_iter);
+      mfem::out << "Average reduction factor = " << arf << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "PPCG: No convergence!" << '\n';
+   }
+
+   final_norm = sqrt(gamma);
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+void DeflatedCGSolver::UpdateVectors()
+{
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+
+   r.SetSize(width, mt); r.UseDevice(true);
+   z.SetSize(width, mt); z.UseDevice(true);
+   d.SetSize(width, mt); d.UseDevice(true);
+   q.SetSize(width, mt); q.UseDevice(true);
+}
+
+Vector *DeflatedCGSolver::NewVector() const
+{
+   Vector *v = new Vector(width, GetMemoryType(oper->GetMemoryClass()));
+   v->UseDevice(true);
+   return v;
+}
+
+void DeflatedCGSolver::DeleteVectors(Array<Vector *> &v)
+{
+   for (int i = 0; i < v.Size(); i++) { delete v[i]; }
+   v.SetSize(0);
+}
+
+void DeflatedCGSolver::SetOperator(const Operator &op)
+{
+   IterativeSolver::SetOperator(op);
+   UpdateVectors();
+   if (D.Size() > 0 && D[0]->Size() != width)
+   {
+      DeleteVectors(D);
+      DeleteVectors(AD);
+      DeleteVectors(BAD);
+   }
+   if (W.Size() > 0 && W[0]->Size() != width) { ResetRecycleSpace(); }
+   recycle_stale = (W.Size() > 0);
+}
+
+void DeflatedCGSolver::SetPreconditioner(Solver &pr)
+{
+   IterativeSolver::SetPreconditioner(pr);
+   recycle_stale = (W.Size() > 0);
+}
+
+void DeflatedCGSolver::ResetRecycleSpace()
+{
+   DeleteVectors(W);
+   DeleteVectors(AW);
+   DeleteVectors(BAW);
+   recycle_stale = false;
+}
+
+int DeflatedCGSolver::AOrthonormalize(Array<Vector *> &v, Array<Vector *> &Av,
+                                      Array<Vector *> *BAv) const
+{
+   int k = 0;
+   for (int i = 0; i < v.Size(); i++)
+   {
+      std::swap(v[i], v[k]);
+      std::swap(Av[i], Av[k]);
+      if (BAv) { std::swap((*BAv)[i], (*BAv)[k]); }
+
+      // A-inner products (v[j], v[k]), j = 0,...,k, using A v[j]
+      Array<const Vector*> vx(k+1), vy(k+1);
+      for (int j = 0; j <= k; j++) { vx[j] = Av[j]; vy[j] = v[k]; }
+      Vector h(k+1);
+      real_t vv0 = 0.0, vv = 0.0;
+      for (int pass = 0; pass < 2; pass++)
+      {
+         StartDots(k+1, vx.GetData(), vy.GetData(), h.GetData());
+         WaitDots();
+         if (pass == 0) { vv0 = h(k); }
+         real_t hh = 0.0;
+         for (int j = 0; j < k; j++)
+         {
+            hh += h(j)*h(j);
+            h(j) = -h(j);
+         }
+         if (k > 0)
+         {
+            v[k]->MultiAdd(k, h.GetData(), v.GetData());
+            Av[k]->MultiAdd(k, h.GetData(), Av.GetData());
+            if (BAv) { (*BAv)[k]->MultiAdd(k, h.GetData(), BAv->GetData()); }
+         }
+         vv = h(k) - hh;
+         if (vv > 0.5*h(k)) { break; }
+      }
+      // Drop the numerically dependent vectors
+      if (!(vv0 > 0.0) || vv <= 1e-12*vv0) { continue; }
+      const real_t s = 1.0/sqrt(vv);
+      (*v[k]) *= s;
+      (*Av[k]) *= s;
+      if (BAv) { (*(*BAv)[k]) *= s; }
+      k++;
+   }
+   return k;
+}
+
+void DeflatedCGSolver::RefreshRecycleSpace() const
+{
+   if (!prec) { DeleteVectors(BAW); }
+   for (int i = 0; i < W.Size(); i++)
+   {
+      oper->Mult(*W[i], *AW[i]);
+      if (prec)
+      {
+         if (BAW.Size() <= i) { BAW.Append(NewVector()); }
+         prec->Mult(*AW[i], *BAW[i]);
+      }
+   }
+   const int k = AOrthonormalize(W, AW, prec ? &BAW : NULL);
+   for (int i = k; i < W.Size(); i++)
+   {
+      delete W[i];
+      delete AW[i];
+      if (prec) { delete BAW[i]; }
+   }
+   W.SetSize(k);
+   AW.SetSize(k);
+   if (prec) { BAW.SetSize(k); }
+   recycle_stale = false;
+}
+
+// Eigenvalues and eigenvectors of the symmetric matrix A, using the cyclic
+// Jacobi method. The matrix A is overwritten.
+static void SymmetricEigensystem(DenseMatrix &A, Vector &ev, DenseMatrix &V)
 {
-   MFEM_PERF_FUNCTION;
-
-   SLISolver sli;
-   sli.SetPrintLevel(print_iter);
-   sli.SetMaxIter(max_num_iter);
-   sli.SetRelTol(sqrt(RTOLERANCE));
-   sli.SetAbsTol(sqrt(ATOLERANCE));
-   sli.SetOperator(A);
-   sli.SetPreconditioner(B);
-   sli.Mult(b, x);
+   const int n = A.Height();
+   V.Diag(1.0, n);
+   for (int sweep = 0; sweep < 50; sweep++)
+   {
+      real_t off = 0.0, diag = 0.0;
+      for (int i = 0; i < n; i++)
+      {
+         diag += A(i,i)*A(i,i);
+         for (int j = i+1; j < n; j++) { off += A(i,j)*A(i,j); }
+      }
+      if (off <= 1e-30*diag) { break; }
+      for (int p = 0; p < n; p++)
+      {
+         for (int q = p+1; q < n; q++)
+         {
+            if (A(p,q) == 0.0) { continue; }
+            const real_t theta = (A(q,q) - A(p,p))/(2.0*A(p,q));
+            const real_t t = (theta >= 0.0 ? 1.0 : -1.0) /
+                             (std::abs(theta) + sqrt(theta*theta + 1.0));
+            const real_t c = 1.0/sqrt(t*t + 1.0), s = t*c;
+            for (int k = 0; k < n; k++)
+            {
+               const real_t akp = A(k,p), akq = A(k,q);
+               A(k,p) = c*akp - s*akq;
+               A(k,q) = s*akp + c*akq;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const real_t apk = A(p,k), aqk = A(q,k);
+               A(p,k) = c*apk - s*aqk;
+               A(q,k) = s*apk + c*aqk;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const real_t vkp = V(k,p), vkq = V(k,q);
+               V(k,p) = c*vkp - s*vkq;
+               V(k,q) = s*vkp + c*vkq;
+            }
+         }
+      }
+   }
+   ev.SetSize(n);
+   for (int i = 0; i < n; i++) { ev(i) = A(i,i); }
 }
 
-
-void CGSolver::UpdateVectors()
+void DeflatedCGSolver::UpdateRecycleSpace() const
 {
-   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+   const int nw = W.Size(), m = nw + num_dirs;
+   if (recycle_dim <= 0 || m == 0) { return; }
+
+   // Basis Z of span{W, D}, A-orthonormalized
+   Array<Vector *> Z(m), AZ(m), BAZ(prec ? m : 0);
+   for (int i = 0; i < m; i++)
+   {
+      Z[i] = (i < nw) ? W[i] : D[i-nw];
+      AZ[i] = (i < nw) ? AW[i] : AD[i-nw];
+      if (prec) { BAZ[i] = (i < nw) ? BAW[i] : BAD[i-nw]; }
+   }
+   const int k = AOrthonormalize(Z, AZ, prec ? &BAZ : NULL);
+   if (k == 0) { return; }
+   const Array<Vector *> &BAZ_ = prec ? BAZ : AZ;
+
+   // The harmonic Ritz values theta of B A in span{Z} are the eigenvalues of
+   // F = (A Z)^T B (A Z), since Z^T A Z = I.
+   Array<const Vector*> vx(k*k), vy(k*k);
+   for (int j = 0; j < k; j++)
+   {
+      for (int i = 0; i < k; i++) { vx[i+k*j] = AZ[i]; vy[i+k*j] = BAZ_[j]; }
+   }
+   DenseMatrix F(k), Y;
+   StartDots(k*k, vx.GetData(), vy.GetData(), F.Data());
+   WaitDots();
+   F.Symmetrize();
+   Vector theta;
+   SymmetricEigensystem(F, theta, Y);
+
+   // The new recycle space: the vectors Z y for the smallest theta
+   Array<int> order(k);
+   for (int i = 0; i < k; i++) { order[i] = i; }
+   std::sort(order.begin(), order.end(),
+             [&theta](int a, int b) { return theta(a) < theta(b); });
+   const int nk = std::min(recycle_dim, k);
+   Array<Vector *> W_new(nk), AW_new(nk), BAW_new(prec ? nk : 0);
+   for (int l = 0; l < nk; l++)
+   {
+      const real_t *y = Y.GetColumn(order[l]);
+      W_new[l] = NewVector();
+      *W_new[l] = 0.0;
+      W_new[l]->MultiAdd(k, y, Z.GetData());
+      AW_new[l] = NewVector();
+      *AW_new[l] = 0.0;
+      AW_new[l]->MultiAdd(k, y, AZ.GetData());
+      if (prec)
+      {
+         BAW_new[l] = NewVector();
+         *BAW_new[l] = 0.0;
+         BAW_new[l]->MultiAdd(k, y, BAZ.GetData());
+      }
+   }
+   DeleteVectors(W);
+   DeleteVectors(AW);
+   DeleteVectors(BAW);
+   W_new.Copy(W);
+   AW_new.Copy(AW);
+   BAW_new.Copy(BAW);
+}
 
-   r.SetSize(width, mt); r.UseDevice(true);
-   d.SetSize(width, mt); d.UseDevice(true);
-   z.SetSize(width, mt); z.UseDevice(true);
+void DeflatedCGSolver::Deflate(Vector &v) const
+{
+   const int k = W.Size();
+   if (k == 0) { return; }
+   Array<const Vector*> vx(k), vy(k);
+   for (int i = 0; i < k; i++) { vx[i] = AW[i]; vy[i] = &v; }
+   Vector h(k);
+   StartDots(k, vx.GetData(), vy.GetData(), h.GetData());
+   WaitDots();
+   h.Neg();
+   v.MultiAdd(k, h.GetData(), W.GetData());  // v -= W (A W)^T v
 }
 
-void CGSolver::Mult(const Vector &b, Vector &x) const
+void DeflatedCGSolver::Mult(const Vector &b, Vector &x) const
 {
    int i;
-   real_t r0, den, nom, nom0, betanom, alpha, beta;
+   real_t r0, den, nom, nom0, betanom = 0.0, alpha, beta;
+
+   if (recycle_stale) { RefreshRecycleSpace(); }
+   Vector &zr = prec ? z : r;
 
    x.UseDevice(true);
    if (iterative_mode)
@@ -732,19 +1785,44 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
       r = b;
       x = 0.0;
    }
+   if (prec) { prec->Mult(r, z); } // z = B r
 
-   if (prec)
+   // The relative tolerance refers to the residual before the projection
+   nom0 = Dot(zr, r);
+   if (nom0 >= 0.0) { initial_norm = sqrt(nom0); }
+   MFEM_VERIFY(IsFinite(nom0), "nom0 = " << nom0);
+   if (nom0 < 0.0)
    {
-      prec->Mult(r, z); // z = B r
-      d = z;
+      if (print_options.warnings)
+      {
+         mfem::out << "DCG: The preconditioner is not positive definite. (Br, r) = "
+                   << nom0 << '\n';
+      }
+      converged = false;
+      final_iter = 0;
+      initial_norm = nom0;
+      final_norm = nom0;
+      return;
    }
-   else
-   {
-      d = r;
+   r0 = std::max(nom0*rel_tol*rel_tol, abs_tol*abs_tol);
+
+   // Galerkin projection of the initial guess onto the recycle space
+   const int k = W.Size();
+   nom = nom0;
+   if (k > 0)
+   {
+      Array<const Vector*> vx(k), vy(k);
+      for (int j = 0; j < k; j++) { vx[j] = W[j]; vy[j] = &r; }
+      Vector h(k);
+      StartDots(k, vx.GetData(), vy.GetData(), h.GetData());
+      WaitDots();
+      x.MultiAdd(k, h.GetData(), W.GetData());      // x += W W^T r
+      h.Neg();
+      r.MultiAdd(k, h.GetData(), AW.GetData());     // r -= A W W^T r
+      if (prec) { z.MultiAdd(k, h.GetData(), BAW.GetData()); }
+      nom = Dot(zr, r);
+      MFEM_VERIFY(IsFinite(nom), "nom = " << nom);
    }
-   nom0 = nom = Dot(d, r);
-   if (nom0 >= 0.0) { initial_norm = sqrt(nom0); }
-   MFEM_VERIFY(IsFinite(nom), "nom = " << nom);
    if (print_options.iterations || print_options.first_and_last)
    {
       mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
@@ -752,74 +1830,79 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    }
    Monitor(0, nom, r, x);
 
-   if (nom < 0.0)
-   {
-      if (print_options.warnings)
-      {
-         mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
-                   << nom << '\n';
-      }
-      converged = false;
-      final_iter = 0;
-      initial_norm = nom;
-      final_norm = nom;
-      return;
-   }
-   r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
+   num_dirs = 0;
+   betanom = nom;
+   converged = false;
+   final_iter = max_iter;
    if (nom <= r0)
    {
       converged = true;
       final_iter = 0;
-      final_norm = sqrt(nom);
-      return;
+   }
+   else
+   {
+      d = zr;
+      Deflate(d);
    }
 
-   oper->Mult(d, z);  // z = A d
-   den = Dot(z, d);
-   MFEM_VERIFY(IsFinite(den), "den = " << den);
-   if (den <= 0.0)
+   for (i = 1; !converged; )
    {
-      if (Dot(d, d) > 0.0 && print_options.warnings)
+      oper->Mult(d, q);         //  q = A d
+      den = Dot(d, q);
+      MFEM_VERIFY(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
       {
-         mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
-                   << den << '\n';
+         if (Dot(d, d) > 0.0 && print_options.warnings)
+         {
+            mfem::out << "DCG: The operator is not positive definite. (Ad, d) = "
+                      << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i-1;
+            break;
+         }
       }
-      if (den == 0.0)
+      alpha = nom/den;
+
+      // Store the search direction for the update of the recycle space; with
+      // a preconditioner, B A d = (z_old - z_new)/alpha.
+      const bool store = (recycle_dim > 0 && num_dirs < num_stored);
+      if (store)
       {
-         converged = false;
-         final_iter = 0;
-         final_norm = sqrt(nom);
-         return;
+         if (D.Size() == num_dirs)
+         {
+            D.Append(NewVector());
+            AD.Append(NewVector());
+         }
+         if (prec && BAD.Size() == num_dirs) { BAD.Append(NewVector()); }
+         *D[num_dirs] = d;
+         *AD[num_dirs] = q;
+         if (prec) { *BAD[num_dirs] = z; }
       }
-   }
 
-   // start iteration
-   converged = false;
-   final_iter = max_iter;
-   for (i = 1; true; )
-   {
-      alpha = nom/den;
       add(x,  alpha, d, x);     //  x = x + alpha d
-      add(r, -alpha, z, r);     //  r = r - alpha A d
+      add(r, -alpha, q, r);     //  r = r - alpha A d
 
       if (prec)
       {
          prec->Mult(r, z);      //  z = B r
-         betanom = Dot(r, z);
-      }
-      else
-      {
-         betanom = Dot(r, r);
+         if (store)
+         {
+            *BAD[num_dirs] -= z;
+            *BAD[num_dirs] *= 1.0/alpha;
+         }
       }
+      if (store) { num_dirs++; }
+      betanom = Dot(zr, r);
       MFEM_VERIFY(IsFinite(betanom), "betanom = " << betanom);
       if (betanom < 0.0)
       {
          if (print_options.warnings)
          {
-            mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
+            mfem::out << "DCG: The preconditioner is not positive definite. (Br, r) = "
                       << betanom << '\n';
          }
-         converged = false;
          final_iter = i;
          break;
       }
@@ -845,30 +1928,8 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
       }
 
       beta = betanom/nom;
-      if (prec)
-      {
-         add(z, beta, d, d);   //  d = z + beta d
-      }
-      else
-      {
-         add(r, beta, d, d);
-      }
-      oper->Mult(d, z);       //  z = A d
-      den = Dot(d, z);
-      MFEM_VERIFY(IsFinite(den), "den = " << den);
-      if (den <= 0.0)
-      {
-         if (Dot(d, d) > 0.0 && print_options.warnings)
-         {
-            mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
-                      << den << '\n';
-         }
-         if (den == 0.0)
-         {
-            final_iter = i;
-            break;
-         }
-      }
+      add(zr, beta, d, d);      //  d = z + beta d
+      Deflate(d);               //  d = d - W (A W)^T d
       nom = betanom;
    }
    if (print_options.first_and_last && !print_options.iterations)
@@ -878,22 +1939,29 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    }
    if (print_options.summary || (print_options.warnings && !converged))
    {
-      mfem::out << "PCG: Number of iterations: " << final_iter << '\n';
-   }
-   if (print_options.summary || print_options.iterations ||
-       print_options.first_and_last)
-   {
-      const auto arf = pow (betanom/nom0, 0.5/final_iter);
-      mfem::out << "Average reduction factor = " << arf << '\n';
+      mfem::out << "DCG: Number of iterations: " << final_iter
+                << " (recycle space dimension " << W.Size() << ")\n";
    }
    if (print_options.warnings && !converged)
    {
-      mfem::out << "PCG: No convergence!" << '\n';
+      mfem::out << "DCG: No convergence!" << '\n';
    }
 
    final_norm = sqrt(betanom);
 
    Monitor(final_iter, final_norm, r, x, true);
+
+   UpdateRecycleSpace();
+}
+
+DeflatedCGSolver::~DeflatedCGSolver()
+{
+   DeleteVectors(W);
+   DeleteVectors(AW);
+   DeleteVectors(BAW);
+   DeleteVectors(D);
+   DeleteVectors(AD);
+   DeleteVectors(BAD);
 }
 
 void CG(const Operator &A, const Vector &b, Vector &x,
@@ -972,9 +2040,37 @@ inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
       }
    }
 
-   for (int j = 0; j <= k; j++)
-   {
-      x.Add(y(j), *v[j]);
+   x.MultiAdd(k+1, y.GetData(), v.GetData());
+}
+
+void GMRESSolver::OrthogonalizeCGS(int i, const Array<Vector*> &v,
+                                   Vector &w, DenseMatrix &H) const
+{
+   // Inner products (v[k], w), k = 0,...,i, and (w, w)
+   Array<const Vector*> vx(i+2), vy(i+2);
+   for (int k = 0; k <= i; k++) { vx[k] = v[k]; vy[k] = &w; }
+   vx[i+1] = vy[i+1] = &w;
+   Vector h(i+2);
+
+   for (int k = 0; k <= i; k++) { H(k,i) = 0.0; }
+   for (int pass = 0; pass < 2; pass++)
+   {
+      StartDots(i+2, vx.GetData(), vy.GetData(), h.GetData());
+      WaitDots();
+      const real_t ww_old = h(i+1);
+      real_t hh = 0.0;
+      for (int k = 0; k <= i; k++)
+      {
+         H(k,i) += h(k);
+         hh += h(k)*h(k);
+         h(k) = -h(k);
+      }
+      w.MultiAdd(i+1, h.GetData(), v.GetData());   // w -= V h
+      // ||w - V h||^2 = ||w||^2 - ||h||^2, since the v[k] are orthonormal
+      const real_t ww = ww_old - hh;
+      H(i+1,i) = sqrt(std::max(ww, real_t(0.0)));
+      // No second pass is needed if less than half of ||w||^2 was removed
+      if (ww > 0.5*ww_old) { break; }
    }
 }
 
@@ -1068,13 +2164,20 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
             oper->Mult(*v[i], w);
          }
 
-         for (k = 0; k <= i; k++)
+         if (single_reduction)
          {
-            H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
-            w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
+            OrthogonalizeCGS(i, v, w, H);
          }
+         else
+         {
+            for (k = 0; k <= i; k++)
+            {
+               H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
+               w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
+            }
 
-         H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
+            H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
+         }
          MFEM_VERIFY(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
          if (v[i+1] == NULL) { v[i+1] = new Vector(n); }
          v[i+1]->Set(1.0/H(i+1,i), w); // v[i+1] = w / H(i+1,i)
@@ -1166,6 +2269,195 @@ finish:
    }
 }
 
+void GMRESSolver::ArrayMult(const Array<const Vector *> &B,
+                            Array<Vector *> &X) const
+{
+   MFEM_ASSERT(B.Size() == X.Size(), "Number of columns mismatch!");
+   const int nv = B.Size();
+   const int n = width;
+
+   // Krylov basis and least squares problem of each system
+   struct System
+   {
+      DenseMatrix H;
+      Vector s, cs, sn;
+      Array<Vector *> v;
+      real_t beta, tol;
+      ~System() { for (int i = 0; i < v.Size(); i++) { delete v[i]; } }
+   };
+   std::vector<System> sys(nv);
+   std::vector<Vector> R(nv), W(nv);
+   Array<int> active(nv);  // the systems that are still iterating
+   for (int k = 0; k < nv; k++)
+   {
+      sys[k].H.SetSize(m+1, m);
+      sys[k].s.SetSize(m+1);
+      sys[k].cs.SetSize(m+1);
+      sys[k].sn.SetSize(m+1);
+      sys[k].v.SetSize(m+1, NULL);
+      R[k].SetSize(n);
+      W[k].SetSize(n);
+      active[k] = k;
+   }
+   Array<const Vector *> in;
+   Array<Vector *> out;
+
+   // r = M (b - A x) for the active systems, with x = 0 if zero_x is true
+   auto residuals = [&](bool zero_x)
+   {
+      in.SetSize(active.Size());
+      out.SetSize(active.Size());
+      for (int a = 0; a < active.Size(); a++)
+      {
+         in[a] = X[active[a]];
+         out[a] = &R[active[a]];
+      }
+      if (zero_x)
+      {
+         for (int k : active) { R[k] = *B[k]; }
+      }
+      else
+      {
+         oper->ArrayMult(in, out);
+         for (int k : active) { subtract(*B[k], R[k], R[k]); }
+      }
+      if (prec)
+      {
+         ArrayMultColumns(*prec, active, R.data(), W.data());
+         for (int k : active) { R[k].Swap(W[k]); }
+      }
+   };
+
+   initial_norm = final_norm = 0.0;
+   final_iter = 0;
+   converged = true;
+   // Record the final state of system k and remove it from the iteration
+   auto finish = [&](int k, int iter, real_t norm, bool conv)
+   {
+      final_iter = std::max(final_iter, iter);
+      final_norm = std::max(final_norm, norm);
+      converged = converged && conv;
+      if (print_options.warnings && !conv)
+      {
+         mfem::out << "GMRES: Right-hand side " << k << " did not converge.\n";
+      }
+   };
+   // Compute the norms of the residuals of the active systems, finishing the
+   // converged ones
+   auto restart = [&](int iter)
+   {
+      int j = 0;
+      for (int k : active)
+      {
+         const real_t beta = Norm(R[k]);
+         MFEM_VERIFY(IsFinite(beta), "beta = " << beta);
+         if (iter == 0)
+         {
+            initial_norm = std::max(initial_norm, beta);
+            sys[k].tol = std::max(rel_tol*beta, abs_tol);
+         }
+         sys[k].beta = beta;
+         if (beta <= sys[k].tol) { finish(k, iter, beta, true); }
+         else { active[j++] = k; }
+      }
+      active.SetSize(j);
+   };
+
+   if (!iterative_mode)
+   {
+      for (int k = 0; k < nv; k++) { *X[k] = 0.0; }
+   }
+   residuals(!iterative_mode);
+   restart(0);
+
+   int i, j;
+   for (j = 1; active.Size() > 0 && j <= max_iter; )
+   {
+      for (int k : active)
+      {
+         System &S = sys[k];
+         if (S.v[0] == NULL) { S.v[0] = new Vector(n); }
+         S.v[0]->Set(1.0/S.beta, R[k]);
+         S.s = 0.0; S.s(0) = S.beta;
+      }
+
+      for (i = 0; i < m && j <= max_iter && active.Size() > 0; i++, j++)
+      {
+         // w = M A v[i], for all active systems at once
+         in.SetSize(active.Size());
+         out.SetSize(active.Size());
+         for (int a = 0; a < active.Size(); a++)
+         {
+            in[a] = sys[active[a]].v[i];
+            out[a] = prec ? &R[active[a]] : &W[active[a]];
+         }
+         oper->ArrayMult(in, out);
+         if (prec) { ArrayMultColumns(*prec, active, R.data(), W.data()); }
+
+         int na = 0;
+         for (int k : active)
+         {
+            System &S = sys[k];
+            DenseMatrix &H = S.H;
+            Vector &w = W[k];
+            if (single_reduction)
+            {
+               OrthogonalizeCGS(i, S.v, w, H);
+            }
+            else
+            {
+               for (int l = 0; l <= i; l++)
+               {
+                  H(l,i) = Dot(w, *S.v[l]);  // H(l,i) = w * v[l]
+                  w.Add(-H(l,i), *S.v[l]);   // w -= H(l,i) * v[l]
+               }
+               H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
+            }
+            MFEM_VERIFY(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
+            if (S.v[i+1] == NULL) { S.v[i+1] = new Vector(n); }
+            S.v[i+1]->Set(1.0/H(i+1,i), w); // v[i+1] = w / H(i+1,i)
+
+            for (int l = 0; l < i; l++)
+            {
+               ApplyPlaneRotation(H(l,i), H(l+1,i), S.cs(l), S.sn(l));
+            }
+            GeneratePlaneRotation(H(i,i), H(i+1,i), S.cs(i), S.sn(i));
+            ApplyPlaneRotation(H(i,i), H(i+1,i), S.cs(i), S.sn(i));
+            ApplyPlaneRotation(S.s(i), S.s(i+1), S.cs(i), S.sn(i));
+
+            const real_t resid = fabs(S.s(i+1));
+            MFEM_VERIFY(IsFinite(resid), "resid = " << resid);
+            if (resid <= S.tol)
+            {
+               Update(*X[k], i, H, S.s, S.v);
+               finish(k, j, resid, true);
+               continue;
+            }
+            active[na++] = k;
+         }
+         active.SetSize(na);
+
+         if (print_options.iterations)
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  active right-hand sides = " << na << '\n';
+         }
+      }
+
+      for (int k : active) { Update(*X[k], i-1, sys[k].H, sys[k].s, sys[k].v); }
+      residuals(false);
+      restart(j-1);
+   }
+   for (int k : active) { finish(k, max_iter, sys[k].beta, false); }
+
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "GMRES: Number of iterations: " << final_iter
+                << " (" << nv << " right-hand sides)\n";
+   }
+}
+
 void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 {
    DenseMatrix H(m+1,m);
@@ -2790,6 +4082,11 @@ void BlockILU::SetOperator(const Operator &op)
    MFEM_VERIFY(A->Finalized(), "Matrix must be finalized.");
    CreateBlockPattern(*A);
    Factorize();
+   const int nblockrows = Height()/block_size;
+   CSRLevelSchedule(nblockrows, IB.GetData(), JB.GetData(), true,
+                    lower_ptr, lower_rows);
+   CSRLevelSchedule(nblockrows, IB.GetData(), JB.GetData(), false,
+                    upper_ptr, upper_rows);
 }
 
 void BlockILU::CreateBlockPattern(const SparseMatrix &A)
@@ -2996,53 +4293,98 @@ void BlockILU::Factorize()
    }
 }
 
-void BlockILU::Mult(const Vector &b, Vector &x) const
+void BlockILU::SolveRows(const int *rows, int begin, int end, bool forward,
+                         const Vector &b, Vector &x) const
 {
-   MFEM_VERIFY(height > 0, "BlockILU(0) preconditioner is not constructed");
-   int nblockrows = Height()/block_size;
-   y.SetSize(Height());
-
-   DenseMatrix B;
+   // Thread-local views: the DenseTensor call operator is not thread-safe
+   DenseMatrix A_ij;
    Vector yi, yj, xi, xj;
-   Vector tmp(block_size);
-   // Forward substitute to solve Ly = b
-   // Implicitly, L has identity on the diagonal
-   y = 0.0;
-   for (int i=0; i<nblockrows; ++i)
+   for (int r=begin; r<end; ++r)
    {
-      yi.SetDataAndSize(&y[i*block_size], block_size);
-      for (int ib=0; ib<block_size; ++ib)
+      const int i = rows[r];
+      if (forward)
       {
-         yi[ib] = b[ib + P[i]*block_size];
+         // Implicitly, L has identity on the diagonal
+         yi.SetDataAndSize(&y[i*block_size], block_size);
+         for (int ib=0; ib<block_size; ++ib)
+         {
+            yi[ib] = b[ib + P[i]*block_size];
+         }
+         for (int k=IB[i]; k<ID[i]; ++k)
+         {
+            int j = JB[k];
+            A_ij.UseExternalData(const_cast<real_t*>(AB.GetData(k)),
+                                 block_size, block_size);
+            yj.SetDataAndSize(&y[j*block_size], block_size);
+            // y_i = y_i - L_ij*y_j
+            A_ij.AddMult_a(-1.0, yj, yi);
+         }
       }
-      for (int k=IB[i]; k<ID[i]; ++k)
+      else
       {
-         int j = JB[k];
-         const DenseMatrix &L_ij = AB(k);
-         yj.SetDataAndSize(&y[j*block_size], block_size);
-         // y_i = y_i - L_ij*y_j
-         L_ij.AddMult_a(-1.0, yj, yi);
+         xi.SetDataAndSize(&x[P[i]*block_size], block_size);
+         for (int ib=0; ib<block_size; ++ib)
+         {
+            xi[ib] = y[ib + i*block_size];
+         }
+         for (int k=ID[i]+1; k<IB[i+1]; ++k)
+         {
+            int j = JB[k];
+            A_ij.UseExternalData(const_cast<real_t*>(AB.GetData(k)),
+                                 block_size, block_size);
+            xj.SetDataAndSize(&x[P[j]*block_size], block_size);
+            // x_i = x_i - U_ij*x_j
+            A_ij.AddMult_a(-1.0, xj, xi);
+         }
+         LUFactors A_ii_inv(&DB(0,0,i), &ipiv[i*block_size]);
+         // x_i = D_ii^{-1} x_i
+         A_ii_inv.Solve(block_size, 1, xi.GetData());
       }
    }
-   // Backward substitution to solve Ux = y
-   for (int i=nblockrows-1; i >= 0; --i)
-   {
-      xi.SetDataAndSize(&x[P[i]*block_size], block_size);
-      for (int ib=0; ib<block_size; ++ib)
+}
+
+void BlockILU::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_VERIFY(height > 0, "BlockILU(0) preconditioner is not constructed");
+   y.SetSize(Height());
+   b.HostRead();
+   x.HostReadWrite();
+   y.HostWrite();
+
+   // Forward substitute to solve Ly = b, then backward substitute to solve
+   // Ux = y. The block rows are processed level by level; all rows in a level
+   // depend only on rows of earlier levels, and each row is computed with the
+   // same sequence of operations as in the sequential sweep, so the result
+   // does not depend on the number of threads.
+   for (int pass = 0; pass < 2; ++pass)
+   {
+      const bool forward = (pass == 0);
+      const Array<int> &level_ptr = forward ? lower_ptr : upper_ptr;
+      const int *rows = forward ? lower_rows.GetData() : upper_rows.GetData();
+      const int nlevels = level_ptr.Size() - 1;
+#ifdef MFEM_USE_OPENMP
+      const bool parallel = Device::Allows(Backend::OMP_MASK) &&
+                            !Device::Allows(Backend::DEVICE_MASK) &&
+                            nlevels > 0 && level_ptr[nlevels] >= 16*nlevels;
+      if (parallel)
       {
-         xi[ib] = y[ib + i*block_size];
+         #pragma omp parallel
+         for (int l = 0; l < nlevels; l++)
+         {
+            const int begin = level_ptr[l], end = level_ptr[l+1];
+            const int nt = omp_get_num_threads(), t = omp_get_thread_num();
+            const int size = end - begin;
+            SolveRows(rows, begin + (size*t)/nt, begin + (size*(t+1))/nt,
+                      forward, b, x);
+            #pragma omp barrier
+         }
+         continue;
       }
-      for (int k=ID[i]+1; k<IB[i+1]; ++k)
+#endif
+      for (int l = 0; l < nlevels; l++)
       {
-         int j = JB[k];
-         const DenseMatrix &U_ij = AB(k);
-         xj.SetDataAndSize(&x[P[j]*block_size], block_size);
-         // x_i = x_i - U_ij*x_j
-         U_ij.AddMult_a(-1.0, xj, xi);
+         SolveRows(rows, level_ptr[l], level_ptr[l+1], forward, b, x);
       }
-      LUFactors A_ii_inv(&DB(0,0,i), &ipiv[i*block_size]);
-      // x_i = D_ii^{-1} x_i
-      A_ii_inv.Solve(block_size, 1, xi.GetData());
    }
 }
 
@@ -115,7 +115,9 @@ public:
 private:
    int dot_prod_type; // 0 - local, 1 - global over 'comm'
    MPI_Comm comm = MPI_COMM_NULL;
+   mutable MPI_Request dots_request = MPI_REQUEST_NULL; // see StartDots()
 #endif
+   mutable Vector dots_work; // workspace of Vector::MultiDot() in StartDots()
 
 protected:
    const Operator *oper;
@@ -179,6 +181,29 @@ protected:
    /// Return the inner product norm of @a x, using the inner product defined by Dot()
    real_t Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
 
+   /** @brief Start the computation of the @a n standard (l2) inner products
+       @a dots[i] = (@a x[i], @a y[i]) using a single global reduction. */
+   /** In parallel, the reduction is non-blocking (MPI_Iallreduce), so that
+       local work can be overlapped with the communication: the values in
+       @a dots are available only after the call to WaitDots(), and the array
+       must not be accessed before that. Only one reduction can be in progress
+       at a time.
+
+       Consecutive inner products with the same @a y[i] are computed in a
+       single pass over the data using Vector::MultiDot(). Unlike Dot(), these
+       inner products can not be customized in derived classes. */
+   void StartDots(int n, const Vector *const *x, const Vector *const *y,
+                  real_t *dots) const;
+
+   /// Wait for the completion of the reduction started with StartDots().
+   void WaitDots() const;
+
+   /** @brief Compute @a y += @a a @a x and return the standard (l2) inner
+       product (@a y, @a y), using a single pass over the data. */
+   /** In parallel, the inner product is reduced like in Dot(). Unlike Dot(),
+       it can not be customized in derived classes, see Vector::AddDot(). */
+   real_t AddDot(real_t a, const Vector &x, Vector &y) const;
+
    /// Monitor both the residual @a r and the solution @a x
    void Monitor(int it, real_t norm, const Vector& r, const Vector& x,
                 bool final=false) const;
@@ -507,6 +532,83 @@ void SLI(const Operator &A, Solver &B, const Vector &b, Vector &x,
          int print_iter = 0, int max_num_iter = 1000,
          real_t RTOLERANCE = 1e-12, real_t ATOLERANCE = 1e-24);
 
+/// Mixed-precision iterative refinement.
+/** The outer iteration is a defect correction in full precision: the residual
+    r = b - A x is computed with the operator of SetOperator(), an approximate
+    correction c ~ A^{-1} r is computed by an inner solver in reduced
+    precision, and x is updated with x += c. The stopping criterion uses the
+    norm of the full-precision residual, so the final accuracy is not limited
+    by the precision of the inner solver.
+
+    If the operator is a SparseMatrix, the default inner solver is a Jacobi
+    preconditioned CG in single precision: a float copy of the matrix values
+    is made in SetOperator() and all vectors of the inner iterations are
+    float. The inner solver can instead be set with SetInnerSolver(), e.g. a
+    Krylov solver for a partially assembled form using reduced precision
+    partial assembly data, see BilinearFormIntegrator::SetPADataPrecision().
+    A preconditioner B set with SetPreconditioner() is used as the inner
+    solver, i.e. the iteration is then the preconditioned Richardson iteration
+    x += B (b - A x). */
+class MixedPrecisionRefinementSolver : public IterativeSolver
+{
+protected:
+   /// Single precision copy of the values of the SparseMatrix operator.
+   Array<float> mat_values;
+   /// Inverse of the diagonal of the SparseMatrix operator.
+   Array<float> inv_diag;
+   /// Vectors of the single precision CG.
+   mutable Array<float> fr, fx, fz, fp, fq;
+   /// Partial sums of the single precision inner products.
+   mutable Vector partials;
+
+   Solver *inner_solver = nullptr;
+   real_t inner_rel_tol = 1e-4;
+   int inner_max_iter = 100;
+   mutable int inner_iterations = 0;
+
+   mutable Vector r, c;
+
+   /// Inner product of two single precision vectors, accumulated in real_t.
+   real_t FloatDot(const Array<float> &x, const Array<float> &y) const;
+
+   /** Approximate solution of A c = r using the single precision Jacobi
+       preconditioned CG. Returns the number of iterations. */
+   int FloatCG(const Vector &r, Vector &c) const;
+
+public:
+   MixedPrecisionRefinementSolver() { }
+
+   void SetOperator(const Operator &op) override;
+
+   /** @brief Set the inner solver, which approximates the inverse of the
+       operator in reduced precision. Overrides the default single precision
+       CG for a SparseMatrix operator. */
+   void SetInnerSolver(Solver &solver) { inner_solver = &solver; }
+
+   /// Set the relative tolerance of the single precision CG (default 1e-4).
+   void SetInnerRelTol(real_t rtol) { inner_rel_tol = rtol; }
+
+   /// Set the maximum number of single precision CG iterations (default 100).
+   void SetInnerMaxIter(int max_it) { inner_max_iter = max_it; }
+
+   /** @brief Return the total number of single precision CG iterations of the
+       last call to Mult(). */
+   int GetNumInnerIterations() const { return inner_iterations; }
+
+   /** @brief Set the preconditioner, which is used as the inner solver, see
+       SetInnerSolver(). */
+   /** Unlike with SetInnerSolver(), the operator of @a pr is also set by the
+       following calls to SetOperator(). */
+   void SetPreconditioner(Solver &pr) override
+   {
+      IterativeSolver::SetPreconditioner(pr);
+      inner_solver = &pr;
+   }
+
+   /// Iterative solution of the linear system using iterative refinement.
+   void Mult(const Vector &b, Vector &x) const override;
+};
+
 
 /// Conjugate gradient method
 class CGSolver : public IterativeSolver
@@ -528,7 +630,158 @@ public:
 
    /** @brief Iterative solution of the linear system using the Conjugate
        Gradient method. */
+   /** Without a preconditioner, the update of the residual and its norm are
+       computed in a single pass with IterativeSolver::AddDot(). This is not
+       done in derived classes, which may customize Dot(). */
    void Mult(const Vector &b, Vector &x) const override;
+
+   /** @brief Solve the linear system for each of the right-hand sides @a B[k],
+       using @a X[k] as the initial guess if iterative mode is on. */
+   /** The CG iterations for all right-hand sides are performed together: the
+       operator and the preconditioner are applied to all systems that have
+       not yet converged with a single call to their ArrayMult() method, while
+       the coefficients of each system are computed independently, so that the
+       iterates are the same as with Mult(). Systems drop out of the iteration
+       as they converge. After the call, GetNumIterations(), GetFinalNorm() and
+       GetInitialNorm() return the maximum over the right-hand sides, and
+       GetConverged() is true only if all systems have converged. The monitor
+       is not called. */
+   void ArrayMult(const Array<const Vector *> &B,
+                  Array<Vector *> &X) const override;
+};
+
+/// Pipelined conjugate gradient method
+/** The preconditioned pipelined CG of P. Ghysels and W. Vanroose, "Hiding
+    global synchronization latency in the preconditioned Conjugate Gradient
+    algorithm", Parallel Computing 40 (2014). Each iteration uses a single
+    global reduction for its two inner products, which in parallel is
+    overlapped with the application of the preconditioner and the operator.
+
+    The iterates are the same as in CGSolver in exact arithmetic and the same
+    convergence criterion, based on (B r, r), is used. The method requires
+    more vectors and vector updates than CGSolver and one additional operator
+    and preconditioner application, so it pays off when the global reductions
+    dominate, e.g. on large numbers of MPI ranks. The inner products are the
+    standard ones, see StartDots(). */
+class PipelinedCGSolver : public IterativeSolver
+{
+protected:
+   mutable Vector r, u, w, m, n, p, s, q, z;
+
+   void UpdateVectors();
+
+   /// Update all CG recurrences and the solution @a x in a single pass.
+   void UpdateIterates(bool first, real_t alpha, real_t beta, Vector &x) const;
+
+public:
+   PipelinedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   PipelinedCGSolver(MPI_Comm comm_) : IterativeSolver(comm_) { }
+#endif
+
+   void SetOperator(const Operator &op) override
+   { IterativeSolver::SetOperator(op); UpdateVectors(); }
+
+   /** @brief Iterative solution of the linear system using the pipelined
+       Conjugate Gradient method. */
+   void Mult(const Vector &b, Vector &x) const override;
+};
+
+/// Deflated conjugate gradient method with subspace recycling
+/** The deflated preconditioned CG of Y. Saad, M. Yeung, J. Erhel and F.
+    Guyomarc'h, "A deflated version of the conjugate gradient algorithm", SIAM
+    J. Sci. Comput. 21 (2000), for sequences of symmetric positive definite
+    systems, e.g. the linear systems of the time steps of a transient
+    simulation. The solver keeps a recycle space W of dimension up to
+    SetRecycleDim() between calls to Mult():
+
+    - the initial guess is corrected with the Galerkin projection onto W, so
+      that the initial residual is orthogonal to W;
+    - the search directions are kept A-orthogonal to W, which removes the
+      eigenvalues of the (preconditioned) operator captured by W from the
+      convergence of the iteration;
+    - after each solve, W is replaced by the harmonic Ritz vectors associated
+      with the smallest eigenvalues of B A (B being the preconditioner) in the
+      span of W and the first SetNumStoredDirections() search directions of
+      the solve.
+
+    The first solve is a standard CG solve. The recycle space is kept when
+    SetOperator() or SetPreconditioner() is called and is updated for the new
+    operator at the beginning of the next solve, at the cost of one operator
+    application per recycle vector; it can be discarded with
+    ResetRecycleSpace(). If the operator is modified in place, SetOperator()
+    must be called again before the next solve. The convergence criterion is
+    the same as in CGSolver. */
+class DeflatedCGSolver : public IterativeSolver
+{
+protected:
+   int recycle_dim = 8; // see SetRecycleDim()
+   int num_stored = 20; // see SetNumStoredDirections()
+
+   mutable Vector r, z, d, q;
+   /// Recycle space, A-orthonormal, with A W and B A W.
+   mutable Array<Vector *> W, AW, BAW;
+   /// Stored search directions of the current solve, with A D and B A D.
+   mutable Array<Vector *> D, AD, BAD;
+   /// Number of stored search directions of the current solve.
+   mutable int num_dirs = 0;
+   /// True if #AW and #BAW must be recomputed for the current operator.
+   mutable bool recycle_stale = false;
+
+   void UpdateVectors();
+
+   /// Allocate a vector of the size and memory type of the operator.
+   Vector *NewVector() const;
+
+   /** @brief A-orthonormalize the vectors @a v in place, using @a Av = A v,
+       and update @a BAv = B A v if not NULL. */
+   /** The vectors are reordered so that the first ones, whose number is
+       returned, are the A-orthonormal basis; the numerically dependent ones
+       are moved to the end. */
+   int AOrthonormalize(Array<Vector *> &v, Array<Vector *> &Av,
+                       Array<Vector *> *BAv) const;
+
+   /// Recompute A W and B A W and A-orthonormalize W.
+   void RefreshRecycleSpace() const;
+
+   /// Replace W with the harmonic Ritz vectors from span{W, D}.
+   void UpdateRecycleSpace() const;
+
+   /// Orthogonalize @a v against the recycle space: v -= W (A W)^T v.
+   void Deflate(Vector &v) const;
+
+   static void DeleteVectors(Array<Vector *> &v);
+
+public:
+   DeflatedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   DeflatedCGSolver(MPI_Comm comm_) : IterativeSolver(comm_) { }
+#endif
+
+   void SetOperator(const Operator &op) override;
+
+   void SetPreconditioner(Solver &pr) override;
+
+   /// Set the maximum dimension of the recycle space (default 8).
+   void SetRecycleDim(int dim) { recycle_dim = dim; }
+
+   /** @brief Set the number of search directions of each solve used to
+       update the recycle space (default 20). */
+   void SetNumStoredDirections(int num) { num_stored = num; }
+
+   /// Return the current dimension of the recycle space.
+   int GetRecycleDim() const { return W.Size(); }
+
+   /// Discard the recycle space.
+   void ResetRecycleSpace();
+
+   /** @brief Iterative solution of the linear system using the deflated
+       Conjugate Gradient method, updating the recycle space. */
+   void Mult(const Vector &b, Vector &x) const override;
+
+   ~DeflatedCGSolver();
 };
 
 /// Conjugate gradient method. (tolerances are squared)
@@ -547,6 +800,13 @@ class GMRESSolver : public IterativeSolver
 {
 protected:
    int m; // see SetKDim()
+   bool single_reduction = false; // see SetSingleReduction()
+
+   /** Orthogonalize @a w against v[0..i], computing the column i of the
+       Hessenberg matrix @a H, using classical Gram-Schmidt with the fused
+       inner products of StartDots(). */
+   void OrthogonalizeCGS(int i, const Array<Vector*> &v, Vector &w,
+                         DenseMatrix &H) const;
 
 public:
    GMRESSolver() { m = 50; }
@@ -558,8 +818,30 @@ public:
    /// Set the number of iteration to perform between restarts, default is 50.
    void SetKDim(int dim) { m = dim; }
 
+   /** @brief Use classical Gram-Schmidt with a single global reduction per
+       iteration in the Arnoldi process, instead of modified Gram-Schmidt. */
+   /** All the inner products of an iteration, including the one for the norm
+       of the new basis vector, are computed with one call to StartDots(). The
+       norm is obtained from the Pythagorean identity, and a second pass (with
+       a second reduction) is performed only when cancellation is detected. The
+       default modified Gram-Schmidt requires i+2 reductions in iteration i.
+
+       In this mode, the inner products are the standard ones, and Dot() is
+       used only for the norm of the (restarted) residuals. */
+   void SetSingleReduction(bool single = true) { single_reduction = single; }
+
    /// Iterative solution of the linear system using the GMRES method
    void Mult(const Vector &b, Vector &x) const override;
+
+   /** @brief Solve the linear system for each of the right-hand sides @a B[k],
+       using @a X[k] as the initial guess if iterative mode is on. */
+   /** Each system has its own Krylov basis (of up to KDim+1 vectors) and the
+       iterates are the same as with Mult(), but the operator and the
+       preconditioner are applied to all systems that have not yet converged
+       with a single call to their ArrayMult() method. The reported norms and
+       iteration counts are as in CGSolver::ArrayMult(). */
+   void ArrayMult(const Array<const Vector *> &B,
+                  Array<Vector *> &X) const override;
 };
 
 /// FGMRES method
@@ -1043,6 +1325,12 @@ private:
    /// Perform the block ILU factorization
    void Factorize();
 
+   /** Apply the block triangular solves to the block rows listed in
+       @a rows[begin,end). The forward solve reads from @a b and writes to #y,
+       the backward solve reads from #y and writes to @a x. */
+   void SolveRows(const int *rows, int begin, int end, bool forward,
+                  const Vector &b, Vector &x) const;
+
    int block_size;
 
    /// Fill level for block ILU(k) factorizations. Only k=0 is supported.
@@ -1064,6 +1352,11 @@ private:
    Array<int> IB, ID, JB;
    DenseTensor AB;
 
+   /** Level schedules of the block L and U factors, see CSRLevelSchedule().
+       Block rows within one level are independent and are solved in parallel
+       when OpenMP is enabled. */
+   Array<int> lower_ptr, lower_rows, upper_ptr, upper_rows;
+
    /// DB(i) stores the LU factorization of the i'th diagonal block
    mutable DenseTensor DB;
    /// Pivot arrays for the LU factorizations given by #DB
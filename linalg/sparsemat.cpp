@@ -24,6 +24,10 @@
 #include <limits>
 #include <cstring>
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 #if defined(MFEM_USE_CUDA)
 #define MFEM_cu_or_hip(stub) cu##stub
 #define MFEM_Cu_or_Hip(stub) Cu##stub
@@ -333,6 +337,9 @@ void SparseMatrix::SetEmpty()
    ColPtrJ = NULL;
    ColPtrNode = NULL;
    At = NULL;
+   Ab = nullptr;
+   mp = nullptr;
+   ls = nullptr;
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
 #endif
@@ -462,6 +469,7 @@ void SparseMatrix::SortColumnIndices()
    {
       return;
    }
+   ResetSparsityData();
 
 #ifdef MFEM_USE_CUDA_OR_HIP
    if ( Device::Allows( Backend::CUDA_MASK ))
@@ -599,6 +607,7 @@ void SparseMatrix::SortColumnIndices()
 void SparseMatrix::MoveDiagonalFirst()
 {
    MFEM_VERIFY(Finalized(), "Matrix is not Finalized!");
+   ResetSparsityData();
 
    for (int row = 0, end = 0; row < height; row++)
    {
@@ -786,6 +795,19 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const real_t a) const
       return;
    }
 
+   if (Ab && !Device::Allows(Backend::DEVICE_MASK))
+   {
+      BlockedAddMult(x, y, a, false);
+      return;
+   }
+
+   if (Device::Allows(Backend::OMP_MASK) &&
+       !Device::Allows(Backend::DEVICE_MASK))
+   {
+      MergePathAddMult(x, y, a, false);
+      return;
+   }
+
 #ifndef MFEM_USE_LEGACY_OPENMP
    const int height = this->height;
    const int nnz = J.Capacity();
@@ -988,6 +1010,15 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
    {
       At->AddMult(x, y, a);
    }
+   else if (Ab && !Device::Allows(Backend::DEVICE_MASK))
+   {
+      BlockedAddMult(x, y, a, true);
+   }
+   else if (Device::Allows(Backend::OMP_MASK) &&
+            !Device::Allows(Backend::DEVICE_MASK))
+   {
+      MergePathAddMult(x, y, a, true);
+   }
    else
    {
       real_t *yp = y.HostReadWrite();
@@ -1023,16 +1054,431 @@ void SparseMatrix::ResetTranspose() const
 {
    delete At;
    At = NULL;
+   ResetSparsityData();
 }
 
 void SparseMatrix::EnsureMultTranspose() const
 {
-   if (Device::Allows(~Backend::CPU_MASK))
+   if (Device::Allows(~(Backend::CPU_MASK | Backend::OMP_MASK)))
    {
       BuildTranspose();
    }
 }
 
+struct SparseMatrix::MergePath
+{
+   /// Sizes of the matrix and number of threads used to build the partition
+   int height, width, nnz, nthreads;
+   /// Host arrays #I and #J used to build the partition
+   const int *I, *J;
+   /// Starting row and nonzero of each part on the merge path, size nparts+1
+   Array<int> row, nz;
+   /** First column and offsets in #work of the column range of each part,
+       used in the transpose product. */
+   Array<int> col, offset;
+   /// Per-part results: row carry-outs, and column buffers for the transpose
+   mutable Vector carry, work;
+};
+
+/** Find the coordinates (i, k) where the diagonal @a d intersects the merge
+    path of the row end offsets I[1..height] and the indices 0..nnz-1 of the
+    nonzeros: i rows are completed and k nonzeros are consumed, with i+k=d. */
+static void MergePathSearch(const int d, const int *I, const int height,
+                            const int nnz, int &i, int &k)
+{
+   int lo = std::max(d - nnz, 0), hi = std::min(d, height);
+   while (lo < hi)
+   {
+      const int mid = (lo + hi)/2;
+      if (I[mid+1] <= d - mid - 1) { lo = mid + 1; }
+      else { hi = mid; }
+   }
+   i = lo;
+   k = d - lo;
+}
+
+struct SparseMatrix::LevelSchedule
+{
+   /// Sizes of the matrix for which the schedules were built
+   int height, nnz;
+   /// Host arrays #I and #J used to build the schedules
+   const int *I, *J;
+   /// Level offsets and rows of the forward (lower) and backward (upper) sweeps
+   Array<int> lower_ptr, lower_rows, upper_ptr, upper_rows;
+   /// Values of y at the start of a sweep
+   mutable Vector y_old;
+};
+
+void SparseMatrix::ResetSparsityData() const
+{
+   delete mp;
+   mp = nullptr;
+   delete ls;
+   ls = nullptr;
+}
+
+void SparseMatrix::BuildMergePath() const
+{
+#ifdef MFEM_USE_OPENMP
+   const int nt = omp_get_max_threads();
+#else
+   const int nt = 1;
+#endif
+   const int *Ip = HostRead(I, height+1);
+   const int nnz = Ip[height];
+   const int *Jp = HostRead(J, nnz);
+   // Changes of the pattern that keep the arrays are not detected here, they
+   // must be followed by a call to ResetTranspose().
+   if (mp && mp->height == height && mp->width == width && mp->nnz == nnz &&
+       mp->nthreads == nt && mp->I == Ip && mp->J == Jp) { return; }
+
+   delete mp;
+   mp = new MergePath;
+   mp->height = height;
+   mp->width = width;
+   mp->nnz = nnz;
+   mp->nthreads = nt;
+   mp->I = Ip;
+   mp->J = Jp;
+
+   const int np = std::max(1, std::min(nt, height + nnz));
+   const int len = (height + nnz + np - 1)/np;
+   mp->row.SetSize(np+1);
+   mp->nz.SetSize(np+1);
+   for (int t = 0; t <= np; t++)
+   {
+      MergePathSearch(std::min(t*len, height + nnz), Ip, height, nnz,
+                      mp->row[t], mp->nz[t]);
+   }
+
+   // The column range of a part covers all entries of the rows it touches, so
+   // that it does not depend on the order of the columns within the rows.
+   mp->col.SetSize(np);
+   mp->offset.SetSize(np+1);
+   mp->offset[0] = 0;
+   for (int t = 0; t < np; t++)
+   {
+      const int r_end = std::min(mp->row[t+1] + 1, height);
+      int cmin = width, cmax = -1;
+      for (int k = Ip[mp->row[t]]; k < Ip[r_end]; k++)
+      {
+         cmin = std::min(cmin, Jp[k]);
+         cmax = std::max(cmax, Jp[k]);
+      }
+      mp->col[t] = (cmax < 0) ? 0 : cmin;
+      mp->offset[t+1] = mp->offset[t] + std::max(cmax - cmin + 1, 0);
+   }
+   mp->carry.SetSize(np);
+   mp->carry.UseDevice(false);
+   mp->work.UseDevice(false);
+}
+
+void SparseMatrix::MergePathAddMult(const Vector &x, Vector &y, const real_t a,
+                                    const bool transpose) const
+{
+   BuildMergePath();
+
+   const int *Ip = HostRead(I, height+1);
+   const int nnz = Ip[height];
+   const int *Jp = HostRead(J, nnz);
+   const real_t *Ap = HostRead(A, nnz);
+   const real_t *xp = x.HostRead();
+   real_t *yp = y.HostReadWrite();
+
+   const int np = mp->row.Size() - 1;
+   const int *row = mp->row.GetData(), *nz = mp->nz.GetData();
+   if (!transpose)
+   {
+      // Each part completes its rows and returns the partial sum of the row
+      // where it ends, which is added after the parallel loop.
+      real_t *carry = mp->carry.GetData();
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for num_threads(np) schedule(static, 1)
+#endif
+      for (int t = 0; t < np; t++)
+      {
+         int i = row[t], k = nz[t];
+         real_t d = 0.0;
+         for ( ; i < row[t+1]; i++)
+         {
+            const int end = Ip[i+1];
+            for ( ; k < end; k++) { d += Ap[k] * xp[Jp[k]]; }
+            yp[i] += a * d;
+            d = 0.0;
+         }
+         for ( ; k < nz[t+1]; k++) { d += Ap[k] * xp[Jp[k]]; }
+         carry[t] = d;
+      }
+      for (int t = 0; t < np; t++)
+      {
+         if (row[t+1] < height) { yp[row[t+1]] += a * carry[t]; }
+      }
+   }
+   else
+   {
+      // Each part accumulates into its own buffer over its column range, the
+      // buffers are then added to y one part at a time. The buffers hold the
+      // sum of the column ranges: close to the width for matrices with a
+      // narrow band, at most nthreads times the width in general.
+      const int *col = mp->col.GetData(), *offset = mp->offset.GetData();
+      mp->work.SetSize(offset[np]);
+      real_t *work = mp->work.GetData();
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel num_threads(np)
+#endif
+      {
+#ifdef MFEM_USE_OPENMP
+         #pragma omp for schedule(static, 1)
+#endif
+         for (int t = 0; t < np; t++)
+         {
+            real_t *buf = work + offset[t];
+            const int c0 = col[t];
+            std::fill(buf, work + offset[t+1], real_t(0.0));
+            int i = row[t], k = nz[t];
+            for ( ; i < row[t+1]; i++)
+            {
+               const real_t xi = a * xp[i];
+               const int end = Ip[i+1];
+               for ( ; k < end; k++) { buf[Jp[k] - c0] += Ap[k] * xi; }
+            }
+            if (k < nz[t+1])
+            {
+               const real_t xi = a * xp[i];
+               for ( ; k < nz[t+1]; k++) { buf[Jp[k] - c0] += Ap[k] * xi; }
+            }
+         }
+         // The loop over the parts is sequential so that the updates of the
+         // overlapping column ranges do not race, the work is O(offset[np]).
+         for (int t = 0; t < np; t++)
+         {
+            const real_t *buf = work + offset[t];
+            real_t *yt = yp + col[t];
+            const int nc = offset[t+1] - offset[t];
+#ifdef MFEM_USE_OPENMP
+            #pragma omp for
+#endif
+            for (int c = 0; c < nc; c++) { yt[c] += buf[c]; }
+         }
+      }
+   }
+}
+
+struct SparseMatrix::BlockedStorage
+{
+   int bsize;
+   /// Block row offsets and block column indices
+   Array<int> I, J;
+   /// Values of the blocks, each stored column-major
+   Vector A;
+};
+
+namespace internal
+{
+
+/// y += a A x, with A in BCSR format with blocks of size B.
+template <int B>
+static void BCSRAddMult(const int nbrows, const int *d_I, const int *d_J,
+                        const real_t *d_A, const real_t *d_x, real_t *d_y,
+                        const real_t a)
+{
+   mfem::forall(nbrows, [=] MFEM_HOST_DEVICE (int i)
+   {
+      real_t yb[B];
+      MFEM_UNROLL(B)
+      for (int r = 0; r < B; r++) { yb[r] = 0.0; }
+      const int end = d_I[i+1];
+      for (int k = d_I[i]; k < end; k++)
+      {
+         const real_t *blk = d_A + k*B*B;
+         const real_t *xb = d_x + d_J[k]*B;
+         MFEM_UNROLL(B)
+         for (int c = 0; c < B; c++)
+         {
+            const real_t xc = xb[c];
+            MFEM_UNROLL(B)
+            for (int r = 0; r < B; r++) { yb[r] += blk[r + c*B] * xc; }
+         }
+      }
+      MFEM_UNROLL(B)
+      for (int r = 0; r < B; r++) { d_y[i*B + r] += a * yb[r]; }
+   });
+}
+
+/// y += a A^t x, with A in BCSR format with blocks of size B.
+template <int B>
+static void BCSRAddMultTranspose(const int nbrows, const int *I, const int *J,
+                                 const real_t *A, const real_t *x, real_t *y,
+                                 const real_t a)
+{
+   for (int i = 0; i < nbrows; i++)
+   {
+      real_t xb[B];
+      for (int r = 0; r < B; r++) { xb[r] = a * x[i*B + r]; }
+      const int end = I[i+1];
+      for (int k = I[i]; k < end; k++)
+      {
+         const real_t *blk = A + k*B*B;
+         real_t *yb = y + J[k]*B;
+         for (int c = 0; c < B; c++)
+         {
+            real_t s = 0.0;
+            for (int r = 0; r < B; r++) { s += blk[r + c*B] * xb[r]; }
+            yb[c] += s;
+         }
+      }
+   }
+}
+
+} // namespace internal
+
+int SparseMatrix::BuildBlockedStorage(int block_size) const
+{
+   MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
+   if (Ab) { return Ab->bsize; }
+
+   const int *Ip = HostRead(I, height+1);
+   const int nnz = Ip[height];
+   const int *Jp = HostRead(J, nnz);
+   const real_t *Ap = HostRead(A, nnz);
+
+   // Returns the number of blocks of size b, using marker to find the distinct
+   // block columns of each block row.
+   Array<int> marker;
+   auto count_blocks = [&](const int b)
+   {
+      marker.SetSize(width/b);
+      marker = -1;
+      int nblocks = 0;
+      for (int i = 0; i < height; i++)
+      {
+         for (int k = Ip[i]; k < Ip[i+1]; k++)
+         {
+            const int bj = Jp[k]/b;
+            if (marker[bj] != i/b) { marker[bj] = i/b; nblocks++; }
+         }
+      }
+      return nblocks;
+   };
+
+   int b = block_size;
+   if (b == 0)
+   {
+      b = 1;
+      for (int bs = 4; bs >= 2; bs--)
+      {
+         if (height % bs || width % bs) { continue; }
+         if (4*count_blocks(bs)*bs*bs <= 5*nnz) { b = bs; break; }
+      }
+      if (b == 1) { return 1; }
+   }
+   MFEM_VERIFY(b >= 2 && b <= 4, "invalid block size: " << b);
+   MFEM_VERIFY(height % b == 0 && width % b == 0, "the block size " << b
+               << " does not divide the size of the matrix");
+
+   Ab = new BlockedStorage;
+   Ab->bsize = b;
+   const int nbrows = height/b;
+   Array<int> &bI = Ab->I, &bJ = Ab->J;
+   bI.SetSize(nbrows+1);
+   bJ.SetSize(count_blocks(b));
+
+   // Block sparsity pattern, the blocks are numbered in order of appearance
+   Array<int> position(width/b);
+   marker = -1;
+   bI[0] = 0;
+   for (int bi = 0; bi < nbrows; bi++)
+   {
+      int nb = bI[bi];
+      for (int i = bi*b; i < (bi+1)*b; i++)
+      {
+         for (int k = Ip[i]; k < Ip[i+1]; k++)
+         {
+            const int bj = Jp[k]/b;
+            if (marker[bj] != bi)
+            {
+               marker[bj] = bi;
+               position[bj] = nb;
+               bJ[nb++] = bj;
+            }
+         }
+      }
+      bI[bi+1] = nb;
+   }
+
+   // Values, the pattern is traversed again to find the position of the blocks
+   Vector &bA = Ab->A;
+   bA.SetSize(bJ.Size()*b*b);
+   bA = 0.0;
+   marker = -1;
+   for (int bi = 0; bi < nbrows; bi++)
+   {
+      for (int k = bI[bi]; k < bI[bi+1]; k++) { position[bJ[k]] = k; }
+      for (int i = bi*b; i < (bi+1)*b; i++)
+      {
+         for (int k = Ip[i]; k < Ip[i+1]; k++)
+         {
+            const int j = Jp[k];
+            bA[position[j/b]*b*b + (i%b) + (j%b)*b] += Ap[k];
+         }
+      }
+   }
+   return b;
+}
+
+void SparseMatrix::ResetBlockedStorage() const
+{
+   delete Ab;
+   Ab = nullptr;
+}
+
+int SparseMatrix::GetBlockedStorageSize() const
+{
+   return Ab ? Ab->bsize : 1;
+}
+
+void SparseMatrix::BlockedAddMult(const Vector &x, Vector &y, const real_t a,
+                                  const bool transpose) const
+{
+   const int b = Ab->bsize;
+   const int nbrows = height/b;
+   if (!transpose)
+   {
+      auto d_I = Ab->I.Read(), d_J = Ab->J.Read();
+      auto d_A = Ab->A.Read();
+      auto d_x = x.Read();
+      auto d_y = y.ReadWrite();
+      switch (b)
+      {
+         case 2: internal::BCSRAddMult<2>(nbrows, d_I, d_J, d_A, d_x, d_y, a);
+            break;
+         case 3: internal::BCSRAddMult<3>(nbrows, d_I, d_J, d_A, d_x, d_y, a);
+            break;
+         case 4: internal::BCSRAddMult<4>(nbrows, d_I, d_J, d_A, d_x, d_y, a);
+            break;
+      }
+   }
+   else
+   {
+      auto h_I = Ab->I.HostRead(), h_J = Ab->J.HostRead();
+      auto h_A = Ab->A.HostRead();
+      auto h_x = x.HostRead();
+      auto h_y = y.HostReadWrite();
+      switch (b)
+      {
+         case 2:
+            internal::BCSRAddMultTranspose<2>(nbrows, h_I, h_J, h_A, h_x, h_y, a);
+            break;
+         case 3:
+            internal::BCSRAddMultTranspose<3>(nbrows, h_I, h_J, h_A, h_x, h_y, a);
+            break;
+         case 4:
+            internal::BCSRAddMultTranspose<4>(nbrows, h_I, h_J, h_A, h_x, h_y, a);
+            break;
+      }
+   }
+}
+
 void SparseMatrix::PartMult(
    const Array<int> &rows, const Vector &x, Vector &y) const
 {
@@ -1376,6 +1822,10 @@ void SparseMatrix::Threshold(real_t tol, bool fix_empty_rows)
       }
    }
    Destroy();
+   At = NULL;
+   Ab = nullptr;
+   mp = nullptr;
+   ls = nullptr;
    I.Wrap(newI, height+1, true);
    J.Wrap(newJ, I[height], true);
    A.Wrap(newA, I[height], true);
@@ -1494,6 +1944,8 @@ void SparseMatrix::Finalize(int skip_zeros, bool fix_empty_rows)
 
    delete [] Rows;
    Rows = NULL;
+
+   if (Device::Allows(Backend::OMP_MASK)) { BuildMergePath(); }
 }
 
 void SparseMatrix::GetBlocks(Array2D<SparseMatrix *> &blocks) const
@@ -2448,9 +2900,146 @@ void SparseMatrix::EliminateZeroRows(const real_t threshold)
    }
 }
 
+void CSRLevelSchedule(int n, const int *I, const int *J, bool lower,
+                      Array<int> &level_ptr, Array<int> &level_rows)
+{
+   Array<int> level(n);
+   int nlevels = 0;
+   for (int r = 0; r < n; r++)
+   {
+      const int i = lower ? r : n-1-r;
+      int l = 0;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const int c = J[k];
+         if (lower ? c < i : (c > i && c < n))
+         {
+            l = std::max(l, level[c] + 1);
+         }
+      }
+      level[i] = l;
+      nlevels = std::max(nlevels, l + 1);
+   }
+
+   level_ptr.SetSize(nlevels + 1);
+   level_ptr = 0;
+   for (int i = 0; i < n; i++) { level_ptr[level[i] + 1]++; }
+   level_ptr.PartialSum();
+   level_rows.SetSize(n);
+   for (int i = 0; i < n; i++) { level_rows[level_ptr[level[i]]++] = i; }
+   for (int l = nlevels; l > 0; l--) { level_ptr[l] = level_ptr[l-1]; }
+   level_ptr[0] = 0;
+}
+
+void SparseMatrix::BuildLevelSchedule() const
+{
+   MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
+   const int *Ip = HostRead(I, height+1);
+   const int nnz = Ip[height];
+   const int *Jp = HostRead(J, nnz);
+   if (ls && ls->height == height && ls->nnz == nnz && ls->I == Ip &&
+       ls->J == Jp) { return; }
+
+   delete ls;
+   ls = new LevelSchedule;
+   ls->height = height;
+   ls->nnz = nnz;
+   ls->I = Ip;
+   ls->J = Jp;
+   CSRLevelSchedule(height, Ip, Jp, true, ls->lower_ptr, ls->lower_rows);
+   CSRLevelSchedule(height, Ip, Jp, false, ls->upper_ptr, ls->upper_rows);
+   ls->y_old.UseDevice(false);
+}
+
+void SparseMatrix::LevelScheduledGaussSeidel(const Vector &x, Vector &y,
+                                             const bool forward) const
+{
+   BuildLevelSchedule();
+
+   const int s = height;
+   const int nnz = J.Capacity();
+   const int *Ip = HostRead(I, s+1);
+   const int *Jp = HostRead(J, nnz);
+   const real_t *Ap = HostRead(A, nnz);
+   const real_t *xp = x.HostRead();
+   const int *ptr = forward ? ls->lower_ptr.GetData() : ls->upper_ptr.GetData();
+   const int *rows = forward ? ls->lower_rows.GetData() :
+                     ls->upper_rows.GetData();
+   const int nlevels = (forward ? ls->lower_ptr.Size() : ls->upper_ptr.Size())
+                       - 1;
+
+   // Entries on the not yet swept side of the diagonal use the values of y
+   // from the start of the sweep, as in the sequential sweep. The rows are
+   // summed in the same order as in the sequential sweep, so the result does
+   // not depend on the schedule.
+   ls->y_old = y;
+   const real_t *yo = ls->y_old.HostRead();
+   real_t *yp = y.HostReadWrite();
+
+   // The threads synchronize after each level, so use them only when the
+   // levels are large enough on average.
+   const bool parallel = s >= 64*nlevels;
+   int error = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel if (parallel)
+#else
+   MFEM_CONTRACT_VAR(parallel);
+#endif
+   for (int l = 0; l < nlevels; l++)
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp for schedule(static)
+#endif
+      for (int r = ptr[l]; r < ptr[l+1]; r++)
+      {
+         const int i = rows[r];
+         const int beg = forward ? Ip[i] : Ip[i+1]-1;
+         const int end = forward ? Ip[i+1] : Ip[i]-1;
+         const int inc = forward ? 1 : -1;
+         real_t sum = 0.0;
+         int d = -1;
+         for (int j = beg; j != end; j += inc)
+         {
+            const int c = Jp[j];
+            if (c == i)
+            {
+               d = j;
+            }
+            else
+            {
+               sum += Ap[j] * (((c < i) == forward) ? yp[c] : yo[c]);
+            }
+         }
+
+         if (d >= 0 && Ap[d] != 0.0)
+         {
+            yp[i] = (xp[i] - sum) / Ap[d];
+         }
+         else if (xp[i] == sum)
+         {
+            yp[i] = sum;
+         }
+         else
+         {
+#ifdef MFEM_USE_OPENMP
+            #pragma omp atomic write
+#endif
+            error = 1;
+         }
+      }
+   }
+   MFEM_VERIFY(!error, "SparseMatrix::Gauss_Seidel_"
+               << (forward ? "forw" : "back") << "(...) #3");
+}
+
 void SparseMatrix::Gauss_Seidel_forw(const Vector &x, Vector &y) const
 {
-   if (!Finalized())
+   if (Finalized() && Device::Allows(Backend::OMP_MASK) &&
+       !Device::Allows(Backend::DEVICE_MASK))
+   {
+      LevelScheduledGaussSeidel(x, y, true);
+   }
+   else if (!Finalized())
    {
       real_t *yp = y.GetData();
       const real_t *xp = x.GetData();
@@ -2534,7 +3123,12 @@ void SparseMatrix::Gauss_Seidel_forw(const Vector &x, Vector &y) const
 
 void SparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y) const
 {
-   if (!Finalized())
+   if (Finalized() && Device::Allows(Backend::OMP_MASK) &&
+       !Device::Allows(Backend::DEVICE_MASK))
+   {
+      LevelScheduledGaussSeidel(x, y, false);
+   }
+   else if (!Finalized())
    {
       real_t *yp = y.GetData();
       const real_t *xp = x.GetData();
@@ -3626,6 +4220,9 @@ void SparseMatrix::Destroy()
    delete NodesMem;
 #endif
    delete At;
+   delete Ab;
+   delete mp;
+   delete ls;
 
    ClearGPUSparse();
 }
@@ -3800,132 +4397,300 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
 }
 
 
-SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
-                    SparseMatrix *OAB)
+namespace internal
 {
-   int nrowsA, ncolsA, nrowsB, ncolsB;
-   const int *A_i, *A_j, *B_i, *B_j;
-   int *C_i, *C_j, *B_marker;
-   const real_t *A_data, *B_data;
-   real_t *C_data;
-   int ia, ib, ic, ja, jb, num_nonzeros;
-   int row_start, counter;
-   real_t a_entry, b_entry;
-   SparseMatrix *C;
 
-   nrowsA = A.Height();
-   ncolsA = A.Width();
-   nrowsB = B.Height();
-   ncolsB = B.Width();
+/// Number of threads used in the sparse matrix-matrix operations below.
+static int SpGEMMNumThreads()
+{
+#if defined(MFEM_USE_LEGACY_OPENMP)
+   return omp_get_max_threads();
+#elif defined(MFEM_USE_OPENMP)
+   if (Device::Allows(Backend::OMP_MASK)) { return omp_get_max_threads(); }
+#endif
+   return 1;
+}
 
-   MFEM_VERIFY(ncolsA == nrowsB,
-               "number of columns of A (" << ncolsA
-               << ") must equal number of rows of B (" << nrowsB << ")");
+/// Call f(t) for each thread index t in [0, nt).
+template <typename F>
+static void SpGEMMForEachThread(const int nt, F &&f)
+{
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for num_threads(nt) schedule(static, 1)
+#endif
+   for (int t = 0; t < nt; t++) { f(t); }
+}
 
-   A_i    = A.HostReadI();
-   A_j    = A.HostReadJ();
-   A_data = A.HostReadData();
-   B_i    = B.HostReadI();
-   B_j    = B.HostReadJ();
-   B_data = B.HostReadData();
+/// Symbolic phase: count the distinct columns in a row.
+struct SpGEMMCount
+{
+   int *marker, row, count;
+   void operator()(const int j, const real_t)
+   {
+      if (marker[j] != row) { marker[j] = row; count++; }
+   }
+};
 
-   B_marker = new int[ncolsB];
+/// Numeric phase: fill the columns and the values of a new row.
+struct SpGEMMFill
+{
+   int *marker, *C_j;
+   real_t *C_data;
+   int start, pos;
+   void operator()(const int j, const real_t v)
+   {
+      if (marker[j] < start)
+      {
+         marker[j] = pos;
+         C_j[pos] = j;
+         C_data[pos++] = v;
+      }
+      else
+      {
+         C_data[marker[j]] += v;
+      }
+   }
+};
 
-   for (ib = 0; ib < ncolsB; ib++)
+/// Numeric phase with a given sparsity pattern: only the values are computed.
+struct SpGEMMUpdate
+{
+   const int *marker;
+   real_t *C_data;
+   int start, missing;
+   void operator()(const int j, const real_t v)
    {
-      B_marker[ib] = -1;
+      const int k = marker[j];
+      if (k >= start) { C_data[k] += v; }
+      else { missing++; }
    }
+};
+
+/// Rows of the product A B.
+struct SpGEMMMultRows
+{
+   const int *A_i, *A_j, *B_i, *B_j;
+   const real_t *A_data, *B_data;
 
-   if (OAB == NULL)
+   template <typename AddEntry>
+   void operator()(const int i, AddEntry &add)
    {
-      C_i = Memory<int>(nrowsA+1);
+      for (int ia = A_i[i]; ia < A_i[i+1]; ia++)
+      {
+         const int ja = A_j[ia];
+         const real_t a = A_data[ia];
+         for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+         {
+            add(B_j[ib], a*B_data[ib]);
+         }
+      }
+   }
+};
 
-      C_i[0] = num_nonzeros = 0;
-      for (ic = 0; ic < nrowsA; ic++)
+/** Rows of the triple product R A P. The row i of R A is accumulated in a
+    dense work array and then multiplied by P, so R A is never stored. */
+struct SpGEMMRAPRows
+{
+   const int *R_i, *R_j, *A_i, *A_j, *P_i, *P_j;
+   const real_t *R_data, *A_data, *P_data;
+   Array<int> marker, cols;
+   Vector vals;
+
+   template <typename AddEntry>
+   void operator()(const int i, AddEntry &add)
+   {
+      int n = 0;
+      for (int ir = R_i[i]; ir < R_i[i+1]; ir++)
       {
-         for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+         const int k = R_j[ir];
+         const real_t r = R_data[ir];
+         for (int ia = A_i[k]; ia < A_i[k+1]; ia++)
          {
-            ja = A_j[ia];
-            for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+            const int j = A_j[ia];
+            if (marker[j] < 0)
             {
-               jb = B_j[ib];
-               if (B_marker[jb] != ic)
-               {
-                  B_marker[jb] = ic;
-                  num_nonzeros++;
-               }
+               marker[j] = n;
+               cols[n] = j;
+               vals[n++] = r*A_data[ia];
+            }
+            else
+            {
+               vals[marker[j]] += r*A_data[ia];
             }
          }
-         C_i[ic+1] = num_nonzeros;
       }
+      for (int l = 0; l < n; l++)
+      {
+         const int j = cols[l];
+         const real_t ra = vals[l];
+         marker[j] = -1;
+         for (int ip = P_i[j]; ip < P_i[j+1]; ip++)
+         {
+            add(P_j[ip], ra*P_data[ip]);
+         }
+      }
+   }
+};
 
-      C_j    = Memory<int>(num_nonzeros);
-      C_data = Memory<real_t>(num_nonzeros);
-
-      C = new SparseMatrix(C_i, C_j, C_data, nrowsA, ncolsB);
+/// Rows of the sum a A + b B.
+struct SpGEMMAddRows
+{
+   const int *A_i, *A_j, *B_i, *B_j;
+   const real_t *A_data, *B_data;
+   real_t a, b;
 
-      for (ib = 0; ib < ncolsB; ib++)
+   template <typename AddEntry>
+   void operator()(const int i, AddEntry &add)
+   {
+      for (int ia = A_i[i]; ia < A_i[i+1]; ia++)
+      {
+         add(A_j[ia], a*A_data[ia]);
+      }
+      for (int ib = B_i[i]; ib < B_i[i+1]; ib++)
       {
-         B_marker[ib] = -1;
+         add(B_j[ib], b*B_data[ib]);
       }
    }
-   else
-   {
-      C = OAB;
+};
 
-      MFEM_VERIFY(nrowsA == C->Height() && ncolsB == C->Width(),
-                  "Input matrix sizes do not match output sizes"
-                  << " nrowsA = " << nrowsA
-                  << ", C->Height() = " << C->Height()
-                  << " ncolsB = " << ncolsB
-                  << ", C->Width() = " << C->Width());
+/** @brief Compute the nrows x ncols sparse matrix C whose rows are generated
+    by @a rows, in two phases: the sizes of the rows are computed first and
+    then the rows are filled.
 
-      // C_i    = C->HostReadI(); // not used
-      C_j    = C->HostWriteJ();
-      C_data = C->HostWriteData();
+    The rows are distributed among the threads in contiguous ranges of similar
+    work, as given by the prefix sums @a work (of size nrows+1). Each thread
+    uses a copy of @a rows and its own dense marker array of size ncols.
+
+    If @a OC is not NULL, its sparsity pattern must contain the one of C; the
+    pattern is reused and only the values of @a OC are computed. */
+template <typename RowFunc>
+static SparseMatrix *SpGEMM(const int nrows, const int ncols,
+                            const int *work, const RowFunc &rows,
+                            SparseMatrix *OC)
+{
+   const int nt = std::max(1, std::min(SpGEMMNumThreads(), nrows));
+   Array<int> part(nt+1);
+   part[0] = 0;
+   for (int t = 1; t < nt; t++)
+   {
+      const long long target =
+         work[0] + (long long)(work[nrows] - work[0])*t/nt;
+      const int *p = std::lower_bound(work, work + nrows + 1, target);
+      part[t] = std::max(part[t-1], std::min(int(p - work), nrows));
    }
+   part[nt] = nrows;
 
-   counter = 0;
-   for (ic = 0; ic < nrowsA; ic++)
+   if (OC)
    {
-      // row_start = C_i[ic];
-      row_start = counter;
-      for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
-      {
-         ja = A_j[ia];
-         a_entry = A_data[ia];
-         for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
-         {
-            jb = B_j[ib];
-            b_entry = B_data[ib];
-            if (B_marker[jb] < row_start)
-            {
-               B_marker[jb] = counter;
-               if (OAB == NULL)
-               {
-                  C_j[counter] = jb;
-               }
-               C_data[counter] = a_entry*b_entry;
-               counter++;
-            }
-            else
+      MFEM_VERIFY(nrows == OC->Height() && ncols == OC->Width(),
+                  "Input matrix sizes do not match output sizes"
+                  << " nrows = " << nrows << ", OC->Height() = "
+                  << OC->Height() << " ncols = " << ncols
+                  << ", OC->Width() = " << OC->Width());
+      const int *C_i = OC->HostReadI();
+      const int *C_j = OC->HostReadJ();
+      real_t *C_data = OC->HostWriteData();
+      Array<int> missing(nt);
+      SpGEMMForEachThread(nt, [&](const int t)
+      {
+         RowFunc row(rows);
+         Array<int> marker(ncols);
+         marker = -1;
+         SpGEMMUpdate update = {marker.GetData(), C_data, 0, 0};
+         for (int i = part[t]; i < part[t+1]; i++)
+         {
+            for (int k = C_i[i]; k < C_i[i+1]; k++)
             {
-               C_data[B_marker[jb]] += a_entry*b_entry;
+               marker[C_j[k]] = k;
+               C_data[k] = 0.0;
             }
+            update.start = C_i[i];
+            row(i, update);
          }
-      }
+         missing[t] = update.missing;
+      });
+      MFEM_VERIFY(missing.Sum() == 0, "The sparsity pattern of the output"
+                  " matrix does not contain the pattern of the result.");
+      return OC;
    }
 
-   MFEM_VERIFY(
-      OAB == NULL || counter == OAB->NumNonZeroElems(),
-      "With pre-allocated output matrix, number of non-zeros ("
-      << OAB->NumNonZeroElems()
-      << ") did not match number of entries changed from matrix-matrix multiply, "
-      << counter);
+   int *C_i = Memory<int>(nrows+1);
+   C_i[0] = 0;
+   SpGEMMForEachThread(nt, [&](const int t)
+   {
+      RowFunc row(rows);
+      Array<int> marker(ncols);
+      marker = -1;
+      SpGEMMCount count = {marker.GetData(), 0, 0};
+      for (int i = part[t]; i < part[t+1]; i++)
+      {
+         count.row = i;
+         count.count = 0;
+         row(i, count);
+         C_i[i+1] = count.count;
+      }
+   });
+   for (int i = 0; i < nrows; i++) { C_i[i+1] += C_i[i]; }
 
-   delete [] B_marker;
+   const int nnz = C_i[nrows];
+   int *C_j = Memory<int>(nnz);
+   real_t *C_data = Memory<real_t>(nnz);
+   SpGEMMForEachThread(nt, [&](const int t)
+   {
+      RowFunc row(rows);
+      Array<int> marker(ncols);
+      marker = -1;
+      SpGEMMFill fill = {marker.GetData(), C_j, C_data, 0, 0};
+      for (int i = part[t]; i < part[t+1]; i++)
+      {
+         fill.start = fill.pos = C_i[i];
+         row(i, fill);
+      }
+   });
 
-   return C;
+   return new SparseMatrix(C_i, C_j, C_data, nrows, ncols);
+}
+
+/// Compute R A P, see RAP().
+static SparseMatrix *SpGEMMRAP(const SparseMatrix &R, const SparseMatrix &A,
+                               const SparseMatrix &P, SparseMatrix *ORAP)
+{
+   MFEM_VERIFY(R.Width() == A.Height() && A.Width() == P.Height(),
+               "incompatible matrix sizes: R is " << R.Height() << " x "
+               << R.Width() << ", A is " << A.Height() << " x " << A.Width()
+               << ", P is " << P.Height() << " x " << P.Width());
+   SpGEMMRAPRows rows;
+   rows.R_i = R.HostReadI(); rows.R_j = R.HostReadJ();
+   rows.R_data = R.HostReadData();
+   rows.A_i = A.HostReadI(); rows.A_j = A.HostReadJ();
+   rows.A_data = A.HostReadData();
+   rows.P_i = P.HostReadI(); rows.P_j = P.HostReadJ();
+   rows.P_data = P.HostReadData();
+   rows.marker.SetSize(A.Width());
+   rows.marker = -1;
+   rows.cols.SetSize(A.Width());
+   rows.vals.SetSize(A.Width());
+   return SpGEMM(R.Height(), P.Width(), rows.R_i, rows, ORAP);
+}
+
+} // namespace internal
+
+SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
+                    SparseMatrix *OAB)
+{
+   MFEM_VERIFY(A.Width() == B.Height(),
+               "number of columns of A (" << A.Width()
+               << ") must equal number of rows of B (" << B.Height() << ")");
+
+   internal::SpGEMMMultRows rows;
+   rows.A_i    = A.HostReadI();
+   rows.A_j    = A.HostReadJ();
+   rows.A_data = A.HostReadData();
+   rows.B_i    = B.HostReadI();
+   rows.B_j    = B.HostReadJ();
+   rows.B_data = B.HostReadData();
+
+   return internal::SpGEMM(A.Height(), B.Width(), rows.A_i, rows, OAB);
 }
 
 SparseMatrix * TransposeMult(const SparseMatrix &A, const SparseMatrix &B)
@@ -4073,21 +4838,17 @@ SparseMatrix *RAP (const SparseMatrix &A, const SparseMatrix &R,
                    SparseMatrix *ORAP)
 {
    SparseMatrix *P  = Transpose (R);
-   SparseMatrix *AP = Mult (A, *P);
+   SparseMatrix *RAP_ = internal::SpGEMMRAP(R, A, *P, ORAP);
    delete P;
-   SparseMatrix *RAP_ = Mult (R, *AP, ORAP);
-   delete AP;
    return RAP_;
 }
 
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
-                  const SparseMatrix &P)
+                  const SparseMatrix &P, SparseMatrix *ORAP)
 {
    SparseMatrix * R = Transpose(Rt);
-   SparseMatrix * RA = Mult(*R,A);
+   SparseMatrix * RAP_ = internal::SpGEMMRAP(*R, A, P, ORAP);
    delete R;
-   SparseMatrix * RAP_ = Mult(*RA, P);
-   delete RA;
    return RAP_;
 }
 
@@ -4111,86 +4872,23 @@ SparseMatrix *Mult_AtDA (const SparseMatrix &A, const Vector &D,
 }
 
 SparseMatrix * Add(real_t a, const SparseMatrix & A, real_t b,
-                   const SparseMatrix & B)
+                   const SparseMatrix & B, SparseMatrix *OC)
 {
-   int nrows = A.Height();
-   int ncols = A.Width();
-
-   int * C_i = Memory<int>(nrows+1);
-   int * C_j;
-   real_t * C_data;
-
-   const int *A_i = A.GetI();
-   const int *A_j = A.GetJ();
-   const real_t *A_data = A.GetData();
-
-   const int *B_i = B.GetI();
-   const int *B_j = B.GetJ();
-   const real_t *B_data = B.GetData();
-
-   int * marker = new int[ncols];
-   std::fill(marker, marker+ncols, -1);
-
-   int num_nonzeros = 0, jcol;
-   C_i[0] = 0;
-   for (int ic = 0; ic < nrows; ic++)
-   {
-      for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
-      {
-         jcol = A_j[ia];
-         marker[jcol] = ic;
-         num_nonzeros++;
-      }
-      for (int ib = B_i[ic]; ib < B_i[ic+1]; ib++)
-      {
-         jcol = B_j[ib];
-         if (marker[jcol] != ic)
-         {
-            marker[jcol] = ic;
-            num_nonzeros++;
-         }
-      }
-      C_i[ic+1] = num_nonzeros;
-   }
-
-   C_j = Memory<int>(num_nonzeros);
-   C_data = Memory<real_t>(num_nonzeros);
-
-   for (int ia = 0; ia < ncols; ia++)
-   {
-      marker[ia] = -1;
-   }
-
-   int pos = 0;
-   for (int ic = 0; ic < nrows; ic++)
-   {
-      for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
-      {
-         jcol = A_j[ia];
-         C_j[pos] = jcol;
-         C_data[pos] = a*A_data[ia];
-         marker[jcol] = pos;
-         pos++;
-      }
-      for (int ib = B_i[ic]; ib < B_i[ic+1]; ib++)
-      {
-         jcol = B_j[ib];
-         if (marker[jcol] < C_i[ic])
-         {
-            C_j[pos] = jcol;
-            C_data[pos] = b*B_data[ib];
-            marker[jcol] = pos;
-            pos++;
-         }
-         else
-         {
-            C_data[marker[jcol]] += b*B_data[ib];
-         }
-      }
-   }
-
-   delete[] marker;
-   return new SparseMatrix(C_i, C_j, C_data, nrows, ncols);
+   MFEM_VERIFY(A.Height() == B.Height() && A.Width() == B.Width(),
+               "incompatible matrix sizes: A is " << A.Height() << " x "
+               << A.Width() << ", B is " << B.Height() << " x " << B.Width());
+
+   internal::SpGEMMAddRows rows;
+   rows.A_i = A.HostReadI();
+   rows.A_j = A.HostReadJ();
+   rows.A_data = A.HostReadData();
+   rows.B_i = B.HostReadI();
+   rows.B_j = B.HostReadJ();
+   rows.B_data = B.HostReadData();
+   rows.a = a;
+   rows.b = b;
+
+   return internal::SpGEMM(A.Height(), A.Width(), rows.A_i, rows, OC);
 }
 
 SparseMatrix * Add(const SparseMatrix & A, const SparseMatrix & B)
@@ -4355,6 +5053,9 @@ void SparseMatrix::Swap(SparseMatrix &other)
    mfem::Swap(ColPtrJ, other.ColPtrJ);
    mfem::Swap(ColPtrNode, other.ColPtrNode);
    mfem::Swap(At, other.At);
+   mfem::Swap(Ab, other.Ab);
+   mfem::Swap(mp, other.mp);
+   mfem::Swap(ls, other.ls);
 
 #ifdef MFEM_USE_MEMALLOC
    mfem::Swap(NodesMem, other.NodesMem);
@@ -79,6 +79,53 @@ protected:
    /// Transpose of A. Owned. Used to perform MultTranspose() on devices.
    mutable SparseMatrix *At;
 
+   /// Block CSR (BCSR) storage of the matrix, see BuildBlockedStorage().
+   struct BlockedStorage;
+
+   /// Block CSR copy of A. Owned. Used to perform the products on the host.
+   mutable BlockedStorage *Ab = nullptr;
+
+   /// y += a A x, or y += a A^t x, using the BCSR copy #Ab.
+   void BlockedAddMult(const Vector &x, Vector &y, const real_t a,
+                       const bool transpose) const;
+
+   /// Merge-path partition of the CSR arrays among the OpenMP threads.
+   struct MergePath;
+
+   /** Merge-path partition used to balance the work of the products with the
+       OpenMP backend. Owned. Built in Finalize() when the OpenMP backend is
+       enabled, or in the first product, see BuildMergePath(). */
+   mutable MergePath *mp = nullptr;
+
+   /** @brief Build the merge-path partition #mp, if it is not already built
+       for the current sizes of the matrix and number of OpenMP threads. */
+   /** The merge path of the row offsets and the nonzeros is split into equal
+       parts, one per thread, so that each thread processes about the same
+       number of rows plus nonzeros, regardless of the lengths of the rows. */
+   void BuildMergePath() const;
+
+   /** y += a A x, or y += a A^t x, using the merge-path partition #mp. The
+       transpose product uses per-thread buffers instead of the internal
+       transpose matrix. */
+   void MergePathAddMult(const Vector &x, Vector &y, const real_t a,
+                         const bool transpose) const;
+
+   /// Level schedules of the triangular parts of the sparsity pattern.
+   struct LevelSchedule;
+
+   /** Level schedules used by the Gauss-Seidel sweeps with the OpenMP backend.
+       Owned. Built in the first sweep, see BuildLevelSchedule(). */
+   mutable LevelSchedule *ls = nullptr;
+
+   /** One forward (or backward) Gauss-Seidel sweep using the level schedule
+       #ls, processing the rows of each level in parallel. */
+   void LevelScheduledGaussSeidel(const Vector &x, Vector &y,
+                                  const bool forward) const;
+
+   /** Delete #mp and #ls, which depend on the sparsity pattern. Called when
+       #I or #J are modified, and by ResetTranspose(). */
+   void ResetSparsityData() const;
+
 #ifdef MFEM_USE_MEMALLOC
    typedef MemAlloc <RowNode, 1024> RowNodeAlloc;
    RowNodeAlloc * NodesMem;
@@ -219,11 +266,15 @@ public:
    bool Empty() const { return A.Empty() && (Rows == NULL); }
 
    /// Return the array #I.
+   /** If the sparsity pattern is modified through the returned pointer, call
+       ResetTranspose() before the next product or smoothing sweep. */
    inline int *GetI() { return I; }
    /// Return the array #I, const version.
    inline const int *GetI() const { return I; }
 
    /// Return the array #J.
+   /** If the sparsity pattern is modified through the returned pointer, call
+       ResetTranspose() before the next product or smoothing sweep. */
    inline int *GetJ() { return J; }
    /// Return the array #J, const version.
    inline const int *GetJ() const { return J; }
@@ -346,6 +397,10 @@ public:
    }
 
    /// Matrix vector multiplication.
+   /** With the OpenMP backend, the rows and nonzeros are split among the
+       threads using a merge-path partition, which balances the work when the
+       lengths of the rows vary. The same partition is used in MultTranspose(),
+       without the internal transpose matrix. */
    void Mult(const Vector &x, Vector &y) const override;
 
    /// y += A * x (default)  or  y += a * A * x
@@ -377,12 +432,13 @@ public:
        (optionally) a call to this method. If the internal transpose is already
        built, this method has no effect.
 
-       When any non-serial-CPU backend is enabled, i.e. the call
-       Device::Allows(~ Backend::CPU_MASK) returns true, the above methods
-       require the internal transpose to be built. If that is not the case (i.e.
-       the internal transpose is not built), these methods will automatically
-       call EnsureMultTranspose(). When using any backend from
-       Backend::CPU_MASK, calling this method is optional.
+       When any device backend is enabled, i.e. the call
+       Device::Allows(~ (Backend::CPU_MASK | Backend::OMP_MASK)) returns true,
+       the above methods require the internal transpose to be built. If that is
+       not the case (i.e. the internal transpose is not built), these methods
+       will automatically call EnsureMultTranspose(). When using any backend
+       from Backend::CPU_MASK or Backend::OMP_MASK, calling this method is
+       optional.
 
        This method can only be used when the sparse matrix is finalized.
 
@@ -391,20 +447,61 @@ public:
 
    /** Reset (destroy) the internal transpose matrix. See BuildTranspose() for
        more details. */
+   /** This also resets the merge-path partition and the level schedules used
+       with the OpenMP backend, which have to be rebuilt when the sparsity
+       pattern is modified, e.g. through GetJ(). */
    void ResetTranspose() const;
 
    /** @brief Ensures that the matrix is capable of performing MultTranspose(),
        AddMultTranspose(), and AbsMultTranspose(). */
-   /** For non-serial-CPU backends (e.g. GPU, OpenMP), multiplying by the
-       transpose requires that the internal transpose matrix be already built.
-       When such a backend is enabled, this function will build the internal
-       transpose matrix, see BuildTranspose().
-
-       For the serial CPU backends, the internal transpose is not required, and
-       this function is a no-op. This allows for significant memory savings
-       when the internal transpose matrix is not required. */
+   /** For device backends (e.g. GPU), multiplying by the transpose requires
+       that the internal transpose matrix be already built. When such a backend
+       is enabled, this function will build the internal transpose matrix, see
+       BuildTranspose().
+
+       For the serial CPU and the OpenMP backends, the internal transpose is not
+       required, and this function is a no-op. This allows for significant
+       memory savings when the internal transpose matrix is not required. */
    void EnsureMultTranspose() const;
 
+   /** @brief Build and store internally a block CSR (BCSR) copy of this matrix,
+       with dense square blocks, which will be used in the methods Mult(),
+       AddMult(), MultTranspose() and AddMultTranspose() on the host. */
+   /** With the BCSR storage, one column index is stored per block, and the
+       products use kernels specialized for the block size, which are
+       vectorized by the compiler. This is efficient for matrices with a
+       natural block structure, e.g. vector-valued problems with
+       Ordering::byVDIM.
+
+       If @a block_size is 0, the block size is detected: the largest size in
+       {2, 3, 4}, dividing the height and the width, for which at most 20% of
+       the entries stored in the blocks are explicit zeros (i.e. the blocks
+       store at most 25% more entries than the CSR matrix) is used. Returns
+       the block size of the internal BCSR copy, or 1 if no suitable block
+       size was found (in which case the copy is not built).
+
+       Warning: any changes in this matrix will invalidate the internal BCSR
+       copy. To rebuild it, call ResetBlockedStorage() followed by a call to
+       this method. If the BCSR copy is already built, this method has no
+       effect.
+
+       The BCSR copy is not used when a device backend is enabled, i.e. when
+       Device::Allows(Backend::DEVICE_MASK) returns true, and the internal
+       transpose (see BuildTranspose()) takes precedence over it in the
+       transpose products.
+
+       This method can only be used when the sparse matrix is finalized.
+
+       @sa ResetBlockedStorage(). */
+   int BuildBlockedStorage(int block_size = 0) const;
+
+   /** Reset (destroy) the internal BCSR copy of the matrix. See
+       BuildBlockedStorage() for more details. */
+   void ResetBlockedStorage() const;
+
+   /// Return the block size of the internal BCSR copy, or 1 if it is not built.
+   int GetBlockedStorageSize() const;
+
    void PartMult(const Array<int> &rows, const Vector &x, Vector &y) const;
    void PartAddMult(const Array<int> &rows, const Vector &x, Vector &y,
                     const real_t a=1.0) const;
@@ -515,9 +612,21 @@ public:
    void EliminateZeroRows(const real_t threshold = 1e-12) override;
 
    /// Gauss-Seidel forward and backward iterations over a vector x.
+   /** With the OpenMP backend, the sweeps over a finalized matrix process the
+       rows level by level in parallel, see BuildLevelSchedule(). The result is
+       the same as that of the sequential sweep, for any number of threads. */
    void Gauss_Seidel_forw(const Vector &x, Vector &y) const;
    void Gauss_Seidel_back(const Vector &x, Vector &y) const;
 
+   /** @brief Build the level schedules of the strictly lower and upper
+       triangular parts of the sparsity pattern, used by the Gauss-Seidel
+       sweeps with the OpenMP backend, if they are not already built. */
+   /** The rows of a level depend only on rows of lower levels, see
+       CSRLevelSchedule(). The schedules are built in the first sweep and
+       reused while the sizes of the matrix do not change; calling this method
+       moves the cost to the setup. */
+   void BuildLevelSchedule() const;
+
    /// Determine appropriate scaling for Jacobi iteration
    real_t GetJacobiScaling() const;
    /** One scaled Jacobi iteration for the system A x = b.
@@ -743,9 +852,13 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
                                              int useActualWidth);
 
 /// Matrix product A.B.
-/** If @a OAB is not NULL, we assume it has the structure of A.B and store the
-    result in @a OAB. If @a OAB is NULL, we create a new SparseMatrix to store
-    the result and return a pointer to it.
+/** If @a OAB is not NULL, we assume it has the structure of A.B (or a larger
+    one) and store the result in @a OAB, computing only the values. If @a OAB
+    is NULL, we create a new SparseMatrix to store the result and return a
+    pointer to it.
+
+    The product is computed in two phases, symbolic and numeric, with the rows
+    distributed among the OpenMP threads when the OpenMP backend is enabled.
 
     All matrices must be finalized. */
 SparseMatrix *Mult(const SparseMatrix &A, const SparseMatrix &B,
@@ -772,9 +885,10 @@ DenseMatrix *RAP(DenseMatrix &A, const SparseMatrix &P);
 SparseMatrix *RAP(const SparseMatrix &A, const SparseMatrix &R,
                   SparseMatrix *ORAP = NULL);
 
-/// General RAP with given R^T, A and P
+/** General RAP with given R^T, A and P. ORAP is like OAB above.
+    All matrices must be finalized. */
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
-                  const SparseMatrix &P);
+                  const SparseMatrix &P, SparseMatrix *ORAP = NULL);
 
 /// Matrix multiplication A^t D A. All matrices must be finalized.
 SparseMatrix *Mult_AtDA(const SparseMatrix &A, const Vector &D,
@@ -783,9 +897,9 @@ SparseMatrix *Mult_AtDA(const SparseMatrix &A, const Vector &D,
 
 /// Matrix addition result = A + B.
 SparseMatrix * Add(const SparseMatrix & A, const SparseMatrix & B);
-/// Matrix addition result = a*A + b*B
+/// Matrix addition result = a*A + b*B. OC is like OAB above.
 SparseMatrix * Add(real_t a, const SparseMatrix & A, real_t b,
-                   const SparseMatrix & B);
+                   const SparseMatrix & B, SparseMatrix *OC = NULL);
 /// Matrix addition result = sum_i A_i
 SparseMatrix * Add(Array<SparseMatrix *> & Ai);
 
@@ -804,6 +918,16 @@ SparseMatrix *OuterProduct(const SparseMatrix &A, const DenseMatrix &B);
 /// Produces a block matrix with blocks A_{ij}*B
 SparseMatrix *OuterProduct(const SparseMatrix &A, const SparseMatrix &B);
 
+/** @brief Compute the level schedule of the strictly lower (if @a lower is
+    true) or upper triangular part of the sparsity pattern @a I, @a J of a
+    square matrix with @a n rows. */
+/** On output, the rows of level l are level_rows[level_ptr[l]],...,
+    level_rows[level_ptr[l+1]-1], in increasing order. Each row depends only
+    on rows of lower levels, so the rows of a level can be processed in
+    parallel in a forward (if @a lower) or backward triangular sweep. */
+void CSRLevelSchedule(int n, const int *I, const int *J, bool lower,
+                      Array<int> &level_ptr, Array<int> &level_rows);
+
 
 // Inline methods
 
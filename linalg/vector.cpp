@@ -268,6 +268,181 @@ Vector &Vector::Set(const real_t a, const Vector &Va)
    return *this;
 }
 
+namespace internal
+{
+
+// Maximal number of vectors processed by a single fused kernel
+constexpr int FUSED_MAX_VECTORS = 8;
+
+// Data pointers and coefficients of a group of vectors, captured by value in
+// the fused kernels.
+struct FusedGroup
+{
+   const real_t *v[FUSED_MAX_VECTORS];
+   real_t a[FUSED_MAX_VECTORS];
+};
+
+// Partition of [0,N) into nb parts, each reduced by one thread: part b
+// consists of the entries Start(b), Start(b) + Step(), ... below Stop(b). On
+// devices the parts are interleaved for coalesced memory access, with OpenMP
+// they are contiguous chunks.
+struct FusedPartition
+{
+   int N, nb, chunk;
+   bool strided;
+
+   FusedPartition(bool use_dev, int N_) : N(N_), nb(1), chunk(N_),
+      strided(false)
+   {
+      if (!use_dev) { return; }
+      if (Device::Allows(Backend::DEVICE_MASK))
+      {
+         nb = std::max(1, std::min(N, 4096));
+         strided = true;
+      }
+#ifdef MFEM_USE_OPENMP
+      else if (Device::Allows(Backend::OMP_MASK))
+      {
+         nb = std::max(1, std::min(N, omp_get_max_threads()));
+         chunk = (N + nb - 1)/nb;
+      }
+#endif
+   }
+
+   MFEM_HOST_DEVICE int Start(int b) const { return strided ? b : b*chunk; }
+   MFEM_HOST_DEVICE int Stop(int b) const
+   { return (strided || (b+1)*chunk > N) ? N : (b+1)*chunk; }
+   MFEM_HOST_DEVICE int Step() const { return strided ? nb : 1; }
+};
+
+// Return write access to n*nb partial results, n rows of length nb, stored at
+// the beginning of the workspace w.
+static real_t *FusedPartials(bool use_dev, int n, int nb, Vector &w)
+{
+   w.UseDevice(true);
+   w.SetSize(n*nb + (nb > 1 ? n : 0));
+   return w.Write(use_dev);
+}
+
+// Sum the partial results returned by FusedPartials() into res[k], k < n.
+static void FusedSum(bool use_dev, int n, int nb, Vector &w, real_t *res)
+{
+   const real_t *h_part;
+   if (nb == 1)
+   {
+      h_part = w.HostRead();
+   }
+   else
+   {
+      // The sums are stored after the partial results.
+      auto d_w = w.ReadWrite(use_dev);
+      mfem::forall_switch(use_dev, n, [=] MFEM_HOST_DEVICE (int k)
+      {
+         real_t sum = 0.0;
+         for (int b = 0; b < nb; b++) { sum += d_w[k*nb + b]; }
+         d_w[n*nb + k] = sum;
+      });
+      h_part = w.HostRead() + n*nb;
+   }
+   for (int k = 0; k < n; k++) { res[k] = h_part[k]; }
+}
+
+} // namespace internal
+
+real_t Vector::AddDot(const real_t a, const Vector &x, const Vector &z,
+                      Vector &work)
+{
+   MFEM_ASSERT(size == x.size && size == z.size, "incompatible Vectors!");
+
+   const bool use_dev = UseDevice() || x.UseDevice() || z.UseDevice();
+   const internal::FusedPartition fp(use_dev, size);
+   // Note: get read access first, in case z is the same as *this.
+   auto d_x = x.Read(use_dev);
+   auto d_z = z.Read(use_dev);
+   auto d_y = ReadWrite(use_dev);
+   auto d_part = internal::FusedPartials(use_dev, 1, fp.nb, work);
+   mfem::forall_switch(use_dev, fp.nb, [=] MFEM_HOST_DEVICE (int b)
+   {
+      real_t dot = 0.0;
+      for (int i = fp.Start(b); i < fp.Stop(b); i += fp.Step())
+      {
+         const real_t y_i = d_y[i] + a * d_x[i];
+         d_y[i] = y_i;
+         dot += y_i * d_z[i];
+      }
+      d_part[b] = dot;
+   });
+   real_t dot;
+   internal::FusedSum(use_dev, 1, fp.nb, work, &dot);
+   return dot;
+}
+
+void Vector::MultiDot(int n, const Vector *const *v, real_t *dots,
+                      Vector &work) const
+{
+   using internal::FUSED_MAX_VECTORS;
+
+   bool use_dev = UseDevice();
+   for (int k = 0; k < n; k++)
+   {
+      MFEM_ASSERT(v[k]->size == size, "incompatible Vectors!");
+      use_dev = use_dev || v[k]->UseDevice();
+   }
+   const internal::FusedPartition fp(use_dev, size);
+   for (int k0 = 0; k0 < n; k0 += FUSED_MAX_VECTORS)
+   {
+      const int nk = std::min(n - k0, FUSED_MAX_VECTORS);
+      internal::FusedGroup g;
+      for (int k = 0; k < nk; k++) { g.v[k] = v[k0+k]->Read(use_dev); }
+      auto d_y = Read(use_dev);
+      auto d_part = internal::FusedPartials(use_dev, nk, fp.nb, work);
+      mfem::forall_switch(use_dev, fp.nb, [=] MFEM_HOST_DEVICE (int b)
+      {
+         real_t dot[FUSED_MAX_VECTORS];
+         for (int k = 0; k < nk; k++) { dot[k] = 0.0; }
+         for (int i = fp.Start(b); i < fp.Stop(b); i += fp.Step())
+         {
+            const real_t y_i = d_y[i];
+            for (int k = 0; k < nk; k++) { dot[k] += g.v[k][i] * y_i; }
+         }
+         for (int k = 0; k < nk; k++) { d_part[k*fp.nb + b] = dot[k]; }
+      });
+      internal::FusedSum(use_dev, nk, fp.nb, work, dots + k0);
+   }
+}
+
+Vector &Vector::MultiAdd(int n, const real_t *a, const Vector *const *v)
+{
+   using internal::FUSED_MAX_VECTORS;
+
+   bool use_dev = UseDevice();
+   for (int k = 0; k < n; k++)
+   {
+      MFEM_ASSERT(v[k]->size == size, "incompatible Vectors!");
+      use_dev = use_dev || v[k]->UseDevice();
+   }
+   const int N = size;
+   for (int k0 = 0; k0 < n; k0 += FUSED_MAX_VECTORS)
+   {
+      const int nk = std::min(n - k0, FUSED_MAX_VECTORS);
+      internal::FusedGroup g;
+      for (int k = 0; k < nk; k++)
+      {
+         g.v[k] = v[k0+k]->Read(use_dev);
+         g.a[k] = a[k0+k];
+      }
+      // Note: get read access first, in case *this is one of the v[k].
+      auto d_y = ReadWrite(use_dev);
+      mfem::forall_switch(use_dev, N, [=] MFEM_HOST_DEVICE (int i)
+      {
+         real_t y_i = d_y[i];
+         for (int k = 0; k < nk; k++) { y_i += g.a[k] * g.v[k][i]; }
+         d_y[i] = y_i;
+      });
+   }
+   return *this;
+}
+
 void Vector::SetVector(const Vector &v, int offset)
 {
    MFEM_ASSERT(v.Size() + offset <= size, "invalid sub-vector");
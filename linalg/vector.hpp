@@ -335,6 +335,26 @@ public:
    /// (*this) = a * x
    Vector &Set(const real_t a, const Vector &x);
 
+   /// (*this) += a * x and return the inner product of the result with @a z.
+   /** The update and the inner product are computed in a single pass over the
+       data; @a z may be the same as *this. The partial sums of the threads
+       are stored in @a work, see MultiDot(). */
+   real_t AddDot(const real_t a, const Vector &x, const Vector &z,
+                 Vector &work);
+
+   /// Compute the @a n inner products @a dots[k] = (*@a v[k]) * (*this).
+   /** The inner products are computed in a single pass over the data of *this
+       for up to 8 vectors at a time. Any of the @a v[k] may be *this. The
+       partial sums of the threads are stored in @a work, which is resized as
+       needed and can be reused between calls. */
+   void MultiDot(int n, const Vector *const *v, real_t *dots,
+                 Vector &work) const;
+
+   /// (*this) += sum_k @a a[k] * (*@a v[k]), k = 0,...,n-1.
+   /** The linear combination is accumulated in a single pass over the data of
+       *this for up to 8 vectors at a time. */
+   Vector &MultiAdd(int n, const real_t *a, const Vector *const *v);
+
    void SetVector(const Vector &v, int offset);
 
    void AddSubVector(const Vector &v, int offset);
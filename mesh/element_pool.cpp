@@ -0,0 +1,195 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "element_pool.hpp"
+#include "point.hpp"
+#include "segment.hpp"
+#include "triangle.hpp"
+#include "quadrilateral.hpp"
+#include "tetrahedron.hpp"
+#include "hexahedron.hpp"
+#include "wedge.hpp"
+#include "pyramid.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <new>
+
+namespace mfem
+{
+
+constexpr size_t ElementPool::min_block_size;
+constexpr size_t ElementPool::max_block_size;
+
+size_t ElementPool::ElementSize(Geometry::Type geom)
+{
+   switch (geom)
+   {
+      case Geometry::POINT:       return sizeof(Point);
+      case Geometry::SEGMENT:     return sizeof(Segment);
+      case Geometry::TRIANGLE:    return sizeof(Triangle);
+      case Geometry::SQUARE:      return sizeof(Quadrilateral);
+      case Geometry::TETRAHEDRON: return sizeof(Tetrahedron);
+      case Geometry::CUBE:        return sizeof(Hexahedron);
+      case Geometry::PRISM:       return sizeof(Wedge);
+      case Geometry::PYRAMID:     return sizeof(Pyramid);
+      default:
+         MFEM_ABORT("invalid Geometry::Type, geom = " << geom);
+   }
+   return 0;
+}
+
+void ElementPool::NewBlock(Geometry::Type geom)
+{
+   GeomPool &pool = pools[geom];
+   const size_t num = std::min(std::max(pool.capacity, min_block_size),
+                               max_block_size);
+   Block block;
+   block.bytes = num*ElementSize(geom);
+   block.data = static_cast<char*>(::operator new(block.bytes));
+
+   // Keep the blocks sorted by address, see Owns()
+   int pos = pool.blocks.Size();
+   pool.blocks.Append(block);
+   while (pos > 0 && std::less<char*>()(block.data, pool.blocks[pos-1].data))
+   {
+      pool.blocks[pos] = pool.blocks[pos-1];
+      pos--;
+   }
+   pool.blocks[pos] = block;
+
+   pool.next = block.data;
+   pool.end = block.data + block.bytes;
+   pool.capacity += num;
+}
+
+void *ElementPool::Reserve(Geometry::Type geom)
+{
+   MFEM_VERIFY(geom >= 0 && geom < Geometry::NUM_GEOMETRIES,
+               "invalid Geometry::Type, geom = " << geom);
+   GeomPool &pool = pools[geom];
+   void *mem;
+   if (pool.free_head)
+   {
+      mem = pool.free_head;
+      pool.free_head = *static_cast<void**>(mem);
+   }
+   else
+   {
+      if (pool.next == pool.end) { NewBlock(geom); }
+      mem = pool.next;
+      pool.next += ElementSize(geom);
+   }
+   pool.size++;
+   return mem;
+}
+
+Element *ElementPool::Alloc(Geometry::Type geom)
+{
+   void *mem = Reserve(geom);
+   switch (geom)
+   {
+      case Geometry::POINT:       return new (mem) Point;
+      case Geometry::SEGMENT:     return new (mem) Segment;
+      case Geometry::TRIANGLE:    return new (mem) Triangle;
+      case Geometry::SQUARE:      return new (mem) Quadrilateral;
+      case Geometry::TETRAHEDRON: return new (mem) Tetrahedron;
+      case Geometry::CUBE:        return new (mem) Hexahedron;
+      case Geometry::PRISM:       return new (mem) Wedge;
+      case Geometry::PYRAMID:     return new (mem) Pyramid;
+      default:
+         MFEM_ABORT("invalid Geometry::Type, geom = " << geom);
+   }
+   return NULL;
+}
+
+bool ElementPool::Owns(const Element *el) const
+{
+   const Array<Block> &blocks = pools[el->GetGeometryType()].blocks;
+   const char *p = reinterpret_cast<const char*>(el);
+   // Find the last block starting at or before p
+   int lo = 0, hi = blocks.Size();
+   while (lo < hi)
+   {
+      const int mid = (lo + hi)/2;
+      if (std::less<const char*>()(p, blocks[mid].data)) { hi = mid; }
+      else { lo = mid + 1; }
+   }
+   if (lo == 0) { return false; }
+   const Block &block = blocks[lo-1];
+   return std::less<const char*>()(p, block.data + block.bytes);
+}
+
+void ElementPool::Free(Element *el)
+{
+   MFEM_ASSERT(Owns(el), "the element is not stored in this pool");
+   GeomPool &pool = pools[el->GetGeometryType()];
+   el->~Element();
+   void *mem = el;
+   *static_cast<void**>(mem) = pool.free_head;
+   pool.free_head = mem;
+   pool.size--;
+}
+
+int ElementPool::Size() const
+{
+   int size = 0;
+   for (int g = 0; g < Geometry::NUM_GEOMETRIES; g++)
+   {
+      size += pools[g].size;
+   }
+   return size;
+}
+
+void ElementPool::Clear()
+{
+   for (int g = 0; g < Geometry::NUM_GEOMETRIES; g++)
+   {
+      GeomPool &pool = pools[g];
+      for (int i = 0; i < pool.blocks.Size(); i++)
+      {
+         ::operator delete(pool.blocks[i].data);
+      }
+      pool.blocks.DeleteAll();
+      pool.next = pool.end = nullptr;
+      pool.capacity = 0;
+      pool.free_head = nullptr;
+      pool.size = 0;
+   }
+}
+
+void ElementPool::Swap(ElementPool &other)
+{
+   for (int g = 0; g < Geometry::NUM_GEOMETRIES; g++)
+   {
+      GeomPool &a = pools[g], &b = other.pools[g];
+      mfem::Swap(a.blocks, b.blocks);
+      mfem::Swap(a.next, b.next);
+      mfem::Swap(a.end, b.end);
+      mfem::Swap(a.capacity, b.capacity);
+      mfem::Swap(a.free_head, b.free_head);
+      mfem::Swap(a.size, b.size);
+   }
+}
+
+size_t ElementPool::MemoryUsage() const
+{
+   size_t bytes = 0;
+   for (int g = 0; g < Geometry::NUM_GEOMETRIES; g++)
+   {
+      const Array<Block> &blocks = pools[g].blocks;
+      for (int i = 0; i < blocks.Size(); i++) { bytes += blocks[i].bytes; }
+      bytes += blocks.MemoryUsage();
+   }
+   return bytes;
+}
+
+}
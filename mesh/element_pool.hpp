@@ -0,0 +1,122 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_ELEMENT_POOL
+#define MFEM_ELEMENT_POOL
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "element.hpp"
+
+#include <new>
+#include <utility>
+
+namespace mfem
+{
+
+/// Contiguous storage for the Element objects of a Mesh.
+/** The elements of each Geometry::Type are constructed in large blocks of
+    memory holding elements of that type only, in the order of allocation.
+    This removes the per-element overhead of the heap allocator and keeps the
+    connectivity and the attributes of consecutive elements of the same type
+    next to each other in memory. The elements are accessed through the usual
+    Element interface.
+
+    The size of the blocks grows geometrically with the number of allocated
+    elements, up to a maximum size. The storage of the freed elements is
+    reused by the next allocations of the same type. */
+class ElementPool
+{
+public:
+   ElementPool() { }
+
+   ElementPool(const ElementPool &) = delete;
+   ElementPool &operator=(const ElementPool &) = delete;
+
+   /// Construct a new element of type @a geom in the pool.
+   /** The element has the default vertices and attribute of its class. */
+   Element *Alloc(Geometry::Type geom);
+
+   /** @brief Construct a new element of class @a T, e.g. Triangle, with the
+       constructor arguments @a args in the pool. */
+   template <typename T, typename... Args>
+   T *New(Args&&... args)
+   {
+      const typename T::geom_t *constants = nullptr;
+      return new (Reserve(GeometryOf(constants))) T(std::forward<Args>(args)...);
+   }
+
+   /// Return true if the element @a el is stored in this pool.
+   bool Owns(const Element *el) const;
+
+   /// Destroy the element @a el, which must be stored in this pool.
+   void Free(Element *el);
+
+   /// Return the number of elements allocated and not yet freed.
+   int Size() const;
+
+   /** @brief Release all memory of the pool. Any elements that have not been
+       freed become invalid. */
+   void Clear();
+
+   /// Swap the contents of the pool with @a other.
+   void Swap(ElementPool &other);
+
+   /// Return the number of bytes allocated by the pool.
+   size_t MemoryUsage() const;
+
+   ~ElementPool() { Clear(); }
+
+protected:
+   struct Block
+   {
+      char *data;
+      size_t bytes;
+   };
+
+   /// Storage of the elements of one Geometry::Type.
+   struct GeomPool
+   {
+      /// Blocks of memory, sorted by address.
+      Array<Block> blocks;
+      /// Unused part of the last allocated block.
+      char *next = nullptr, *end = nullptr;
+      /// Total number of elements that fit in the blocks.
+      size_t capacity = 0;
+      /// Head of the list of freed elements, linked through their storage.
+      void *free_head = nullptr;
+      /// Number of allocated elements.
+      int size = 0;
+   };
+
+   GeomPool pools[Geometry::NUM_GEOMETRIES];
+
+   /// Minimum and maximum number of elements in a block.
+   static constexpr size_t min_block_size = 64, max_block_size = 65536;
+
+   /// Return the size of an element object of type @a geom.
+   static size_t ElementSize(Geometry::Type geom);
+
+   /// Allocate a new block for the elements of type @a geom.
+   void NewBlock(Geometry::Type geom);
+
+   /// Return the storage for a new element of type @a geom.
+   void *Reserve(Geometry::Type geom);
+
+   /// Return the Geometry::Type of the element classes with this geom_t.
+   template <Geometry::Type G>
+   static constexpr Geometry::Type GeometryOf(const Geometry::Constants<G> *)
+   { return G; }
+};
+
+}
+
+#endif
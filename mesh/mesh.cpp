@@ -33,6 +33,11 @@
 #include <functional>
 #include <unordered_map>
 #include <unordered_set>
+#include <algorithm>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
 
 // Include the METIS header, if using version 5. If using METIS 4, the needed
 // declarations are inlined below, i.e. no header is needed.
@@ -59,6 +64,12 @@ using namespace std;
 namespace mfem
 {
 
+#ifdef MFEM_USE_OPENMP
+bool Mesh::sort_based_topology = true;
+#else
+bool Mesh::sort_based_topology = false;
+#endif
+
 void Mesh::GetElementJacobian(int i, DenseMatrix &J, const IntegrationPoint *ip)
 {
    Geometry::Type geom = GetElementBaseGeometry(i);
@@ -869,7 +880,13 @@ const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
 
    this->EnsureNodes();
 
-   GeometricFactors *gf = new GeometricFactors(this, ir, flags, d_mt);
+   GeometricFactors *gf = nullptr;
+   if (pa_cache) { gf = pa_cache->LoadGeometricFactors(*this, ir, flags, d_mt); }
+   if (!gf)
+   {
+      gf = new GeometricFactors(this, ir, flags, d_mt);
+      if (pa_cache) { pa_cache->Save(*gf); }
+   }
    geom_factors.Append(gf);
    return gf;
 }
@@ -1583,6 +1600,10 @@ void Mesh::Destroy()
 
    CoarseFineTr.Clear();
 
+   // Keep the storage if some elements are still in use, e.g. the shared
+   // entities of a ParMesh; it is released by the destructor of the pool.
+   if (element_pool.Size() == 0) { element_pool.Clear(); }
+
 #ifdef MFEM_USE_MEMALLOC
    TetMemory.Clear();
 #endif
@@ -1715,43 +1736,40 @@ int Mesh::AddVertexAtMeanCenter(const int *vi, int nverts, int dim)
 
 int Mesh::AddSegment(int v1, int v2, int attr)
 {
-   CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Segment(v1, v2, attr);
-   return NumOfElements++;
+   int vi[2] = {v1, v2};
+   return AddSegment(vi, attr);
 }
 
 int Mesh::AddSegment(const int *vi, int attr)
 {
    CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Segment(vi, attr);
+   elements[NumOfElements] = AllocElement(Geometry::SEGMENT, vi, attr);
    return NumOfElements++;
 }
 
 int Mesh::AddTriangle(int v1, int v2, int v3, int attr)
 {
-   CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Triangle(v1, v2, v3, attr);
-   return NumOfElements++;
+   int vi[3] = {v1, v2, v3};
+   return AddTriangle(vi, attr);
 }
 
 int Mesh::AddTriangle(const int *vi, int attr)
 {
    CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Triangle(vi, attr);
+   elements[NumOfElements] = AllocElement(Geometry::TRIANGLE, vi, attr);
    return NumOfElements++;
 }
 
 int Mesh::AddQuad(int v1, int v2, int v3, int v4, int attr)
 {
-   CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Quadrilateral(v1, v2, v3, v4, attr);
-   return NumOfElements++;
+   int vi[4] = {v1, v2, v3, v4};
+   return AddQuad(vi, attr);
 }
 
 int Mesh::AddQuad(const int *vi, int attr)
 {
    CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Quadrilateral(vi, attr);
+   elements[NumOfElements] = AllocElement(Geometry::SQUARE, vi, attr);
    return NumOfElements++;
 }
 
@@ -1764,59 +1782,47 @@ int Mesh::AddTet(int v1, int v2, int v3, int v4, int attr)
 int Mesh::AddTet(const int *vi, int attr)
 {
    CheckEnlarge(elements, NumOfElements);
-#ifdef MFEM_USE_MEMALLOC
-   Tetrahedron *tet;
-   tet = TetMemory.Alloc();
-   tet->SetVertices(vi);
-   tet->SetAttribute(attr);
-   elements[NumOfElements] = tet;
-#else
-   elements[NumOfElements] = new Tetrahedron(vi, attr);
-#endif
+   elements[NumOfElements] = AllocElement(Geometry::TETRAHEDRON, vi, attr);
    return NumOfElements++;
 }
 
 int Mesh::AddWedge(int v1, int v2, int v3, int v4, int v5, int v6, int attr)
 {
-   CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Wedge(v1, v2, v3, v4, v5, v6, attr);
-   return NumOfElements++;
+   int vi[6] = {v1, v2, v3, v4, v5, v6};
+   return AddWedge(vi, attr);
 }
 
 int Mesh::AddWedge(const int *vi, int attr)
 {
    CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Wedge(vi, attr);
+   elements[NumOfElements] = AllocElement(Geometry::PRISM, vi, attr);
    return NumOfElements++;
 }
 
 int Mesh::AddPyramid(int v1, int v2, int v3, int v4, int v5, int attr)
 {
-   CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Pyramid(v1, v2, v3, v4, v5, attr);
-   return NumOfElements++;
+   int vi[5] = {v1, v2, v3, v4, v5};
+   return AddPyramid(vi, attr);
 }
 
 int Mesh::AddPyramid(const int *vi, int attr)
 {
    CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Pyramid(vi, attr);
+   elements[NumOfElements] = AllocElement(Geometry::PYRAMID, vi, attr);
    return NumOfElements++;
 }
 
 int Mesh::AddHex(int v1, int v2, int v3, int v4, int v5, int v6, int v7, int v8,
                  int attr)
 {
-   CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] =
-      new Hexahedron(v1, v2, v3, v4, v5, v6, v7, v8, attr);
-   return NumOfElements++;
+   int vi[8] = {v1, v2, v3, v4, v5, v6, v7, v8};
+   return AddHex(vi, attr);
 }
 
 int Mesh::AddHex(const int *vi, int attr)
 {
    CheckEnlarge(elements, NumOfElements);
-   elements[NumOfElements] = new Hexahedron(vi, attr);
+   elements[NumOfElements] = AllocElement(Geometry::CUBE, vi, attr);
    return NumOfElements++;
 }
 
@@ -2035,43 +2041,40 @@ int Mesh::AddBdrElement(Element *elem)
 
 int Mesh::AddBdrSegment(int v1, int v2, int attr)
 {
-   CheckEnlarge(boundary, NumOfBdrElements);
-   boundary[NumOfBdrElements] = new Segment(v1, v2, attr);
-   return NumOfBdrElements++;
+   int vi[2] = {v1, v2};
+   return AddBdrSegment(vi, attr);
 }
 
 int Mesh::AddBdrSegment(const int *vi, int attr)
 {
    CheckEnlarge(boundary, NumOfBdrElements);
-   boundary[NumOfBdrElements] = new Segment(vi, attr);
+   boundary[NumOfBdrElements] = AllocElement(Geometry::SEGMENT, vi, attr);
    return NumOfBdrElements++;
 }
 
 int Mesh::AddBdrTriangle(int v1, int v2, int v3, int attr)
 {
-   CheckEnlarge(boundary, NumOfBdrElements);
-   boundary[NumOfBdrElements] = new Triangle(v1, v2, v3, attr);
-   return NumOfBdrElements++;
+   int vi[3] = {v1, v2, v3};
+   return AddBdrTriangle(vi, attr);
 }
 
 int Mesh::AddBdrTriangle(const int *vi, int attr)
 {
    CheckEnlarge(boundary, NumOfBdrElements);
-   boundary[NumOfBdrElements] = new Triangle(vi, attr);
+   boundary[NumOfBdrElements] = AllocElement(Geometry::TRIANGLE, vi, attr);
    return NumOfBdrElements++;
 }
 
 int Mesh::AddBdrQuad(int v1, int v2, int v3, int v4, int attr)
 {
-   CheckEnlarge(boundary, NumOfBdrElements);
-   boundary[NumOfBdrElements] = new Quadrilateral(v1, v2, v3, v4, attr);
-   return NumOfBdrElements++;
+   int vi[4] = {v1, v2, v3, v4};
+   return AddBdrQuad(vi, attr);
 }
 
 int Mesh::AddBdrQuad(const int *vi, int attr)
 {
    CheckEnlarge(boundary, NumOfBdrElements);
-   boundary[NumOfBdrElements] = new Quadrilateral(vi, attr);
+   boundary[NumOfBdrElements] = AllocElement(Geometry::SQUARE, vi, attr);
    return NumOfBdrElements++;
 }
 
@@ -2093,7 +2096,7 @@ void Mesh::AddBdrQuadAsTriangles(const int *vi, int attr)
 int Mesh::AddBdrPoint(int v, int attr)
 {
    CheckEnlarge(boundary, NumOfBdrElements);
-   boundary[NumOfBdrElements] = new Point(&v, attr);
+   boundary[NumOfBdrElements] = AllocElement(Geometry::POINT, &v, attr);
    return NumOfBdrElements++;
 }
 
@@ -2124,7 +2127,7 @@ void Mesh::GenerateBoundaryElements()
    {
       if (faces_info[i].Elem2No < 0)
       {
-         boundary[j] = faces[i]->Duplicate(this);
+         boundary[j] = AllocElement(*faces[i]);
          be_to_face[j++] = i;
       }
    }
@@ -3642,14 +3645,14 @@ void Mesh::Make2D4TrisFromQuad(int nx, int ny, real_t sx, real_t sy)
    int m = (nx+1)*ny;
    for (int i = 0; i < nx; i++)
    {
-      boundary[i] = new Segment(i, i+1, 1);
-      boundary[nx+i] = new Segment(m+i+1, m+i, 3);
+      boundary[i] = AllocSegment(i, i+1, 1);
+      boundary[nx+i] = AllocSegment(m+i+1, m+i, 3);
    }
    m = nx+1;
    for (int j = 0; j < ny; j++)
    {
-      boundary[2*nx+j] = new Segment((j+1)*m, j*m, 4);
-      boundary[2*nx+ny+j] = new Segment(j*m+nx, (j+1)*m+nx, 2);
+      boundary[2*nx+j] = AllocSegment((j+1)*m, j*m, 4);
+      boundary[2*nx+ny+j] = AllocSegment(j*m+nx, (j+1)*m+nx, 2);
    }
 
    SetMeshGen();
@@ -3716,14 +3719,14 @@ void Mesh::Make2D5QuadsFromQuad(int nx, int ny,
    int m = (nx+1)*ny;
    for (int i = 0; i < nx; i++)
    {
-      boundary[i] = new Segment(i, i+1, 1);
-      boundary[nx+i] = new Segment(m+i+1, m+i, 3);
+      boundary[i] = AllocSegment(i, i+1, 1);
+      boundary[nx+i] = AllocSegment(m+i+1, m+i, 3);
    }
    m = nx+1;
    for (int j = 0; j < ny; j++)
    {
-      boundary[2*nx+j] = new Segment((j+1)*m, j*m, 4);
-      boundary[2*nx+ny+j] = new Segment(j*m+nx, (j+1)*m+nx, 2);
+      boundary[2*nx+j] = AllocSegment((j+1)*m, j*m, 4);
+      boundary[2*nx+ny+j] = AllocSegment(j*m+nx, (j+1)*m+nx, 2);
    }
 
    SetMeshGen();
@@ -3911,7 +3914,7 @@ void Mesh::Make2D(int nx, int ny, Element::Type type,
             ind[1] = i + 1 +j*(nx+1);
             ind[2] = i + 1 + (j+1)*(nx+1);
             ind[3] = i + (j+1)*(nx+1);
-            elements[k] = new Quadrilateral(ind);
+            elements[k] = AllocElement(Geometry::SQUARE, ind, 1);
          }
       }
       else
@@ -3925,7 +3928,7 @@ void Mesh::Make2D(int nx, int ny, Element::Type type,
                ind[1] = i + 1 +j*(nx+1);
                ind[2] = i + 1 + (j+1)*(nx+1);
                ind[3] = i + (j+1)*(nx+1);
-               elements[k] = new Quadrilateral(ind);
+               elements[k] = AllocElement(Geometry::SQUARE, ind, 1);
                k++;
             }
          }
@@ -3935,14 +3938,14 @@ void Mesh::Make2D(int nx, int ny, Element::Type type,
       int m = (nx+1)*ny;
       for (i = 0; i < nx; i++)
       {
-         boundary[i] = new Segment(i, i+1, 1);
-         boundary[nx+i] = new Segment(m+i+1, m+i, 3);
+         boundary[i] = AllocSegment(i, i+1, 1);
+         boundary[nx+i] = AllocSegment(m+i+1, m+i, 3);
       }
       m = nx+1;
       for (j = 0; j < ny; j++)
       {
-         boundary[2*nx+j] = new Segment((j+1)*m, j*m, 4);
-         boundary[2*nx+ny+j] = new Segment(j*m+nx, (j+1)*m+nx, 2);
+         boundary[2*nx+j] = AllocSegment((j+1)*m, j*m, 4);
+         boundary[2*nx+ny+j] = AllocSegment(j*m+nx, (j+1)*m+nx, 2);
       }
    }
    // Creates triangular mesh
@@ -3982,11 +3985,11 @@ void Mesh::Make2D(int nx, int ny, Element::Type type,
             ind[0] = i + j*(nx+1);
             ind[1] = i + 1 + (j+1)*(nx+1);
             ind[2] = i + (j+1)*(nx+1);
-            elements[k] = new Triangle(ind);
+            elements[k] = AllocElement(Geometry::TRIANGLE, ind, 1);
             k++;
             ind[1] = i + 1 + j*(nx+1);
             ind[2] = i + 1 + (j+1)*(nx+1);
-            elements[k] = new Triangle(ind);
+            elements[k] = AllocElement(Geometry::TRIANGLE, ind, 1);
             k++;
          }
       }
@@ -3995,14 +3998,14 @@ void Mesh::Make2D(int nx, int ny, Element::Type type,
       int m = (nx+1)*ny;
       for (i = 0; i < nx; i++)
       {
-         boundary[i] = new Segment(i, i+1, 1);
-         boundary[nx+i] = new Segment(m+i+1, m+i, 3);
+         boundary[i] = AllocSegment(i, i+1, 1);
+         boundary[nx+i] = AllocSegment(m+i+1, m+i, 3);
       }
       m = nx+1;
       for (j = 0; j < ny; j++)
       {
-         boundary[2*nx+j] = new Segment((j+1)*m, j*m, 4);
-         boundary[2*nx+ny+j] = new Segment(j*m+nx, (j+1)*m+nx, 2);
+         boundary[2*nx+j] = AllocSegment((j+1)*m, j*m, 4);
+         boundary[2*nx+ny+j] = AllocSegment(j*m+nx, (j+1)*m+nx, 2);
       }
 
       // MarkTriMeshForRefinement(); // done in Finalize(...)
@@ -4061,14 +4064,14 @@ void Mesh::Make1D(int n, real_t sx)
    // Sets elements and the corresponding indices of vertices
    for (j = 0; j < n; j++)
    {
-      elements[j] = new Segment(j, j+1, 1);
+      elements[j] = AllocSegment(j, j+1, 1);
    }
 
    // Sets the boundary elements
    ind[0] = 0;
-   boundary[0] = new Point(ind, 1);
+   boundary[0] = AllocElement(Geometry::POINT, ind, 1);
    ind[0] = n;
-   boundary[1] = new Point(ind, 2);
+   boundary[1] = AllocElement(Geometry::POINT, ind, 2);
 
    NumOfEdges = 0;
    NumOfFaces = 0;
@@ -4111,7 +4114,7 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
    elements.SetSize(NumOfElements);
    for (int i = 0; i < NumOfElements; i++)
    {
-      elements[i] = mesh.elements[i]->Duplicate(this);
+      elements[i] = AllocElement(*mesh.elements[i]);
    }
 
    // Copy the vertices
@@ -4121,7 +4124,7 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
    boundary.SetSize(NumOfBdrElements);
    for (int i = 0; i < NumOfBdrElements; i++)
    {
-      boundary[i] = mesh.boundary[i]->Duplicate(this);
+      boundary[i] = AllocElement(*mesh.boundary[i]);
    }
 
    // Copy the element-to-face Table, el_to_face
@@ -4141,7 +4144,7 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
    for (int i = 0; i < faces.Size(); i++)
    {
       Element *face = mesh.faces[i]; // in 1D the faces are NULL
-      faces[i] = (face) ? face->Duplicate(this) : NULL;
+      faces[i] = (face) ? AllocElement(*face) : NULL;
    }
    mesh.faces_info.Copy(faces_info);
    mesh.nc_faces_info.Copy(nc_faces_info);
@@ -4382,7 +4385,7 @@ Mesh::Mesh(real_t *vertices_, int num_vertices,
 
    for (int i = 0; i < num_elements; i++)
    {
-      elements[i] = NewElement(element_type);
+      elements[i] = AllocElement(element_type);
       elements[i]->SetVertices(element_indices + i * element_index_stride);
       elements[i]->SetAttribute(element_attributes[i]);
    }
@@ -4390,7 +4393,7 @@ Mesh::Mesh(real_t *vertices_, int num_vertices,
 
    for (int i = 0; i < num_boundary_elements; i++)
    {
-      boundary[i] = NewElement(boundary_type);
+      boundary[i] = AllocElement(boundary_type);
       boundary[i]->SetVertices(boundary_indices + i * boundary_index_stride);
       boundary[i]->SetAttribute(boundary_attributes[i]);
    }
@@ -4423,13 +4426,26 @@ Element *Mesh::NewElement(int geom)
    return NULL;
 }
 
+Element *Mesh::AllocElement(const Element &el)
+{
+   Element *copy = AllocElement(el.GetGeometryType(), el.GetVertices(),
+                                el.GetAttribute());
+   if (el.GetType() == Element::TETRAHEDRON)
+   {
+      const Tetrahedron &tet = static_cast<const Tetrahedron&>(el);
+      static_cast<Tetrahedron*>(copy)->SetRefinementFlag(
+         tet.GetRefinementFlag());
+   }
+   return copy;
+}
+
 Element *Mesh::ReadElementWithoutAttr(std::istream &input)
 {
    int geom, nv, *v;
    Element *el;
 
    input >> geom;
-   el = NewElement(geom);
+   el = AllocElement(geom);
    MFEM_VERIFY(el, "Unsupported element type: " << geom);
    nv = el->GetNVertices();
    v  = el->GetVertices();
@@ -4643,6 +4659,11 @@ void Mesh::Loader(std::istream &input, int generate_edges,
       ReadInlineMesh(input, generate_edges);
       return; // done with inline mesh construction
    }
+   else if (mesh_type == "MFEM binary mesh v1.0")
+   {
+      ReadBinaryMesh(input);
+      return; // done with binary mesh construction
+   }
    else if (mesh_type == "$MeshFormat") // Gmsh
    {
       ReadGmshMesh(input, curved, read_gf);
@@ -4801,7 +4822,7 @@ Mesh::Mesh(Mesh *mesh_array[], int num_pieces)
          // copy the boundary
          for (j = 0; j < m->GetNBE(); j++)
          {
-            el = m->GetBdrElement(j)->Duplicate(this);
+            el = AllocElement(*m->GetBdrElement(j));
             v  = el->GetVertices();
             nv = el->GetNVertices();
             for (int k = 0; k < nv; k++)
@@ -4840,7 +4861,7 @@ Mesh::Mesh(Mesh *mesh_array[], int num_pieces)
          // copy the elements
          for (j = 0; j < m->GetNE(); j++)
          {
-            el = m->GetElement(j)->Duplicate(this);
+            el = AllocElement(*m->GetElement(j));
             v  = el->GetVertices();
             nv = el->GetNVertices();
             for (int k = 0; k < nv; k++)
@@ -4852,7 +4873,7 @@ Mesh::Mesh(Mesh *mesh_array[], int num_pieces)
          // copy the boundary elements
          for (j = 0; j < m->GetNBE(); j++)
          {
-            el = m->GetBdrElement(j)->Duplicate(this);
+            el = AllocElement(*m->GetBdrElement(j));
             v  = el->GetVertices();
             nv = el->GetNVertices();
             for (int k = 0; k < nv; k++)
@@ -4965,7 +4986,7 @@ void Mesh::MakeRefined_(Mesh &orig_mesh, const Array<int> &ref_factors,
       }
       for (int j = 0; j < RG.RefGeoms.Size()/nvert; j++)
       {
-         Element *elem = NewElement(geom);
+         Element *elem = AllocElement(geom);
          elem->SetAttribute(attrib);
          int *v = elem->GetVertices();
          for (int k = 0; k < nvert; k++)
@@ -4998,7 +5019,7 @@ void Mesh::MakeRefined_(Mesh &orig_mesh, const Array<int> &ref_factors,
       const int *c2h_map = rfec.GetDofMap(geom, ref_factors[i]);
       for (int j = 0; j < RG.RefGeoms.Size()/nvert; j++)
       {
-         Element *elem = NewElement(geom);
+         Element *elem = AllocElement(geom);
          elem->SetAttribute(attrib);
          int *v = elem->GetVertices();
          for (int k = 0; k < nvert; k++)
@@ -5296,7 +5317,7 @@ void Mesh::MakeSimplicial_(const Mesh &orig_mesh, int *vglobal)
          // (num_subdivisions[orig_geom] == 1) implies that the element does
          // not need to be further split (it is either a segment, triangle,
          // or tetrahedron), and so it is left unchanged.
-         Element *e = NewElement(orig_geom);
+         Element *e = AllocElement(orig_geom);
          e->SetAttribute(attrib);
          e->SetVertices(v);
          AddElement(e);
@@ -5305,7 +5326,7 @@ void Mesh::MakeSimplicial_(const Mesh &orig_mesh, int *vglobal)
       {
          for (int itri=0; itri<quad_ntris; ++itri)
          {
-            Element *e = NewElement(Geometry::TRIANGLE);
+            Element *e = AllocElement(Geometry::TRIANGLE);
             e->SetAttribute(attrib);
             int *v2 = e->GetVertices();
             for (int iv=0; iv<nv_tri; ++iv)
@@ -5334,7 +5355,7 @@ void Mesh::MakeSimplicial_(const Mesh &orig_mesh, int *vglobal)
          const int *tetmap = (j == 0 || j == 2) ? prism_tetmaps[0] : prism_tetmaps[1];
          for (int itet=0; itet<prism_ntets; ++itet)
          {
-            Element *e = NewElement(Geometry::TETRAHEDRON);
+            Element *e = AllocElement(Geometry::TETRAHEDRON);
             e->SetAttribute(attrib);
             int *v2 = e->GetVertices();
             for (int iv=0; iv<nv_tet; ++iv)
@@ -5397,7 +5418,7 @@ void Mesh::MakeSimplicial_(const Mesh &orig_mesh, int *vglobal)
          const int *tetmap = hex_tetmaps[ndiags];
          for (int itet=0; itet<ntets; ++itet)
          {
-            Element *e = NewElement(Geometry::TETRAHEDRON);
+            Element *e = AllocElement(Geometry::TETRAHEDRON);
             e->SetAttribute(attrib);
             int *v2 = e->GetVertices();
             for (int iv=0; iv<nv_tet; ++iv)
@@ -5418,7 +5439,7 @@ void Mesh::MakeSimplicial_(const Mesh &orig_mesh, int *vglobal)
       const Geometry::Type orig_geom = orig_mesh.GetBdrElementGeometry(i);
       if (num_subdivisions[orig_geom] == 1)
       {
-         Element *be = NewElement(orig_geom);
+         Element *be = AllocElement(orig_geom);
          be->SetAttribute(attrib);
          be->SetVertices(v);
          AddBdrElement(be);
@@ -5432,7 +5453,7 @@ void Mesh::MakeSimplicial_(const Mesh &orig_mesh, int *vglobal)
          int isplit = (iv_min == 0 || iv_min == 2) ? 0 : 1;
          for (int itri=0; itri<quad_ntris; ++itri)
          {
-            Element *be = NewElement(Geometry::TRIANGLE);
+            Element *be = AllocElement(Geometry::TRIANGLE);
             be->SetAttribute(attrib);
             int *v2 = be->GetVertices();
             for (int iv=0; iv<nv_tri; ++iv)
@@ -7427,6 +7448,225 @@ void Mesh::GetElementArrayEdgeTable(const Array<Element*> &elem_array,
    el_to_edge.ShiftUpI();
 }
 
+// Entry of the sort-based construction of the edges and faces: the key, e.g.
+// the sorted vertices identifying an edge (NV = 2) or a face (NV = 3), and the
+// position of the entry in the traversal of the elements.
+template <int NV>
+struct TopologyEntry
+{
+   int v[NV];
+   int pos;
+};
+
+template <int NV>
+static inline bool SameKey(const TopologyEntry<NV> &a,
+                           const TopologyEntry<NV> &b)
+{
+   for (int i = 0; i < NV; i++)
+   {
+      if (a.v[i] != b.v[i]) { return false; }
+   }
+   return true;
+}
+
+static inline int TopologyMaxThreads()
+{
+#ifdef MFEM_USE_OPENMP
+   return omp_get_max_threads();
+#else
+   return 1;
+#endif
+}
+
+// Return the index of the calling thread and its range [beg, end) of [0, n).
+static inline int TopologyThreadRange(int n, int &beg, int &end)
+{
+#ifdef MFEM_USE_OPENMP
+   const int nt = omp_get_num_threads(), t = omp_get_thread_num();
+#else
+   const int nt = 1, t = 0;
+#endif
+   beg = (int)(((long long) n*t)/nt);
+   end = (int)(((long long) n*(t+1))/nt);
+   return t;
+}
+
+// Replace the entries of 'a' with their exclusive prefix sum and return the
+// total sum.
+static int TopologyExclusiveScan(Array<int> &a)
+{
+   const int n = a.Size(), nt = TopologyMaxThreads();
+   Array<int> sums(nt+1);
+   sums = 0;
+   int *ap = a.GetData(), *sp = sums.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel num_threads(nt)
+#endif
+   {
+      int beg, end;
+      const int t = TopologyThreadRange(n, beg, end);
+      int sum = 0;
+      for (int k = beg; k < end; k++) { sum += ap[k]; }
+      sp[t+1] = sum;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp barrier
+      #pragma omp single
+#endif
+      for (int i = 0; i < nt; i++) { sp[i+1] += sp[i]; }
+      int offset = sp[t];
+      for (int k = beg; k < end; k++)
+      {
+         const int val = ap[k];
+         ap[k] = offset;
+         offset += val;
+      }
+   }
+   return sp[nt];
+}
+
+template <int NV>
+static inline bool TopologyLess(const TopologyEntry<NV> &a,
+                                const TopologyEntry<NV> &b)
+{
+   for (int i = 1; i < NV; i++)
+   {
+      if (a.v[i] != b.v[i]) { return a.v[i] < b.v[i]; }
+   }
+   return a.pos < b.pos;
+}
+
+// Sort the entries 'a' by their keys, in lexicographic order, and then by
+// position. The first key values, in [0, num_buckets), are sorted with a
+// counting sort (one radix pass with one bucket per value), and each bucket,
+// which is small for the edges and faces of a mesh, is then sorted by the
+// remaining keys and the position. The order within the buckets after the
+// (multithreaded) counting sort depends on the threads, but the result does
+// not.
+template <int NV>
+static void TopologySort(Array<TopologyEntry<NV>> &a, int num_buckets)
+{
+   const int n = a.Size();
+   Array<int> offsets(num_buckets + 1);
+   int *op = offsets.GetData();
+   const TopologyEntry<NV> *src = a.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int b = 0; b <= num_buckets; b++) { op[b] = 0; }
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < n; k++)
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp atomic
+#endif
+      op[src[k].v[0]]++;
+   }
+   TopologyExclusiveScan(offsets);
+
+   Array<int> next(offsets);
+   int *np = next.GetData();
+   Array<TopologyEntry<NV>> tmp(n);
+   TopologyEntry<NV> *dst = tmp.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < n; k++)
+   {
+      int p;
+#ifdef MFEM_USE_OPENMP
+      #pragma omp atomic capture
+#endif
+      p = np[src[k].v[0]]++;
+      dst[p] = src[k];
+   }
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(dynamic, 1024)
+#endif
+   for (int b = 0; b < num_buckets; b++)
+   {
+      // Insertion sort, the buckets are small
+      for (int k = op[b] + 1; k < op[b+1]; k++)
+      {
+         const TopologyEntry<NV> e = dst[k];
+         int l = k;
+         for ( ; l > op[b] && TopologyLess(e, dst[l-1]); l--)
+         {
+            dst[l] = dst[l-1];
+         }
+         dst[l] = e;
+      }
+   }
+   mfem::Swap(a, tmp);
+}
+
+// Number the distinct keys of 'entries' in the order of their first
+// appearance, i.e. of the smallest position of the entries with that key, as
+// done by the hash tables DSTable and STable3D. Only the entries with position
+// less than 'num_new' define new keys, the others are lookups. On return,
+// index[p] is the number of the key of the entry with position p (-1 for a
+// lookup of a key that was not defined). Returns the number of keys.
+template <int NV>
+static int TopologyNumberKeys(Array<TopologyEntry<NV>> &entries, int num_new,
+                              int num_buckets, Array<int> &index)
+{
+   const int n = entries.Size();
+   TopologySort(entries, num_buckets);
+   const TopologyEntry<NV> *e = entries.GetData();
+
+   // Mark the positions where the keys appear first; the entries with the same
+   // key are sorted by position.
+   index.SetSize(n);
+   int *ip = index.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < n; k++)
+   {
+      const bool first = (k == 0 || !SameKey(e[k], e[k-1]));
+      ip[e[k].pos] = (first && e[k].pos < num_new);
+   }
+   const int num_keys = TopologyExclusiveScan(index);
+
+   // Copy the number of each key to all its entries
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < n; k++)
+   {
+      if (k > 0 && SameKey(e[k], e[k-1])) { continue; }
+      const int key = (e[k].pos < num_new) ? ip[e[k].pos] : -1;
+      ip[e[k].pos] = key;
+      for (int l = k+1; l < n && SameKey(e[l], e[k]); l++)
+      {
+         ip[e[l].pos] = key;
+      }
+   }
+   return num_keys;
+}
+
+// Sorted key of a face with vertices 'fv': the three smallest vertices.
+static inline void TopologyFaceKey(const int *fv, int nfv, int *key)
+{
+   int a = fv[0], b = fv[1], c = fv[2];
+   if (nfv == 4)
+   {
+      const int d = fv[3];
+      if (d < a || d < b || d < c)
+      {
+         if (a > b && a > c) { a = d; }
+         else if (b > c) { b = d; }
+         else { c = d; }
+      }
+   }
+   if (a > b) { std::swap(a, b); }
+   if (b > c) { std::swap(b, c); }
+   if (a > b) { std::swap(a, b); }
+   key[0] = a; key[1] = b; key[2] = c;
+}
+
 void Mesh::GetVertexToVertexTable(DSTable &v_to_v) const
 {
    if (edge_vertex)
@@ -7454,6 +7694,12 @@ void Mesh::GetVertexToVertexTable(DSTable &v_to_v) const
 
 int Mesh::GetElementToEdgeTable(Table &e_to_f)
 {
+   // The numbering follows edge_vertex when it is defined
+   if (sort_based_topology && !edge_vertex && (Dim == 2 || Dim == 3))
+   {
+      return GetElementToEdgeTableSorted(e_to_f);
+   }
+
    int i, NumberOfEdges;
 
    DSTable v_to_v(NumOfVertices);
@@ -7491,6 +7737,291 @@ int Mesh::GetElementToEdgeTable(Table &e_to_f)
    return NumberOfEdges;
 }
 
+int Mesh::GetElementToEdgeTableSorted(Table &e_to_f)
+{
+   // The entries are the edges of the elements, followed by the boundary
+   // element lookups: the boundary elements themselves in 2D, and their edges
+   // in 3D.
+   const int ne = NumOfElements, nbe = NumOfBdrElements;
+   Array<int> offsets(ne + nbe + 1);
+   int *op = offsets.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < ne + nbe; i++)
+   {
+      op[i] = (i < ne) ? elements[i]->GetNEdges() :
+              (Dim == 2) ? 1 : boundary[i-ne]->GetNEdges();
+   }
+   op[ne + nbe] = 0;
+   const int num_entries = TopologyExclusiveScan(offsets);
+   const int num_el_entries = op[ne];
+
+   Array<TopologyEntry<2>> entries(num_entries);
+   TopologyEntry<2> *ep = entries.GetData();
+   static const int segment_vert[2] = { 0, 1 };
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < ne + nbe; i++)
+   {
+      Element *el = (i < ne) ? elements[i] : boundary[i-ne];
+      const int *v = el->GetVertices();
+      const bool bdr_edge = (i >= ne && Dim == 2);
+      const int nedges = bdr_edge ? 1 : el->GetNEdges();
+      for (int j = 0; j < nedges; j++)
+      {
+         const int *e = bdr_edge ? segment_vert : el->GetEdgeVertices(j);
+         TopologyEntry<2> &entry = ep[op[i] + j];
+         entry.v[0] = std::min(v[e[0]], v[e[1]]);
+         entry.v[1] = std::max(v[e[0]], v[e[1]]);
+         entry.pos = op[i] + j;
+      }
+   }
+
+   Array<int> index;
+   const int num_edges = TopologyNumberKeys(entries, num_el_entries,
+                                            NumOfVertices, index);
+
+   e_to_f.SetDims(ne, num_el_entries);
+   std::copy(op, op + ne + 1, e_to_f.GetI());
+   std::copy(index.begin(), index.begin() + num_el_entries, e_to_f.GetJ());
+
+   if (Dim == 2)
+   {
+      be_to_face.SetSize(nbe);
+      for (int i = 0; i < nbe; i++)
+      {
+         be_to_face[i] = index[op[ne + i]];
+      }
+   }
+   else
+   {
+      if (bel_to_edge == NULL)
+      {
+         bel_to_edge = new Table;
+      }
+      bel_to_edge->SetDims(nbe, num_entries - num_el_entries);
+      int *I = bel_to_edge->GetI();
+      for (int i = 0; i <= nbe; i++)
+      {
+         I[i] = op[ne + i] - num_el_entries;
+      }
+      std::copy(index.begin() + num_el_entries, index.end(),
+                bel_to_edge->GetJ());
+   }
+
+   return num_edges;
+}
+
+void Mesh::GetElementToFaceTableSorted()
+{
+   // The entries are the faces of the elements, followed by the boundary
+   // element lookups.
+   const int ne = NumOfElements, nbe = NumOfBdrElements;
+   Array<int> offsets(ne + 1);
+   int *op = offsets.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < ne; i++)
+   {
+      op[i] = elements[i]->GetNFaces();
+   }
+   op[ne] = 0;
+   const int num_el_entries = TopologyExclusiveScan(offsets);
+
+   Array<TopologyEntry<3>> entries(num_el_entries + nbe);
+   TopologyEntry<3> *ep = entries.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < ne + nbe; i++)
+   {
+      Element *el = (i < ne) ? elements[i] : boundary[i-ne];
+      const int *v = el->GetVertices();
+      if (i < ne)
+      {
+         for (int j = 0; j < op[i+1] - op[i]; j++)
+         {
+            const int *lfv = el->GetFaceVertices(j);
+            const int nfv = el->GetNFaceVertices(j);
+            int fv[4] = {-1, -1, -1, -1};
+            for (int k = 0; k < nfv; k++) { fv[k] = v[lfv[k]]; }
+            TopologyEntry<3> &entry = ep[op[i] + j];
+            TopologyFaceKey(fv, nfv, entry.v);
+            entry.pos = op[i] + j;
+         }
+      }
+      else
+      {
+         TopologyEntry<3> &entry = ep[num_el_entries + i - ne];
+         TopologyFaceKey(v, el->GetNVertices(), entry.v);
+         entry.pos = num_el_entries + i - ne;
+      }
+   }
+
+   Array<int> index;
+   NumOfFaces = TopologyNumberKeys(entries, num_el_entries, NumOfVertices,
+                                   index);
+
+   delete el_to_face;
+   el_to_face = new Table;
+   el_to_face->SetDims(ne, num_el_entries);
+   std::copy(op, op + ne + 1, el_to_face->GetI());
+   std::copy(index.begin(), index.begin() + num_el_entries,
+             el_to_face->GetJ());
+
+   be_to_face.SetSize(nbe);
+   for (int i = 0; i < nbe; i++)
+   {
+      be_to_face[i] = index[num_el_entries + i];
+      MFEM_VERIFY(be_to_face[i] >= 0, "boundary element " << i
+                  << " is not a face of the mesh");
+   }
+}
+
+void Mesh::GenerateFacesSorted()
+{
+   const int nfaces = GetNumFaces();
+   const int ne = NumOfElements;
+   const Table &e_to_f = (Dim == 2) ? *el_to_edge : *el_to_face;
+   const int *I = e_to_f.GetI(), *J = e_to_f.GetJ();
+   const int nnz = I[ne];
+
+   // Sort the element faces by face number (and element): the first two
+   // entries of a face are its elements 1 and 2, as in the element by element
+   // construction.
+   Array<TopologyEntry<2>> entries(nnz);
+   TopologyEntry<2> *ep = entries.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < ne; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         ep[k].v[0] = J[k];
+         ep[k].v[1] = i;
+         ep[k].pos = k;
+      }
+   }
+   TopologySort(entries, nfaces);
+   ep = entries.GetData();
+
+   // Element and local face number of the two sides of each face
+   Array<int> sides(4*nfaces);
+   int *sp = sides.GetData();
+   int bad_face = -1;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int f = 0; f < 4*nfaces; f++) { sp[f] = -1; }
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < nnz; k++)
+   {
+      if (k > 0 && ep[k].v[0] == ep[k-1].v[0]) { continue; }
+      const int f = ep[k].v[0];
+      MFEM_ASSERT(0 <= f && f < nfaces, "invalid face number " << f);
+      for (int s = 0; s < 2 && k + s < nnz && ep[k+s].v[0] == f; s++)
+      {
+         const int el = ep[k+s].v[1];
+         sp[4*f + 2*s] = el;
+         sp[4*f + 2*s + 1] = ep[k+s].pos - I[el];
+      }
+      if (k + 2 < nnz && ep[k+2].v[0] == f)
+      {
+#ifdef MFEM_USE_OPENMP
+         #pragma omp atomic write
+#endif
+         bad_face = f;
+      }
+   }
+   MFEM_VERIFY(bad_face < 0, "Invalid mesh topology. Face " << bad_face
+               << " is shared by more than two elements.");
+
+   for (auto &f : faces)
+   {
+      FreeElement(f);
+   }
+   faces.SetSize(nfaces);
+   faces_info.SetSize(nfaces);
+
+   // Allocate the face elements in order, then set them up in parallel
+   for (int f = 0; f < nfaces; f++)
+   {
+      const int el = sp[4*f], lf = sp[4*f + 1];
+      if (el < 0)
+      {
+         faces[f] = NULL;
+         continue;
+      }
+      const int nfv = (Dim == 2) ? 2 : elements[el]->GetNFaceVertices(lf);
+      faces[f] = AllocElement((nfv == 2) ? Geometry::SEGMENT :
+                              (nfv == 3) ? Geometry::TRIANGLE :
+                              Geometry::SQUARE);
+   }
+
+   // Vertices of the local face 'lf' of element 'el'
+   auto face_vertices = [this](int el, int lf, int *fv)
+   {
+      const int *v = elements[el]->GetVertices();
+      const int nfv = (Dim == 2) ? 2 : elements[el]->GetNFaceVertices(lf);
+      const int *lfv = (Dim == 2) ? elements[el]->GetEdgeVertices(lf) :
+                       elements[el]->GetFaceVertices(lf);
+      for (int k = 0; k < nfv; k++) { fv[k] = v[lfv[k]]; }
+      return nfv;
+   };
+
+   int bad_orientation = -1;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int f = 0; f < nfaces; f++)
+   {
+      FaceInfo &fi = faces_info[f];
+      const int *s = sp + 4*f;
+      fi.Elem1No = s[0];
+      fi.NCFace = -1;
+      if (s[0] < 0) { continue; }
+
+      int fv[4];
+      const int nfv = face_vertices(s[0], s[1], fv);
+      faces[f]->SetVertices(fv);
+      fi.Elem1Inf = 64 * s[1]; // face s[1] with orientation 0
+      fi.Elem2No = s[2];
+      fi.Elem2Inf = -1;
+      if (s[2] < 0) { continue; }
+
+      int vv[4], ori = 0;
+      face_vertices(s[2], s[3], vv);
+      if (nfv == 2)
+      {
+         // Even edge orientations are allowed, see AddSegmentFaceElement()
+         if (fv[1] == vv[0] && fv[0] == vv[1]) { ori = 1; }
+         else if (!(fv[0] == vv[0] && fv[1] == vv[1]))
+         {
+#ifdef MFEM_USE_OPENMP
+            #pragma omp atomic write
+#endif
+            bad_orientation = f;
+         }
+      }
+      else if (nfv == 3)
+      {
+         ori = GetTriOrientation(fv, vv);
+      }
+      else
+      {
+         ori = GetQuadOrientation(fv, vv);
+      }
+      fi.Elem2Inf = 64 * s[3] + ori;
+   }
+   MFEM_VERIFY(bad_orientation < 0, "internal error");
+}
+
 const Table & Mesh::ElementToElementTable()
 {
    if (el_to_el)
@@ -7549,7 +8080,7 @@ void Mesh::AddPointFaceElement(int lf, int gf, int el)
 {
    if (faces[gf] == NULL)  // this will be elem1
    {
-      faces[gf] = new Point(&gf);
+      faces[gf] = AllocElement(Geometry::POINT, &gf, 1);
       faces_info[gf].Elem1No  = el;
       faces_info[gf].Elem1Inf = 64 * lf; // face lf with orientation 0
       faces_info[gf].Elem2No  = -1; // in case there's no other side
@@ -7581,7 +8112,8 @@ void Mesh::AddSegmentFaceElement(int lf, int gf, int el, int v0, int v1)
 {
    if (faces[gf] == NULL)  // this will be elem1
    {
-      faces[gf] = new Segment(v0, v1);
+      const int vv[2] = { v0, v1 };
+      faces[gf] = AllocElement(Geometry::SEGMENT, vv, 1);
       faces_info[gf].Elem1No  = el;
       faces_info[gf].Elem1Inf = 64 * lf; // face lf with orientation 0
       faces_info[gf].Elem2No  = -1; // in case there's no other side
@@ -7619,7 +8151,8 @@ void Mesh::AddTriangleFaceElement(int lf, int gf, int el,
 {
    if (faces[gf] == NULL)  // this will be elem1
    {
-      faces[gf] = new Triangle(v0, v1, v2);
+      const int vv[3] = { v0, v1, v2 };
+      faces[gf] = AllocElement(Geometry::TRIANGLE, vv, 1);
       faces_info[gf].Elem1No  = el;
       faces_info[gf].Elem1Inf = 64 * lf; // face lf with orientation 0
       faces_info[gf].Elem2No  = -1; // in case there's no other side
@@ -7647,7 +8180,8 @@ void Mesh::AddQuadFaceElement(int lf, int gf, int el,
 {
    if (faces_info[gf].Elem1No < 0)  // this will be elem1
    {
-      faces[gf] = new Quadrilateral(v0, v1, v2, v3);
+      const int vv[4] = { v0, v1, v2, v3 };
+      faces[gf] = AllocElement(Geometry::SQUARE, vv, 1);
       faces_info[gf].Elem1No  = el;
       faces_info[gf].Elem1Inf = 64 * lf; // face lf with orientation 0
       faces_info[gf].Elem2No  = -1; // in case there's no other side
@@ -7671,6 +8205,12 @@ void Mesh::AddQuadFaceElement(int lf, int gf, int el,
 
 void Mesh::GenerateFaces()
 {
+   if (sort_based_topology && Dim > 1)
+   {
+      GenerateFacesSorted();
+      return;
+   }
+
    int nfaces = GetNumFaces();
 
    for (auto &f : faces)
@@ -7894,6 +8434,12 @@ STable3D *Mesh::GetFacesTable()
 
 STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
 {
+   if (sort_based_topology && !ret_ftbl)
+   {
+      GetElementToFaceTableSorted();
+      return NULL;
+   }
+
    Array<int> v;
    STable3D *faces_tbl;
 
@@ -9161,13 +9707,13 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
          }
 
          new_elements[j++] =
-            new Triangle(v[0], oedge+e[0], oedge+e[2], attr);
+            AllocElement<Triangle>(v[0], oedge+e[0], oedge+e[2], attr);
          new_elements[j++] =
-            new Triangle(oedge+e[1], oedge+e[2], oedge+e[0], attr);
+            AllocElement<Triangle>(oedge+e[1], oedge+e[2], oedge+e[0], attr);
          new_elements[j++] =
-            new Triangle(oedge+e[0], v[1], oedge+e[1], attr);
+            AllocElement<Triangle>(oedge+e[0], v[1], oedge+e[1], attr);
          new_elements[j++] =
-            new Triangle(oedge+e[2], oedge+e[1], v[2], attr);
+            AllocElement<Triangle>(oedge+e[2], oedge+e[1], v[2], attr);
       }
       else if (el_type == Element::QUADRILATERAL)
       {
@@ -9185,13 +9731,17 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
          }
 
          new_elements[j++] =
-            new Quadrilateral(v[0], oedge+e[0], oelem+qe, oedge+e[3], attr);
+            AllocElement<Quadrilateral>(v[0], oedge+e[0], oelem+qe, oedge+e[3],
+                                        attr);
          new_elements[j++] =
-            new Quadrilateral(oedge+e[0], v[1], oedge+e[1], oelem+qe, attr);
+            AllocElement<Quadrilateral>(oedge+e[0], v[1], oedge+e[1], oelem+qe,
+                                        attr);
          new_elements[j++] =
-            new Quadrilateral(oelem+qe, oedge+e[1], v[2], oedge+e[2], attr);
+            AllocElement<Quadrilateral>(oelem+qe, oedge+e[1], v[2], oedge+e[2],
+                                        attr);
          new_elements[j++] =
-            new Quadrilateral(oedge+e[3], oelem+qe, oedge+e[2], v[3], attr);
+            AllocElement<Quadrilateral>(oedge+e[3], oelem+qe, oedge+e[2], v[3],
+                                        attr);
       }
       else
       {
@@ -9208,8 +9758,10 @@ void Mesh::UniformRefinement2D_base(bool update_nodes)
       const int attr = boundary[i]->GetAttribute();
       int *v = boundary[i]->GetVertices();
 
-      new_boundary[j++] = new Segment(v[0], oedge+be_to_face[i], attr);
-      new_boundary[j++] = new Segment(oedge+be_to_face[i], v[1], attr);
+      new_boundary[j++] = AllocElement<Segment>(v[0], oedge+be_to_face[i],
+                                                attr);
+      new_boundary[j++] = AllocElement<Segment>(oedge+be_to_face[i], v[1],
+                                                attr);
 
       FreeElement(boundary[i]);
    }
@@ -9551,19 +10103,25 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
 
 #ifndef MFEM_USE_MEMALLOC
             new_elements[j+0] =
-               new Tetrahedron(v[0], oedge+e[0], oedge+e[1], oedge+e[2], attr);
+               AllocElement<Tetrahedron>(v[0], oedge+e[0], oedge+e[1],
+                                         oedge+e[2], attr);
             new_elements[j+1] =
-               new Tetrahedron(oedge+e[0], v[1], oedge+e[3], oedge+e[4], attr);
+               AllocElement<Tetrahedron>(oedge+e[0], v[1], oedge+e[3],
+                                         oedge+e[4], attr);
             new_elements[j+2] =
-               new Tetrahedron(oedge+e[1], oedge+e[3], v[2], oedge+e[5], attr);
+               AllocElement<Tetrahedron>(oedge+e[1], oedge+e[3], v[2],
+                                         oedge+e[5], attr);
             new_elements[j+3] =
-               new Tetrahedron(oedge+e[2], oedge+e[4], oedge+e[5], v[3], attr);
+               AllocElement<Tetrahedron>(oedge+e[2], oedge+e[4], oedge+e[5],
+                                         v[3], attr);
 
             for (int k = 0; k < 4; k++)
             {
                new_elements[j+4+k] =
-                  new Tetrahedron(oedge+e[mv[k][0]], oedge+e[mv[k][1]],
-                                  oedge+e[mv[k][2]], oedge+e[mv[k][3]], attr);
+                  AllocElement<Tetrahedron>(oedge+e[mv[k][0]],
+                                            oedge+e[mv[k][1]],
+                                            oedge+e[mv[k][2]],
+                                            oedge+e[mv[k][3]], attr);
             }
 #else
             Tetrahedron *tet;
@@ -9628,36 +10186,36 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
             const int qf4 = f2qf[f[4]];
 
             new_elements[j++] =
-               new Wedge(v[0], oedge+e[0], oedge+e[2],
-                         oedge+e[6], oface+qf2, oface+qf4, attr);
+               AllocElement<Wedge>(v[0], oedge+e[0], oedge+e[2],
+                                   oedge+e[6], oface+qf2, oface+qf4, attr);
 
             new_elements[j++] =
-               new Wedge(oedge+e[1], oedge+e[2], oedge+e[0],
-                         oface+qf3, oface+qf4, oface+qf2, attr);
+               AllocElement<Wedge>(oedge+e[1], oedge+e[2], oedge+e[0],
+                                   oface+qf3, oface+qf4, oface+qf2, attr);
 
             new_elements[j++] =
-               new Wedge(oedge+e[0], v[1], oedge+e[1],
-                         oface+qf2, oedge+e[7], oface+qf3, attr);
+               AllocElement<Wedge>(oedge+e[0], v[1], oedge+e[1],
+                                   oface+qf2, oedge+e[7], oface+qf3, attr);
 
             new_elements[j++] =
-               new Wedge(oedge+e[2], oedge+e[1], v[2],
-                         oface+qf4, oface+qf3, oedge+e[8], attr);
+               AllocElement<Wedge>(oedge+e[2], oedge+e[1], v[2],
+                                   oface+qf4, oface+qf3, oedge+e[8], attr);
 
             new_elements[j++] =
-               new Wedge(oedge+e[6], oface+qf2, oface+qf4,
-                         v[3], oedge+e[3], oedge+e[5], attr);
+               AllocElement<Wedge>(oedge+e[6], oface+qf2, oface+qf4,
+                                   v[3], oedge+e[3], oedge+e[5], attr);
 
             new_elements[j++] =
-               new Wedge(oface+qf3, oface+qf4, oface+qf2,
-                         oedge+e[4], oedge+e[5], oedge+e[3], attr);
+               AllocElement<Wedge>(oface+qf3, oface+qf4, oface+qf2,
+                                   oedge+e[4], oedge+e[5], oedge+e[3], attr);
 
             new_elements[j++] =
-               new Wedge(oface+qf2, oedge+e[7], oface+qf3,
-                         oedge+e[3], v[4], oedge+e[4], attr);
+               AllocElement<Wedge>(oface+qf2, oedge+e[7], oface+qf3,
+                                   oedge+e[3], v[4], oedge+e[4], attr);
 
             new_elements[j++] =
-               new Wedge(oface+qf4, oface+qf3, oedge+e[8],
-                         oedge+e[5], oedge+e[4], v[5], attr);
+               AllocElement<Wedge>(oface+qf4, oface+qf3, oedge+e[8],
+                                   oedge+e[5], oedge+e[4], v[5], attr);
          }
          break;
 
@@ -9687,45 +10245,45 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
             const int qf0 = f2qf[f[0]];
 
             new_elements[j++] =
-               new Pyramid(v[0], oedge+e[0], oface+qf0,
-                           oedge+e[3], oedge+e[4], attr);
+               AllocElement<Pyramid>(v[0], oedge+e[0], oface+qf0,
+                                     oedge+e[3], oedge+e[4], attr);
 
             new_elements[j++] =
-               new Pyramid(oedge+e[0], v[1], oedge+e[1],
-                           oface+qf0, oedge+e[5], attr);
+               AllocElement<Pyramid>(oedge+e[0], v[1], oedge+e[1],
+                                     oface+qf0, oedge+e[5], attr);
 
             new_elements[j++] =
-               new Pyramid(oface+qf0, oedge+e[1], v[2],
-                           oedge+e[2], oedge+e[6], attr);
+               AllocElement<Pyramid>(oface+qf0, oedge+e[1], v[2],
+                                     oedge+e[2], oedge+e[6], attr);
 
             new_elements[j++] =
-               new Pyramid(oedge+e[3], oface+qf0, oedge+e[2],
-                           v[3], oedge+e[7], attr);
+               AllocElement<Pyramid>(oedge+e[3], oface+qf0, oedge+e[2],
+                                     v[3], oedge+e[7], attr);
 
             new_elements[j++] =
-               new Pyramid(oedge+e[4], oedge+e[5], oedge+e[6],
-                           oedge+e[7], v[4], attr);
+               AllocElement<Pyramid>(oedge+e[4], oedge+e[5], oedge+e[6],
+                                     oedge+e[7], v[4], attr);
 
             new_elements[j++] =
-               new Pyramid(oedge+e[7], oedge+e[6], oedge+e[5],
-                           oedge+e[4], oface+qf0, attr);
+               AllocElement<Pyramid>(oedge+e[7], oedge+e[6], oedge+e[5],
+                                     oedge+e[4], oface+qf0, attr);
 
 #ifndef MFEM_USE_MEMALLOC
             new_elements[j++] =
-               new Tetrahedron(oedge+e[0], oedge+e[4], oedge+e[5],
-                               oface+qf0, attr);
+               AllocElement<Tetrahedron>(oedge+e[0], oedge+e[4], oedge+e[5],
+                                         oface+qf0, attr);
 
             new_elements[j++] =
-               new Tetrahedron(oedge+e[1], oedge+e[5], oedge+e[6],
-                               oface+qf0, attr);
+               AllocElement<Tetrahedron>(oedge+e[1], oedge+e[5], oedge+e[6],
+                                         oface+qf0, attr);
 
             new_elements[j++] =
-               new Tetrahedron(oedge+e[2], oedge+e[6], oedge+e[7],
-                               oface+qf0, attr);
+               AllocElement<Tetrahedron>(oedge+e[2], oedge+e[6], oedge+e[7],
+                                         oface+qf0, attr);
 
             new_elements[j++] =
-               new Tetrahedron(oedge+e[3], oedge+e[7], oedge+e[4],
-                               oface+qf0, attr);
+               AllocElement<Tetrahedron>(oedge+e[3], oedge+e[7], oedge+e[4],
+                                         oface+qf0, attr);
 #else
             Tetrahedron *tet;
             new_elements[j++] = tet = TetMemory.Alloc();
@@ -9786,37 +10344,37 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
             }
 
             new_elements[j++] =
-               new Hexahedron(v[0], oedge+e[0], oface+qf[0],
-                              oedge+e[3], oedge+e[8], oface+qf[1],
-                              oelem+he, oface+qf[4], attr);
+               AllocElement<Hexahedron>(v[0], oedge+e[0], oface+qf[0],
+                                        oedge+e[3], oedge+e[8], oface+qf[1],
+                                        oelem+he, oface+qf[4], attr);
             new_elements[j++] =
-               new Hexahedron(oedge+e[0], v[1], oedge+e[1],
-                              oface+qf[0], oface+qf[1], oedge+e[9],
-                              oface+qf[2], oelem+he, attr);
+               AllocElement<Hexahedron>(oedge+e[0], v[1], oedge+e[1],
+                                        oface+qf[0], oface+qf[1], oedge+e[9],
+                                        oface+qf[2], oelem+he, attr);
             new_elements[j++] =
-               new Hexahedron(oface+qf[0], oedge+e[1], v[2],
-                              oedge+e[2], oelem+he, oface+qf[2],
-                              oedge+e[10], oface+qf[3], attr);
+               AllocElement<Hexahedron>(oface+qf[0], oedge+e[1], v[2],
+                                        oedge+e[2], oelem+he, oface+qf[2],
+                                        oedge+e[10], oface+qf[3], attr);
             new_elements[j++] =
-               new Hexahedron(oedge+e[3], oface+qf[0], oedge+e[2],
-                              v[3], oface+qf[4], oelem+he,
-                              oface+qf[3], oedge+e[11], attr);
+               AllocElement<Hexahedron>(oedge+e[3], oface+qf[0], oedge+e[2],
+                                        v[3], oface+qf[4], oelem+he,
+                                        oface+qf[3], oedge+e[11], attr);
             new_elements[j++] =
-               new Hexahedron(oedge+e[8], oface+qf[1], oelem+he,
-                              oface+qf[4], v[4], oedge+e[4],
-                              oface+qf[5], oedge+e[7], attr);
+               AllocElement<Hexahedron>(oedge+e[8], oface+qf[1], oelem+he,
+                                        oface+qf[4], v[4], oedge+e[4],
+                                        oface+qf[5], oedge+e[7], attr);
             new_elements[j++] =
-               new Hexahedron(oface+qf[1], oedge+e[9], oface+qf[2],
-                              oelem+he, oedge+e[4], v[5],
-                              oedge+e[5], oface+qf[5], attr);
+               AllocElement<Hexahedron>(oface+qf[1], oedge+e[9], oface+qf[2],
+                                        oelem+he, oedge+e[4], v[5],
+                                        oedge+e[5], oface+qf[5], attr);
             new_elements[j++] =
-               new Hexahedron(oelem+he, oface+qf[2], oedge+e[10],
-                              oface+qf[3], oface+qf[5], oedge+e[5],
-                              v[6], oedge+e[6], attr);
+               AllocElement<Hexahedron>(oelem+he, oface+qf[2], oedge+e[10],
+                                        oface+qf[3], oface+qf[5], oedge+e[5],
+                                        v[6], oedge+e[6], attr);
             new_elements[j++] =
-               new Hexahedron(oface+qf[4], oelem+he, oface+qf[3],
-                              oedge+e[11], oedge+e[7], oface+qf[5],
-                              oedge+e[6], v[7], attr);
+               AllocElement<Hexahedron>(oface+qf[4], oelem+he, oface+qf[3],
+                                        oedge+e[11], oedge+e[7], oface+qf[5],
+                                        oedge+e[6], v[7], attr);
          }
          break;
 
@@ -9848,13 +10406,13 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
       if (bdr_el_type == Element::TRIANGLE)
       {
          new_boundary[j++] =
-            new Triangle(v[0], oedge+e[0], oedge+e[2], attr);
+            AllocElement<Triangle>(v[0], oedge+e[0], oedge+e[2], attr);
          new_boundary[j++] =
-            new Triangle(oedge+e[1], oedge+e[2], oedge+e[0], attr);
+            AllocElement<Triangle>(oedge+e[1], oedge+e[2], oedge+e[0], attr);
          new_boundary[j++] =
-            new Triangle(oedge+e[0], v[1], oedge+e[1], attr);
+            AllocElement<Triangle>(oedge+e[0], v[1], oedge+e[1], attr);
          new_boundary[j++] =
-            new Triangle(oedge+e[2], oedge+e[1], v[2], attr);
+            AllocElement<Triangle>(oedge+e[2], oedge+e[1], v[2], attr);
       }
       else if (bdr_el_type == Element::QUADRILATERAL)
       {
@@ -9862,13 +10420,17 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
             (f2qf.Size() == 0) ? be_to_face[i] : f2qf[be_to_face[i]];
 
          new_boundary[j++] =
-            new Quadrilateral(v[0], oedge+e[0], oface+qf, oedge+e[3], attr);
+            AllocElement<Quadrilateral>(v[0], oedge+e[0], oface+qf, oedge+e[3],
+                                        attr);
          new_boundary[j++] =
-            new Quadrilateral(oedge+e[0], v[1], oedge+e[1], oface+qf, attr);
+            AllocElement<Quadrilateral>(oedge+e[0], v[1], oedge+e[1], oface+qf,
+                                        attr);
          new_boundary[j++] =
-            new Quadrilateral(oface+qf, oedge+e[1], v[2], oedge+e[2], attr);
+            AllocElement<Quadrilateral>(oface+qf, oedge+e[1], v[2], oedge+e[2],
+                                        attr);
          new_boundary[j++] =
-            new Quadrilateral(oedge+e[3], oface+qf, oedge+e[2], v[3], attr);
+            AllocElement<Quadrilateral>(oedge+e[3], oface+qf, oedge+e[2], v[3],
+                                        attr);
       }
       else
       {
@@ -10008,7 +10570,7 @@ void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
          int *vert = c_seg->GetVertices(), attr = c_seg->GetAttribute();
          int new_v = cnv + j, new_e = cne + j;
          AverageVertices(vert, 2, new_v);
-         elements[new_e] = new Segment(new_v, vert[1], attr);
+         elements[new_e] = AllocElement<Segment>(new_v, vert[1], attr);
          vert[1] = new_v;
 
          CoarseFineTr.embeddings[i] = Embedding(i, Geometry::SEGMENT, 1);
@@ -10088,7 +10650,8 @@ void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
                v2[0] = middle[bisect]; v2[1] =           v[1];
 
                boundary[i]->SetVertices(v1);
-               boundary.Append(new Segment(v2, boundary[i]->GetAttribute()));
+               boundary.Append(
+                  AllocElement<Segment>(v2, boundary[i]->GetAttribute()));
             }
             else
                mfem_error("Only bisection of segment is implemented"
@@ -10449,6 +11012,8 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    mfem::Swap(geom_factors, other.geom_factors);
    mfem::Swap(face_geom_factors, other.face_geom_factors);
 
+   element_pool.Swap(other.element_pool);
+
 #ifdef MFEM_USE_MEMALLOC
    TetMemory.Swap(other.TetMemory);
 #endif
@@ -10809,7 +11374,7 @@ void Mesh::Bisection(int i, const DSTable &v_to_v,
 
       tri->SetVertices(v[0]);   // changes vert[0..2] !!!
 
-      Triangle* tri_new = new Triangle(v[1], tri->GetAttribute());
+      Triangle* tri_new = AllocElement<Triangle>(v[1], tri->GetAttribute());
       elements.Append(tri_new);
 
       int tr = tri->GetTransform();
@@ -10931,7 +11496,7 @@ void Mesh::Bisection(int i, HashTable<Hashed2> &v_to_v)
       tet2->SetVertices(v[1]);
       tet2->SetAttribute(attr);
 #else
-      Tetrahedron *tet2 = new Tetrahedron(v[1], attr);
+      Tetrahedron *tet2 = AllocElement<Tetrahedron>(v[1], attr);
 #endif
       tet2->ResetTransform(tet->GetTransform());
       elements.Append(tet2);
@@ -10992,7 +11557,7 @@ void Mesh::BdrBisection(int i, const HashTable<Hashed2> &v_to_v)
 
       tri->SetVertices(v[0]);
 
-      boundary.Append(new Triangle(v[1], tri->GetAttribute()));
+      boundary.Append(AllocElement<Triangle>(v[1], tri->GetAttribute()));
 
       NumOfBdrElements++;
    }
@@ -11057,9 +11622,9 @@ void Mesh::UniformRefinement(int i, const DSTable &v_to_v,
       v3[0] = v_new[2]; v3[1] = v_new[1]; v3[2] =     v[2];
       v4[0] = v_new[1]; v4[1] = v_new[2]; v4[2] = v_new[0];
 
-      Triangle* tri1 = new Triangle(v1, tri0->GetAttribute());
-      Triangle* tri2 = new Triangle(v2, tri0->GetAttribute());
-      Triangle* tri3 = new Triangle(v3, tri0->GetAttribute());
+      Triangle* tri1 = AllocElement<Triangle>(v1, tri0->GetAttribute());
+      Triangle* tri2 = AllocElement<Triangle>(v2, tri0->GetAttribute());
+      Triangle* tri3 = AllocElement<Triangle>(v3, tri0->GetAttribute());
 
       elements.Append(tri1);
       elements.Append(tri2);
@@ -13091,6 +13656,11 @@ void Mesh::RemoveInternalBoundaries()
 
 void Mesh::FreeElement(Element *E)
 {
+   if (E && element_pool.Owns(E))
+   {
+      element_pool.Free(E);
+      return;
+   }
 #ifdef MFEM_USE_MEMALLOC
    if (E)
    {
@@ -13575,7 +14145,7 @@ Mesh &MeshPart::GetMesh()
          const int bytype_elem_id = have_element_map ?
                                     element_map[nat_elem_id] : nat_elem_id;
          const Entity ent = elem_helper.FindEntity(bytype_elem_id);
-         Element *el = mesh->NewElement(ent.geom);
+         Element *el = mesh->AllocElement(ent.geom);
          el->SetVertices(ent.verts);
          el->SetAttribute(attributes[nat_elem_id]);
          if (ent.geom == Geometry::TETRAHEDRON && have_tet_refine_flags)
@@ -13602,7 +14172,7 @@ Mesh &MeshPart::GetMesh()
          const int bytype_bdr_id = have_boundary_map ?
                                    boundary_map[nat_bdr_id] : nat_bdr_id;
          const Entity ent = bdr_helper.FindEntity(bytype_bdr_id);
-         Element *bdr = mesh->NewElement(ent.geom);
+         Element *bdr = mesh->AllocElement(ent.geom);
          bdr->SetVertices(ent.verts);
          bdr->SetAttribute(bdr_attributes[nat_bdr_id]);
          mesh->AddBdrElement(bdr);
@@ -16,6 +16,7 @@
 #include "../general/stable3d.hpp"
 #include "../general/globals.hpp"
 #include "attribute_sets.hpp"
+#include "element_pool.hpp"
 #include "triangle.hpp"
 #include "tetrahedron.hpp"
 #include "vertex.hpp"
@@ -38,6 +39,7 @@ namespace mfem
 
 class GeometricFactors;
 class FaceGeometricFactors;
+class PADataCache;
 class KnotVector;
 class NURBSExtension;
 class FiniteElementSpace;
@@ -72,6 +74,11 @@ class Mesh
    friend class adios2stream;
 #endif
 
+private:
+   /// Optional on-disk cache of the geometric factors, not owned, see
+   /// SetPADataCache().
+   PADataCache *pa_cache = nullptr;
+
 protected:
    int Dim;
    int spaceDim;
@@ -265,6 +272,9 @@ protected:
    static const int vtk_quadratic_wedge[18];
    static const int vtk_quadratic_hex[27];
 
+   /// Storage of the elements allocated with AllocElement().
+   ElementPool element_pool;
+
 #ifdef MFEM_USE_MEMALLOC
    friend class Tetrahedron;
    MemAlloc <Tetrahedron, 1024> TetMemory;
@@ -300,12 +310,18 @@ public:
    Array<GeometricFactors*> geom_factors; ///< Optional geometric factors.
    Array<FaceGeometricFactors*> face_geom_factors; /**< Optional face geometric
                                                         factors. */
-
    // Global parameter that can be used to control the removal of unused
    // vertices performed when reading a mesh in MFEM format. The default value
    // (true) is set in mesh_readers.cpp.
    static bool remove_unused_vertices;
 
+   // Global parameter that selects the sort-based construction of the edges
+   // and faces of the mesh, which is multithreaded when MFEM is built with
+   // OpenMP, instead of the construction based on hash tables. Both give the
+   // same numbering. The default value (true with OpenMP, false otherwise) is
+   // set in mesh.cpp.
+   static bool sort_based_topology;
+
 protected:
    Operation last_operation;
 
@@ -345,6 +361,20 @@ protected:
    void ReadInlineMesh(std::istream &input, bool generate_edges = false);
    void ReadGmshMesh(std::istream &input, int &curved, int &read_gf);
 
+   // Readers for the binary mesh format, see PrintBinary(). The
+   // implementations of these methods are in mesh_binary.cpp.
+   void ReadBinaryMesh(std::istream &input);
+   /** Read the part @a part of @a num_parts of the binary mesh in @a data: the
+       elements with indices in [ne*part/num_parts, ne*(part+1)/num_parts),
+       their vertices and the boundary elements adjacent to them. If
+       @a vertex_ids is not NULL, it is set to the vertex indices in the file
+       of the vertices of the part. */
+   void ReadBinaryMesh(const char *data, std::size_t size, int part,
+                       int num_parts, Array<int> *vertex_ids);
+   /// Read a part of a binary mesh file, mapping it into memory if possible.
+   void ReadBinaryFile(const std::string &filename, int part, int num_parts,
+                       Array<int> *vertex_ids);
+
    /* Note NetCDF (optional library) is used for reading cubit files */
 #ifdef MFEM_USE_NETCDF
    /// @brief Load a mesh from a Genesis file.
@@ -396,6 +426,8 @@ protected:
 
    STable3D *GetFacesTable();
    STable3D *GetElementToFaceTable(int ret_ftbl = 0);
+   /// Sort-based version of GetElementToFaceTable(0).
+   void GetElementToFaceTableSorted();
 
    /** Red refinement. Element with index i is refined. The default
        red refinement for now is Uniform. */
@@ -554,6 +586,11 @@ protected:
        T(i, 0) gives the index of edge in element i that connects vertex 0
        to vertex 1, etc. Returns the number of the edges. */
    int GetElementToEdgeTable(Table &);
+   /// Sort-based version of GetElementToEdgeTable().
+   int GetElementToEdgeTableSorted(Table &);
+
+   /// Sort-based version of GenerateFaces() for Dim > 1.
+   void GenerateFacesSorted();
 
    /// Used in GenerateFaces()
    void AddPointFaceElement(int lf, int gf, int el);
@@ -647,6 +684,13 @@ protected:
    /// intervals.
    void Make1D(int n, real_t sx = 1.0);
 
+   /// Construct a segment with vertices @a v1, @a v2 using AllocElement().
+   Element *AllocSegment(int v1, int v2, int attr)
+   {
+      const int vi[2] = {v1, v2};
+      return AllocElement(Geometry::SEGMENT, vi, attr);
+   }
+
    /// Internal function used in Mesh::MakeRefined
    void MakeRefined_(Mesh &orig_mesh, const Array<int> &ref_factors,
                      int ref_type);
@@ -784,6 +828,18 @@ public:
                             int generate_edges = 0, int refine = 1,
                             bool fix_orientation = true);
 
+   /** Creates mesh by reading the file @a filename in the binary mesh format,
+       see PrintBinary(). The file is mapped into memory where possible and
+       only the data of the part @a part of @a num_parts is read: the elements
+       with indices in [ne*part/num_parts, ne*(part+1)/num_parts), their
+       vertices and the boundary elements adjacent to them. The vertices are
+       renumbered in increasing order of their index in the file. Reading a
+       part of a nonconforming mesh is not supported. See @a Mesh::Finalize
+       for the meaning of @a refine. */
+   static Mesh LoadFromBinaryFile(const std::string &filename, int part = 0,
+                                  int num_parts = 1, int refine = 1,
+                                  bool fix_orientation = true);
+
    /// Creates 1D mesh, divided into n equal intervals.
    static Mesh MakeCartesian1D(int n, real_t sx = 1.0);
 
@@ -905,6 +961,36 @@ public:
    /// @note The returned object should be deleted by the caller.
    Element *NewElement(int geom);
 
+   /** @brief Construct a new element of type @a geom in the contiguous
+       element storage of the Mesh, see ElementPool. */
+   /** The element can only be added to this Mesh (or used as a shared or face
+       neighbor element of this ParMesh), and it is freed by the Mesh. Unlike
+       NewElement(), this method avoids the per-element heap allocations. */
+   Element *AllocElement(int geom)
+   { return element_pool.Alloc(static_cast<Geometry::Type>(geom)); }
+
+   /** @brief Construct a new element of type @a geom with vertices @a vi and
+       attribute @a attr in the contiguous element storage, see
+       AllocElement(int). */
+   Element *AllocElement(int geom, const int *vi, int attr)
+   {
+      Element *el = AllocElement(geom);
+      el->SetVertices(vi);
+      el->SetAttribute(attr);
+      return el;
+   }
+
+   /** @brief Construct a new element of class @a T, e.g. Triangle, with the
+       constructor arguments @a args in the contiguous element storage, see
+       AllocElement(int). */
+   template <typename T, typename... Args>
+   T *AllocElement(Args&&... args)
+   { return element_pool.New<T>(std::forward<Args>(args)...); }
+
+   /** @brief Construct a copy of the element @a el, like Element::Duplicate(),
+       in the contiguous element storage, see AllocElement(int). */
+   Element *AllocElement(const Element &el);
+
    int AddVertex(real_t x, real_t y = 0.0, real_t z = 0.0);
    int AddVertex(const real_t *coords);
    int AddVertex(const Vector &coords);
@@ -1821,6 +1907,17 @@ public:
       const int flags,
       MemoryType d_mt = MemoryType::DEFAULT);
 
+   /** @brief Set the on-disk cache used by GetGeometricFactors() to store new
+       geometric factors and to load them instead of computing them again, e.g.
+       when the simulation is restarted. Use NULL to disable the cache.
+
+       The cache is not owned by the Mesh. When the cache uses memory mapping,
+       it must outlive the geometric factors of the Mesh. */
+   void SetPADataCache(PADataCache *cache) { pa_cache = cache; }
+
+   /// Return the cache set with SetPADataCache() (possibly NULL).
+   PADataCache *GetPADataCache() const { return pa_cache; }
+
    /** @brief Return the mesh geometric factors for the faces corresponding
        to the given integration rule.
 
@@ -2329,6 +2426,19 @@ public:
    /// used for ASCII output.
    virtual void Save(const std::string &fname, int precision=16) const;
 
+   /** @brief Print the mesh to the given stream using the binary MFEM mesh
+       format. */
+   /** The format stores the connectivity, attributes, attribute sets, vertex
+       coordinates and curvature Nodes of the mesh in separate arrays that can
+       be mapped into memory, see LoadFromBinaryFile(). Nonconforming meshes
+       are stored with their refinement trees. The data is written in the
+       native byte order. The binary format is recognized by Load() and the
+       mesh constructors that read a stream. NURBS meshes are not supported. */
+   void PrintBinary(std::ostream &os) const;
+
+   /// Save the mesh to a file using Mesh::PrintBinary.
+   virtual void SaveBinary(const std::string &fname) const;
+
    /// Print the mesh to the given stream using the adios2 bp format
 #ifdef MFEM_USE_ADIOS2
    virtual void Print(adios2stream &os) const;
@@ -2826,10 +2936,15 @@ public:
     Mesh. See Mesh::GetGeometricFactors(). */
 class GeometricFactors
 {
+   friend class PADataCache;
+
 private:
    void Compute(const GridFunction &nodes,
                 MemoryType d_mt = MemoryType::DEFAULT);
 
+   // Used by PADataCache to create the object from cached data.
+   GeometricFactors() = default;
+
 public:
    const Mesh *mesh;
    const IntegrationRule *IntRule;
@@ -0,0 +1,669 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of the binary MFEM mesh format, see Mesh::PrintBinary().
+
+#include "mesh_headers.hpp"
+#include "../fem/fem.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+#endif
+
+namespace mfem
+{
+
+namespace
+{
+
+// Layout of the binary MFEM mesh format v1.0. All data is stored in the native
+// byte order, which is checked when reading:
+//
+//    offset  0: "MFEM binary mesh v1.0\n", followed by 2 bytes of padding
+//    offset 24: uint32 byte order mark, uint32 sizeof(real_t)
+//    offset 32: uint64 total size of the mesh data in bytes
+//    offset 40: int32 dimension, int32 space dimension
+//    offset 48: int64 number of vertices, elements and boundary elements
+//    offset 72: uint64 number of sections, followed by the section table with
+//               (id, offset, bytes) for each section
+//
+// The sections start at multiples of 64 bytes. The elements and boundary
+// elements are stored in separate arrays (geometry, attribute, offsets into the
+// vertex array and vertices), so that any range of elements can be read
+// without touching the rest of the file. Sections with unknown ids are ignored
+// by the reader, so new sections can be added without changing the version.
+const char header_line[] = "MFEM binary mesh v1.0";
+const uint32_t byte_order_mark = 0x01020304;
+const uint64_t fixed_header_bytes = 80;
+const uint64_t alignment = 64;
+
+enum SectionId : uint64_t
+{
+   ELEMENT_GEOMETRIES = 1, // uint8
+   ELEMENT_ATTRIBUTES,     // int32
+   ELEMENT_OFFSETS,        // int64, number of elements + 1
+   ELEMENT_VERTICES,       // int32
+   BDR_GEOMETRIES,
+   BDR_ATTRIBUTES,
+   BDR_OFFSETS,
+   BDR_VERTICES,
+   BDR_ELEMENTS,           // int32, adjacent element of each boundary element
+   BDR_ORDER,              // int32, boundary elements sorted by BDR_ELEMENTS
+   VERTICES,               // real_t, space dimension values per vertex
+   ATTRIBUTE_SETS,         // text, see AttributeSets::Print()
+   BDR_ATTRIBUTE_SETS,     // text
+   NODES_SPACE,            // text: FE collection, vector dimension, ordering
+   NODES_OFFSETS,          // int64, number of elements + 1
+   NODES_DATA,             // real_t, nodal values of the element vdofs
+   NCMESH                  // text, see NCMesh::Print()
+};
+
+uint64_t Align(const uint64_t offset)
+{
+   return (offset + alignment - 1) / alignment * alignment;
+}
+
+void Pad(std::ostream &os, const uint64_t size)
+{
+   for (uint64_t i = size; i < Align(size); i++) { os.put('\0'); }
+}
+
+template <typename T>
+void WriteValue(std::ostream &os, const T value)
+{
+   os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void WriteValues(std::ostream &os, const std::vector<T> &values)
+{
+   os.write(reinterpret_cast<const char*>(values.data()),
+            values.size()*sizeof(T));
+}
+
+template <typename T>
+T ReadValue(const char *data)
+{
+   T value;
+   std::memcpy(&value, data, sizeof(T));
+   return value;
+}
+
+// A section of a binary mesh being written: its size and a function writing
+// its contents.
+struct SectionWriter
+{
+   SectionId id;
+   uint64_t bytes;
+   std::function<void(std::ostream&)> write;
+};
+
+void AddTextSection(std::vector<SectionWriter> &sections, SectionId id,
+                    const std::string &text)
+{
+   sections.push_back({id, text.size(), [&text](std::ostream &os)
+   {
+      os.write(text.data(), text.size());
+   }});
+}
+
+// Add the sections describing the elements 'els', starting at 'first' which is
+// either ELEMENT_GEOMETRIES or BDR_GEOMETRIES. The section ids of the element
+// and boundary element arrays are in the same order.
+void AddElementSections(std::vector<SectionWriter> &sections, SectionId first,
+                        const Array<Element*> &els,
+                        std::vector<int64_t> &offsets)
+{
+   const int n = els.Size();
+   offsets.resize(n + 1);
+   offsets[0] = 0;
+   for (int i = 0; i < n; i++)
+   {
+      offsets[i+1] = offsets[i] + els[i]->GetNVertices();
+   }
+   sections.push_back({first, uint64_t(n), [&els, n](std::ostream &os)
+   {
+      std::vector<uint8_t> geom(n);
+      for (int i = 0; i < n; i++) { geom[i] = els[i]->GetGeometryType(); }
+      WriteValues(os, geom);
+   }});
+   sections.push_back({SectionId(first + 1), n*sizeof(int32_t),
+                       [&els, n](std::ostream &os)
+   {
+      std::vector<int32_t> attr(n);
+      for (int i = 0; i < n; i++) { attr[i] = els[i]->GetAttribute(); }
+      WriteValues(os, attr);
+   }});
+   sections.push_back({SectionId(first + 2), (n + 1)*sizeof(int64_t),
+                       [&offsets](std::ostream &os)
+   {
+      WriteValues(os, offsets);
+   }});
+   sections.push_back({SectionId(first + 3), offsets[n]*sizeof(int32_t),
+                       [&els, &offsets, n](std::ostream &os)
+   {
+      std::vector<int32_t> vert(offsets[n]);
+      for (int i = 0; i < n; i++)
+      {
+         std::copy(els[i]->GetVertices(),
+                   els[i]->GetVertices() + els[i]->GetNVertices(),
+                   vert.begin() + offsets[i]);
+      }
+      WriteValues(os, vert);
+   }});
+}
+
+// Read-only view of the sections of a binary mesh stored in memory.
+class SectionReader
+{
+   const char *data;
+   std::map<uint64_t, std::pair<uint64_t, uint64_t>> sections;
+
+public:
+   int dim, space_dim;
+   int64_t nv, ne, nbe;
+
+   SectionReader(const char *data_, const uint64_t size) : data(data_)
+   {
+      const uint64_t line = sizeof(header_line) - 1;
+      MFEM_VERIFY(size >= fixed_header_bytes &&
+                  std::equal(header_line, header_line + line, data) &&
+                  data[line] == '\n', "invalid binary mesh");
+      MFEM_VERIFY(ReadValue<uint32_t>(data + 24) == byte_order_mark,
+                  "binary mesh written with a different byte order");
+      MFEM_VERIFY(ReadValue<uint32_t>(data + 28) == sizeof(real_t),
+                  "binary mesh written with a different size of real_t");
+      MFEM_VERIFY(ReadValue<uint64_t>(data + 32) <= size,
+                  "truncated binary mesh");
+      dim = ReadValue<int32_t>(data + 40);
+      space_dim = ReadValue<int32_t>(data + 44);
+      nv = ReadValue<int64_t>(data + 48);
+      ne = ReadValue<int64_t>(data + 56);
+      nbe = ReadValue<int64_t>(data + 64);
+      const uint64_t num_sections = ReadValue<uint64_t>(data + 72);
+      MFEM_VERIFY(fixed_header_bytes + 3*num_sections*sizeof(uint64_t) <= size,
+                  "invalid binary mesh");
+      for (uint64_t i = 0; i < num_sections; i++)
+      {
+         const char *entry = data + fixed_header_bytes + 3*i*sizeof(uint64_t);
+         const uint64_t id = ReadValue<uint64_t>(entry);
+         const uint64_t offset = ReadValue<uint64_t>(entry + 8);
+         const uint64_t bytes = ReadValue<uint64_t>(entry + 16);
+         MFEM_VERIFY(offset % alignment == 0 && offset + bytes <= size,
+                     "invalid section " << id << " in binary mesh");
+         sections[id] = std::make_pair(offset, bytes);
+      }
+   }
+
+   bool Has(SectionId id) const { return sections.count(id) > 0; }
+
+   /// Return the section @a id, which must contain at least @a n values.
+   template <typename T>
+   const T *Get(SectionId id, int64_t n) const
+   {
+      auto it = sections.find(id);
+      MFEM_VERIFY(it != sections.end(),
+                  "section " << id << " not found in binary mesh");
+      MFEM_VERIFY(uint64_t(n)*sizeof(T) <= it->second.second,
+                  "section " << id << " of binary mesh is too small");
+      return reinterpret_cast<const T*>(data + it->second.first);
+   }
+
+   std::string GetText(SectionId id) const
+   {
+      auto it = sections.find(id);
+      MFEM_VERIFY(it != sections.end(),
+                  "section " << id << " not found in binary mesh");
+      return std::string(data + it->second.first, it->second.second);
+   }
+};
+
+// Read-only mapping of a file into memory, with a fallback to reading the
+// whole file where mmap is not available.
+class MappedFile
+{
+   const char *data = nullptr;
+   uint64_t size = 0;
+   std::vector<char> buffer;
+
+public:
+   explicit MappedFile(const std::string &filename)
+   {
+#ifndef _WIN32
+      const int fd = open(filename.c_str(), O_RDONLY);
+      MFEM_VERIFY(fd >= 0, "Mesh file not found: " << filename);
+      struct stat st;
+      MFEM_VERIFY(fstat(fd, &st) == 0, "error reading " << filename);
+      size = st.st_size;
+      void *addr = (size > 0) ?
+                   mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+      close(fd);
+      MFEM_VERIFY(addr != MAP_FAILED, "error mapping " << filename);
+      data = static_cast<const char*>(addr);
+#else
+      std::ifstream is(filename, std::ios::binary | std::ios::ate);
+      MFEM_VERIFY(is.good(), "Mesh file not found: " << filename);
+      size = is.tellg();
+      buffer.resize(size);
+      is.seekg(0);
+      is.read(buffer.data(), size);
+      MFEM_VERIFY(is.good(), "error reading " << filename);
+      data = buffer.data();
+#endif
+   }
+
+   ~MappedFile()
+   {
+#ifndef _WIN32
+      if (data) { munmap(const_cast<char*>(data), size); }
+#endif
+   }
+
+   const char *Data() const { return data; }
+   uint64_t Size() const { return size; }
+};
+
+} // anonymous namespace
+
+void Mesh::PrintBinary(std::ostream &os) const
+{
+   MFEM_VERIFY(NURBSext == NULL,
+               "NURBS meshes are not supported by the binary mesh format");
+
+   std::vector<SectionWriter> sections;
+   std::vector<int64_t> elem_offsets, bdr_offsets;
+   std::vector<int32_t> bdr_elem, bdr_order;
+   std::string ncmesh_text, attr_sets_text, bdr_attr_sets_text, nodes_text;
+
+   if (Nonconforming())
+   {
+      // The refinement trees define the elements and the vertices, see also
+      // the comment in Mesh::Printer().
+      Array<real_t> coords_save;
+      if (Nodes) { mfem::Swap(coords_save, ncmesh->coordinates); }
+      std::ostringstream nc_os;
+      nc_os.precision(17);
+      ncmesh->Print(nc_os);
+      if (Nodes) { mfem::Swap(coords_save, ncmesh->coordinates); }
+      ncmesh_text = nc_os.str();
+      AddTextSection(sections, NCMESH, ncmesh_text);
+   }
+   else
+   {
+      AddElementSections(sections, ELEMENT_GEOMETRIES, elements, elem_offsets);
+      AddElementSections(sections, BDR_GEOMETRIES, boundary, bdr_offsets);
+
+      // Each boundary element belongs to the part of its adjacent element
+      bdr_elem.resize(NumOfBdrElements);
+      bdr_order.resize(NumOfBdrElements);
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         bdr_elem[i] = faces_info[GetBdrElementFaceIndex(i)].Elem1No;
+         bdr_order[i] = i;
+      }
+      std::stable_sort(bdr_order.begin(), bdr_order.end(),
+                       [&bdr_elem](int32_t a, int32_t b)
+      { return bdr_elem[a] < bdr_elem[b]; });
+      sections.push_back({BDR_ELEMENTS, NumOfBdrElements*sizeof(int32_t),
+                          [&bdr_elem](std::ostream &s) { WriteValues(s, bdr_elem); }});
+      sections.push_back({BDR_ORDER, NumOfBdrElements*sizeof(int32_t),
+                          [&bdr_order](std::ostream &s) { WriteValues(s, bdr_order); }});
+
+      sections.push_back({VERTICES, uint64_t(NumOfVertices)*spaceDim*sizeof(real_t),
+                          [this](std::ostream &s)
+      {
+         std::vector<real_t> coords(size_t(NumOfVertices)*spaceDim);
+         for (int i = 0; i < NumOfVertices; i++)
+         {
+            std::copy(vertices[i](), vertices[i]() + spaceDim,
+                      coords.begin() + size_t(i)*spaceDim);
+         }
+         WriteValues(s, coords);
+      }});
+   }
+
+   if (attribute_sets.SetsExist())
+   {
+      std::ostringstream sets_os;
+      attribute_sets.Print(sets_os);
+      attr_sets_text = sets_os.str();
+      AddTextSection(sections, ATTRIBUTE_SETS, attr_sets_text);
+   }
+   if (bdr_attribute_sets.SetsExist())
+   {
+      std::ostringstream sets_os;
+      bdr_attribute_sets.Print(sets_os);
+      bdr_attr_sets_text = sets_os.str();
+      AddTextSection(sections, BDR_ATTRIBUTE_SETS, bdr_attr_sets_text);
+   }
+
+   // The nodes are stored element by element, so that they can be read for
+   // any range of elements.
+   std::vector<int64_t> nodes_offsets;
+   if (Nodes)
+   {
+      const FiniteElementSpace *fes = Nodes->FESpace();
+      std::ostringstream nodes_os;
+      nodes_os << "FiniteElementCollection: " << fes->FEColl()->Name()
+               << "\nVDim: " << fes->GetVDim()
+               << "\nOrdering: " << int(fes->GetOrdering()) << '\n';
+      nodes_text = nodes_os.str();
+      AddTextSection(sections, NODES_SPACE, nodes_text);
+
+      nodes_offsets.resize(NumOfElements + 1);
+      nodes_offsets[0] = 0;
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         nodes_offsets[i+1] = nodes_offsets[i] +
+                              fes->GetFE(i)->GetDof()*fes->GetVDim();
+      }
+      sections.push_back({NODES_OFFSETS, (NumOfElements + 1)*sizeof(int64_t),
+                          [&nodes_offsets](std::ostream &s)
+      {
+         WriteValues(s, nodes_offsets);
+      }});
+      sections.push_back({NODES_DATA, nodes_offsets.back()*sizeof(real_t),
+                          [this, fes, &nodes_offsets](std::ostream &s)
+      {
+         std::vector<real_t> values(nodes_offsets.back());
+         Nodes->HostRead();
+         Array<int> vdofs;
+         for (int i = 0; i < NumOfElements; i++)
+         {
+            fes->GetElementVDofs(i, vdofs);
+            MFEM_ASSERT(vdofs.Size() == nodes_offsets[i+1] - nodes_offsets[i],
+                        "internal error");
+            Nodes->GetSubVector(vdofs, values.data() + nodes_offsets[i]);
+         }
+         WriteValues(s, values);
+      }});
+   }
+
+   // Header and section table
+   const uint64_t num_sections = sections.size();
+   uint64_t offset = Align(fixed_header_bytes +
+                           3*num_sections*sizeof(uint64_t));
+   std::vector<uint64_t> offsets(num_sections);
+   for (uint64_t i = 0; i < num_sections; i++)
+   {
+      offsets[i] = offset;
+      offset += Align(sections[i].bytes);
+   }
+   os.write(header_line, sizeof(header_line) - 1);
+   os.put('\n');
+   os.put('\0');
+   os.put('\0');
+   WriteValue<uint32_t>(os, byte_order_mark);
+   WriteValue<uint32_t>(os, sizeof(real_t));
+   WriteValue<uint64_t>(os, offset);
+   WriteValue<int32_t>(os, Dim);
+   WriteValue<int32_t>(os, spaceDim);
+   WriteValue<int64_t>(os, NumOfVertices);
+   WriteValue<int64_t>(os, NumOfElements);
+   WriteValue<int64_t>(os, NumOfBdrElements);
+   WriteValue<uint64_t>(os, num_sections);
+   for (uint64_t i = 0; i < num_sections; i++)
+   {
+      WriteValue<uint64_t>(os, sections[i].id);
+      WriteValue<uint64_t>(os, offsets[i]);
+      WriteValue<uint64_t>(os, sections[i].bytes);
+   }
+   Pad(os, fixed_header_bytes + 3*num_sections*sizeof(uint64_t));
+
+   for (const SectionWriter &section : sections)
+   {
+      section.write(os);
+      Pad(os, section.bytes);
+   }
+   MFEM_VERIFY(os.good(), "error writing the binary mesh");
+}
+
+void Mesh::SaveBinary(const std::string &fname) const
+{
+   std::ofstream ofs(fname, std::ios::binary);
+   MFEM_VERIFY(ofs.good(), "error opening " << fname);
+   PrintBinary(ofs);
+}
+
+void Mesh::ReadBinaryMesh(std::istream &input)
+{
+   // The header line has already been read by Loader(); read the rest of the
+   // fixed header to find the size of the mesh data.
+   const uint64_t line = sizeof(header_line);
+   std::vector<char> buffer(fixed_header_bytes);
+   std::copy(header_line, header_line + line - 1, buffer.begin());
+   buffer[line - 1] = '\n';
+   input.read(buffer.data() + line, fixed_header_bytes - line);
+   MFEM_VERIFY(input.good(), "error reading the binary mesh");
+   MFEM_VERIFY(ReadValue<uint32_t>(buffer.data() + 24) == byte_order_mark,
+               "binary mesh written with a different byte order");
+   const uint64_t size = ReadValue<uint64_t>(buffer.data() + 32);
+   MFEM_VERIFY(size >= fixed_header_bytes, "invalid binary mesh");
+   buffer.resize(size);
+   input.read(buffer.data() + fixed_header_bytes, size - fixed_header_bytes);
+   MFEM_VERIFY(input.good(), "error reading the binary mesh");
+
+   ReadBinaryMesh(buffer.data(), size, 0, 1, NULL);
+}
+
+void Mesh::ReadBinaryFile(const std::string &filename, int part,
+                          int num_parts, Array<int> *vertex_ids)
+{
+   MappedFile file(filename);
+   Clear();
+   ReadBinaryMesh(file.Data(), file.Size(), part, num_parts, vertex_ids);
+}
+
+void Mesh::ReadBinaryMesh(const char *data, size_t size, int part,
+                          int num_parts, Array<int> *vertex_ids)
+{
+   MFEM_VERIFY(0 <= part && part < num_parts,
+               "invalid part " << part << " of " << num_parts);
+   SectionReader in(data, size);
+
+   // The elements [e_begin, e_end) of the part
+   const int64_t e_begin = in.ne*part/num_parts;
+   const int64_t e_end = in.ne*(part+1)/num_parts;
+
+   if (in.Has(NCMESH))
+   {
+      MFEM_VERIFY(num_parts == 1, "reading a part of a nonconforming "
+                  "binary mesh is not supported");
+      std::istringstream input(in.GetText(NCMESH));
+      std::string ident;
+      getline(input, ident); // MFEM NC mesh v1.0
+      int curved = 0, is_nc = 1;
+#ifdef MFEM_USE_MPI
+      ParMesh *pmesh = dynamic_cast<ParMesh*>(this);
+      if (pmesh)
+      {
+         ncmesh = new ParNCMesh(pmesh->GetComm(), input, 10, curved, is_nc);
+      }
+      else
+#endif
+      {
+         ncmesh = new NCMesh(input, 10, curved, is_nc);
+      }
+      InitFromNCMesh(*ncmesh);
+   }
+   else
+   {
+      Dim = in.dim;
+      spaceDim = in.space_dim;
+
+      const uint8_t *geom = in.Get<uint8_t>(ELEMENT_GEOMETRIES, in.ne);
+      const int32_t *attr = in.Get<int32_t>(ELEMENT_ATTRIBUTES, in.ne);
+      const int64_t *offsets = in.Get<int64_t>(ELEMENT_OFFSETS, in.ne + 1);
+      const int32_t *vert = in.Get<int32_t>(ELEMENT_VERTICES, offsets[in.ne]);
+
+      // The vertices used by the part, in increasing order
+      Array<int> part_vertices;
+      if (num_parts == 1)
+      {
+         part_vertices.SetSize(int(in.nv));
+         for (int i = 0; i < part_vertices.Size(); i++) { part_vertices[i] = i; }
+      }
+      else
+      {
+         part_vertices.SetSize(int(offsets[e_end] - offsets[e_begin]));
+         std::copy(vert + offsets[e_begin], vert + offsets[e_end],
+                   part_vertices.begin());
+         part_vertices.Sort();
+         part_vertices.Unique();
+      }
+      auto local_vertex = [&part_vertices, num_parts](int v)
+      {
+         if (num_parts == 1) { return v; }
+         return int(std::lower_bound(part_vertices.begin(),
+                                     part_vertices.end(), v) -
+                    part_vertices.begin());
+      };
+      constexpr int max_nv = Geometry::Constants<Geometry::CUBE>::NumVert;
+      auto read_element = [&](const uint8_t *g, const int32_t *a,
+                              const int64_t *o, const int32_t *v, int64_t e)
+      {
+         MFEM_VERIFY(g[e] < Geometry::NumGeom, "invalid geometry in binary "
+                     "mesh: " << int(g[e]));
+         const int nv = int(o[e+1] - o[e]);
+         MFEM_VERIFY(nv == Geometry::NumVerts[g[e]] &&
+                     nv <= max_nv, "invalid binary mesh");
+         int lv[max_nv];
+         for (int j = 0; j < nv; j++) { lv[j] = local_vertex(v[o[e] + j]); }
+         return AllocElement(g[e], lv, a[e]);
+      };
+
+      NumOfElements = int(e_end - e_begin);
+      elements.SetSize(NumOfElements);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         elements[i] = read_element(geom, attr, offsets, vert, e_begin + i);
+      }
+
+      // The boundary elements adjacent to the elements of the part, in their
+      // original order
+      const uint8_t *bgeom = in.Get<uint8_t>(BDR_GEOMETRIES, in.nbe);
+      const int32_t *battr = in.Get<int32_t>(BDR_ATTRIBUTES, in.nbe);
+      const int64_t *boffsets = in.Get<int64_t>(BDR_OFFSETS, in.nbe + 1);
+      const int32_t *bvert = in.Get<int32_t>(BDR_VERTICES, boffsets[in.nbe]);
+      Array<int> part_bdr;
+      if (num_parts == 1)
+      {
+         part_bdr.SetSize(int(in.nbe));
+         for (int i = 0; i < part_bdr.Size(); i++) { part_bdr[i] = i; }
+      }
+      else
+      {
+         const int32_t *belem = in.Get<int32_t>(BDR_ELEMENTS, in.nbe);
+         const int32_t *border = in.Get<int32_t>(BDR_ORDER, in.nbe);
+         auto before = [belem](int32_t b, int64_t e) { return belem[b] < e; };
+         const int32_t *first = std::lower_bound(border, border + in.nbe,
+                                                 e_begin, before);
+         const int32_t *last = std::lower_bound(first, border + in.nbe,
+                                                e_end, before);
+         part_bdr.SetSize(int(last - first));
+         std::copy(first, last, part_bdr.begin());
+         part_bdr.Sort();
+      }
+      NumOfBdrElements = part_bdr.Size();
+      boundary.SetSize(NumOfBdrElements);
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         boundary[i] = read_element(bgeom, battr, boffsets, bvert, part_bdr[i]);
+      }
+
+      const real_t *coords = in.Get<real_t>(VERTICES, in.nv*spaceDim);
+      NumOfVertices = part_vertices.Size();
+      vertices.SetSize(NumOfVertices);
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         vertices[i].SetCoords(spaceDim,
+                               coords + int64_t(part_vertices[i])*spaceDim);
+      }
+
+      if (vertex_ids) { mfem::Swap(*vertex_ids, part_vertices); }
+   }
+
+   if (in.Has(ATTRIBUTE_SETS))
+   {
+      std::istringstream input(in.GetText(ATTRIBUTE_SETS));
+      attribute_sets.attr_sets.Load(input);
+      attribute_sets.attr_sets.SortAll();
+      attribute_sets.attr_sets.UniqueAll();
+   }
+   if (in.Has(BDR_ATTRIBUTE_SETS))
+   {
+      std::istringstream input(in.GetText(BDR_ATTRIBUTE_SETS));
+      bdr_attribute_sets.attr_sets.Load(input);
+      bdr_attribute_sets.attr_sets.SortAll();
+      bdr_attribute_sets.attr_sets.UniqueAll();
+   }
+
+   // see the comments in Loader()
+   FinalizeTopology(false);
+
+   if (in.Has(NODES_SPACE))
+   {
+      std::istringstream input(in.GetText(NODES_SPACE));
+      std::string ident, fec_name;
+      int vdim, ordering;
+      input >> ident >> fec_name >> ident >> vdim >> ident >> ordering;
+      MFEM_VERIFY(input, "invalid nodes in binary mesh");
+
+      FiniteElementCollection *fec =
+         FiniteElementCollection::New(fec_name.c_str());
+      FiniteElementSpace *fes =
+         new FiniteElementSpace(this, fec, vdim, Ordering::Type(ordering));
+      Nodes = new GridFunction(fes);
+      Nodes->MakeOwner(fec);
+      own_nodes = 1;
+
+      const int64_t *offsets = in.Get<int64_t>(NODES_OFFSETS, in.ne + 1);
+      const real_t *values = in.Get<real_t>(NODES_DATA, offsets[in.ne]);
+      Array<int> vdofs;
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const int64_t e = e_begin + i;
+         fes->GetElementVDofs(i, vdofs);
+         MFEM_VERIFY(vdofs.Size() == offsets[e+1] - offsets[e],
+                     "invalid nodes in binary mesh");
+         Nodes->SetSubVector(vdofs, const_cast<real_t*>(values + offsets[e]));
+      }
+
+      spaceDim = Nodes->VectorDim();
+      if (ncmesh) { ncmesh->spaceDim = spaceDim; }
+
+      // Set vertex coordinates from the 'Nodes'
+      SetVerticesFromNodes(Nodes);
+   }
+}
+
+Mesh Mesh::LoadFromBinaryFile(const std::string &filename, int part,
+                              int num_parts, int refine, bool fix_orientation)
+{
+   Mesh mesh;
+   mesh.ReadBinaryFile(filename, part, num_parts, NULL);
+   mesh.Finalize(refine, fix_orientation);
+   return mesh;
+}
+
+} // namespace mfem
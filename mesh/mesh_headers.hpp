@@ -16,6 +16,7 @@
 
 #include "vertex.hpp"
 #include "element.hpp"
+#include "element_pool.hpp"
 #include "point.hpp"
 #include "segment.hpp"
 #include "triangle.hpp"
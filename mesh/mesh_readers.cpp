@@ -20,6 +20,8 @@
 #include <cstdio>
 #include <vector>
 #include <algorithm>
+#include <functional>
+#include <limits>
 #include <map>
 
 #ifdef MFEM_USE_NETCDF
@@ -413,7 +415,7 @@ void Mesh::CreateVTKMesh(const Vector &points, const Array<int> &cell_data,
       int j = (i > 0) ? cell_offsets[i-1] : 0;
       int ct = cell_types[i];
       Geometry::Type geom = VTKGeometry::GetMFEMGeometry(ct);
-      elements[i] = NewElement(geom);
+      elements[i] = AllocElement(geom);
       if (cell_attributes.Size() > 0)
       {
          elements[i]->SetAttribute(cell_attributes[i]);
@@ -692,35 +694,123 @@ bool StringCompare(const char *s1, const char *s2)
    return strcmp(s1, s2) == 0;
 }
 
+/// Stream of the binary data of the @a DataArray elements, which is stored
+/// either as raw bytes or as base-64 encoded text. The base-64 text is decoded
+/// on demand in chunks of bounded size, and only the characters needed for the
+/// requested bytes are extracted from the input stream.
+class DataStream
+{
+   std::istream &in;
+   const bool base64;
+   std::vector<char> chars, bytes; // encoded and decoded chunks
+   size_t pos; // position in 'bytes'
+   size_t consumed; // number of characters extracted from 'in'
+
+   /// Maximum number of groups of four base-64 characters decoded at once.
+   static constexpr size_t max_groups = 1 << 20;
+
+   /// Decode the next @a ngroups groups of four base-64 characters, skipping
+   /// any whitespace between them.
+   void DecodeGroups(size_t ngroups)
+   {
+      chars.resize(4*ngroups);
+      size_t nchars = 0;
+      while (nchars < chars.size())
+      {
+         in.read(chars.data() + nchars, chars.size() - nchars);
+         const size_t count = in.gcount();
+         MFEM_VERIFY(count > 0, "Unexpected end of base-64 encoded data");
+         consumed += count;
+         const size_t end = nchars + count;
+         for (size_t i = nchars; i < end; i++)
+         {
+            if (bin_io::IsBase64Char(chars[i])) { chars[nchars++] = chars[i]; }
+         }
+      }
+      bytes.resize(3*ngroups);
+      bytes.resize(bin_io::DecodeBase64Groups(chars.data(), chars.size(),
+                                              bytes.data()));
+      pos = 0;
+   }
+
+public:
+   DataStream(std::istream &in_, bool base64_)
+      : in(in_), base64(base64_), pos(0), consumed(0) { }
+
+   /// Read the next @a n bytes of binary data into @a dest.
+   void Read(char *dest, size_t n)
+   {
+      if (!base64)
+      {
+         in.read(dest, n);
+         MFEM_VERIFY(size_t(in.gcount()) == n, "Unexpected end of binary data");
+         consumed += n;
+         return;
+      }
+      while (n > 0)
+      {
+         if (pos == bytes.size())
+         {
+            DecodeGroups(std::min((n + 2)/3, size_t(max_groups)));
+         }
+         const size_t count = std::min(n, bytes.size() - pos);
+         std::copy(bytes.data() + pos, bytes.data() + pos + count, dest);
+         pos += count;
+         dest += count;
+         n -= count;
+      }
+   }
+
+   /// Skip ahead to the position @a offset of the input, given in bytes for
+   /// raw data and in characters for base-64 encoded data.
+   void Seek(size_t offset)
+   {
+      MFEM_VERIFY(offset >= consumed, "Invalid AppendedData offset");
+      in.ignore(offset - consumed);
+      consumed = offset;
+      bytes.clear();
+      pos = 0;
+   }
+};
+
+/// Input stream buffer reading from a block of memory without copying it.
+struct MemoryBuffer : std::streambuf
+{
+   MemoryBuffer(const char *buf, size_t n)
+   {
+      char *p = const_cast<char*>(buf);
+      setg(p, p, p + n);
+   }
+};
+
 /// Abstract base class for reading contiguous arrays of (potentially
-/// compressed, potentially base-64 encoded) binary data from a buffer into a
-/// destination array. The types of the source and destination arrays may be
-/// different (e.g. read data of type uint8_t into destination array of
+/// compressed, potentially base-64 encoded) binary data from a @a DataStream
+/// into a destination array. The types of the source and destination arrays
+/// may be different (e.g. read data of type uint8_t into destination array of
 /// uint32_t), which is handled by the templated derived class @a BufferReader.
+///
+/// The binary data has a header, which is one integer if the data is
+/// uncompressed, and is N + 3 integers if the data is compressed in N blocks.
+/// The integers may either by uint32_t or uint64_t, according to the @a
+/// header_type. If the data is compressed and base-64 encoded, then the header
+/// is encoded separately from the data. If the data is uncompressed and base-64
+/// encoded, then the header and data may be encoded together.
 struct BufferReaderBase
 {
    enum HeaderType { UINT32_HEADER, UINT64_HEADER };
-   virtual void ReadBinary(const char *buf, void *dest, int n) const = 0;
-   virtual void ReadBase64(const char *txt, void *dest, int n) const = 0;
-   virtual ~BufferReaderBase() { }
-};
 
-/// Read an array of source data stored as (potentially compressed, potentially
-/// base-64 encoded) into a destination array. The types of the elements in the
-/// source array are given by template parameter @a F ("from") and the types of
-/// the elements of the destination array are given by @a T ("to"). The binary
-/// data has a header, which is one integer if the data is uncompressed, and is
-/// four integers if the data is compressed. The integers may either by uint32_t
-/// or uint64_t, according to the @a header_type. If the data is compressed and
-/// base-64 encoded, then the header is encoded separately from the data. If the
-/// data is uncompressed and base-64 encoded, then the header and data are
-/// encoded together.
-template <typename T, typename F>
-struct BufferReader : BufferReaderBase
-{
+   /// Sizes read from the header of the binary data.
+   struct Header
+   {
+      size_t nbytes; ///< Total uncompressed size
+      size_t block_size, last_block_size; ///< Uncompressed block sizes
+      std::vector<size_t> compressed_sizes; ///< Compressed block sizes
+   };
+
    bool compressed;
    HeaderType header_type;
-   BufferReader(bool compressed_, HeaderType header_type_)
+
+   BufferReaderBase(bool compressed_, HeaderType header_type_)
       : compressed(compressed_), header_type(header_type_) { }
 
    /// Return the number of bytes of each header entry.
@@ -729,169 +819,201 @@ struct BufferReader : BufferReaderBase
       return header_type == UINT64_HEADER ? sizeof(uint64_t) : sizeof(uint32_t);
    }
 
-   /// Return the value of the header entry pointer to by @a header_buf. The
-   /// value is stored as either uint32_t or uint64_t, according to the @a
-   /// header_type, and is returned as uint64_t.
-   uint64_t ReadHeaderEntry(const char *header_buf) const
+   /// Read the next header entry from @a src. The value is stored as either
+   /// uint32_t or uint64_t, according to the @a header_type, and is returned
+   /// as uint64_t.
+   uint64_t ReadHeaderEntry(DataStream &src) const
    {
-      return (header_type == UINT64_HEADER) ? bin_io::read<uint64_t>(header_buf)
-             : bin_io::read<uint32_t>(header_buf);
+      char buf[sizeof(uint64_t)];
+      src.Read(buf, HeaderEntrySize());
+      return (header_type == UINT64_HEADER) ? bin_io::read<uint64_t>(buf)
+             : bin_io::read<uint32_t>(buf);
    }
 
-   /// Return the number of bytes in the header. The header consists of one
-   /// integer if the data is uncompressed, and @a N + 3 integers if the data is
-   /// compressed, where @a N is the number of blocks. The integers are either
-   /// 32 or 64 bytes depending on the value of @a header_type. The number of
-   /// blocks is determined by reading the first integer (of type @a
-   /// header_type) pointed to by @a header_buf.
-   int NumHeaderBytes(const char *header_buf) const
+   /// Read the header of the binary data from @a src. If the data is
+   /// compressed, the header has format (where header_t is uint32_t or
+   /// uint64_t):
+   ///    header_t number_of_blocks;
+   ///    header_t uncompressed_block_size;
+   ///    header_t uncompressed_last_block_size; // 0 if the last block is full
+   ///    header_t compressed_size[number_of_blocks];
+   /// otherwise it is the number of bytes of data.
+   void ReadHeader(DataStream &src, Header &header) const
    {
-      if (!compressed) { return HeaderEntrySize(); }
-      return (3 + ReadHeaderEntry(header_buf))*HeaderEntrySize();
+      if (!compressed)
+      {
+         header.nbytes = ReadHeaderEntry(src);
+         return;
+      }
+      const size_t nblocks = ReadHeaderEntry(src);
+      header.block_size = ReadHeaderEntry(src);
+      header.last_block_size = ReadHeaderEntry(src);
+      if (header.last_block_size == 0)
+      {
+         header.last_block_size = header.block_size;
+      }
+      header.compressed_sizes.resize(nblocks);
+      for (size_t i = 0; i < nblocks; i++)
+      {
+         header.compressed_sizes[i] = ReadHeaderEntry(src);
+      }
+      header.nbytes = (nblocks == 0) ? 0 :
+                      (nblocks - 1)*header.block_size + header.last_block_size;
    }
 
-   /// Read @a n elements of type @a F from the source buffer @a buf into the
-   /// (pre-allocated) destination array of elements of type @a T stored in
-   /// the buffer @a dest_void. The header is stored @b separately from the
-   /// rest of the data, in the buffer @a header_buf. The data buffer @a buf
-   /// does @b not contain a header.
-   void ReadBinaryWithHeader(const char *header_buf, const char *buf,
-                             void *dest_void, int n) const
+   /// Return the size of the source data type in bytes.
+   virtual size_t ValueSize() const = 0;
+
+   /// Read the data described by @a header from @a src into the
+   /// (pre-allocated) destination array @a dest with @a n elements.
+   virtual void ReadData(DataStream &src, const Header &header,
+                         void *dest, int n) const = 0;
+
+   virtual ~BufferReaderBase() { }
+};
+
+/// Read an array of source data stored as (potentially compressed, potentially
+/// base-64 encoded) into a destination array. The types of the elements in the
+/// source array are given by template parameter @a F ("from") and the types of
+/// the elements of the destination array are given by @a T ("to"). When the
+/// types are the same, the data is decoded directly into the destination,
+/// otherwise it is converted through a staging buffer of bounded size.
+template <typename T, typename F>
+struct BufferReader : BufferReaderBase
+{
+   /// Maximum size of the staging buffers, in bytes.
+   static constexpr size_t max_chunk = size_t(1) << 24;
+
+   BufferReader(bool compressed_, HeaderType header_type_)
+      : BufferReaderBase(compressed_, header_type_) { }
+
+   size_t ValueSize() const override { return sizeof(F); }
+
+   /// Convert the @a nbytes bytes of source data in @a buf into @a dest.
+   static void Convert(const char *buf, size_t nbytes, T *dest)
    {
-      std::vector<char> uncompressed_data;
+      const size_t n = nbytes/sizeof(F);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (long long i = 0; i < (long long)n; ++i)
+      {
+         // Read binary data as type F, place in array as type T
+         dest[i] = bin_io::read<F>(buf + i*sizeof(F));
+      }
+   }
+
+   void ReadData(DataStream &src, const Header &header,
+                 void *dest_void, int n) const override
+   {
+      MFEM_VERIFY(sizeof(F)*n == header.nbytes, "AppendedData: wrong data size");
       T *dest = static_cast<T*>(dest_void);
+      char *dest_bytes = static_cast<char*>(dest_void);
+      const bool direct = std::is_same<T, F>::value;
+      std::vector<char> staging;
 
-      if (compressed)
+      if (!compressed)
       {
-#ifdef MFEM_USE_ZLIB
-         // The header has format (where header_t is uint32_t or uint64_t):
-         //    header_t number_of_blocks;
-         //    header_t uncompressed_block_size;
-         //    header_t uncompressed_last_block_size;
-         //    header_t compressed_size[number_of_blocks];
-         int header_entry_size = HeaderEntrySize();
-         int nblocks = ReadHeaderEntry(header_buf);
-         header_buf += header_entry_size;
-         std::vector<int> header(nblocks + 2);
-         for (int i=0; i<nblocks+2; ++i)
-         {
-            header[i] = ReadHeaderEntry(header_buf);
-            header_buf += header_entry_size;
-         }
-         uncompressed_data.resize((nblocks-1)*header[0] + header[1]);
-         Bytef *dest_ptr = (Bytef *)uncompressed_data.data();
-         Bytef *dest_start = dest_ptr;
-         const Bytef *source_ptr = (const Bytef *)buf;
-         for (int i=0; i<nblocks; ++i)
+         const size_t chunk = max_chunk - max_chunk % sizeof(F);
+         for (size_t done = 0; done < header.nbytes; )
          {
-            uLongf source_len = header[i+2];
-            uLong dest_len = (i == nblocks-1) ? header[1] : header[0];
-            int res = uncompress(dest_ptr, &dest_len, source_ptr, source_len);
-            MFEM_VERIFY(res == Z_OK, "Error uncompressing");
-            dest_ptr += dest_len;
-            source_ptr += source_len;
+            const size_t count = std::min(chunk, header.nbytes - done);
+            if (direct)
+            {
+               src.Read(dest_bytes + done, count);
+            }
+            else
+            {
+               staging.resize(count);
+               src.Read(staging.data(), count);
+               Convert(staging.data(), count, dest + done/sizeof(F));
+            }
+            done += count;
          }
-         MFEM_VERIFY(int(sizeof(F)*n) == (dest_ptr - dest_start),
-                     "AppendedData: wrong data size");
-         buf = uncompressed_data.data();
-#else
-         MFEM_ABORT("MFEM must be compiled with zlib enabled to uncompress.")
-#endif
+         return;
       }
-      else
+
+#ifdef MFEM_USE_ZLIB
+      // The compressed blocks are read in batches of bounded size, and the
+      // blocks of a batch are uncompressed in parallel. Without a direct copy,
+      // a batch must consist of whole values of type F.
+      const size_t nblocks = header.compressed_sizes.size();
+      const size_t block_size = header.block_size;
+      const bool single_batch = !direct && (block_size % sizeof(F) != 0);
+      std::vector<char> compressed_data;
+      std::vector<size_t> offsets;
+      for (size_t b0 = 0; b0 < nblocks; )
       {
-         // Each "data block" is preceded by a header that is either UInt32 or
-         // UInt64. The rest of the data follows.
-         uint64_t data_size;
-         if (header_type == UINT32_HEADER)
+         size_t b1 = b0, batch_size = 0;
+         offsets.assign(1, 0);
+         while (b1 < nblocks &&
+                (b1 == b0 || batch_size < max_chunk || single_batch))
          {
-            uint32_t *data_size_32 = (uint32_t *)header_buf;
-            data_size = *data_size_32;
+            batch_size += header.compressed_sizes[b1++];
+            offsets.push_back(batch_size);
          }
-         else
+         compressed_data.resize(batch_size);
+         src.Read(compressed_data.data(), batch_size);
+
+         const size_t out_size = (b1 == nblocks) ?
+                                 header.nbytes - b0*block_size :
+                                 (b1 - b0)*block_size;
+         char *out = dest_bytes + b0*block_size;
+         if (!direct)
          {
-            uint64_t *data_size_64 = (uint64_t *)header_buf;
-            data_size = *data_size_64;
+            staging.resize(out_size);
+            out = staging.data();
          }
-         MFEM_VERIFY(sizeof(F)*n == data_size, "AppendedData: wrong data size");
-      }
-
-      if (std::is_same<T, F>::value)
-      {
-         // Special case: no type conversions necessary, so can just memcpy
-         memcpy(dest, buf, sizeof(T)*n);
-      }
-      else
-      {
-         for (int i=0; i<n; ++i)
+         int error = 0;
+#ifdef MFEM_USE_OPENMP
+         #pragma omp parallel for reduction(+:error)
+#endif
+         for (long long b = b0; b < (long long)b1; b++)
          {
-            // Read binary data as type F, place in array as type T
-            dest[i] = bin_io::read<F>(buf + i*sizeof(F));
+            const size_t expected = (size_t(b) == nblocks - 1) ?
+                                    header.last_block_size : block_size;
+            uLongf dest_len = expected;
+            const int res = uncompress(
+                               (Bytef *)out + (b - b0)*block_size, &dest_len,
+                               (const Bytef *)compressed_data.data()
+                               + offsets[b - b0],
+                               offsets[b - b0 + 1] - offsets[b - b0]);
+            if (res != Z_OK || dest_len != expected) { error++; }
          }
+         MFEM_VERIFY(error == 0, "Error uncompressing");
+         if (!direct)
+         {
+            Convert(staging.data(), out_size, dest + b0*block_size/sizeof(F));
+         }
+         b0 = b1;
       }
-   }
-
-   /// Read @a n elements of type @a F from source buffer @a buf into
-   /// (pre-allocated) array of elements of type @a T stored in destination
-   /// buffer @a dest. The input buffer contains both the header and the data.
-   void ReadBinary(const char *buf, void *dest, int n) const override
-   {
-      ReadBinaryWithHeader(buf, buf + NumHeaderBytes(buf), dest, n);
-   }
-
-   /// Read @a n elements of type @a F from base-64 encoded source buffer into
-   /// (pre-allocated) array of elements of type @a T stored in destination
-   /// buffer @a dest. The base-64-encoded data is given by the null-terminated
-   /// string @a txt, which contains both the header and the data.
-   void ReadBase64(const char *txt, void *dest, int n) const override
-   {
-      // Skip whitespace
-      while (*txt)
-      {
-         if (*txt != ' ' && *txt != '\n') { break; }
-         ++txt;
-      }
-      if (compressed)
-      {
-         // Decode the first entry of the header, which we need to determine
-         // how long the rest of the header is.
-         std::vector<char> nblocks_buf;
-         int nblocks_b64 = bin_io::NumBase64Chars(HeaderEntrySize());
-         bin_io::DecodeBase64(txt, nblocks_b64, nblocks_buf);
-         std::vector<char> data, header;
-         // Compute number of characters needed to encode header in base 64,
-         // then round to nearest multiple of 4 to take padding into account.
-         int header_b64 = bin_io::NumBase64Chars(NumHeaderBytes(nblocks_buf.data()));
-         // If data is compressed, header is encoded separately
-         bin_io::DecodeBase64(txt, header_b64, header);
-         bin_io::DecodeBase64(txt + header_b64, strlen(txt)-header_b64, data);
-         ReadBinaryWithHeader(header.data(), data.data(), dest, n);
-      }
-      else
-      {
-         std::vector<char> data;
-         bin_io::DecodeBase64(txt, strlen(txt), data);
-         ReadBinary(data.data(), dest, n);
-      }
+#else
+      MFEM_ABORT("MFEM must be compiled with zlib enabled to uncompress.")
+#endif
    }
 };
 
 /// Class to read data from VTK's @a DataArary elements. Each @a DataArray can
 /// contain inline ASCII data, inline base-64-encoded data (potentially
 /// compressed), or reference "appended data", which may be raw or base-64, and
-/// may be compressed or uncompressed.
+/// may be compressed or uncompressed. The appended data is read from the input
+/// stream, which must be positioned at its start.
 struct XMLDataReader
 {
-   const char *appended_data, *byte_order, *compressor;
-   enum AppendedDataEncoding { RAW, BASE64 };
+   const char *byte_order, *compressor;
    map<string,BufferReaderBase*> type_map;
-   AppendedDataEncoding encoding;
+   std::istream *appended_data;
+   bool appended_base64;
+
+   /// Reads of appended data, performed in the order of their offsets.
+   std::vector<std::pair<size_t, std::function<void(DataStream&)>>> pending;
 
    /// Create the data reader, where @a vtk is the @a VTKFile XML element, and
    /// @a vtu is the child @a UnstructuredGrid XML element. This will determine
    /// the header type (32 or 64 bit integers) and whether compression is
-   /// enabled or not. The appended data will be loaded.
-   XMLDataReader(const XMLElement *vtk, const XMLElement *vtu)
+   /// enabled or not. The appended data, if any, will be read from @a input.
+   XMLDataReader(const XMLElement *vtk, const XMLElement *vtu,
+                 std::istream &input)
    {
       // Determine whether binary data header is 32 or 64 bit integer
       BufferReaderBase::HeaderType htype;
@@ -912,8 +1034,9 @@ struct XMLDataReader
       compressor = vtk->Attribute("compressor");
       bool compressed = (compressor != NULL);
 
-      // Find the appended data.
+      // Find the encoding of the appended data.
       appended_data = NULL;
+      appended_base64 = false;
       for (const XMLElement *xml_elem = vtu->NextSiblingElement();
            xml_elem != NULL;
            xml_elem = xml_elem->NextSiblingElement())
@@ -921,30 +1044,10 @@ struct XMLDataReader
          if (StringCompare(xml_elem->Name(), "AppendedData"))
          {
             const char *encoding_str = xml_elem->Attribute("encoding");
-            if (StringCompare(encoding_str, "raw"))
-            {
-               appended_data = xml_elem->GetAppendedData();
-               encoding = RAW;
-            }
-            else if (StringCompare(encoding_str, "base64"))
-            {
-               appended_data = xml_elem->GetText();
-               encoding = BASE64;
-            }
-            MFEM_VERIFY(appended_data != NULL, "Invalid AppendedData");
-            // Appended data follows first underscore
-            bool found_leading_underscore = false;
-            while (*appended_data)
-            {
-               ++appended_data;
-               if (*appended_data == '_')
-               {
-                  found_leading_underscore = true;
-                  ++appended_data;
-                  break;
-               }
-            }
-            MFEM_VERIFY(found_leading_underscore, "Invalid AppendedData");
+            appended_base64 = StringCompare(encoding_str, "base64");
+            MFEM_VERIFY(appended_base64 || StringCompare(encoding_str, "raw"),
+                        "Invalid AppendedData");
+            appended_data = &input;
             break;
          }
       }
@@ -957,15 +1060,36 @@ struct XMLDataReader
       type_map["UInt16"] = new BufferReader<int, uint16_t>(compressed, htype);
       type_map["UInt32"] = new BufferReader<int, uint32_t>(compressed, htype);
       type_map["UInt64"] = new BufferReader<int, uint64_t>(compressed, htype);
-      type_map["Float32"] = new BufferReader<double, float>(compressed, htype);
-      type_map["Float64"] = new BufferReader<double, double>(compressed, htype);
+      type_map["Float32"] = new BufferReader<real_t, float>(compressed, htype);
+      type_map["Float64"] = new BufferReader<real_t, double>(compressed, htype);
    }
 
-   /// Read the @a DataArray XML element given by @a xml_elem into
-   /// (pre-allocated) destination array @a dest, where @a dest stores @a n
-   /// elements of type @a T.
-   template <typename T>
-   void Read(const XMLElement *xml_elem, T *dest, int n)
+   /// Read the header and the data of a binary @a DataArray of type @a type
+   /// from @a src into @a dest, which is resized to the number of values. If
+   /// @a n is nonnegative, verify that this number is @a n.
+   template <typename C>
+   void ReadBinary(DataStream &src, const char *type, C &dest, int n)
+   {
+      static const char *erstr = "Error reading XML DataArray";
+      MFEM_VERIFY(type != NULL, erstr);
+      auto it = type_map.find(type);
+      MFEM_VERIFY(it != type_map.end(), erstr);
+      const BufferReaderBase *reader = it->second;
+      BufferReaderBase::Header header;
+      reader->ReadHeader(src, header);
+      const int size = int(header.nbytes/reader->ValueSize());
+      MFEM_VERIFY(n < 0 || size == n, "AppendedData: wrong data size");
+      dest.SetSize(size);
+      reader->ReadData(src, header, dest.GetData(), size);
+   }
+
+   /// Read the @a DataArray XML element given by @a xml_elem into @a dest
+   /// (an Array<int> or a Vector), which is resized to the number of values.
+   /// If @a n is nonnegative, the array must have @a n values. Inline data is
+   /// read immediately, while the reading of appended data is deferred until
+   /// ReadAppended(), so that the input is traversed only once.
+   template <typename C>
+   void Read(const XMLElement *xml_elem, C &dest, int n = -1)
    {
       static const char *erstr = "Error reading XML DataArray";
       MFEM_VERIFY(StringCompare(xml_elem->Name(), "DataArray"), erstr);
@@ -974,37 +1098,42 @@ struct XMLDataReader
       {
          const char *txt = xml_elem->GetText();
          MFEM_VERIFY(txt != NULL, erstr);
-         std::istringstream data_stream(txt);
-         for (int i=0; i<n; ++i) { data_stream >> dest[i]; }
-      }
-      else if (StringCompare(format, "appended"))
-      {
-         VerifyBinaryOptions();
-         int offset = xml_elem->IntAttribute("offset");
-         const char *type = xml_elem->Attribute("type");
-         MFEM_VERIFY(type != NULL, erstr);
-         BufferReaderBase *reader = type_map[type];
-         MFEM_VERIFY(reader != NULL, erstr);
-         MFEM_VERIFY(appended_data != NULL, "No AppendedData found");
-         if (encoding == RAW)
+         MemoryBuffer buf(txt, strlen(txt));
+         std::istream data_stream(&buf);
+         if (n >= 0)
          {
-            reader->ReadBinary(appended_data + offset, dest, n);
+            dest.SetSize(n);
+            for (int i=0; i<n; ++i) { data_stream >> dest[i]; }
          }
          else
          {
-            reader->ReadBase64(appended_data + offset, dest, n);
+            typedef typename std::remove_reference<decltype(dest[0])>::type T;
+            std::vector<T> values;
+            T value;
+            while (data_stream >> value) { values.push_back(value); }
+            dest.SetSize(int(values.size()));
+            std::copy(values.begin(), values.end(), dest.GetData());
          }
       }
+      else if (StringCompare(format, "appended"))
+      {
+         VerifyBinaryOptions();
+         MFEM_VERIFY(appended_data != NULL, "No AppendedData found");
+         const int64_t offset = xml_elem->Int64Attribute("offset", -1);
+         MFEM_VERIFY(offset >= 0, erstr);
+         const char *type = xml_elem->Attribute("type");
+         pending.emplace_back(size_t(offset), [this, type, &dest, n]
+                              (DataStream &src) { ReadBinary(src, type, dest, n); });
+      }
       else if (StringCompare(format, "binary"))
       {
          VerifyBinaryOptions();
          const char *txt = xml_elem->GetText();
          MFEM_VERIFY(txt != NULL, erstr);
-         const char *type = xml_elem->Attribute("type");
-         if (type == NULL) { MFEM_ABORT(erstr); }
-         BufferReaderBase *reader = type_map[type];
-         if (reader == NULL) { MFEM_ABORT(erstr); }
-         reader->ReadBase64(txt, dest, n);
+         MemoryBuffer buf(txt, strlen(txt));
+         std::istream data_stream(&buf);
+         DataStream src(data_stream, true);
+         ReadBinary(src, xml_elem->Attribute("type"), dest, n);
       }
       else
       {
@@ -1012,6 +1141,24 @@ struct XMLDataReader
       }
    }
 
+   /// Read the requested arrays of appended data, streaming through the input
+   /// in the order of the offsets.
+   void ReadAppended()
+   {
+      if (pending.empty()) { return; }
+      std::sort(pending.begin(), pending.end(),
+                [](const std::pair<size_t, std::function<void(DataStream&)>> &a,
+                   const std::pair<size_t, std::function<void(DataStream&)>> &b)
+      { return a.first < b.first; });
+      DataStream src(*appended_data, appended_base64);
+      for (auto &p : pending)
+      {
+         src.Seek(p.first);
+         p.second(src);
+      }
+      pending.clear();
+   }
+
    /// Check that the byte order of the file is the same as the native byte
    /// order that we're running with. We don't currently support converting
    /// between byte orders. The byte order is only verified if we encounter
@@ -1063,18 +1210,36 @@ void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
 
    static const char *erstr = "XML parsing error";
 
-   // Create buffer beginning with xml_prefix, then read the rest of the stream
-   std::vector<char> buf(xml_prefix.begin(), xml_prefix.end());
-   std::istreambuf_iterator<char> eos;
-   buf.insert(buf.end(), std::istreambuf_iterator<char>(input), eos);
-   buf.push_back('\0'); // null-terminate buffer
+   // Read the XML up to the start of the appended data, beginning with
+   // xml_prefix. The appended data, which holds the bulk of the mesh, is then
+   // streamed from the input directly into the mesh arrays.
+   std::string xml_str(xml_prefix);
+   xml_str += '\n';
+   std::string chunk;
+   bool appended = false;
+   while (!appended && std::getline(input, chunk, '>'))
+   {
+      xml_str += chunk;
+      if (!input.eof()) { xml_str += '>'; }
+      appended = (chunk.find("<AppendedData") != std::string::npos &&
+                  chunk.back() != '/');
+   }
+   if (appended)
+   {
+      // Appended data follows first underscore
+      char c = 0;
+      while (input.get(c) && c != '_') { }
+      MFEM_VERIFY(c == '_', "Invalid AppendedData");
+      xml_str += "</AppendedData></VTKFile>";
+   }
 
    XMLDocument xml;
-   xml.Parse(buf.data(), buf.size());
+   xml.Parse(xml_str.data(), xml_str.size());
    if (xml.ErrorID() != XML_SUCCESS)
    {
       MFEM_ABORT("Error parsing XML VTK file.\n" << xml.ErrorStr());
    }
+   std::string().swap(xml_str);
 
    const XMLElement *vtkfile = xml.FirstChildElement();
    MFEM_VERIFY(vtkfile, erstr);
@@ -1083,7 +1248,7 @@ void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
    MFEM_VERIFY(vtu, erstr);
    MFEM_VERIFY(StringCompare(vtu->Name(), "UnstructuredGrid"), erstr);
 
-   XMLDataReader data_reader(vtkfile, vtu);
+   XMLDataReader data_reader(vtkfile, vtu, input);
 
    // Count the number of points and cells
    const XMLElement *piece = vtu->FirstChildElement();
@@ -1094,7 +1259,7 @@ void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
    int ncells = piece->IntAttribute("NumberOfCells");
 
    // Read the points
-   Vector points(3*npts);
+   Vector points;
    const XMLElement *pts_xml;
    for (pts_xml = piece->FirstChildElement();
         pts_xml != NULL;
@@ -1105,14 +1270,15 @@ void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
          const XMLElement *pts_data = pts_xml->FirstChildElement();
          MFEM_VERIFY(pts_data->IntAttribute("NumberOfComponents") == 3,
                      "XML VTK Points DataArray must have 3 components");
-         data_reader.Read(pts_data, points.GetData(), points.Size());
+         data_reader.Read(pts_data, points, 3*npts);
          break;
       }
    }
    if (pts_xml == NULL) { MFEM_ABORT(erstr); }
 
-   // Read the cells
-   Array<int> cell_data, cell_offsets(ncells), cell_types(ncells);
+   // Read the cells. The size of the connectivity array is equal to the last
+   // offset, which is checked once all arrays are read.
+   Array<int> cell_data, cell_offsets, cell_types;
    const XMLElement *cells_xml;
    for (cells_xml = piece->FirstChildElement();
         cells_xml != NULL;
@@ -1120,7 +1286,7 @@ void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
    {
       if (StringCompare(cells_xml->Name(), "Cells"))
       {
-         const XMLElement *cell_data_xml = NULL;
+         bool found_cell_data = false;
          for (const XMLElement *data_xml = cells_xml->FirstChildElement();
               data_xml != NULL;
               data_xml = data_xml->NextSiblingElement())
@@ -1128,25 +1294,19 @@ void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
             const char *data_name = data_xml->Attribute("Name");
             if (StringCompare(data_name, "offsets"))
             {
-               data_reader.Read(data_xml, cell_offsets.GetData(), ncells);
+               data_reader.Read(data_xml, cell_offsets, ncells);
             }
             else if (StringCompare(data_name, "types"))
             {
-               data_reader.Read(data_xml, cell_types.GetData(), ncells);
+               data_reader.Read(data_xml, cell_types, ncells);
             }
             else if (StringCompare(data_name, "connectivity"))
             {
-               // Have to read the connectivity after the offsets, because we
-               // don't know how many points to read until we have the offsets
-               // (size of connectivity array is equal to the last offset), so
-               // store the XML element pointer and read this data later.
-               cell_data_xml = data_xml;
+               data_reader.Read(data_xml, cell_data);
+               found_cell_data = true;
             }
          }
-         MFEM_VERIFY(cell_data_xml != NULL, erstr);
-         int cell_data_size = cell_offsets.Last();
-         cell_data.SetSize(cell_data_size);
-         data_reader.Read(cell_data_xml, cell_data.GetData(), cell_data_size);
+         MFEM_VERIFY(found_cell_data, erstr);
          break;
       }
    }
@@ -1156,7 +1316,8 @@ void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
    // "material" or "attribute". We prioritize "material" over "attribute" for
    // backwards compatibility.
    Array<int> cell_attributes;
-   bool found_attributes = false;
+   const XMLElement *attributes_xml = NULL;
+   bool found_material = false;
    for (const XMLElement *cell_data_xml = piece->FirstChildElement();
         cell_data_xml != NULL;
         cell_data_xml = cell_data_xml->NextSiblingElement())
@@ -1167,17 +1328,33 @@ void Mesh::ReadXML_VTKMesh(std::istream &input, int &curved, int &read_gf,
          StringCompare(cell_data_xml->Attribute("Scalars"), "material");
       const bool is_attribute =
          StringCompare(cell_data_xml->Attribute("Scalars"), "attribute");
-      if (is_cell_data && (is_material || (is_attribute && !found_attributes)))
+      if (is_cell_data && (is_material ||
+                           (is_attribute && !found_material && !attributes_xml)))
       {
-         found_attributes = true;
+         found_material = found_material || is_material;
          const XMLElement *data_xml = cell_data_xml->FirstChildElement();
          if (data_xml != NULL && StringCompare(data_xml->Name(), "DataArray"))
          {
-            cell_attributes.SetSize(ncells);
-            data_reader.Read(data_xml, cell_attributes.GetData(), ncells);
+            attributes_xml = data_xml;
          }
       }
    }
+   if (attributes_xml != NULL)
+   {
+      data_reader.Read(attributes_xml, cell_attributes, ncells);
+   }
+
+   data_reader.ReadAppended();
+   MFEM_VERIFY(cell_offsets.Size() == ncells && cell_types.Size() == ncells,
+               erstr);
+   MFEM_VERIFY(cell_data.Size() == (ncells > 0 ? cell_offsets.Last() : 0),
+               "XML VTK connectivity does not match the cell offsets");
+
+   // Skip the rest of the appended data
+   if (appended)
+   {
+      input.ignore(std::numeric_limits<std::streamsize>::max());
+   }
 
    CreateVTKMesh(points, cell_data, cell_offsets, cell_types, cell_attributes,
                  curved, read_gf, finalize_topo);
@@ -1519,6 +1696,69 @@ void Mesh::ReadInlineMesh(std::istream &input, bool generate_edges)
    }
 }
 
+/// Map between the Gmsh node numbers and the vertex indices. Gmsh numbers the
+/// nodes starting from 1, and there may be gaps in the numbering, so the map is
+/// stored as a dense array when the numbers are not too sparse, and as a sorted
+/// array searched by bisection otherwise.
+class GmshVertexMap
+{
+   Array<int> dense; // vertex index of each number, or -1
+   Array<int> numbers, indices; // sorted numbers and their vertex indices
+   int min_number = 0;
+   bool is_dense = true;
+
+public:
+   /// Set up the map, where @a node_numbers holds the node number of each
+   /// vertex. Return false if the numbers are not unique.
+   bool Build(const Array<int> &node_numbers)
+   {
+      const int nv = node_numbers.Size();
+      dense.DeleteAll();
+      numbers.DeleteAll();
+      indices.DeleteAll();
+      if (nv == 0) { return true; }
+      min_number = node_numbers.Min();
+      const long long range = (long long)node_numbers.Max() - min_number + 1;
+      is_dense = (range <= 2LL*nv);
+      if (is_dense)
+      {
+         dense.SetSize(int(range));
+         dense = -1;
+         for (int i = 0; i < nv; i++)
+         {
+            int &index = dense[node_numbers[i] - min_number];
+            if (index >= 0) { return false; }
+            index = i;
+         }
+         return true;
+      }
+      indices.SetSize(nv);
+      for (int i = 0; i < nv; i++) { indices[i] = i; }
+      std::sort(indices.begin(), indices.end(), [&](int a, int b)
+      { return node_numbers[a] < node_numbers[b]; });
+      numbers.SetSize(nv);
+      for (int i = 0; i < nv; i++)
+      {
+         numbers[i] = node_numbers[indices[i]];
+         if (i > 0 && numbers[i] == numbers[i-1]) { return false; }
+      }
+      return true;
+   }
+
+   /// Return the vertex index of the node @a number, or -1 if there is none.
+   int operator()(int number) const
+   {
+      if (is_dense)
+      {
+         const long long k = (long long)number - min_number;
+         return (k >= 0 && k < dense.Size()) ? dense[int(k)] : -1;
+      }
+      const int *it = std::lower_bound(numbers.begin(), numbers.end(), number);
+      return (it != numbers.end() && *it == number) ?
+             indices[int(it - numbers.begin())] : -1;
+   }
+};
+
 void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
 {
    string buff;
@@ -1548,7 +1788,7 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
    // A map between a serial number of the vertex and its number in the file
    // (there may be gaps in the numbering, and also Gmsh enumerates vertices
    // starting from 1, not 0)
-   map<int, int> vertices_map;
+   GmshVertexMap vertices_map;
 
    // A map containing names of physical curves, surfaces, and volumes.
    // The first index is the dimension of the physical manifold, the second
@@ -1588,6 +1828,7 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
          input >> NumOfVertices;
          getline(input, buff);
          vertices.SetSize(NumOfVertices);
+         Array<int> node_numbers(NumOfVertices);
          int serial_number;
          const int gmsh_dim = 3; // Gmsh always outputs 3 coordinates
          real_t coord[gmsh_dim];
@@ -1607,7 +1848,7 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                }
             }
             vertices[ver] = Vertex(coord, gmsh_dim);
-            vertices_map[serial_number] = ver;
+            node_numbers[ver] = serial_number;
 
             for (int ci = 0; ci < gmsh_dim; ++ci)
             {
@@ -1630,7 +1871,7 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
             spaceDim++;
          }
 
-         if (static_cast<int>(vertices_map.size()) != NumOfVertices)
+         if (!vertices_map.Build(node_numbers))
          {
             MFEM_ABORT("Gmsh file : vertices indices are not unique");
          }
@@ -1904,23 +2145,15 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                         29,23,19,24,17,10,14,20,18,4
                        };
 
+         // The element lists grow as needed, since reserving the total number
+         // of elements for each dimension would multiply the peak memory.
          vector<Element*> elements_0D, elements_1D, elements_2D, elements_3D;
-         elements_0D.reserve(num_of_all_elements);
-         elements_1D.reserve(num_of_all_elements);
-         elements_2D.reserve(num_of_all_elements);
-         elements_3D.reserve(num_of_all_elements);
 
          // Temporary storage for high order vertices, if present
          vector<Array<int>*> ho_verts_1D, ho_verts_2D, ho_verts_3D;
-         ho_verts_1D.reserve(num_of_all_elements);
-         ho_verts_2D.reserve(num_of_all_elements);
-         ho_verts_3D.reserve(num_of_all_elements);
 
          // Temporary storage for order of elements
          vector<int> ho_el_order_1D, ho_el_order_2D, ho_el_order_3D;
-         ho_el_order_1D.reserve(num_of_all_elements);
-         ho_el_order_2D.reserve(num_of_all_elements);
-         ho_el_order_3D.reserve(num_of_all_elements);
 
          // Vertex order mappings
          Array<int*> ho_lin(11); ho_lin = NULL;
@@ -1963,11 +2196,21 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                n_elem_part += n_elem_one_type;
 
                const int n_elem_nodes = nodes_of_gmsh_element[type_of_element-1];
-               vector<int> data(1+n_tags+n_elem_nodes);
+               const int n_data = 1+n_tags+n_elem_nodes;
+               // the elements are read in chunks of bounded size
+               const int chunk_size = std::max(1, 65536/n_data);
+               vector<int> chunk;
+               vector<int> vert_indices(n_elem_nodes);
                for (int el = 0; el < n_elem_one_type; ++el)
                {
-                  input.read(reinterpret_cast<char*>(&data[0]),
-                             data.size()*sizeof(int));
+                  if (el % chunk_size == 0)
+                  {
+                     chunk.resize(std::min(chunk_size, n_elem_one_type - el)*
+                                  n_data);
+                     input.read(reinterpret_cast<char*>(chunk.data()),
+                                chunk.size()*sizeof(int));
+                  }
+                  const int *data = &chunk[(el % chunk_size)*n_data];
                   int dd = 0; // index for data array
                   serial_number = data[dd++];
                   // physical domain - the most important value (to distinguish
@@ -1981,16 +2224,13 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                   n_partitions = (n_tags > 2) ? data[dd++] : 0;
                   // we currently just skip the partitions if they exist, and go
                   // directly to vertices describing the mesh element
-                  vector<int> vert_indices(n_elem_nodes);
                   for (int vi = 0; vi < n_elem_nodes; ++vi)
                   {
-                     map<int, int>::const_iterator it =
-                        vertices_map.find(data[1+n_tags+vi]);
-                     if (it == vertices_map.end())
+                     vert_indices[vi] = vertices_map(data[1+n_tags+vi]);
+                     if (vert_indices[vi] < 0)
                      {
                         MFEM_ABORT("Gmsh file : vertex index doesn't exist");
                      }
-                     vert_indices[vi] = it->second;
                   }
 
                   // Non-positive attributes are not allowed in MFEM. However,
@@ -2189,10 +2429,11 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
          } // if binary
          else // ASCII
          {
+            vector<int> data, vert_indices;
             for (int el = 0; el < num_of_all_elements; ++el)
             {
                input >> serial_number >> type_of_element >> n_tags;
-               vector<int> data(n_tags);
+               data.resize(n_tags);
                for (int i = 0; i < n_tags; ++i) { input >> data[i]; }
                // physical domain - the most important value (to distinguish
                // materials with different properties)
@@ -2206,17 +2447,16 @@ void Mesh::ReadGmshMesh(std::istream &input, int &curved, int &read_gf)
                // we currently just skip the partitions if they exist, and go
                // directly to vertices describing the mesh element
                const int n_elem_nodes = nodes_of_gmsh_element[type_of_element-1];
-               vector<int> vert_indices(n_elem_nodes);
+               vert_indices.resize(n_elem_nodes);
                int index;
                for (int vi = 0; vi < n_elem_nodes; ++vi)
                {
                   input >> index;
-                  map<int, int>::const_iterator it = vertices_map.find(index);
-                  if (it == vertices_map.end())
+                  vert_indices[vi] = vertices_map(index);
+                  if (vert_indices[vi] < 0)
                   {
                      MFEM_ABORT("Gmsh file : vertex index doesn't exist");
                   }
-                  vert_indices[vi] = it->second;
                }
 
                // Non-positive attributes are not allowed in MFEM. However,
@@ -3251,7 +3491,7 @@ mfem::Element * CubitElement::NewElement(Mesh &mesh, Geometry::Type geom,
                                          const int *vertices,
                                          const int attribute) const
 {
-   Element *new_element = mesh.NewElement(geom);
+   Element *new_element = mesh.AllocElement(geom);
    new_element->SetVertices(vertices);
    new_element->SetAttribute(attribute);
    return new_element;
@@ -2500,7 +2500,7 @@ void NCMesh::GetMeshComponents(Mesh &mesh) const
       const int* node = nc_elem.node;
       GeomInfo& gi = GI[(int) nc_elem.geom];
 
-      mfem::Element* elem = mesh.NewElement(nc_elem.geom);
+      mfem::Element* elem = mesh.AllocElement(nc_elem.geom);
       mesh.elements.Append(elem);
 
       elem->SetAttribute(nc_elem.attribute);
@@ -2579,7 +2579,7 @@ void NCMesh::GetMeshComponents(Mesh &mesh) const
                   " does not match a valid face geometry: Quad, Tri, Segment, Point");
 
       // Add a new boundary element, with matching attribute and vertices
-      mesh.boundary.Append(mesh.NewElement(geom));
+      mesh.boundary.Append(mesh.AllocElement(geom));
       auto * const be = mesh.boundary.Last();
       be->SetAttribute(face.attribute);
       be->SetVertices(v);
@@ -20,6 +20,7 @@
 #include "../general/text.hpp"
 #include "../general/globals.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
@@ -46,7 +47,7 @@ ParMesh::ParMesh(const ParMesh &pmesh, bool copy_nodes)
    shared_edges.SetSize(pmesh.shared_edges.Size());
    for (int i = 0; i < shared_edges.Size(); i++)
    {
-      shared_edges[i] = pmesh.shared_edges[i]->Duplicate(this);
+      shared_edges[i] = AllocElement(*pmesh.shared_edges[i]);
    }
 
    shared_trias = pmesh.shared_trias;
@@ -378,7 +379,7 @@ int ParMesh::BuildLocalElements(const Mesh& mesh, const int* partitioning,
    {
       if (partitioning[i] == MyRank)
       {
-         elements[element_counter] = mesh.GetElement(i)->Duplicate(this);
+         elements[element_counter] = AllocElement(*mesh.GetElement(i));
          int *v = elements[element_counter]->GetVertices();
          int nv = elements[element_counter]->GetNVertices();
          for (int j = 0; j < nv; j++)
@@ -430,7 +431,7 @@ int ParMesh::BuildLocalBoundary(const Mesh& mesh, const int* partitioning,
          mesh.GetFaceElements(face, &el1, &el2);
          if (partitioning[(o % 2 == 0 || el2 < 0) ? el1 : el2] == MyRank)
          {
-            boundary[bdrelem_counter] = mesh.GetBdrElement(i)->Duplicate(this);
+            boundary[bdrelem_counter] = AllocElement(*mesh.GetBdrElement(i));
             int *v = boundary[bdrelem_counter]->GetVertices();
             int nv = boundary[bdrelem_counter]->GetNVertices();
             for (int j = 0; j < nv; j++)
@@ -468,7 +469,7 @@ int ParMesh::BuildLocalBoundary(const Mesh& mesh, const int* partitioning,
          int el1 = edge_element->GetRow(edge)[0];
          if (partitioning[el1] == MyRank)
          {
-            boundary[bdrelem_counter] = mesh.GetBdrElement(i)->Duplicate(this);
+            boundary[bdrelem_counter] = AllocElement(*mesh.GetBdrElement(i));
             int *v = boundary[bdrelem_counter]->GetVertices();
             int nv = boundary[bdrelem_counter]->GetNVertices();
             for (int j = 0; j < nv; j++)
@@ -501,7 +502,7 @@ int ParMesh::BuildLocalBoundary(const Mesh& mesh, const int* partitioning,
          mesh.GetFaceElements(vert, &el1, &el2);
          if (partitioning[el1] == MyRank)
          {
-            boundary[bdrelem_counter] = mesh.GetBdrElement(i)->Duplicate(this);
+            boundary[bdrelem_counter] = AllocElement(*mesh.GetBdrElement(i));
             int *v = boundary[bdrelem_counter]->GetVertices();
             v[0] = vert_global_local[v[0]];
             bdrelem_counter++;
@@ -828,8 +829,8 @@ void ParMesh::BuildSharedEdgeElems(int nedges, Mesh& mesh,
             mesh.GetEdgeVertices(i, vert);
 
             shared_edges[sedge_counter] =
-               new Segment(vert_global_local[vert[0]],
-                           vert_global_local[vert[1]], 1);
+               AllocElement<Segment>(vert_global_local[vert[0]],
+                                     vert_global_local[vert[1]], 1);
 
             sedge_ledge[sedge_counter] = v_to_v(vert_global_local[vert[0]],
                                                 vert_global_local[vert[1]]);
@@ -1079,7 +1080,7 @@ void ParMesh::LoadSharedEntities(istream &input)
          {
             group_sedge.GetJ()[sedge_counter] = sedge_counter;
             input >> v[0] >> v[1];
-            shared_edges[sedge_counter] = new Segment(v[0], v[1], 1);
+            shared_edges[sedge_counter] = AllocElement<Segment>(v[0], v[1], 1);
          }
       }
       if (Dim >= 3)
@@ -1520,6 +1521,661 @@ ParMesh ParMesh::MakeSimplicial(ParMesh &orig_mesh)
    return mesh;
 }
 
+ParMesh ParMesh::LoadFromBinaryFile(MPI_Comm comm, const std::string &filename,
+                                    int refine, bool fix_orientation)
+{
+   ParMesh mesh;
+
+   mesh.MyComm = comm;
+   MPI_Comm_size(comm, &mesh.NRanks);
+   MPI_Comm_rank(comm, &mesh.MyRank);
+   mesh.gtopo.SetComm(comm);
+
+   Array<int> vertex_ids;
+   mesh.ReadBinaryFile(filename, mesh.MyRank, mesh.NRanks, &vertex_ids);
+
+   mesh.ReduceMeshGen(); // determine the global 'meshgen'
+
+   if (mesh.Conforming())
+   {
+      Array<long long> vert_global(vertex_ids.Size());
+      for (int i = 0; i < vertex_ids.Size(); i++)
+      {
+         vert_global[i] = vertex_ids[i];
+      }
+      mesh.BuildSharedEntities(vert_global);
+   }
+   else
+   {
+      // the ParNCMesh instance was already constructed in 'ReadBinaryFile'
+      mesh.pncmesh = dynamic_cast<ParNCMesh*>(mesh.ncmesh);
+      MFEM_ASSERT(mesh.pncmesh, "internal error");
+      mesh.pncmesh->GetConformingSharedStructures(mesh);
+   }
+
+   mesh.Finalize(refine, fix_orientation);
+
+   mesh.EnsureParNodes();
+
+   return mesh;
+}
+
+// Choose the process grid p[0] x ... x p[dim-1] = nranks with p[d] <= n[d]
+// that minimizes the total size of the interfaces between the boxes of the
+// n[0] x ... x n[dim-1] grid. Returns false if there is no such grid.
+static bool CartesianProcessGrid(int dim, const int *n, int nranks, int *p)
+{
+   bool found = false;
+   double best = 0.0;
+   for (int p0 = 1; p0 <= nranks; p0++)
+   {
+      if (nranks % p0 || p0 > n[0]) { continue; }
+      const int rest = nranks / p0;
+      for (int p1 = (dim == 2) ? rest : 1; p1 <= rest; p1++)
+      {
+         if (rest % p1 || p1 > n[1]) { continue; }
+         const int p2 = rest / p1;
+         if (dim == 3 && p2 > n[2]) { continue; }
+         const double cost = (dim == 2) ?
+                             double(p0-1)*n[1] + double(p1-1)*n[0] :
+                             double(p0-1)*n[1]*n[2] + double(p1-1)*n[0]*n[2] +
+                             double(p2-1)*n[0]*n[1];
+         if (!found || cost < best)
+         {
+            found = true;
+            best = cost;
+            p[0] = p0;
+            p[1] = p1;
+            if (dim == 3) { p[2] = p2; }
+         }
+      }
+   }
+   return found;
+}
+
+ParMesh ParMesh::MakeCartesian(MPI_Comm comm, int dim, const int *n,
+                               Element::Type type, const real_t *s,
+                               bool sfc_ordering)
+{
+   ParMesh mesh;
+
+   mesh.MyComm = comm;
+   MPI_Comm_size(comm, &mesh.NRanks);
+   MPI_Comm_rank(comm, &mesh.MyRank);
+   mesh.gtopo.SetComm(comm);
+
+   int p[3], lo[3], hi[3];
+   const bool found = CartesianProcessGrid(dim, n, mesh.NRanks, p);
+   MFEM_VERIFY(found, "cannot decompose the Cartesian grid into "
+               << mesh.NRanks << " boxes with at least one cell in each"
+               " direction");
+   for (int d = 0, r = mesh.MyRank; d < dim; d++)
+   {
+      const int i = r % p[d];
+      r /= p[d];
+      lo[d] = int((long long)n[d]*i/p[d]);
+      hi[d] = int((long long)n[d]*(i+1)/p[d]);
+   }
+
+   Array<long long> vert_global;
+   mesh.MakeCartesianPart(n, lo, hi, type, s, sfc_ordering, vert_global);
+
+   mesh.ReduceMeshGen(); // determine the global 'meshgen'
+
+   mesh.BuildSharedEntities(vert_global);
+
+   mesh.Finalize(true); // refine = true, as in Mesh::MakeCartesian3D
+
+   return mesh;
+}
+
+ParMesh ParMesh::MakeCartesian2D(MPI_Comm comm, int nx, int ny,
+                                 Element::Type type, real_t sx, real_t sy,
+                                 bool sfc_ordering)
+{
+   MFEM_VERIFY(type == Element::QUADRILATERAL || type == Element::TRIANGLE,
+               "unsupported element type " << type);
+   const int n[2] = { nx, ny };
+   const real_t s[2] = { sx, sy };
+   return MakeCartesian(comm, 2, n, type, s, sfc_ordering);
+}
+
+ParMesh ParMesh::MakeCartesian3D(MPI_Comm comm, int nx, int ny, int nz,
+                                 Element::Type type, real_t sx, real_t sy,
+                                 real_t sz, bool sfc_ordering)
+{
+   MFEM_VERIFY(type == Element::HEXAHEDRON || type == Element::TETRAHEDRON,
+               "unsupported element type " << type);
+   const int n[3] = { nx, ny, nz };
+   const real_t s[3] = { sx, sy, sz };
+   return MakeCartesian(comm, 3, n, type, s, sfc_ordering);
+}
+
+void ParMesh::MakeCartesianPart(const int *n, const int *lo, const int *hi,
+                                Element::Type type, const real_t *s,
+                                bool sfc_ordering,
+                                Array<long long> &vert_global)
+{
+   const int dim = (type == Element::QUADRILATERAL ||
+                    type == Element::TRIANGLE) ? 2 : 3;
+   const int nx = n[0], ny = n[1], nz = (dim == 3) ? n[2] : 0;
+   const int x0 = lo[0], x1 = hi[0], y0 = lo[1], y1 = hi[1];
+   const int z0 = (dim == 3) ? lo[2] : 0, z1 = (dim == 3) ? hi[2] : 0;
+   const int mx = x1 - x0, my = y1 - y0, mz = z1 - z0;
+   const bool tets = (type == Element::TETRAHEDRON);
+
+   int NVert = (mx+1) * (my+1) * (mz+1);
+   int NElem = mx * my * ((dim == 3) ? mz : 1);
+   int NBdrElem;
+   if (dim == 2)
+   {
+      NBdrElem = ((y0 == 0) + (y1 == ny)) * mx + ((x0 == 0) + (x1 == nx)) * my;
+      if (type == Element::TRIANGLE) { NElem *= 2; }
+   }
+   else
+   {
+      NBdrElem = ((z0 == 0) + (z1 == nz)) * mx * my +
+                 ((x0 == 0) + (x1 == nx)) * my * mz +
+                 ((y0 == 0) + (y1 == ny)) * mx * mz;
+      if (tets)
+      {
+         NElem *= 6;
+         NBdrElem *= 2;
+      }
+   }
+
+   InitMesh(dim, dim, NVert, NElem, NBdrElem);
+
+   // Sets the vertices, their coordinates and global numbers, in the same
+   // lexicographic order as in the serial mesh
+   vert_global.SetSize(NVert);
+   real_t coord[3];
+   for (int z = z0, k = 0; z <= z1; z++)
+   {
+      if (dim == 3) { coord[2] = ((real_t) z / nz) * s[2]; }
+      for (int y = y0; y <= y1; y++)
+      {
+         coord[1] = ((real_t) y / ny) * s[1];
+         for (int x = x0; x <= x1; x++)
+         {
+            coord[0] = ((real_t) x / nx) * s[0];
+            AddVertex(coord);
+            vert_global[k++] = x + (nx+1)*(y + (long long)(ny+1)*z);
+         }
+      }
+   }
+
+#define VTX(XC, YC, ZC) ((XC)-x0+((YC)-y0+((ZC)-z0)*(my+1))*(mx+1))
+
+   int ind[8];
+   if (dim == 2)
+   {
+      // Sets the elements and the corresponding indices of vertices
+      auto add_elem = [&](int i, int j)
+      {
+         if (type == Element::QUADRILATERAL)
+         {
+            AddQuad(VTX(i, j, 0), VTX(i+1, j, 0), VTX(i+1, j+1, 0),
+                    VTX(i, j+1, 0));
+         }
+         else
+         {
+            AddTriangle(VTX(i, j, 0), VTX(i+1, j+1, 0), VTX(i, j+1, 0));
+            AddTriangle(VTX(i, j, 0), VTX(i+1, j, 0), VTX(i+1, j+1, 0));
+         }
+      };
+      if (sfc_ordering && type == Element::QUADRILATERAL)
+      {
+         Array<int> sfc;
+         NCMesh::GridSfcOrdering2D(mx, my, sfc);
+         MFEM_VERIFY(sfc.Size() == 2*mx*my, "");
+         for (int k = 0; k < mx*my; k++)
+         {
+            add_elem(x0 + sfc[2*k], y0 + sfc[2*k + 1]);
+         }
+      }
+      else
+      {
+         for (int j = y0; j < y1; j++)
+         {
+            for (int i = x0; i < x1; i++) { add_elem(i, j); }
+         }
+      }
+
+      // Sets the boundary elements on the boundary of the whole grid:
+      // bottom (1), top (3), left (4) and right (2)
+      for (int i = x0; y0 == 0 && i < x1; i++)
+      {
+         AddBdrSegment(VTX(i, 0, 0), VTX(i+1, 0, 0), 1);
+      }
+      for (int i = x0; y1 == ny && i < x1; i++)
+      {
+         AddBdrSegment(VTX(i+1, ny, 0), VTX(i, ny, 0), 3);
+      }
+      for (int j = y0; x0 == 0 && j < y1; j++)
+      {
+         AddBdrSegment(VTX(0, j+1, 0), VTX(0, j, 0), 4);
+      }
+      for (int j = y0; x1 == nx && j < y1; j++)
+      {
+         AddBdrSegment(VTX(nx, j, 0), VTX(nx, j+1, 0), 2);
+      }
+   }
+   else
+   {
+      // Sets the elements and the corresponding indices of vertices
+      auto add_elem = [&](int x, int y, int z)
+      {
+         // *INDENT-OFF*
+         ind[0] = VTX(x  , y  , z  );
+         ind[1] = VTX(x+1, y  , z  );
+         ind[2] = VTX(x+1, y+1, z  );
+         ind[3] = VTX(x  , y+1, z  );
+         ind[4] = VTX(x  , y  , z+1);
+         ind[5] = VTX(x+1, y  , z+1);
+         ind[6] = VTX(x+1, y+1, z+1);
+         ind[7] = VTX(x  , y+1, z+1);
+         // *INDENT-ON*
+         if (tets) { AddHexAsTets(ind, 1); }
+         else { AddHex(ind, 1); }
+      };
+      if (sfc_ordering && !tets)
+      {
+         Array<int> sfc;
+         NCMesh::GridSfcOrdering3D(mx, my, mz, sfc);
+         MFEM_VERIFY(sfc.Size() == 3*mx*my*mz, "");
+         for (int k = 0; k < mx*my*mz; k++)
+         {
+            add_elem(x0 + sfc[3*k], y0 + sfc[3*k + 1], z0 + sfc[3*k + 2]);
+         }
+      }
+      else
+      {
+         for (int z = z0; z < z1; z++)
+         {
+            for (int y = y0; y < y1; y++)
+            {
+               for (int x = x0; x < x1; x++) { add_elem(x, y, z); }
+            }
+         }
+      }
+
+      // Sets the boundary elements on the boundary of the whole grid, with
+      // the same attributes and orientations as in Mesh::Make3D
+      auto add_bdr = [&](int v0, int v1, int v2, int v3, int attr)
+      {
+         ind[0] = v0; ind[1] = v1; ind[2] = v2; ind[3] = v3;
+         if (tets) { AddBdrQuadAsTriangles(ind, attr); }
+         else { AddBdrQuad(ind, attr); }
+      };
+      // bottom, bdr. attribute 1
+      for (int y = y0; z0 == 0 && y < y1; y++)
+      {
+         for (int x = x0; x < x1; x++)
+         {
+            add_bdr(VTX(x, y, 0), VTX(x, y+1, 0), VTX(x+1, y+1, 0),
+                    VTX(x+1, y, 0), 1);
+         }
+      }
+      // top, bdr. attribute 6
+      for (int y = y0; z1 == nz && y < y1; y++)
+      {
+         for (int x = x0; x < x1; x++)
+         {
+            add_bdr(VTX(x, y, nz), VTX(x+1, y, nz), VTX(x+1, y+1, nz),
+                    VTX(x, y+1, nz), 6);
+         }
+      }
+      // left, bdr. attribute 5
+      for (int z = z0; x0 == 0 && z < z1; z++)
+      {
+         for (int y = y0; y < y1; y++)
+         {
+            add_bdr(VTX(0, y, z), VTX(0, y, z+1), VTX(0, y+1, z+1),
+                    VTX(0, y+1, z), 5);
+         }
+      }
+      // right, bdr. attribute 3
+      for (int z = z0; x1 == nx && z < z1; z++)
+      {
+         for (int y = y0; y < y1; y++)
+         {
+            add_bdr(VTX(nx, y, z), VTX(nx, y+1, z), VTX(nx, y+1, z+1),
+                    VTX(nx, y, z+1), 3);
+         }
+      }
+      // front, bdr. attribute 2
+      for (int x = x0; y0 == 0 && x < x1; x++)
+      {
+         for (int z = z0; z < z1; z++)
+         {
+            add_bdr(VTX(x, 0, z), VTX(x+1, 0, z), VTX(x+1, 0, z+1),
+                    VTX(x, 0, z+1), 2);
+         }
+      }
+      // back, bdr. attribute 4
+      for (int x = x0; y1 == ny && x < x1; x++)
+      {
+         for (int z = z0; z < z1; z++)
+         {
+            add_bdr(VTX(x, ny, z), VTX(x, ny, z+1), VTX(x+1, ny, z+1),
+                    VTX(x+1, ny, z), 4);
+         }
+      }
+   }
+
+#undef VTX
+
+   // The faces on the interfaces between the boxes are not boundary faces
+   FinalizeTopology(false);
+}
+
+// For each of the keys in 'keys', consisting of 'nk' global vertex numbers in
+// [0, max_vert], find the ranks that have the same key. The keys are sent to a
+// directory distributed by their first vertex, which replies with the ranks
+// for each key. On return, the ranks with the key i, including the calling
+// rank, are ranks[offsets[i]:offsets[i+1]-1] in increasing order; the list is
+// empty if the key is not shared.
+static void FindSharingRanks(MPI_Comm comm, int nk, const Array<long long> &keys,
+                             long long max_vert, Array<int> &offsets,
+                             Array<int> &ranks)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+   const int n = keys.Size()/nk;
+   auto directory = [nranks, max_vert](long long v)
+   {
+      return int(v*nranks/(max_vert + 1));
+   };
+   auto exclusive_scan = [nranks](const Array<int> &count, Array<int> &displ)
+   {
+      displ.SetSize(nranks);
+      int sum = 0;
+      for (int r = 0; r < nranks; r++) { displ[r] = sum; sum += count[r]; }
+      return sum;
+   };
+
+   // send the keys to the directory, ordered by rank
+   Array<int> send_count(nranks), send_displ, pos, order(n);
+   send_count = 0;
+   for (int i = 0; i < n; i++) { send_count[directory(keys[i*nk])] += nk; }
+   exclusive_scan(send_count, send_displ);
+   send_displ.Copy(pos);
+   Array<long long> send_keys(n*nk);
+   for (int i = 0; i < n; i++)
+   {
+      const int r = directory(keys[i*nk]);
+      order[pos[r]/nk] = i;
+      for (int j = 0; j < nk; j++) { send_keys[pos[r]++] = keys[i*nk+j]; }
+   }
+   Array<int> recv_count(nranks), recv_displ;
+   MPI_Alltoall(send_count.GetData(), 1, MPI_INT,
+                recv_count.GetData(), 1, MPI_INT, comm);
+   Array<long long> recv_keys(exclusive_scan(recv_count, recv_displ));
+   MPI_Alltoallv(send_keys.GetData(), send_count.GetData(),
+                 send_displ.GetData(), MPI_LONG_LONG,
+                 recv_keys.GetData(), recv_count.GetData(),
+                 recv_displ.GetData(), MPI_LONG_LONG, comm);
+
+   // sort the received keys, with equal keys ordered by rank
+   const int m = recv_keys.Size()/nk;
+   Array<int> src(m), sorted(m);
+   for (int r = 0; r < nranks; r++)
+   {
+      for (int k = recv_displ[r]/nk; k < (recv_displ[r] + recv_count[r])/nk; k++)
+      {
+         src[k] = r;
+      }
+   }
+   auto same_key = [&recv_keys, nk](int a, int b)
+   {
+      for (int j = 0; j < nk; j++)
+      {
+         if (recv_keys[a*nk+j] != recv_keys[b*nk+j]) { return false; }
+      }
+      return true;
+   };
+   for (int k = 0; k < m; k++) { sorted[k] = k; }
+   std::sort(sorted.begin(), sorted.end(), [&](int a, int b)
+   {
+      for (int j = 0; j < nk; j++)
+      {
+         const long long ka = recv_keys[a*nk+j], kb = recv_keys[b*nk+j];
+         if (ka != kb) { return ka < kb; }
+      }
+      return src[a] < src[b];
+   });
+   Array<int> run_begin(m), run_end(m);
+   for (int k = 0; k < m; )
+   {
+      int l = k + 1;
+      while (l < m && same_key(sorted[l], sorted[k])) { l++; }
+      for (int t = k; t < l; t++)
+      {
+         run_begin[sorted[t]] = k;
+         run_end[sorted[t]] = l;
+      }
+      k = l;
+   }
+
+   // reply in the order of the requests: for each key, the number of ranks
+   // that have it (0 if it is not shared) followed by the ranks
+   Array<int> reply_count(nranks), reply_displ;
+   reply_count = 0;
+   for (int k = 0; k < m; k++)
+   {
+      const int size = run_end[k] - run_begin[k];
+      reply_count[src[k]] += 1 + ((size > 1) ? size : 0);
+   }
+   Array<int> reply(exclusive_scan(reply_count, reply_displ));
+   for (int k = 0, p = 0; k < m; k++)
+   {
+      const int size = run_end[k] - run_begin[k];
+      reply[p++] = (size > 1) ? size : 0;
+      for (int t = run_begin[k]; size > 1 && t < run_end[k]; t++)
+      {
+         reply[p++] = src[sorted[t]];
+      }
+   }
+   Array<int> answer_count(nranks), answer_displ;
+   MPI_Alltoall(reply_count.GetData(), 1, MPI_INT,
+                answer_count.GetData(), 1, MPI_INT, comm);
+   Array<int> answer(exclusive_scan(answer_count, answer_displ));
+   MPI_Alltoallv(reply.GetData(), reply_count.GetData(),
+                 reply_displ.GetData(), MPI_INT,
+                 answer.GetData(), answer_count.GetData(),
+                 answer_displ.GetData(), MPI_INT, comm);
+
+   // the answers are in the order of the requests, see 'order'
+   Array<int> start(n);
+   for (int k = 0, p = 0; k < n; k++)
+   {
+      start[order[k]] = p;
+      p += 1 + answer[p];
+   }
+   offsets.SetSize(n + 1);
+   offsets[0] = 0;
+   for (int i = 0; i < n; i++) { offsets[i+1] = offsets[i] + answer[start[i]]; }
+   ranks.SetSize(offsets[n]);
+   for (int i = 0; i < n; i++)
+   {
+      std::copy(answer.begin() + start[i] + 1,
+                answer.begin() + start[i] + 1 + answer[start[i]],
+                ranks.begin() + offsets[i]);
+   }
+}
+
+void ParMesh::BuildSharedEntities(const Array<long long> &vert_global)
+{
+   MFEM_VERIFY(vert_global.Size() == NumOfVertices,
+               "invalid global vertex numbers");
+   long long loc_max_vert = -1, max_vert;
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      loc_max_vert = std::max(loc_max_vert, vert_global[i]);
+   }
+   MPI_Allreduce(&loc_max_vert, &max_vert, 1, MPI_LONG_LONG, MPI_MAX, MyComm);
+
+   // find the shared vertices, then the shared edges and faces among those
+   // with shared vertices only
+   Array<int> v_offsets, v_ranks;
+   FindSharingRanks(MyComm, 1, vert_global, max_vert, v_offsets, v_ranks);
+   auto is_shared = [&v_offsets](int v) { return v_offsets[v+1] > v_offsets[v]; };
+
+   Array<int> edges, faces, vert;
+   Array<long long> edge_keys, face_keys;
+   if (Dim >= 2)
+   {
+      for (int i = 0; i < GetNEdges(); i++)
+      {
+         GetEdgeVertices(i, vert);
+         if (!is_shared(vert[0]) || !is_shared(vert[1])) { continue; }
+         edges.Append(i);
+         const long long g0 = vert_global[vert[0]], g1 = vert_global[vert[1]];
+         edge_keys.Append(std::min(g0, g1));
+         edge_keys.Append(std::max(g0, g1));
+      }
+   }
+   if (Dim >= 3)
+   {
+      for (int i = 0; i < GetNumFaces(); i++)
+      {
+         GetFaceVertices(i, vert);
+         bool shared = true;
+         for (int j = 0; j < vert.Size(); j++) { shared &= is_shared(vert[j]); }
+         if (!shared) { continue; }
+         // the three smallest vertices identify a face of a conforming mesh
+         long long key[4];
+         for (int j = 0; j < vert.Size(); j++) { key[j] = vert_global[vert[j]]; }
+         std::sort(key, key + vert.Size());
+         faces.Append(i);
+         for (int j = 0; j < 3; j++) { face_keys.Append(key[j]); }
+      }
+   }
+   Array<int> e_offsets, e_ranks, f_offsets, f_ranks;
+   FindSharingRanks(MyComm, 2, edge_keys, max_vert, e_offsets, e_ranks);
+   FindSharingRanks(MyComm, 3, face_keys, max_vert, f_offsets, f_ranks);
+
+   // the groups of ranks, the first group is the local one
+   ListOfIntegerSets groups;
+   std::map<std::vector<int>, int> group_ids;
+   IntegerSet group;
+   group.Recreate(1, &MyRank);
+   groups.Insert(group);
+   auto get_group = [&](const Array<int> &offsets, const Array<int> &ranks,
+                        int i)
+   {
+      const std::vector<int> key(ranks.begin() + offsets[i],
+                                 ranks.begin() + offsets[i+1]);
+      auto it = group_ids.find(key);
+      if (it != group_ids.end()) { return it->second; }
+      group.Recreate(int(key.size()), key.data());
+      const int g = groups.Insert(group);
+      group_ids[key] = g;
+      return g;
+   };
+
+   // the shared entities ordered by group, and by their global vertices within
+   // each group, so that all ranks in a group list them in the same order
+   struct SharedEntity
+   {
+      int group, index;
+      long long key[3];
+      bool operator<(const SharedEntity &other) const
+      {
+         if (group != other.group) { return group < other.group; }
+         return std::lexicographical_compare(key, key + 3, other.key,
+                                             other.key + 3);
+      }
+   };
+   std::vector<SharedEntity> sverts, sedges, strias, squads;
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      if (!is_shared(i)) { continue; }
+      sverts.push_back({get_group(v_offsets, v_ranks, i), i,
+         {vert_global[i], -1, -1}});
+   }
+   for (int k = 0; k < edges.Size(); k++)
+   {
+      if (e_offsets[k+1] == e_offsets[k]) { continue; }
+      sedges.push_back({get_group(e_offsets, e_ranks, k), edges[k],
+         {edge_keys[2*k], edge_keys[2*k+1], -1}});
+   }
+   for (int k = 0; k < faces.Size(); k++)
+   {
+      if (f_offsets[k+1] == f_offsets[k]) { continue; }
+      std::vector<SharedEntity> &sfaces =
+         (GetFaceGeometry(faces[k]) == Geometry::TRIANGLE) ? strias : squads;
+      sfaces.push_back({get_group(f_offsets, f_ranks, k), faces[k],
+         {face_keys[3*k], face_keys[3*k+1], face_keys[3*k+2]}});
+   }
+   std::sort(sverts.begin(), sverts.end());
+   std::sort(sedges.begin(), sedges.end());
+   std::sort(strias.begin(), strias.end());
+   std::sort(squads.begin(), squads.end());
+
+   // build the group communication topology
+   gtopo.Create(groups, 822);
+
+   const int ngroups = groups.Size();
+   auto make_group_table = [ngroups](Table &group_ent,
+                                     const std::vector<SharedEntity> &ents)
+   {
+      const int nents = int(ents.size());
+      group_ent.SetDims(ngroups-1, nents);
+      int *I = group_ent.GetI(), *J = group_ent.GetJ();
+      for (int g = 0; g < ngroups; g++) { I[g] = 0; }
+      for (const SharedEntity &e : ents) { I[e.group]++; }
+      for (int g = 1; g < ngroups; g++) { I[g] += I[g-1]; }
+      for (int k = 0; k < nents; k++) { J[k] = k; }
+   };
+   make_group_table(group_svert, sverts);
+   make_group_table(group_sedge, sedges);
+   make_group_table(group_stria, strias);
+   make_group_table(group_squad, squads);
+
+   svert_lvert.SetSize(int(sverts.size()));
+   for (int k = 0; k < svert_lvert.Size(); k++)
+   {
+      svert_lvert[k] = sverts[k].index;
+   }
+
+   // The vertices of the shared edges and faces are ordered consistently on
+   // all ranks using their global numbers.
+   auto global_less = [&vert_global](int a, int b)
+   {
+      return vert_global[a] < vert_global[b];
+   };
+   shared_edges.SetSize(int(sedges.size()));
+   for (int k = 0; k < shared_edges.Size(); k++)
+   {
+      GetEdgeVertices(sedges[k].index, vert);
+      std::sort(vert.begin(), vert.end(), global_less);
+      shared_edges[k] = AllocElement<Segment>(vert[0], vert[1], 1);
+   }
+   shared_trias.SetSize(int(strias.size()));
+   for (int k = 0; k < shared_trias.Size(); k++)
+   {
+      GetFaceVertices(strias[k].index, vert);
+      std::sort(vert.begin(), vert.end(), global_less);
+      shared_trias[k].Set(vert.GetData());
+   }
+   shared_quads.SetSize(int(squads.size()));
+   for (int k = 0; k < shared_quads.Size(); k++)
+   {
+      // start from the smallest vertex, towards its smaller neighbor
+      GetFaceVertices(squads[k].index, vert);
+      int first = 0;
+      for (int j = 1; j < 4; j++)
+      {
+         if (global_less(vert[j], vert[first])) { first = j; }
+      }
+      const int dir = global_less(vert[(first+1)%4], vert[(first+3)%4]) ? 1 : 3;
+      int *v = shared_quads[k].v;
+      for (int j = 0; j < 4; j++) { v[j] = vert[(first + j*dir)%4]; }
+   }
+}
+
 void ParMesh::Finalize(bool refine, bool fix_orientation)
 {
    const int meshgen_save = meshgen; // Mesh::Finalize() may call SetMeshGen()
@@ -3816,7 +4472,8 @@ void ParMesh::LocalRefinement(const Array<int> &marked_el, int type)
                v2[0] = middle[bisect]; v2[1] =           v[1];
 
                boundary[i]->SetVertices(v1);
-               boundary.Append(new Segment(v2, boundary[i]->GetAttribute()));
+               boundary.Append(
+                  AllocElement<Segment>(v2, boundary[i]->GetAttribute()));
             }
             else
             {
@@ -3860,7 +4517,7 @@ void ParMesh::LocalRefinement(const Array<int> &marked_el, int type)
          int *vert = c_seg->GetVertices(), attr = c_seg->GetAttribute();
          int new_v = cnv + j, new_e = cne + j;
          AverageVertices(vert, 2, new_v);
-         elements[new_e] = new Segment(new_v, vert[1], attr);
+         elements[new_e] = AllocElement<Segment>(new_v, vert[1], attr);
          vert[1] = new_v;
 
          CoarseFineTr.embeddings[i] = Embedding(i, Geometry::SEGMENT, 1);
@@ -4102,7 +4759,7 @@ void ParMesh::RefineGroups(const DSTable &v_to_v, int *middle)
             group_verts.Append(svert_lvert.Append(ind)-1);
             // update the edges
             const int attr = shared_edges[group_edges[i]]->GetAttribute();
-            shared_edges.Append(new Segment(v[1], ind, attr));
+            shared_edges.Append(AllocElement<Segment>(v[1], ind, attr));
             group_edges.Append(sedge_ledge.Append(-1)-1);
             v[1] = ind;
          }
@@ -4181,7 +4838,7 @@ void ParMesh::RefineGroups(int old_nv, const HashTable<Hashed2> &v_to_v)
             // Add new shared vertex
             group_verts.Append(svert_lvert.Append(ind)-1);
             // Put the right sub-edge on top of the stack
-            sedge_stack.Append(new Segment(ind, v[1], attr));
+            sedge_stack.Append(AllocElement<Segment>(ind, v[1], attr));
             // The left sub-edge replaces the original edge
             v[1] = ind;
             ind = v_to_v.FindId(v[0], ind);
@@ -4208,7 +4865,7 @@ void ParMesh::RefineGroups(int old_nv, const HashTable<Hashed2> &v_to_v)
                // Add new shared vertex
                group_verts.Append(svert_lvert.Append(ind)-1);
                // Put the left sub-edge on top of the stack
-               sedge_stack.Append(new Segment(v[0], ind, attr));
+               sedge_stack.Append(AllocElement<Segment>(v[0], ind, attr));
                // The right sub-edge replaces the original edge
                v[0] = ind;
             }
@@ -4229,7 +4886,7 @@ void ParMesh::RefineGroups(int old_nv, const HashTable<Hashed2> &v_to_v)
          {
             ind += old_nv;
             // Add the refinement edge to the edge stack
-            sedge_stack.Append(new Segment(v[2], ind, edge_attr));
+            sedge_stack.Append(AllocElement<Segment>(v[2], ind, edge_attr));
             // Put the right sub-triangle on top of the face stack
             sface_stack.Append(Vert3(v[1], v[2], ind));
             // The left sub-triangle replaces the original one
@@ -4256,7 +4913,7 @@ void ParMesh::RefineGroups(int old_nv, const HashTable<Hashed2> &v_to_v)
                // The triangle 'st' is refined
                ind += old_nv;
                // Add the refinement edge to the edge stack
-               sedge_stack.Append(new Segment(v[2], ind, edge_attr));
+               sedge_stack.Append(AllocElement<Segment>(v[2], ind, edge_attr));
                // Put the left sub-triangle on top of the face stack
                sface_stack.Append(Vert3(v[2], v[0], ind));
                // Note that the above Append() may invalidate 'v'
@@ -4287,7 +4944,7 @@ void ParMesh::RefineGroups(int old_nv, const HashTable<Hashed2> &v_to_v)
                // Add new shared vertex
                group_verts.Append(svert_lvert.Append(ind)-1);
                // Put the left sub-edge on top of the stack
-               sedge_stack.Append(new Segment(v[0], ind, edge_attr));
+               sedge_stack.Append(AllocElement<Segment>(v[0], ind, edge_attr));
                // The right sub-edge replaces the original edge
                v[0] = ind;
             }
@@ -4347,7 +5004,7 @@ void ParMesh::UniformRefineGroups2D(int old_nv)
          sverts.Append(svert_lvert.Append(ind)-1);
          // update the edges
          const int attr = shared_edges[sedges[i]]->GetAttribute();
-         shared_edges.Append(new Segment(v[1], ind, attr));
+         shared_edges.Append(AllocElement<Segment>(v[1], ind, attr));
          sedges.Append(sedge_ledge.Append(-1)-1);
          v[1] = ind;
       }
@@ -4418,7 +5075,7 @@ void ParMesh::UniformRefineGroups3D(int old_nv, int old_nedges,
          group_verts.Append(svert_lvert.Append(ind)-1);
          // update the edges
          const int attr = shared_edges[group_edges[i]]->GetAttribute();
-         shared_edges.Append(new Segment(v[1], ind, attr));
+         shared_edges.Append(AllocElement<Segment>(v[1], ind, attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
          v[1] = ind; // v[0] remains the same
       }
@@ -4434,11 +5091,11 @@ void ParMesh::UniformRefineGroups3D(int old_nv, int old_nedges,
          m[1] = old_nv + old_v_to_v(v[1], v[2]);
          m[2] = old_nv + old_v_to_v(v[2], v[0]);
          const int edge_attr = 1;
-         shared_edges.Append(new Segment(m[0], m[1], edge_attr));
+         shared_edges.Append(AllocElement<Segment>(m[0], m[1], edge_attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
-         shared_edges.Append(new Segment(m[1], m[2], edge_attr));
+         shared_edges.Append(AllocElement<Segment>(m[1], m[2], edge_attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
-         shared_edges.Append(new Segment(m[0], m[2], edge_attr));
+         shared_edges.Append(AllocElement<Segment>(m[0], m[2], edge_attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
          // update faces
          const int nst = shared_trias.Size();
@@ -4472,13 +5129,13 @@ void ParMesh::UniformRefineGroups3D(int old_nv, int old_nedges,
          m[3] = old_nv + old_v_to_v(v[2], v[3]);
          m[4] = old_nv + old_v_to_v(v[3], v[0]);
          const int edge_attr = 1;
-         shared_edges.Append(new Segment(m[1], m[0], edge_attr));
+         shared_edges.Append(AllocElement<Segment>(m[1], m[0], edge_attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
-         shared_edges.Append(new Segment(m[2], m[0], edge_attr));
+         shared_edges.Append(AllocElement<Segment>(m[2], m[0], edge_attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
-         shared_edges.Append(new Segment(m[3], m[0], edge_attr));
+         shared_edges.Append(AllocElement<Segment>(m[3], m[0], edge_attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
-         shared_edges.Append(new Segment(m[4], m[0], edge_attr));
+         shared_edges.Append(AllocElement<Segment>(m[4], m[0], edge_attr));
          group_edges.Append(sedge_ledge.Append(-1)-1);
          // update faces
          const int nsq = shared_quads.Size();
@@ -4945,6 +5602,14 @@ void ParMesh::Save(const std::string &fname, int precision) const
    Print(ofs);
 }
 
+void ParMesh::SaveBinary(const std::string &fname) const
+{
+   ostringstream fname_with_suffix;
+   fname_with_suffix << fname << "." << setfill('0') << setw(6) << MyRank;
+   ofstream ofs(fname_with_suffix.str().c_str(), std::ios::binary);
+   ParPrintBinary(ofs);
+}
+
 #ifdef MFEM_USE_ADIOS2
 void ParMesh::Print(adios2stream &os) const
 {
@@ -6331,6 +6996,11 @@ void ParMesh::ParPrint(ostream &os, const std::string &comments) const
    // be adding additional parallel mesh information.
    Printer(os, "mfem_serial_mesh_end", comments);
 
+   PrintSharedEntities(os);
+}
+
+void ParMesh::PrintSharedEntities(ostream &os) const
+{
    // write out group topology info.
    gtopo.Save(os);
 
@@ -6394,6 +7064,14 @@ void ParMesh::ParPrint(ostream &os, const std::string &comments) const
    os << "\nmfem_mesh_end" << endl;
 }
 
+void ParMesh::ParPrintBinary(ostream &os) const
+{
+   PrintBinary(os);
+
+   // the NC mesh format works both in serial and in parallel
+   if (Conforming()) { PrintSharedEntities(os); }
+}
+
 void ParMesh::PrintVTU(std::string pathname,
                        VTKFormat format,
                        bool high_order_output,
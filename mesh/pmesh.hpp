@@ -109,6 +109,29 @@ protected:
    // Determine sedge_ledge and sface_lface.
    void FinalizeParTopo();
 
+   // Print the group topology and the shared entities in the parallel mesh
+   // format, see ParPrint().
+   void PrintSharedEntities(std::ostream &os) const;
+
+   // Determine the group topology and the shared vertices, edges and faces of
+   // a conforming mesh from the global numbers of the local vertices, given in
+   // 'vert_global'. The shared entities are found with a directory of the
+   // global vertex numbers distributed over all ranks.
+   void BuildSharedEntities(const Array<long long> &vert_global);
+
+   // Generate the box [lo[d], hi[d]) of the n[0] x n[1] (x n[2]) Cartesian grid
+   // of [0,s[0]] x [0,s[1]] (x [0,s[2]]), see Mesh::Make2D and Mesh::Make3D,
+   // including only the boundary elements on the boundary of the whole grid.
+   // The global numbers of the local vertices are returned in 'vert_global'.
+   void MakeCartesianPart(const int *n, const int *lo, const int *hi,
+                          Element::Type type, const real_t *s,
+                          bool sfc_ordering, Array<long long> &vert_global);
+
+   // Common part of MakeCartesian2D and MakeCartesian3D.
+   static ParMesh MakeCartesian(MPI_Comm comm, int dim, const int *n,
+                                Element::Type type, const real_t *s,
+                                bool sfc_ordering);
+
    // Mark all tets to ensure consistency across MPI tasks; also mark the
    // shared and boundary triangle faces using the consistently marked tets.
    void MarkTetMeshForRefinement(const DSTable &v_to_v) override;
@@ -392,6 +415,45 @@ public:
        See @a Mesh::MakeSimplicial for more details. */
    static ParMesh MakeSimplicial(ParMesh &orig_mesh);
 
+   /** @brief Create a parallel mesh from a binary mesh file written by
+       Mesh::SaveBinary, with each MPI rank reading only its own part. */
+   /** The elements are partitioned in contiguous ranges of the element
+       numbering of the file, see Mesh::LoadFromBinaryFile, so the elements
+       should be ordered such that these ranges are compact, e.g. using
+       Mesh::GetHilbertElementOrdering before saving. The shared entities are
+       determined from the vertex numbering of the file, without forming the
+       global mesh on any rank. Nonconforming meshes can only be read on a
+       single rank. See Mesh::Finalize for the meaning of @a refine and
+       @a fix_orientation. */
+   static ParMesh LoadFromBinaryFile(MPI_Comm comm, const std::string &filename,
+                                     int refine = 1,
+                                     bool fix_orientation = true);
+
+   /** @brief Create a parallel mesh of the rectangle [0,sx]x[0,sy], see
+       Mesh::MakeCartesian2D, generating only the local part on each rank. */
+   /** The nx x ny grid is decomposed into boxes, one per MPI rank, on a
+       process grid chosen to minimize the size of the interfaces between the
+       boxes. The boxes are assigned to the ranks in lexicographic order and
+       each box must contain at least one cell in each direction. Within a box,
+       the elements are ordered as in Mesh::MakeCartesian2D with @a type and
+       @a sfc_ordering. The elements, vertices and boundary attributes are the
+       same as in the serial mesh partitioned into these boxes, but the global
+       mesh is not formed on any rank. */
+   static ParMesh MakeCartesian2D(MPI_Comm comm, int nx, int ny,
+                                  Element::Type type, real_t sx = 1.0,
+                                  real_t sy = 1.0, bool sfc_ordering = true);
+
+   /** @brief Create a parallel mesh of the parallelepiped
+       [0,sx]x[0,sy]x[0,sz], see Mesh::MakeCartesian3D, generating only the
+       local part on each rank. */
+   /** The nx x ny x nz grid is decomposed into boxes as in MakeCartesian2D,
+       where @a type can be HEXAHEDRON or TETRAHEDRON. The tetrahedra are
+       marked for refinement consistently across the ranks. */
+   static ParMesh MakeCartesian3D(MPI_Comm comm, int nx, int ny, int nz,
+                                  Element::Type type, real_t sx = 1.0,
+                                  real_t sy = 1.0, real_t sz = 1.0,
+                                  bool sfc_ordering = true);
+
    void Finalize(bool refine = false, bool fix_orientation = false) override;
 
    void SetAttributes() override;
@@ -667,6 +729,12 @@ public:
        begin with '#'. */
    void ParPrint(std::ostream &out, const std::string &comments = "") const;
 
+   /** Save the mesh in the binary mesh format, see Mesh::PrintBinary, followed
+       by the shared entities in the parallel mesh format. The resulting stream
+       can be read back with the constructor ParMesh(MPI_Comm, std::istream&)
+       on the same number of MPI ranks. */
+   void ParPrintBinary(std::ostream &out) const;
+
    // Enable Print() to add the parallel interface as boundary (typically used
    // for visualization purposes)
    void SetPrintShared(bool print) { print_shared = print; }
@@ -685,6 +753,11 @@ public:
    /// output.
    void Save(const std::string &fname, int precision=16) const override;
 
+   /// Save the ParMesh to files (one for each MPI rank) using
+   /// ParMesh::ParPrintBinary. The files will be given suffixes according to
+   /// the MPI rank.
+   void SaveBinary(const std::string &fname) const override;
+
 #ifdef MFEM_USE_ADIOS2
    /** Print the part of the mesh in the calling processor using adios2 bp
        format. */
@@ -275,7 +275,7 @@ ParSubMesh::ParSubMesh(const ParMesh &parent, SubMesh::From from,
       {
          if (GetFaceInformation(i).IsBoundary())
          {
-            boundary[j] = faces[i]->Duplicate(this);
+            boundary[j] = AllocElement(*faces[i]);
             be_to_face[j] = i;
 
             if (from == SubMesh::From::Domain && Dim >= 2)
@@ -335,7 +335,7 @@ ParSubMesh::ParSubMesh(const ParMesh &parent, SubMesh::From from,
                if (GetFaceInformation(submeshFaceIdx).IsBoundary())
                { continue; }
 
-               boundary[j] = faces[submeshFaceIdx]->Duplicate(this);
+               boundary[j] = AllocElement(*faces[submeshFaceIdx]);
                be_to_face[j] = submeshFaceIdx;
                boundary[j]->SetAttribute(parent.GetBdrAttribute(i));
 
@@ -93,13 +93,15 @@ void AddConvectionIntegrators(BilinearForm &k, VectorCoefficient &velocity,
 
 void test_assembly_level(const char *meshname,
                          int order, int q_order_inc, bool dg,
-                         const Problem pb, const AssemblyLevel assembly)
+                         const Problem pb, const AssemblyLevel assembly,
+                         bool batched_ea = false, bool symmetric_ea = false)
 {
    const int q_order = 2*order + q_order_inc;
 
    INFO("mesh=" << meshname
         << ", order=" << order << ", q_order=" << q_order << ", DG=" << dg
-        << ", pb=" << getString(pb) << ", assembly=" << getString(assembly));
+        << ", pb=" << getString(pb) << ", assembly=" << getString(assembly)
+        << ", batched_ea=" << batched_ea << ", symmetric_ea=" << symmetric_ea);
    Mesh mesh(meshname, 1, 1);
    mesh.EnsureNodes();
    int dim = mesh.Dimension();
@@ -147,6 +149,8 @@ void test_assembly_level(const char *meshname,
    k_ref.Finalize();
 
    k_test.SetAssemblyLevel(assembly);
+   k_test.EnableBatchedElementAssembly(batched_ea);
+   k_test.EnableSymmetricElementAssembly(symmetric_ea);
    k_test.Assemble();
 
    GridFunction x(&fespace), y_ref(&fespace), y_test(&fespace);
@@ -228,6 +232,28 @@ TEST_CASE("H1 Assembly Levels", "[AssemblyLevel], [PartialAssembly], [CUDA]")
    }
 } // H1 Assembly Levels test case
 
+TEST_CASE("Element Assembly Options", "[AssemblyLevel], [CUDA]")
+{
+   const bool dg = GENERATE(false, true);
+   auto pb = GENERATE(Problem::Mass, Problem::Convection, Problem::Diffusion);
+   // Symmetric packed storage, or batched application of the element matrices
+   const bool symmetric = GENERATE(false, true);
+   if (symmetric && pb == Problem::Convection) { return; }
+   const bool batched = !symmetric;
+
+   const AssemblyLevel assembly = AssemblyLevel::ELEMENT;
+   if (dg && pb == Problem::Diffusion) { return; }
+   test_assembly_level("../../data/periodic-square.mesh",
+                       2, 0, dg, pb, assembly, batched, symmetric);
+   test_assembly_level("../../data/star-q3.mesh",
+                       3, 0, dg, pb, assembly, batched, symmetric);
+   test_assembly_level("../../data/periodic-cube.mesh",
+                       2, 0, dg, pb, assembly, batched, symmetric);
+   // The options are ignored with full assembly
+   test_assembly_level("../../data/star-q3.mesh",
+                       2, 0, dg, pb, AssemblyLevel::FULL, batched, symmetric);
+}
+
 TEST_CASE("L2 Assembly Levels", "[AssemblyLevel], [PartialAssembly], [CUDA]")
 {
    const bool dg = true;
@@ -287,6 +313,57 @@ TEST_CASE("L2 Assembly Levels", "[AssemblyLevel], [PartialAssembly], [CUDA]")
    }
 } // L2 Assembly Levels test case
 
+TEST_CASE("Full Assembly Sparse Matrix", "[AssemblyLevel], [CUDA]")
+{
+   auto order = GENERATE(1, 2, 3);
+   auto mesh_fname = GENERATE("../../data/star-q3.mesh",
+                              "../../data/fichera.mesh");
+   CAPTURE(order, mesh_fname);
+
+   Mesh mesh(mesh_fname);
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fespace(&mesh, &fec);
+
+   ConstantCoefficient coeff(1.0);
+   BilinearForm a_fa(&fespace), a_legacy(&fespace);
+   a_fa.SetAssemblyLevel(AssemblyLevel::FULL);
+   a_fa.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   a_legacy.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+
+   GridFunction x(&fespace), y_fa(&fespace), y_legacy(&fespace);
+   x.Randomize(1);
+
+   // The second assembly reuses the sparsity pattern of the first one
+   for (const real_t c : {1.0, 2.5})
+   {
+      coeff.constant = c;
+      a_fa.Assemble();
+      a_legacy.Update();
+      a_legacy.Assemble();
+      a_legacy.Finalize();
+
+      // The rows are filled in sorted order
+      const SparseMatrix &A = a_fa.SpMat();
+      const int *I = A.HostReadI(), *J = A.HostReadJ();
+      bool sorted = true;
+      for (int i = 0; i < A.Height(); i++)
+      {
+         for (int k = I[i] + 1; k < I[i+1]; k++)
+         {
+            sorted = sorted && (J[k-1] < J[k]);
+         }
+      }
+      REQUIRE(sorted);
+      REQUIRE(A.NumNonZeroElems() == a_legacy.SpMat().NumNonZeroElems());
+
+      A.Mult(x, y_fa);
+      a_legacy.Mult(x, y_legacy);
+      y_fa -= y_legacy;
+      REQUIRE(y_fa.Normlinf() == MFEM_Approx(0.0));
+   }
+}
+
 #ifndef MFEM_USE_MPI
 #define HYPRE_BigInt int
 #endif // MFEM_USE_MPI
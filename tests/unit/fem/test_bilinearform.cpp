@@ -142,3 +142,145 @@ TEST_CASE("FormLinearSystem/SolutionScope",
       REQUIRE(AsConst(sol)(bdr_dof) == 0.0);
    }
 }
+
+TEST_CASE("ReassembleValues", "[BilinearForm][CUDA]")
+{
+   const auto al = GENERATE(AssemblyLevel::LEGACY, AssemblyLevel::FULL);
+   const auto policy = GENERATE(Operator::DIAG_ONE, Operator::DIAG_ZERO,
+                                Operator::DIAG_KEEP);
+   if (al == AssemblyLevel::FULL && policy != Operator::DIAG_ONE) { return; }
+   CAPTURE(int(al), int(policy));
+
+   Mesh mesh = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+   H1_FECollection fec(2, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   fes.GetBoundaryTrueDofs(ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   GridFunction x(&fes);
+   x.Randomize(1);
+
+   ConstantCoefficient k(1.0);
+   BilinearForm a(&fes);
+   a.SetAssemblyLevel(al);
+   a.SetDiagonalPolicy(policy);
+   a.AddDomainIntegrator(new DiffusionIntegrator(k));
+   a.AddDomainIntegrator(new MassIntegrator(k));
+   a.Assemble(0);
+
+   for (const real_t c : {1.0, 3.0, 0.5})
+   {
+      k.constant = c;
+      if (c != 1.0) { a.ReassembleValues(0); }
+
+      OperatorHandle A;
+      Vector X, B;
+      GridFunction x1(x);
+      a.FormLinearSystem(ess_tdof_list, x1, b, A, X, B);
+
+      // Reference: assembly from scratch with the same coefficient
+      BilinearForm a_ref(&fes);
+      a_ref.SetAssemblyLevel(al);
+      a_ref.SetDiagonalPolicy(policy);
+      a_ref.AddDomainIntegrator(new DiffusionIntegrator(k));
+      a_ref.AddDomainIntegrator(new MassIntegrator(k));
+      a_ref.Assemble(0);
+      OperatorHandle A_ref;
+      Vector X_ref, B_ref;
+      GridFunction x2(x);
+      a_ref.FormLinearSystem(ess_tdof_list, x2, b, A_ref, X_ref, B_ref);
+
+      SparseMatrix *D = Add(1.0, *A.As<SparseMatrix>(),
+                            -1.0, *A_ref.As<SparseMatrix>());
+      REQUIRE(D->MaxNorm() == MFEM_Approx(0.0));
+      delete D;
+      B -= B_ref;
+      REQUIRE(B.Normlinf() == MFEM_Approx(0.0));
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel ReassembleValues", "[BilinearForm][Parallel]")
+{
+   Mesh serial_mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+   // Partition the elements in slabs, so that the test does not need METIS
+   int num_procs;
+   MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+   Array<int> partitioning(serial_mesh.GetNE());
+   for (int i = 0; i < partitioning.Size(); i++)
+   {
+      partitioning[i] = i * num_procs / partitioning.Size();
+   }
+   ParMesh mesh(MPI_COMM_WORLD, serial_mesh, partitioning.GetData());
+   serial_mesh.Clear();
+   H1_FECollection fec(2, mesh.Dimension());
+   ParFiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   fes.GetBoundaryTrueDofs(ess_tdof_list);
+
+   ConstantCoefficient k(1.0);
+   ParBilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(k));
+   a.AddDomainIntegrator(new MassIntegrator(k));
+   a.Assemble(0);
+   OperatorHandle A;
+   a.FormSystemMatrix(ess_tdof_list, A);
+   const HypreParMatrix *A_ptr = A.As<HypreParMatrix>();
+
+   // Compare A with the matrix assembled from scratch
+   auto check = [&]()
+   {
+      ParBilinearForm a_ref(&fes);
+      a_ref.AddDomainIntegrator(new DiffusionIntegrator(k));
+      a_ref.AddDomainIntegrator(new MassIntegrator(k));
+      a_ref.Assemble(0);
+      OperatorHandle A_ref;
+      a_ref.FormSystemMatrix(ess_tdof_list, A_ref);
+
+      HypreParVector x(*A_ref.As<HypreParMatrix>()), y(x), y_ref(x);
+      x.Randomize(1);
+      A->Mult(x, y);
+      A_ref->Mult(x, y_ref);
+      y -= y_ref;
+      REQUIRE(InnerProduct(y, y) == MFEM_Approx(0.0));
+
+      // The eliminated part is used for the right-hand side
+      y.Randomize(2);
+      y_ref = y;
+      a.EliminateVDofsInRHS(ess_tdof_list, x, y);
+      a_ref.EliminateVDofsInRHS(ess_tdof_list, x, y_ref);
+      y -= y_ref;
+      REQUIRE(InnerProduct(y, y) == MFEM_Approx(0.0));
+   };
+
+   for (const real_t c : {3.0, 0.5})
+   {
+      k.constant = c;
+      a.ReassembleValues(0);
+      a.FormSystemMatrix(ess_tdof_list, A);
+      // The parallel matrix object is kept
+      REQUIRE(A.As<HypreParMatrix>() == A_ptr);
+      check();
+   }
+
+   // With different essential true dofs, FormSystemMatrix() eliminates them
+   // from a new parallel matrix
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+   a.FormSystemMatrix(ess_tdof_list, A);
+   check();
+
+   k.constant = 2.0;
+   a.ReassembleValues(0);
+   a.FormSystemMatrix(ess_tdof_list, A);
+   check();
+}
+
+#endif // MFEM_USE_MPI
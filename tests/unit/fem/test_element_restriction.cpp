@@ -0,0 +1,66 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+TEST_CASE("Element Restriction Transpose", "[ElementRestriction][OMP]")
+{
+   // The transpose of the element restriction is a gather over the element
+   // dofs of each L-dof: check it against the adjoint of the element
+   // restriction, (R x, e) = (x, R^T e), including the dof signs of the ND
+   // spaces and both vector orderings.
+   const auto mesh_file = GENERATE("../../data/star.mesh",
+                                   "../../data/fichera.mesh");
+   const int space = GENERATE(0, 1, 2);
+   CAPTURE(mesh_file, space);
+
+   Mesh mesh = Mesh::LoadFromFile(mesh_file);
+   mesh.EnsureNodes();
+   const int dim = mesh.Dimension();
+   const int order = 3;
+
+   std::unique_ptr<FiniteElementCollection> fec;
+   std::unique_ptr<FiniteElementSpace> fes;
+   if (space == 2)
+   {
+      fec.reset(new ND_FECollection(order, dim));
+      fes.reset(new FiniteElementSpace(&mesh, fec.get()));
+   }
+   else
+   {
+      fec.reset(new H1_FECollection(order, dim));
+      fes.reset(new FiniteElementSpace(&mesh, fec.get(), dim,
+                                       space ? Ordering::byVDIM :
+                                       Ordering::byNODES));
+   }
+   const Operator *R = fes->GetElementRestriction(
+                          ElementDofOrdering::LEXICOGRAPHIC);
+   REQUIRE(dynamic_cast<const ElementRestriction*>(R));
+
+   Vector x(R->Width()), e(R->Height()), Rx(R->Height()), RTe(R->Width());
+   x.Randomize(1);
+   e.Randomize(2);
+   R->Mult(x, Rx);
+   R->MultTranspose(e, RTe);
+   REQUIRE(InnerProduct(Rx, e) == MFEM_Approx(InnerProduct(x, RTe)));
+
+   // AddMultTranspose adds the same values
+   Vector y(R->Width());
+   y.Randomize(3);
+   Vector y0(y);
+   R->AddMultTranspose(e, y);
+   y -= y0;
+   y -= RTe;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+}
@@ -96,3 +96,87 @@ TEST_CASE("NonlinearForm Boundary Integrator", "[NonlinearForm]")
    u2 -= u1;
    REQUIRE(u2.Norml2() == MFEM_Approx(0.0, 1e-5));
 }
+
+namespace nonlinearform
+{
+
+void deformation(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05*sin(3.0*x(1)) + 0.02*x(0)*x(0);
+   y(1) += 0.04*cos(2.0*x(0)) - 0.03*x(1)*x(0);
+   if (x.Size() == 3) { y(2) += 0.03*sin(x(0) + 2.0*x(2)); }
+}
+
+real_t shear_modulus(const Vector &x)
+{
+   return 1.0 + x(0);
+}
+
+} // namespace nonlinearform
+
+TEST_CASE("NonlinearForm Hyperelastic PA", "[NonlinearForm], [PartialAssembly]")
+{
+   const auto dim = GENERATE(2, 3);
+   const auto model_type = GENERATE(0, 1);
+   CAPTURE(dim, model_type);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(3, 2, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(2, 2, 1, Element::HEXAHEDRON);
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim);
+
+   FunctionCoefficient mu(nonlinearform::shear_modulus);
+   ConstantCoefficient K(5.0);
+   NeoHookeanModel neo_hookean(mu, K);
+   InverseHarmonicModel inverse_harmonic;
+   HyperelasticModel *model = (model_type == 0) ?
+                              static_cast<HyperelasticModel*>(&neo_hookean) :
+                              static_cast<HyperelasticModel*>(&inverse_harmonic);
+
+   NonlinearForm nlf_fa(&fes), nlf_pa(&fes);
+   nlf_fa.AddDomainIntegrator(new HyperelasticNLFIntegrator(model));
+   nlf_pa.AddDomainIntegrator(new HyperelasticNLFIntegrator(model));
+   nlf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   nlf_pa.Setup();
+
+   GridFunction x(&fes), v(&fes);
+   VectorFunctionCoefficient deform(dim, nonlinearform::deformation);
+   x.ProjectCoefficient(deform);
+   v.Randomize(1);
+
+   // Energy
+   const real_t energy = nlf_fa.GetEnergy(x);
+   REQUIRE(nlf_pa.GetEnergy(x) == MFEM_Approx(energy));
+
+   // Residual
+   Vector r_fa(fes.GetTrueVSize()), r_pa(fes.GetTrueVSize());
+   nlf_fa.Mult(x, r_fa);
+   nlf_pa.Mult(x, r_pa);
+   r_pa -= r_fa;
+   REQUIRE(r_pa.Normlinf() == MFEM_Approx(0.0, 1e-12, 1e-12));
+
+   // Gradient action, assembled vs. matrix-free
+   Vector y_fa(fes.GetTrueVSize()), y_pa(fes.GetTrueVSize());
+   SparseMatrix &grad_fa = dynamic_cast<SparseMatrix&>(nlf_fa.GetGradient(x));
+   Operator &grad_pa = nlf_pa.GetGradient(x);
+   grad_fa.Mult(v, y_fa);
+   grad_pa.Mult(v, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() == MFEM_Approx(0.0, 1e-10, 1e-10));
+
+   // Gradient diagonal
+   Vector d_fa, d_pa(fes.GetTrueVSize());
+   grad_fa.GetDiag(d_fa);
+   grad_pa.AssembleDiagonal(d_pa);
+   d_pa -= d_fa;
+   REQUIRE(d_pa.Normlinf() == MFEM_Approx(0.0, 1e-10, 1e-10));
+
+   // The linearization state holds the deformation gradients
+   auto *integ =
+      dynamic_cast<HyperelasticNLFIntegrator*>((*nlf_pa.GetDNFI())[0]);
+   const QuadratureFunction *state = integ->GetPAState();
+   REQUIRE(state != nullptr);
+   REQUIRE(state->GetVDim() == dim*dim);
+}
@@ -0,0 +1,213 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include <fstream>
+#include <iterator>
+
+using namespace mfem;
+
+namespace pa_cache
+{
+
+Mesh MakeMesh(const int dim)
+{
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(3, 3, 3, Element::HEXAHEDRON);
+   mesh.SetCurvature(2);
+   // Perturb the nodes, so that the Jacobians vary in each element
+   GridFunction &nodes = *mesh.GetNodes();
+   for (int i = 0; i < nodes.Size(); i++)
+   {
+      nodes(i) += 0.02 * std::sin(7.0 * nodes(i) + i);
+   }
+   return mesh;
+}
+
+real_t coeff_function(const Vector &x)
+{
+   return 1.0 + x(0) * x(0) + x(1);
+}
+
+TEST_CASE("PA Data Cache", "[PartialAssembly]")
+{
+   const auto dim = GENERATE(2, 3);
+   const auto use_mmap = GENERATE(false, true);
+   CAPTURE(dim, use_mmap);
+
+   PADataCache cache("pa_cache_test/dir", use_mmap);
+   Mesh mesh = MakeMesh(dim);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh.GetElementGeometry(0), 5);
+
+   SECTION("Arrays")
+   {
+      Vector a(17), b(0), c(5);
+      a.Randomize(1);
+      c.Randomize(2);
+      cache.Save("arrays", {&a, &b, &c});
+      REQUIRE(cache.Exists("arrays"));
+      REQUIRE_FALSE(cache.Exists("missing"));
+
+      Vector a2(a.Size()), b2, c2(c.Size()), d2;
+      REQUIRE(cache.Load("arrays", {&a2, &b2, &c2}));
+      REQUIRE(a2.Size() == a.Size());
+      REQUIRE(b2.Size() == 0);
+      a2 -= a;
+      c2 -= c;
+      REQUIRE(a2.Normlinf() == 0.0);
+      REQUIRE(c2.Normlinf() == 0.0);
+
+      // Wrong number or sizes of the arrays, truncated or missing entry: data
+      // is left unchanged
+      REQUIRE_FALSE(cache.Load("arrays", {&a2, &b2}));
+      REQUIRE_FALSE(cache.Load("arrays", {&c2, &b2, &a2}));
+      REQUIRE(c2.Size() == c.Size());
+      {
+         std::ifstream is(cache.GetDirectory() + "/arrays.padata",
+                          std::ios::binary);
+         std::string bytes((std::istreambuf_iterator<char>(is)),
+                           std::istreambuf_iterator<char>());
+         std::ofstream os(cache.GetDirectory() + "/truncated.padata",
+                          std::ios::binary);
+         os.write(bytes.data(), bytes.size() - 16);
+      }
+      REQUIRE_FALSE(cache.Load("truncated", {&a2, &b2, &c2}));
+      REQUIRE_FALSE(cache.Load("missing", d2));
+      REQUIRE(d2.Size() == 0);
+
+      // Saving an existing entry again replaces it
+      cache.Save("arrays", {&c, &b, &a});
+      REQUIRE(cache.Load("arrays", {&c2, &b2, &a2}));
+      REQUIRE(c2.Size() == c.Size());
+      REQUIRE(a2.Size() == a.Size());
+      c2 -= c;
+      REQUIRE(c2.Normlinf() == 0.0);
+   }
+
+   SECTION("Fingerprint")
+   {
+      const std::string fp = PADataCache::Fingerprint(mesh, ir);
+      Mesh mesh2 = MakeMesh(dim);
+      REQUIRE(PADataCache::Fingerprint(mesh2, ir) == fp);
+
+      (*mesh2.GetNodes())(0) += 1e-12;
+      REQUIRE(PADataCache::Fingerprint(mesh2, ir) != fp);
+
+      const IntegrationRule &ir2 =
+         IntRules.Get(mesh.GetElementGeometry(0), 7);
+      REQUIRE(PADataCache::Fingerprint(mesh, ir2) != fp);
+   }
+
+   SECTION("Geometric factors")
+   {
+      const int flags = GeometricFactors::COORDINATES |
+                        GeometricFactors::JACOBIANS |
+                        GeometricFactors::DETERMINANTS;
+      const GeometricFactors *geom = mesh.GetGeometricFactors(ir, flags);
+
+      // A second mesh with the same nodes loads the factors from the cache
+      Mesh mesh2 = MakeMesh(dim);
+      mesh2.SetPADataCache(&cache);
+      mesh2.GetGeometricFactors(ir, flags);
+      REQUIRE(cache.Exists("geom_" + PADataCache::Fingerprint(mesh2, ir) +
+                           "_" + std::to_string(flags)));
+      Mesh mesh3 = MakeMesh(dim);
+      mesh3.SetPADataCache(&cache);
+      const GeometricFactors *geom3 = mesh3.GetGeometricFactors(ir, flags);
+
+      REQUIRE(geom3->mesh == &mesh3);
+      REQUIRE(geom3->IntRule == &ir);
+      Vector diff;
+      diff = geom3->X;
+      diff -= geom->X;
+      REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+      diff = geom3->J;
+      diff -= geom->J;
+      REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+      diff = geom3->detJ;
+      diff -= geom->detJ;
+      REQUIRE(diff.Normlinf() == MFEM_Approx(0.0));
+   }
+
+   SECTION("Integrators")
+   {
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      FunctionCoefficient coeff(coeff_function);
+
+      GridFunction x(&fes), y(&fes), y_cached(&fes);
+      x.Randomize(1);
+
+      for (int i = 0; i < 2; i++)
+      {
+         BilinearForm a(&fes);
+         a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         BilinearFormIntegrator *integ;
+         if (i == 0) { integ = new MassIntegrator(coeff, &ir); }
+         else { integ = new DiffusionIntegrator(coeff, &ir); }
+         a.AddDomainIntegrator(integ);
+         a.Assemble();
+         a.Mult(x, y);
+
+         // The first form stores the data, the second one loads it
+         for (int j = 0; j < 2; j++)
+         {
+            BilinearForm a_cached(&fes);
+            a_cached.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            if (i == 0) { integ = new MassIntegrator(coeff, &ir); }
+            else { integ = new DiffusionIntegrator(coeff, &ir); }
+            integ->SetPADataCache(&cache, "coeff_function");
+            a_cached.AddDomainIntegrator(integ);
+            a_cached.Assemble();
+            a_cached.Mult(x, y_cached);
+
+            y_cached -= y;
+            REQUIRE(y_cached.Normlinf() == MFEM_Approx(0.0));
+         }
+
+         // Without a tag, a different coefficient does not reuse the entries
+         ConstantCoefficient two(2.0);
+         for (int j = 0; j < 2; j++)
+         {
+            BilinearForm a_const(&fes);
+            a_const.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            for (int k = 0; k < 2; k++)
+            {
+               Coefficient &c = (k == 0) ? static_cast<Coefficient&>(coeff) :
+                                static_cast<Coefficient&>(two);
+               if (i == 0) { integ = new MassIntegrator(c, &ir); }
+               else { integ = new DiffusionIntegrator(c, &ir); }
+               integ->SetPADataCache(&cache);
+               a_const.AddDomainIntegrator(integ);
+            }
+            a_const.Assemble();
+            a_const.Mult(x, y_cached);
+
+            // coeff + 2 = y + 2*(y with coefficient 1)
+            BilinearForm a_one(&fes);
+            a_one.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            if (i == 0) { a_one.AddDomainIntegrator(new MassIntegrator(&ir)); }
+            else { a_one.AddDomainIntegrator(new DiffusionIntegrator(&ir)); }
+            a_one.Assemble();
+            GridFunction y_one(&fes);
+            a_one.Mult(x, y_one);
+            y_cached -= y;
+            y_cached.Add(-2.0, y_one);
+            REQUIRE(y_cached.Normlinf() == MFEM_Approx(0.0));
+         }
+      }
+   }
+}
+
+} // namespace pa_cache
@@ -11,7 +11,12 @@
 
 #include "unit_tests.hpp"
 #include "mfem.hpp"
+#ifdef MFEM_USE_SIMD
+#include "../../fem/integ/bilininteg_diffusion_kernels.hpp"
+#include "../../fem/integ/bilininteg_mass_kernels.hpp"
+#endif
 
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 
@@ -622,6 +627,289 @@ TEST_CASE("PA Diffusion", "[PartialAssembly], [CUDA]")
    test_pa_integrator<DiffusionIntegrator>();
 } // PA Diffusion test case
 
+TEST_CASE("PA Element Batches", "[PartialAssembly]")
+{
+   // The host PA kernels process the elements in batches of SIMD width, check
+   // element counts that do not fill the last batch.
+   auto dim = GENERATE(2, 3);
+   auto ne = GENERATE(1, 3, 5, 9);
+   auto order = GENERATE(1, 2);
+   CAPTURE(dim, ne, order);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(ne, 1, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(ne, 1, 1, Element::HEXAHEDRON);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   // Non-symmetric matrix coefficient
+   MatrixFunctionCoefficient mcoeff(dim, [](const Vector &x, DenseMatrix &K)
+   {
+      K = 0.1;
+      for (int i = 0; i < K.Height(); i++) { K(i,i) = 1.0 + i + x(i); }
+      K(0,1) = 0.3;
+   });
+   FunctionCoefficient coeff(f1);
+
+   GridFunction x(&fes), y_fa(&fes), y_pa(&fes);
+   x.Randomize(1);
+
+   for (int i = 0; i < 3; i++)
+   {
+      BilinearForm blf_fa(&fes), blf_pa(&fes);
+      blf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      for (BilinearForm *blf : {&blf_fa, &blf_pa})
+      {
+         BilinearFormIntegrator *integ;
+         if (i == 0) { integ = new MassIntegrator(coeff); }
+         else if (i == 1) { integ = new DiffusionIntegrator(coeff); }
+         else { integ = new DiffusionIntegrator(mcoeff); }
+         blf->AddDomainIntegrator(integ);
+      }
+      blf_fa.Assemble();
+      blf_fa.Finalize();
+      blf_pa.Assemble();
+
+      blf_fa.Mult(x, y_fa);
+      blf_pa.Mult(x, y_pa);
+      y_fa -= y_pa;
+      REQUIRE(y_fa.Normlinf() == MFEM_Approx(0.0));
+   }
+}
+
+#ifdef MFEM_USE_SIMD
+TEST_CASE("PA SIMD Kernels", "[PartialAssembly][OMP]")
+{
+   // Compare the element-batched SIMD kernels with the generic kernels on
+   // random data, including element counts that do not fill the last batch.
+   const int dq[8][3] = {{2,2,2}, {2,3,3}, {2,4,4}, {2,6,6},
+      {3,2,3}, {3,3,4}, {3,4,5}, {3,5,6}
+   };
+   const auto i = GENERATE(range(0, 8));
+   const auto ne = GENERATE(1, 5, 9);
+   const int dim = dq[i][0], d1d = dq[i][1], q1d = dq[i][2];
+   CAPTURE(dim, d1d, q1d, ne);
+
+   const int nd = (dim == 2) ? d1d*d1d : d1d*d1d*d1d;
+   const int nq = (dim == 2) ? q1d*q1d : q1d*q1d*q1d;
+   Array<real_t> B(q1d*d1d), G(q1d*d1d), Bt(q1d*d1d), Gt(q1d*d1d);
+   for (int k = 0; k < q1d*d1d; k++)
+   {
+      B[k] = std::sin(1.0 + k);
+      G[k] = std::cos(2.0 + k);
+      Bt[k] = std::sin(3.0 + k);
+      Gt[k] = std::cos(4.0 + k);
+   }
+   Vector x(nd*ne), y(nd*ne), y_simd(nd*ne);
+   x.Randomize(1);
+
+   SECTION("Mass")
+   {
+      Vector D(nq*ne);
+      D.Randomize(2);
+      y = 0.0;
+      y_simd = 0.0;
+      MassIntegrator::ApplyPAKernels::Run(dim, d1d, q1d, ne, B, Bt, D, x, y,
+                                          d1d, q1d);
+      MassIntegrator::SimdApplyPAKernels::Run(dim, d1d, q1d, ne, B, Bt, D,
+                                              x, y_simd, d1d, q1d);
+      y_simd -= y;
+      REQUIRE(y_simd.Normlinf() <= 1e-12 * y.Normlinf());
+   }
+
+   SECTION("Diffusion")
+   {
+      const bool symmetric = GENERATE(true, false);
+      CAPTURE(symmetric);
+      const int nc = symmetric ? dim*(dim + 1)/2 : dim*dim;
+      Vector D(nq*nc*ne);
+      D.Randomize(2);
+      y = 0.0;
+      y_simd = 0.0;
+      DiffusionIntegrator::ApplyPAKernels::Run(dim, d1d, q1d, ne, symmetric,
+                                               B, G, Bt, Gt, D, x, y,
+                                               d1d, q1d);
+      DiffusionIntegrator::SimdApplyPAKernels::Run(dim, d1d, q1d, ne,
+                                                   symmetric, B, G, Bt, Gt,
+                                                   D, x, y_simd, d1d, q1d);
+      y_simd -= y;
+      REQUIRE(y_simd.Normlinf() <= 1e-12 * y.Normlinf());
+   }
+}
+#endif // MFEM_USE_SIMD
+
+TEST_CASE("PA ArrayMult", "[PartialAssembly]")
+{
+   // With order 3 in 3D, the elements are processed in several chunks
+   const auto dim = GENERATE(2, 3);
+   // Boundary integrators are not batched, ArrayMult falls back to Mult
+   const bool bdr_integ = GENERATE(false, true);
+   // The element and fully assembled forms apply their assembled data one
+   // vector at a time, also when only reduced precision PA data is requested
+   const auto assembly = GENERATE(AssemblyLevel::PARTIAL,
+                                  AssemblyLevel::ELEMENT, AssemblyLevel::FULL);
+   const auto precision = GENERATE(PADataPrecision::FULL,
+                                   PADataPrecision::SINGLE);
+   if (bdr_integ && assembly != AssemblyLevel::PARTIAL) { return; }
+   CAPTURE(dim, bdr_integ, assembly, precision);
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(5, 5, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+   H1_FECollection fec(3, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient coeff(f1);
+   Array<int> ess_tdof_list;
+   // Without essential dofs, so that the boundary term is not eliminated
+   if (!bdr_integ) { fes.GetBoundaryTrueDofs(ess_tdof_list); }
+
+   BilinearForm blf(&fes);
+   blf.SetAssemblyLevel(assembly);
+   auto *diffusion = new DiffusionIntegrator(coeff);
+   diffusion->SetPADataPrecision(precision);
+   blf.AddDomainIntegrator(diffusion);
+   blf.AddDomainIntegrator(new MassIntegrator);
+   if (bdr_integ) { blf.AddBoundaryIntegrator(new MassIntegrator); }
+   blf.Assemble();
+   OperatorHandle A;
+   blf.FormSystemMatrix(ess_tdof_list, A);
+
+   const int nv = 3, n = fes.GetTrueVSize();
+   Vector X[nv], Y[nv], Y_ref(n);
+   Array<const Vector *> Xp(nv);
+   Array<Vector *> Yp(nv);
+   for (int k = 0; k < nv; k++)
+   {
+      X[k].SetSize(n);
+      X[k].Randomize(k + 1);
+      Y[k].SetSize(n);
+      Xp[k] = &X[k];
+      Yp[k] = &Y[k];
+   }
+   A->ArrayMult(Xp, Yp);
+   for (int k = 0; k < nv; k++)
+   {
+      A->Mult(X[k], Y_ref);
+      Y[k] -= Y_ref;
+      REQUIRE(Y[k].Normlinf() == MFEM_Approx(0.0));
+   }
+}
+
+#if defined(MFEM_USE_JIT) && !defined(_WIN32)
+TEST_CASE("PA JIT Kernels", "[PartialAssembly]")
+{
+   if (!KernelJIT::HasCompiler())
+   {
+      WARN("no JIT compiler available, skipping the test");
+      return;
+   }
+   // Use a private cache directory, removed at the end of the test.
+   const char *tmpdir = getenv("TMPDIR");
+   std::string test_dir = std::string(tmpdir ? tmpdir : "/tmp") +
+                          "/mfem_jit_test.XXXXXX";
+   REQUIRE(mkdtemp(&test_dir[0]) != nullptr);
+
+   // (D1D,Q1D) = (3,7) is not registered: with JIT compilation enabled, the
+   // specialization is compiled at runtime and used instead of the fallback.
+   const bool jit_enabled = KernelJIT::IsEnabled();
+   const std::string cache_dir = KernelJIT::GetCacheDir();
+   KernelJIT::Enable();
+   KernelJIT::SetCacheDir(test_dir);
+   const int num_loaded = KernelJIT::GetNumLoaded();
+
+   Mesh mesh = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   const IntegrationRule &ir = IntRules.Get(Geometry::SQUARE, 13);
+   FunctionCoefficient coeff(f1);
+
+   BilinearForm blf_fa(&fes), blf_pa(&fes);
+   blf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf_fa.AddDomainIntegrator(new DiffusionIntegrator(coeff, &ir));
+   blf_pa.AddDomainIntegrator(new DiffusionIntegrator(coeff, &ir));
+   blf_fa.Assemble();
+   blf_fa.Finalize();
+   blf_pa.Assemble();
+
+   GridFunction x(&fes), y_fa(&fes), y_pa(&fes);
+   x.Randomize(1);
+   blf_fa.Mult(x, y_fa);
+   blf_pa.Mult(x, y_pa);
+   y_fa -= y_pa;
+   const int num_jit = KernelJIT::GetNumLoaded() - num_loaded;
+
+   KernelJIT::ClearCache();
+   KernelJIT::SetCacheDir(cache_dir);
+   if (!jit_enabled) { KernelJIT::Disable(); }
+
+   REQUIRE(y_fa.Normlinf() == MFEM_Approx(0.0));
+   REQUIRE(num_jit > 0);
+}
+#endif
+
+TEST_CASE("PA Reduced Precision Diffusion", "[PartialAssembly], [CUDA]")
+{
+   const auto dim = GENERATE(2, 3);
+   const auto order = GENERATE(1, 3);
+   CAPTURE(dim, order);
+
+   Mesh mesh = (dim == 2) ?
+               Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL) :
+               Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient coeff(f1);
+
+   GridFunction x(&fes), y(&fes), y_rp(&fes);
+   x.Randomize(1);
+
+   BilinearForm blf(&fes);
+   blf.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+   blf.Assemble();
+   blf.Mult(x, y);
+
+   // Relative accuracy of the reduced precision data
+   const real_t eps[2] = {1e-6, 1e-2};
+   const PADataPrecision precisions[2] = {PADataPrecision::SINGLE,
+                                          PADataPrecision::BFLOAT16
+                                         };
+   Vector diag(fes.GetTrueVSize()), diag_rp(fes.GetTrueVSize());
+   blf.AssembleDiagonal(diag);
+   for (int i = 0; i < 2; i++)
+   {
+      // By default, the full precision data is not kept
+      BilinearForm blf_rp(&fes);
+      blf_rp.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      blf_rp.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      blf_rp.SetPADataPrecision(precisions[i]);
+      blf_rp.Assemble();
+
+      blf_rp.Mult(x, y_rp);
+      y_rp -= y;
+      REQUIRE(y_rp.Normlinf() <= eps[i] * y.Normlinf());
+      REQUIRE(y_rp.Normlinf() > 0.0);
+
+      blf_rp.AssembleDiagonal(diag_rp);
+      diag_rp -= diag;
+      REQUIRE(diag_rp.Normlinf() <= eps[i] * diag.Normlinf());
+
+      BilinearForm blf_keep(&fes);
+      blf_keep.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      blf_keep.AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      blf_keep.SetPADataPrecision(precisions[i], true);
+      blf_keep.Assemble();
+
+      blf_keep.Mult(x, y_rp);
+      y_rp -= y;
+      REQUIRE(y_rp.Normlinf() <= eps[i] * y.Normlinf());
+
+      blf_keep.UseFullPrecisionPA();
+      blf_keep.Mult(x, y_rp);
+      y_rp -= y;
+      REQUIRE(y_rp.Normlinf() == MFEM_Approx(0.0));
+   }
+}
+
 TEST_CASE("PA Markers", "[PartialAssembly], [CUDA]")
 {
    const bool all_tests = launch_all_non_regression_tests;
@@ -678,6 +966,55 @@ TEST_CASE("PA Markers", "[PartialAssembly], [CUDA]")
    REQUIRE(y_fa.Normlinf() == MFEM_Approx(0.0));
 }
 
+TEST_CASE("PA Fused Diffusion", "[PartialAssembly], [CUDA]")
+{
+   const bool all_tests = launch_all_non_regression_tests;
+   auto fname = GENERATE("../../data/star.mesh", "../../data/star-q3.mesh",
+                         "../../data/fichera.mesh", "../../data/fichera-q3.mesh");
+   auto order = !all_tests ? 2 : GENERATE(1, 2, 3);
+   // q_order_inc > 0 exercises the fallback (non-specialized) kernels
+   auto q_order_inc = GENERATE(0, 3);
+   CAPTURE(fname, order, q_order_inc);
+
+   Mesh mesh(fname);
+   int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   const IntegrationRule *ir = q_order_inc == 0 ? nullptr :
+                               &IntRules.Get(mesh.GetElementGeometry(0),
+                                             2*order + q_order_inc);
+
+   FunctionCoefficient coeff(f1);
+
+   GridFunction x(&fes), y_pa(&fes), y_ref(&fes), y_fused(&fes);
+   x.Randomize(1);
+
+   BilinearForm blf_pa(&fes);
+   blf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf_pa.AddDomainIntegrator(new DiffusionIntegrator(coeff, ir));
+   blf_pa.Assemble();
+   blf_pa.Mult(x, y_pa);
+
+   BilinearForm blf_fused(&fes);
+   blf_fused.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf_fused.EnableFusedPartialAssembly();
+   blf_fused.AddDomainIntegrator(new DiffusionIntegrator(coeff, ir));
+   blf_fused.AddDomainIntegrator(new DiffusionIntegrator(ir));
+   blf_fused.Assemble();
+   blf_fused.Mult(x, y_fused);
+
+   BilinearForm blf_ref(&fes);
+   blf_ref.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf_ref.AddDomainIntegrator(new DiffusionIntegrator(ir));
+   blf_ref.Assemble();
+   blf_ref.Mult(x, y_ref);
+   y_pa += y_ref;
+
+   y_pa -= y_fused;
+   REQUIRE(y_pa.Normlinf() == MFEM_Approx(0.0));
+}
+
 TEST_CASE("PA Boundary Mass", "[PartialAssembly], [CUDA]")
 {
    const bool all_tests = launch_all_non_regression_tests;
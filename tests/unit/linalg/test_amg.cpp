@@ -0,0 +1,155 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace amg
+{
+
+// Number of AMG preconditioned CG iterations for A x = b
+int SolveCG(const SparseMatrix &A, const Vector &b, Solver &prec,
+            real_t &residual)
+{
+   CGSolver cg;
+   cg.SetRelTol(1e-8);
+   cg.SetMaxIter(200);
+   cg.SetOperator(A);
+   cg.SetPreconditioner(prec);
+   Vector x(b.Size());
+   x = 0.0;
+   cg.Mult(b, x);
+   REQUIRE(cg.GetConverged());
+
+   Vector r(b.Size());
+   A.Mult(x, r);
+   r -= b;
+   residual = r.Norml2() / b.Norml2();
+   return cg.GetNumIterations();
+}
+
+} // namespace amg
+
+TEST_CASE("SmoothedAggregationAMG Poisson", "[AMG]")
+{
+   const int order = GENERATE(1, 2);
+   CAPTURE(order);
+
+   int min_iter = 1000, max_iter = 0;
+   for (int n = 8; n <= 64; n *= 2)
+   {
+      CAPTURE(n);
+      Mesh mesh = Mesh::MakeCartesian2D(n, n, Element::QUADRILATERAL);
+      H1_FECollection fec(order, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      Array<int> ess_tdof_list;
+      fes.GetBoundaryTrueDofs(ess_tdof_list);
+
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+      LinearForm f(&fes);
+      ConstantCoefficient one(1.0);
+      f.AddDomainIntegrator(new DomainLFIntegrator(one));
+      f.Assemble();
+      GridFunction u(&fes);
+      u = 0.0;
+      SparseMatrix A;
+      Vector B, X;
+      a.FormLinearSystem(ess_tdof_list, u, f, A, X, B);
+
+      SmoothedAggregationAMG amg;
+      amg.SetMaxCoarseSize(20);
+      amg.SetOperator(A);
+      REQUIRE(amg.GetLevelMatrix(0).Height() == A.Height());
+      REQUIRE(amg.GetOperatorComplexity() < 2.0);
+      if (n >= 32) { REQUIRE(amg.GetNumLevels() > 2); }
+
+      real_t residual;
+      const int it = amg::SolveCG(A, B, amg, residual);
+      REQUIRE(residual < 1e-6);
+      min_iter = std::min(min_iter, it);
+      max_iter = std::max(max_iter, it);
+   }
+   // The number of iterations does not grow with the mesh size
+   CAPTURE(min_iter, max_iter);
+   REQUIRE(max_iter <= 25);
+   REQUIRE(max_iter - min_iter <= 6);
+}
+
+TEST_CASE("SmoothedAggregationAMG elasticity", "[AMG]")
+{
+   const int ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+   CAPTURE(ordering);
+
+   Mesh mesh = Mesh::MakeCartesian2D(24, 8, Element::QUADRILATERAL, false,
+                                     3.0, 1.0);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec, 2, ordering);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max()), ess_tdof_list;
+   ess_bdr = 0;
+   ess_bdr[3] = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   BilinearForm a(&fes);
+   ConstantCoefficient lambda(1.0), mu(1.0);
+   a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+   a.Assemble();
+   LinearForm f(&fes);
+   VectorConstantCoefficient force(Vector({0.0, -1.0}));
+   f.AddDomainIntegrator(new VectorDomainLFIntegrator(force));
+   f.Assemble();
+   GridFunction u(&fes);
+   u = 0.0;
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, u, f, A, X, B);
+
+   real_t residual;
+   SmoothedAggregationAMG amg_systems;
+   amg_systems.SetMaxCoarseSize(20);
+   amg_systems.SetSystemsOptions(2, ordering == Ordering::byNODES);
+   amg_systems.SetOperator(A);
+   const int it_systems = amg::SolveCG(A, B, amg_systems, residual);
+   REQUIRE(residual < 1e-6);
+
+   SmoothedAggregationAMG amg;
+   amg.SetMaxCoarseSize(20);
+   amg.SetElasticityOptions(&fes);
+   amg.SetOperator(A);
+   REQUIRE(amg.GetNumLevels() > 2);
+   const int it = amg::SolveCG(A, B, amg, residual);
+   REQUIRE(residual < 1e-6);
+
+   // The rigid body modes improve the convergence
+   CAPTURE(it, it_systems);
+   REQUIRE(it <= it_systems);
+   REQUIRE(it <= 40);
+
+   // One cycle for several right-hand sides
+   Vector B2(B), X1(B.Size()), X2(B.Size()), Y1(B.Size()), Y2(B.Size());
+   B2.Randomize(1);
+   amg.Mult(B, X1);
+   amg.Mult(B2, X2);
+   Array<const Vector*> Bs(2);
+   Array<Vector*> Ys(2);
+   Bs[0] = &B;
+   Bs[1] = &B2;
+   Ys[0] = &Y1;
+   Ys[1] = &Y2;
+   amg.ArrayMult(Bs, Ys);
+   Y1 -= X1;
+   Y2 -= X2;
+   REQUIRE(Y1.Normlinf() == MFEM_Approx(0.0));
+   REQUIRE(Y2.Normlinf() == MFEM_Approx(0.0));
+}
@@ -169,3 +169,45 @@ TEST_CASE("ILU Factorization", "[ILU]")
    REQUIRE(AB(0,1,6) == MFEM_Approx(-9.4));
    REQUIRE(AB(1,1,6) == MFEM_Approx(22552.0/245.0));
 }
+
+TEST_CASE("ILU Solve", "[ILU][OMP]")
+{
+   // Block matrix with the pattern of a tree in which the parent of each node
+   // has a larger index. The block ILU(0) factorization without reordering has
+   // no fill, so it is the exact LU factorization.
+   const int nb = 60, bs = 3, n = nb*bs;
+   SparseMatrix A(n, n);
+   srand(3);
+   auto add_block = [&](int ib, int jb, real_t diag)
+   {
+      for (int i = 0; i < bs; i++)
+      {
+         for (int j = 0; j < bs; j++)
+         {
+            A.Add(ib*bs + i, jb*bs + j,
+                  (i == j ? diag : 0.0) + real_t(rand())/RAND_MAX - 0.5);
+         }
+      }
+   };
+   for (int i = 0; i < nb; i++)
+   {
+      add_block(i, i, 10.0);
+      if (i + 1 < nb)
+      {
+         const int p = i + 1 + rand() % std::min(4, nb - 1 - i);
+         add_block(i, p, 0.0);
+         add_block(p, i, 0.0);
+      }
+   }
+   A.Finalize();
+
+   BlockILU ilu(A, bs, BlockILU::Reordering::NONE);
+
+   Vector b(n), x(n), r(n);
+   b.Randomize(1);
+   x = 0.0;
+   ilu.Mult(b, x);
+   A.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Normlinf() == MFEM_Approx(0.0));
+}
@@ -0,0 +1,404 @@
+// Copyright (c) 2010-2024, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace krylov
+{
+
+// Diffusion (and optionally convection) system on a 2D mesh with the boundary
+// dofs eliminated.
+struct TestProblem
+{
+   Mesh mesh;
+   H1_FECollection fec;
+   FiniteElementSpace fes;
+   BilinearForm a;
+   LinearForm f;
+   ConstantCoefficient one;
+   VectorConstantCoefficient velocity;
+   GridFunction u;
+   SparseMatrix A;
+   Vector B, X;
+
+   TestProblem(bool convection, int order = 2)
+      : mesh(Mesh::MakeCartesian2D(6, 6, Element::QUADRILATERAL)),
+        fec(order, 2), fes(&mesh, &fec), a(&fes), f(&fes), one(1.0),
+        velocity(Vector({20.0, 10.0})), u(&fes)
+   {
+      Array<int> ess_tdof_list;
+      fes.GetBoundaryTrueDofs(ess_tdof_list);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      if (convection)
+      {
+         a.AddDomainIntegrator(new ConvectionIntegrator(velocity));
+      }
+      a.Assemble();
+      f.AddDomainIntegrator(new DomainLFIntegrator(one));
+      f.Assemble();
+      u = 0.0;
+      a.FormLinearSystem(ess_tdof_list, u, f, A, X, B);
+   }
+
+   real_t Residual(const Vector &x) const
+   {
+      Vector r(B.Size());
+      A.Mult(x, r);
+      r -= B;
+      return r.Norml2() / B.Norml2();
+   }
+};
+
+} // namespace krylov
+
+TEST_CASE("PipelinedCGSolver", "[Krylov]")
+{
+   krylov::TestProblem problem(false);
+   const bool use_prec = GENERATE(false, true);
+   CAPTURE(use_prec);
+
+   GSSmoother prec(problem.A);
+
+   CGSolver cg;
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(500);
+   cg.SetOperator(problem.A);
+   if (use_prec) { cg.SetPreconditioner(prec); }
+
+   PipelinedCGSolver pcg;
+   pcg.SetRelTol(1e-10);
+   pcg.SetMaxIter(500);
+   pcg.SetOperator(problem.A);
+   if (use_prec) { pcg.SetPreconditioner(prec); }
+
+   Vector x_cg(problem.B.Size()), x_pcg(problem.B.Size());
+   x_cg = 0.0;
+   x_pcg = 0.0;
+   cg.Mult(problem.B, x_cg);
+   pcg.Mult(problem.B, x_pcg);
+
+   REQUIRE(cg.GetConverged());
+   REQUIRE(pcg.GetConverged());
+   REQUIRE(problem.Residual(x_pcg) < 1e-8);
+   REQUIRE(std::abs(pcg.GetNumIterations() - cg.GetNumIterations()) <= 2);
+   REQUIRE(pcg.GetInitialNorm() == MFEM_Approx(cg.GetInitialNorm()));
+
+   // Starting from the converged solution
+   pcg.SetRelTol(0.0);
+   pcg.SetAbsTol(10*pcg.GetFinalNorm());
+   pcg.Mult(problem.B, x_pcg);
+   REQUIRE(pcg.GetConverged());
+   REQUIRE(pcg.GetNumIterations() == 0);
+}
+
+namespace krylov
+{
+
+// CGSolver with the standard inner product, computed by Dot()
+class DotCGSolver : public CGSolver
+{
+public:
+   mutable int num_dots = 0;
+
+   real_t Dot(const Vector &x, const Vector &y) const override
+   {
+      num_dots++;
+      return x * y;
+   }
+};
+
+} // namespace krylov
+
+TEST_CASE("CGSolver fused residual update", "[Krylov]")
+{
+   krylov::TestProblem problem(false);
+
+   // Without a preconditioner, CGSolver computes the norm of the residual
+   // together with its update, while the derived class uses Dot()
+   CGSolver cg;
+   krylov::DotCGSolver dot_cg;
+   for (CGSolver *solver : {&cg, static_cast<CGSolver*>(&dot_cg)})
+   {
+      solver->SetRelTol(1e-10);
+      solver->SetMaxIter(500);
+      solver->SetOperator(problem.A);
+   }
+
+   Vector x_cg(problem.B.Size()), x_dot(problem.B.Size());
+   x_cg = 0.0;
+   x_dot = 0.0;
+   cg.Mult(problem.B, x_cg);
+   dot_cg.Mult(problem.B, x_dot);
+
+   REQUIRE(cg.GetConverged());
+   REQUIRE(dot_cg.GetConverged());
+   REQUIRE(problem.Residual(x_cg) < 1e-8);
+   REQUIRE(cg.GetNumIterations() == dot_cg.GetNumIterations());
+   REQUIRE(cg.GetFinalNorm() == MFEM_Approx(dot_cg.GetFinalNorm()));
+   // (d, r) and (A d, d) first, then (r, r) in each iteration, and (A d, d)
+   // in all of them but the last one
+   REQUIRE(dot_cg.num_dots == 1 + 2*dot_cg.GetNumIterations());
+
+   x_cg -= x_dot;
+   REQUIRE(x_cg.Normlinf() < 1e-8 * x_dot.Normlinf());
+}
+
+TEST_CASE("GMRESSolver single reduction", "[Krylov]")
+{
+   krylov::TestProblem problem(true);
+   const int kdim = GENERATE(10, 50);
+   CAPTURE(kdim);
+
+   DSmoother prec(problem.A);
+
+   GMRESSolver gmres;
+   gmres.SetRelTol(1e-10);
+   gmres.SetMaxIter(1000);
+   gmres.SetKDim(kdim);
+   gmres.SetOperator(problem.A);
+   gmres.SetPreconditioner(prec);
+
+   Vector x_mgs(problem.B.Size()), x_cgs(problem.B.Size());
+   x_mgs = 0.0;
+   x_cgs = 0.0;
+   gmres.Mult(problem.B, x_mgs);
+   REQUIRE(gmres.GetConverged());
+   const int it_mgs = gmres.GetNumIterations();
+
+   gmres.SetSingleReduction();
+   gmres.Mult(problem.B, x_cgs);
+   REQUIRE(gmres.GetConverged());
+   REQUIRE(problem.Residual(x_cgs) < 1e-8);
+   REQUIRE(std::abs(gmres.GetNumIterations() - it_mgs) <= 2);
+
+   x_cgs -= x_mgs;
+   REQUIRE(x_cgs.Normlinf() < 1e-8 * x_mgs.Normlinf());
+}
+
+TEST_CASE("Krylov multiple right-hand sides", "[Krylov]")
+{
+   const bool use_cg = GENERATE(true, false);
+   const bool variant = GENERATE(false, true);
+   CAPTURE(use_cg, variant);
+   krylov::TestProblem problem(!use_cg);
+
+   GSSmoother gs(problem.A);
+   DSmoother jacobi(problem.A);
+   CGSolver cg;
+   GMRESSolver gmres;
+   gmres.SetKDim(10);
+   IterativeSolver &solver = use_cg ? (IterativeSolver&)cg : gmres;
+   solver.SetRelTol(1e-10);
+   solver.SetMaxIter(500);
+   solver.SetOperator(problem.A);
+   if (use_cg && variant) { solver.SetPreconditioner(gs); }
+   if (!use_cg)
+   {
+      solver.SetPreconditioner(jacobi);
+      gmres.SetSingleReduction(variant);
+   }
+
+   // Right-hand sides of different difficulty, including a zero one
+   const int nv = 4, n = problem.B.Size();
+   Vector B[nv], X[nv], X_ref[nv];
+   Array<const Vector *> Bp(nv);
+   Array<Vector *> Xp(nv);
+   int max_iter = 0;
+   for (int k = 0; k < nv; k++)
+   {
+      B[k].SetSize(n);
+      B[k].Randomize(k);
+      B[k] *= real_t(k);
+      B[k] += problem.B;
+      if (k == 2) { B[k] = 0.0; }
+      X[k].SetSize(n);
+      X_ref[k].SetSize(n);
+      X[k] = 0.0;
+      X_ref[k] = 0.0;
+      Bp[k] = &B[k];
+      Xp[k] = &X[k];
+
+      solver.Mult(B[k], X_ref[k]);
+      REQUIRE(solver.GetConverged());
+      max_iter = std::max(max_iter, solver.GetNumIterations());
+   }
+
+   solver.ArrayMult(Bp, Xp);
+   REQUIRE(solver.GetConverged());
+   REQUIRE(solver.GetNumIterations() == max_iter);
+   for (int k = 0; k < nv; k++)
+   {
+      X[k] -= X_ref[k];
+      REQUIRE(X[k].Normlinf() <= 1e-10 * std::max(X_ref[k].Normlinf(), 1.0));
+   }
+}
+
+TEST_CASE("MixedPrecisionRefinementSolver", "[Krylov]")
+{
+   krylov::TestProblem problem(false, 3);
+   // 0: default single precision CG, 1: SetInnerSolver(), 2: SetPreconditioner()
+   const int inner = GENERATE(0, 1, 2);
+   const bool use_inner_solver = inner > 0;
+   CAPTURE(inner);
+
+   GSSmoother prec(problem.A);
+   CGSolver cg;
+   cg.SetRelTol(1e-3);
+   cg.SetMaxIter(100);
+   cg.SetOperator(problem.A);
+   cg.SetPreconditioner(prec);
+
+   MixedPrecisionRefinementSolver ir;
+   ir.SetRelTol(1e-12);
+   ir.SetMaxIter(20);
+   if (inner == 2) { ir.SetPreconditioner(cg); }
+   ir.SetOperator(problem.A);
+   if (inner == 1) { ir.SetInnerSolver(cg); }
+
+   // The accuracy is not limited by the single precision inner solves
+   Vector x(problem.B.Size());
+   x = 0.0;
+   ir.Mult(problem.B, x);
+   REQUIRE(ir.GetConverged());
+   REQUIRE(ir.GetNumIterations() <= 6);
+   REQUIRE(problem.Residual(x) < 1e-11);
+   REQUIRE((ir.GetNumInnerIterations() > 0) == !use_inner_solver);
+
+   // Starting from the converged solution
+   ir.iterative_mode = true;
+   ir.SetRelTol(0.0);
+   ir.SetAbsTol(10*ir.GetFinalNorm());
+   ir.Mult(problem.B, x);
+   REQUIRE(ir.GetConverged());
+   REQUIRE(ir.GetNumIterations() == 0);
+}
+
+TEST_CASE("DeflatedCGSolver", "[Krylov]")
+{
+   krylov::TestProblem problem(false, 3);
+   const bool use_prec = GENERATE(false, true);
+   CAPTURE(use_prec);
+
+   // A sequence of slowly varying matrices, as in time stepping
+   const int n = problem.B.Size(), num_steps = 6;
+   SparseMatrix A(problem.A);
+   DSmoother prec(A);
+
+   CGSolver cg;
+   cg.SetRelTol(1e-10);
+   cg.SetMaxIter(500);
+
+   DeflatedCGSolver dcg;
+   dcg.SetRelTol(1e-10);
+   dcg.SetMaxIter(500);
+   dcg.SetRecycleDim(10);
+   dcg.SetNumStoredDirections(40);
+
+   Vector b(n), x_cg(n), x_dcg(n);
+   for (int step = 0; step < num_steps; step++)
+   {
+      CAPTURE(step);
+      if (step > 0)
+      {
+         for (int i = 0; i < n; i++) { A(i,i) *= 1.001; }
+      }
+      cg.SetOperator(A);
+      dcg.SetOperator(A);
+      if (use_prec)
+      {
+         prec.SetOperator(A);
+         cg.SetPreconditioner(prec);
+         dcg.SetPreconditioner(prec);
+      }
+      b.Randomize(step);
+      b += problem.B;
+      x_cg = 0.0;
+      x_dcg = 0.0;
+      cg.Mult(b, x_cg);
+      dcg.Mult(b, x_dcg);
+      REQUIRE(cg.GetConverged());
+      REQUIRE(dcg.GetConverged());
+      x_dcg -= x_cg;
+      REQUIRE(x_dcg.Normlinf() < 1e-8*x_cg.Normlinf());
+
+      // Without a recycle space, the iterates are the same as in CG
+      if (step == 0)
+      {
+         REQUIRE(dcg.GetNumIterations() == cg.GetNumIterations());
+      }
+      REQUIRE(dcg.GetRecycleDim() == 10);
+   }
+   // The recycle space reduces the number of iterations of the later solves
+   CAPTURE(cg.GetNumIterations(), dcg.GetNumIterations());
+   REQUIRE(dcg.GetNumIterations() < 0.75*cg.GetNumIterations());
+
+   // Discard the recycle space
+   dcg.ResetRecycleSpace();
+   REQUIRE(dcg.GetRecycleDim() == 0);
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel PipelinedCGSolver", "[Parallel], [Krylov]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(8, 8, Element::QUADRILATERAL);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   mesh.Clear();
+   H1_FECollection fec(2, 2);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+
+   Array<int> ess_tdof_list;
+   fes.GetBoundaryTrueDofs(ess_tdof_list);
+   ParBilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   ConstantCoefficient one(1.0);
+   ParLinearForm f(&fes);
+   f.AddDomainIntegrator(new DomainLFIntegrator(one));
+   f.Assemble();
+   ParGridFunction u(&fes);
+   u = 0.0;
+
+   HypreParMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, u, f, A, X, B);
+   HypreSmoother prec(A, HypreSmoother::Jacobi);
+
+   CGSolver cg(MPI_COMM_WORLD);
+   PipelinedCGSolver pcg(MPI_COMM_WORLD);
+   GMRESSolver gmres(MPI_COMM_WORLD);
+   gmres.SetSingleReduction();
+   IterativeSolver *solvers[3] = { &cg, &pcg, &gmres };
+   Vector x[3];
+   for (int i = 0; i < 3; i++)
+   {
+      solvers[i]->SetRelTol(1e-10);
+      solvers[i]->SetMaxIter(500);
+      solvers[i]->SetOperator(A);
+      solvers[i]->SetPreconditioner(prec);
+      x[i].SetSize(B.Size());
+      x[i] = 0.0;
+      solvers[i]->Mult(B, x[i]);
+      REQUIRE(solvers[i]->GetConverged());
+   }
+   REQUIRE(std::abs(pcg.GetNumIterations() - cg.GetNumIterations()) <= 2);
+   for (int i = 1; i < 3; i++)
+   {
+      x[i] -= x[0];
+      REQUIRE(InnerProduct(MPI_COMM_WORLD, x[i], x[i]) <
+              1e-14 * InnerProduct(MPI_COMM_WORLD, x[0], x[0]));
+   }
+}
+
+#endif // MFEM_USE_MPI
@@ -443,6 +443,64 @@ TEST_CASE("DenseTensor LinearSolve methods",
    }
 }
 
+TEST_CASE("DenseTensor batched products", "[DenseMatrix][CUDA]")
+{
+   auto backend = GENERATE(BatchedLinAlg::NATIVE,
+                           BatchedLinAlg::GPU_BLAS,
+                           BatchedLinAlg::MAGMA);
+   // Skip unavailable backends
+   if (!BatchedLinAlg::IsAvailable(backend)) { return; }
+   CAPTURE(backend);
+
+   // Sizes which are not multiples of the blocking of the native kernels
+   const int m = 7;
+   const int n = 6;
+   const int n_mat = 3;
+   const int n_rhs = 2;
+
+   DenseTensor A_batch(m, n, n_mat);
+   Vector x_batch(n * n_rhs * n_mat), xt_batch(m * n_rhs * n_mat);
+   Vector y_batch(m * n_rhs * n_mat), yt_batch(n * n_rhs * n_mat);
+   A_batch.HostWrite();
+   for (int i = 0; i < A_batch.TotalSize(); i++)
+   {
+      A_batch.Data()[i] = std::sin(1.0 + i);
+   }
+   x_batch.Randomize(1);
+   xt_batch.Randomize(2);
+   y_batch.Randomize(3);
+   yt_batch.Randomize(4);
+   const Vector y0(y_batch), yt0(yt_batch);
+
+   BatchedLinAlg::Get(backend).AddMult(A_batch, x_batch, y_batch, 1.5, 0.5);
+   BatchedLinAlg::Get(backend).AddMultTranspose(A_batch, xt_batch, yt_batch,
+                                                 1.5, 0.5);
+   y_batch.HostRead();
+   yt_batch.HostRead();
+   for (int i = 0; i < n_mat; ++i)
+   {
+      const DenseMatrix &A = A_batch(i);
+      for (int j = 0; j < n_rhs; ++j)
+      {
+         Vector x(x_batch.GetData() + (j + i*n_rhs)*n, n);
+         Vector xt(xt_batch.GetData() + (j + i*n_rhs)*m, m);
+         Vector y(m), yt(n);
+         A.Mult(x, y);
+         A.MultTranspose(xt, yt);
+         for (int k = 0; k < m; ++k)
+         {
+            const int idx = k + (j + i*n_rhs)*m;
+            REQUIRE(y_batch[idx] == MFEM_Approx(1.5*y(k) + 0.5*y0[idx]));
+         }
+         for (int k = 0; k < n; ++k)
+         {
+            const int idx = k + (j + i*n_rhs)*n;
+            REQUIRE(yt_batch[idx] == MFEM_Approx(1.5*yt(k) + 0.5*yt0[idx]));
+         }
+      }
+   }
+}
+
 TEST_CASE("DenseTensor copy", "[DenseMatrix][DenseTensor]")
 {
    DenseTensor t1(2,3,4);
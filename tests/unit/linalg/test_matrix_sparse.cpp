@@ -240,4 +240,423 @@ TEST_CASE("SparseMatrix printing", "[SparseMatrix]")
    }
 }
 
+TEST_CASE("SparseMatrix blocked storage", "[SparseMatrix]")
+{
+   const int order = GENERATE(1, 2);
+   CAPTURE(order);
+
+   Mesh mesh = Mesh::MakeCartesian3D(2, 2, 1, Element::HEXAHEDRON);
+   H1_FECollection fec(order, mesh.Dimension());
+
+   SECTION("Elasticity, byVDIM")
+   {
+      FiniteElementSpace fes(&mesh, &fec, mesh.Dimension(), Ordering::byVDIM);
+      BilinearForm a(&fes);
+      ConstantCoefficient lambda(1.0), mu(1.0);
+      a.AddDomainIntegrator(new ElasticityIntegrator(lambda, mu));
+      a.Assemble();
+      a.Finalize();
+      SparseMatrix &A = a.SpMat();
+
+      const int n = A.Height();
+      Vector x(n), y(n), y_ref(n);
+      x.Randomize(1);
+
+      A.Mult(x, y_ref);
+      REQUIRE(A.GetBlockedStorageSize() == 1);
+      REQUIRE(A.BuildBlockedStorage() == 3);
+      REQUIRE(A.GetBlockedStorageSize() == 3);
+      A.Mult(x, y);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+      A.ResetBlockedStorage();
+      A.MultTranspose(x, y_ref);
+      A.BuildBlockedStorage();
+      A.MultTranspose(x, y);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+      // The copy follows the matrix in Swap()
+      SparseMatrix B;
+      B.Swap(A);
+      REQUIRE(B.GetBlockedStorageSize() == 3);
+      REQUIRE(A.GetBlockedStorageSize() == 1);
+      B.Swap(A);
+   }
+
+   SECTION("Scalar problem, forced block size")
+   {
+      FiniteElementSpace fes(&mesh, &fec);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator);
+      a.Assemble();
+      a.Finalize();
+      SparseMatrix &A = a.SpMat();
+
+      // The diffusion matrix has no block structure
+      const int n = A.Height();
+      REQUIRE(A.BuildBlockedStorage() == 1);
+
+      // 18 dofs for order 1, 75 dofs for order 2
+      const int b = (n % 2 == 0) ? 2 : 3;
+      REQUIRE(n % b == 0);
+      REQUIRE(A.BuildBlockedStorage(b) == b);
+
+      Vector x(n), y(n), y_ref(n);
+      x.Randomize(2);
+      y_ref.Randomize(3);
+      y = y_ref;
+
+      A.AddMult(x, y, 0.5);
+      A.ResetBlockedStorage();
+      A.AddMult(x, y_ref, 0.5);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+      A.BuildBlockedStorage(b);
+      y = y_ref;
+      A.AddMultTranspose(x, y, -2.0);
+      A.ResetBlockedStorage();
+      A.AddMultTranspose(x, y_ref, -2.0);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   }
+}
+
+static void FillRandom(SparseMatrix &A, int nnz_row, unsigned seed)
+{
+   srand(seed);
+   for (int i = 0; i < A.Height(); i++)
+   {
+      for (int k = 0; k < nnz_row; k++)
+      {
+         A.Add(i, rand() % A.Width(), real_t(rand())/RAND_MAX - 0.5);
+      }
+   }
+   A.Finalize();
+}
+
+static real_t DenseDiff(const SparseMatrix &A, const DenseMatrix &B)
+{
+   DenseMatrix Ad;
+   A.ToDenseMatrix(Ad);
+   Ad -= B;
+   return Ad.MaxMaxNorm();
+}
+
+TEST_CASE("SparseMatrix products", "[SparseMatrix][OMP]")
+{
+   SparseMatrix A(20, 15), B(15, 25), M(15, 15), P(15, 10);
+   FillRandom(A, 4, 1);
+   FillRandom(B, 3, 2);
+   FillRandom(M, 5, 3);
+   FillRandom(P, 2, 4);
+
+   DenseMatrix Ad, Bd, Md, Pd, Rd, MPd(15, 10), RAPd(10), ABd(20, 25);
+   A.ToDenseMatrix(Ad);
+   B.ToDenseMatrix(Bd);
+   M.ToDenseMatrix(Md);
+   P.ToDenseMatrix(Pd);
+   Rd.Transpose(Pd);
+   mfem::Mult(Ad, Bd, ABd);
+   mfem::Mult(Md, Pd, MPd);
+   mfem::Mult(Rd, MPd, RAPd);
+
+   SECTION("Mult")
+   {
+      SparseMatrix *AB = Mult(A, B);
+      REQUIRE(DenseDiff(*AB, ABd) == MFEM_Approx(0.0));
+
+      // Reuse the pattern with new values
+      A *= 2.0;
+      ABd *= 2.0;
+      REQUIRE(Mult(A, B, AB) == AB);
+      REQUIRE(DenseDiff(*AB, ABd) == MFEM_Approx(0.0));
+
+      // The reused pattern does not need to be in the order of the result
+      AB->SortColumnIndices();
+      Mult(A, B, AB);
+      REQUIRE(DenseDiff(*AB, ABd) == MFEM_Approx(0.0));
+      delete AB;
+   }
+
+   SECTION("RAP")
+   {
+      SparseMatrix *R = Transpose(P);
+      SparseMatrix *RMP = RAP(M, *R);
+      REQUIRE(DenseDiff(*RMP, RAPd) == MFEM_Approx(0.0));
+      SparseMatrix *RMP2 = RAP(P, M, P);
+      REQUIRE(DenseDiff(*RMP2, RAPd) == MFEM_Approx(0.0));
+
+      M *= -3.0;
+      RAPd *= -3.0;
+      RAP(M, *R, RMP);
+      REQUIRE(DenseDiff(*RMP, RAPd) == MFEM_Approx(0.0));
+      RAP(P, M, P, RMP2);
+      REQUIRE(DenseDiff(*RMP2, RAPd) == MFEM_Approx(0.0));
+      delete RMP2;
+      delete RMP;
+      delete R;
+   }
+
+   SECTION("Add")
+   {
+      SparseMatrix *MM = Mult(M, M);
+      DenseMatrix MMd(15);
+      mfem::Mult(Md, Md, MMd);
+
+      SparseMatrix *C = Add(2.0, M, -1.0, *MM);
+      DenseMatrix Cd(MMd);
+      Cd.Add(-2.0, Md);
+      Cd.Neg();
+      REQUIRE(DenseDiff(*C, Cd) == MFEM_Approx(0.0));
+
+      // Reuse the pattern with new coefficients
+      Add(0.5, M, 3.0, *MM, C);
+      Cd = 0.0;
+      Cd.Add(0.5, Md);
+      Cd.Add(3.0, MMd);
+      REQUIRE(DenseDiff(*C, Cd) == MFEM_Approx(0.0));
+      delete C;
+      delete MM;
+   }
+}
+
+TEST_CASE("SparseMatrix irregular rows", "[SparseMatrix][OMP]")
+{
+   // Rows with 0 to 40 nonzeros, such that the parts of the merge-path
+   // partition used with the OpenMP backend end in the middle of the rows
+   const int m = 57, n = 43;
+   SparseMatrix A(m, n);
+   srand(5);
+   for (int i = 0; i < m; i++)
+   {
+      const int nnz_row = (i % 11 == 0) ? 40 : (i % 3);
+      for (int k = 0; k < nnz_row; k++)
+      {
+         A.Add(i, (i + 7*k) % n, real_t(rand())/RAND_MAX - 0.5);
+      }
+   }
+   A.Finalize();
+
+   DenseMatrix Ad;
+   A.ToDenseMatrix(Ad);
+
+   Vector x(n), y(m), y_ref(m), xt(m), yt(n), yt_ref(n);
+   x.Randomize(1);
+   xt.Randomize(2);
+   Ad.Mult(x, y_ref);
+   Ad.MultTranspose(xt, yt_ref);
+
+   for (int it = 0; it < 2; it++)
+   {
+      A.Mult(x, y);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+      A.MultTranspose(xt, yt);
+      yt -= yt_ref;
+      REQUIRE(yt.Normlinf() == MFEM_Approx(0.0));
+
+      // Sorting the columns does not change the products
+      A.SortColumnIndices();
+   }
+
+   y = y_ref;
+   A.AddMult(x, y, -1.0);
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   yt = yt_ref;
+   A.AddMultTranspose(xt, yt, -1.0);
+   REQUIRE(yt.Normlinf() == MFEM_Approx(0.0));
+}
+
+// Products and sweeps computed row by row on the host, as in the serial path
+static void CSRMults(const SparseMatrix &A, const Vector &x, const Vector &xt,
+                     Vector &y, Vector &yt)
+{
+   const int *I = A.HostReadI(), *J = A.HostReadJ();
+   const real_t *V = A.HostReadData();
+   y.SetSize(A.Height());
+   yt.SetSize(A.Width());
+   y = 0.0;
+   yt = 0.0;
+   for (int i = 0; i < A.Height(); i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         y[i] += V[k]*x[J[k]];
+         yt[J[k]] += V[k]*xt[i];
+      }
+   }
+}
+
+static void CSRGaussSeidel(const SparseMatrix &A, const Vector &x, Vector &y,
+                           const bool forward)
+{
+   const int *I = A.HostReadI(), *J = A.HostReadJ();
+   const real_t *V = A.HostReadData();
+   const int n = A.Height();
+   for (int r = 0; r < n; r++)
+   {
+      const int i = forward ? r : n-1-r;
+      real_t sum = x[i], diag = 0.0;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (J[k] == i) { diag = V[k]; }
+         else { sum -= V[k]*y[J[k]]; }
+      }
+      y[i] = sum/diag;
+   }
+}
+
+TEST_CASE("SparseMatrix pattern changes", "[SparseMatrix][OMP]")
+{
+   // With the OpenMP backend, the products and the Gauss-Seidel sweeps use the
+   // merge-path partition and the level schedules built from the pattern; they
+   // have to follow the changes of the pattern.
+   const int n = 150;
+   SparseMatrix A(n, n);
+   srand(11);
+   for (int i = 0; i < n; i++)
+   {
+      A.Add(i, i, 10.0);
+      const int nnz_row = (i % 13 == 0) ? 30 : (i % 4);
+      for (int k = 0; k < nnz_row; k++)
+      {
+         A.Add(i, rand() % n, real_t(rand())/RAND_MAX - 0.5);
+      }
+   }
+   A.Finalize();
+
+   Vector x(n), xt(n), y(n), yt(n), y_ref, yt_ref, z(n), z_ref(n);
+   x.Randomize(1);
+   xt.Randomize(2);
+   z.Randomize(3);
+   const Vector z0(z);
+
+   auto check = [&]()
+   {
+      CSRMults(A, x, xt, y_ref, yt_ref);
+      A.Mult(x, y);
+      A.MultTranspose(xt, yt);
+      y -= y_ref;
+      yt -= yt_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+      REQUIRE(yt.Normlinf() == MFEM_Approx(0.0));
+
+      z = z0;
+      z_ref = z0;
+      A.Gauss_Seidel_forw(x, z);
+      A.Gauss_Seidel_back(x, z);
+      CSRGaussSeidel(A, x, z_ref, true);
+      CSRGaussSeidel(A, x, z_ref, false);
+      z -= z_ref;
+      REQUIRE(z.Normlinf() == MFEM_Approx(0.0));
+   };
+   check();
+
+   SECTION("Sorted columns")
+   {
+      A.SortColumnIndices();
+      check();
+      A.MoveDiagonalFirst();
+      check();
+   }
+
+   SECTION("Modified columns")
+   {
+      // Move the off-diagonal entries of every third row to new columns,
+      // keeping the number of nonzeros and the arrays
+      int *I = A.GetI(), *J = A.GetJ();
+      for (int i = 0; i < n; i += 3)
+      {
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            const int c = (J[k] + n/2) % n;
+            if (J[k] != i && c != i) { J[k] = c; }
+         }
+      }
+      A.ResetTranspose();
+      check();
+   }
+
+   SECTION("Threshold")
+   {
+      A.Threshold(0.25);
+      check();
+   }
+}
+
+TEST_CASE("SparseMatrix level schedule", "[SparseMatrix][OMP]")
+{
+   // Unsymmetric pattern with a nonzero diagonal and rows of varying length
+   const int n = 200;
+   SparseMatrix A(n, n);
+   srand(7);
+   for (int i = 0; i < n; i++)
+   {
+      A.Add(i, i, 10.0);
+      const int nnz_row = i % 5;
+      for (int k = 0; k < nnz_row; k++)
+      {
+         A.Add(i, rand() % n, real_t(rand())/RAND_MAX - 0.5);
+      }
+   }
+   A.Finalize();
+   const int *I = A.GetI(), *J = A.GetJ();
+
+   for (const bool lower : {true, false})
+   {
+      Array<int> level_ptr, level_rows, level(n);
+      CSRLevelSchedule(n, I, J, lower, level_ptr, level_rows);
+      REQUIRE(level_ptr[0] == 0);
+      REQUIRE(level_ptr.Last() == n);
+      level = -1;
+      for (int l = 0; l + 1 < level_ptr.Size(); l++)
+      {
+         for (int r = level_ptr[l]; r < level_ptr[l+1]; r++)
+         {
+            REQUIRE(level[level_rows[r]] == -1);
+            level[level_rows[r]] = l;
+         }
+      }
+      // Each row depends only on rows of lower levels
+      for (int i = 0; i < n; i++)
+      {
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            const int c = J[k];
+            if (lower ? c < i : c > i) { REQUIRE(level[c] < level[i]); }
+         }
+      }
+   }
+
+   // Reference sweeps on the dense matrix
+   DenseMatrix Ad;
+   A.ToDenseMatrix(Ad);
+   Vector x(n), y(n), y_ref(n);
+   x.Randomize(1);
+   y.Randomize(2);
+   y_ref = y;
+   for (int i = 0; i < n; i++)
+   {
+      real_t sum = 0.0;
+      for (int j = 0; j < n; j++) { if (j != i) { sum += Ad(i,j)*y_ref[j]; } }
+      y_ref[i] = (x[i] - sum) / Ad(i,i);
+   }
+   for (int i = n-1; i >= 0; i--)
+   {
+      real_t sum = 0.0;
+      for (int j = 0; j < n; j++) { if (j != i) { sum += Ad(i,j)*y_ref[j]; } }
+      y_ref[i] = (x[i] - sum) / Ad(i,i);
+   }
+
+   A.BuildLevelSchedule();
+   A.Gauss_Seidel_forw(x, y);
+   A.Gauss_Seidel_back(x, y);
+   y -= y_ref;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+}
+
 } // namespace mfem
@@ -239,3 +239,57 @@ TEST_CASE("Vector Sum", "[Vector],[CUDA]")
 
    REQUIRE(sum_1 == MFEM_Approx(sum_2));
 }
+
+TEST_CASE("Vector fused kernels", "[Vector],[CUDA]")
+{
+   const int n = 11, N = 1000;
+   Vector y(N), y_ref(N), x(N);
+   y.Randomize(1);
+   x.Randomize(2);
+   Vector v[n];
+   const Vector *vp[n];
+   real_t a[n];
+   for (int k = 0; k < n; k++)
+   {
+      v[k].SetSize(N);
+      v[k].Randomize(k + 3);
+      vp[k] = &v[k];
+      a[k] = 0.1*(k + 1);
+   }
+   y.UseDevice(true);
+   y_ref = y;
+
+   SECTION("AddDot")
+   {
+      Vector work;
+      const real_t dot_x = y.AddDot(-0.5, x, x, work);
+      y_ref.Add(-0.5, x);
+      REQUIRE(dot_x == MFEM_Approx(y_ref * x));
+      // The inner product with the updated vector itself
+      const real_t dot_y = y.AddDot(2.0, x, y, work);
+      y_ref.Add(2.0, x);
+      REQUIRE(dot_y == MFEM_Approx(y_ref * y_ref));
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   }
+
+   SECTION("MultiDot")
+   {
+      real_t dots[n];
+      Vector work;
+      vp[n - 1] = &y;
+      y.MultiDot(n, vp, dots, work);
+      for (int k = 0; k < n; k++)
+      {
+         REQUIRE(dots[k] == MFEM_Approx(*vp[k] * y_ref));
+      }
+   }
+
+   SECTION("MultiAdd")
+   {
+      y.MultiAdd(n, a, vp);
+      for (int k = 0; k < n; k++) { y_ref.Add(a[k], v[k]); }
+      y -= y_ref;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   }
+}
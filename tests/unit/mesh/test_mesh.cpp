@@ -180,3 +180,377 @@ TEST_CASE("MakeSimplicial", "[Mesh]")
    // on the original mesh, but it doesn't happen for these test cases.
    REQUIRE(simplex_mesh.GetNE() == orig_mesh.GetNE()*factor);
 }
+
+TEST_CASE("Contiguous element storage", "[Mesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+   const int ne = mesh.GetNE();
+
+   // The elements are constructed next to each other, in order
+   for (int i = 1; i < ne; i++)
+   {
+      const char *prev = reinterpret_cast<const char*>(mesh.GetElement(i-1));
+      const char *curr = reinterpret_cast<const char*>(mesh.GetElement(i));
+      REQUIRE(curr - prev == (std::ptrdiff_t) sizeof(Hexahedron));
+   }
+
+   SECTION("Copy, move and swap")
+   {
+      Mesh copy(mesh);
+      REQUIRE(copy.GetNE() == ne);
+      REQUIRE(copy.GetElement(0) != mesh.GetElement(0));
+      for (int i = 0; i < ne; i++)
+      {
+         Array<int> v1, v2;
+         mesh.GetElementVertices(i, v1);
+         copy.GetElementVertices(i, v2);
+         REQUIRE(v1.Size() == v2.Size());
+         for (int j = 0; j < v1.Size(); j++) { REQUIRE(v1[j] == v2[j]); }
+      }
+
+      const Element *el0 = copy.GetElement(0);
+      Mesh moved(std::move(copy));
+      REQUIRE(moved.GetElement(0) == el0);
+
+      Mesh other = Mesh::MakeCartesian2D(2, 2, Element::TRIANGLE);
+      other.Swap(moved, true);
+      REQUIRE(other.GetElement(0) == el0);
+      REQUIRE(moved.GetNE() == 8);
+      REQUIRE(other.GetNE() == ne);
+   }
+
+   SECTION("Mixed with heap elements")
+   {
+      Mesh mixed(2, 6, 2);
+      for (int i = 0; i < 6; i++) { mixed.AddVertex(i % 3, i / 3); }
+      const int v0[4] = {0, 1, 4, 3};
+      mixed.AddQuad(v0, 1);
+      Element *el = mixed.NewElement(Geometry::SQUARE);
+      const int v1[4] = {1, 2, 5, 4};
+      el->SetVertices(v1);
+      el->SetAttribute(2);
+      mixed.AddElement(el);
+      mixed.FinalizeTopology();
+      REQUIRE(mixed.GetNE() == 2);
+      REQUIRE(mixed.GetNumFaces() == 7);
+      REQUIRE(mixed.GetAttribute(1) == 2);
+
+      // Refinement frees the coarse elements, reusing their storage
+      mixed.UniformRefinement();
+      REQUIRE(mixed.GetNE() == 8);
+   }
+
+   SECTION("Generated meshes")
+   {
+      // The 1D and 2D Cartesian meshes are also built in the element storage
+      auto contiguous = [](const Mesh &m, std::ptrdiff_t size)
+      {
+         for (int i = 1; i < m.GetNE(); i++)
+         {
+            const char *prev = reinterpret_cast<const char*>(m.GetElement(i-1));
+            const char *curr = reinterpret_cast<const char*>(m.GetElement(i));
+            if (curr - prev != size) { return false; }
+         }
+         return true;
+      };
+      Mesh sfc_quads = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL);
+      REQUIRE(contiguous(sfc_quads, sizeof(Quadrilateral)));
+      Mesh quads = Mesh::MakeCartesian2D(3, 3, Element::QUADRILATERAL,
+                                         false, 1.0, 1.0, false);
+      REQUIRE(contiguous(quads, sizeof(Quadrilateral)));
+      Mesh tris = Mesh::MakeCartesian2D(3, 3, Element::TRIANGLE);
+      REQUIRE(contiguous(tris, sizeof(Triangle)));
+      Mesh segments = Mesh::MakeCartesian1D(5);
+      REQUIRE(contiguous(segments, sizeof(Segment)));
+   }
+
+   SECTION("Duplicate")
+   {
+      // Element::Duplicate() allocates with new, the copy belongs to the caller
+      Element *dup = mesh.GetElement(0)->Duplicate(&mesh);
+      REQUIRE(dup->GetGeometryType() == Geometry::CUBE);
+      delete dup;
+
+      // The copy in the element storage keeps the refinement flag of tets
+      Mesh tets = Mesh::MakeCartesian3D(1, 1, 1, Element::TETRAHEDRON);
+      Tetrahedron *tet = static_cast<Tetrahedron*>(tets.GetElement(0));
+      tet->SetRefinementFlag(5);
+      Mesh single(3, tets.GetNV(), 1);
+      for (int i = 0; i < tets.GetNV(); i++)
+      {
+         single.AddVertex(tets.GetVertex(i));
+      }
+      Element *copy = single.AllocElement(*tet);
+      single.AddElement(copy);
+      REQUIRE(copy->GetAttribute() == tet->GetAttribute());
+      REQUIRE(static_cast<Tetrahedron*>(copy)->GetRefinementFlag() == 5);
+   }
+
+   SECTION("Conforming refinement")
+   {
+      // Uniform refinement and bisection construct the new elements in the
+      // element storage
+      for (Element::Type type : {Element::TETRAHEDRON, Element::WEDGE})
+      {
+         Mesh m = Mesh::MakeCartesian3D(2, 2, 2, type);
+         const int ne0 = m.GetNE(), nbe0 = m.GetNBE();
+         m.UniformRefinement();
+         REQUIRE(m.GetNE() == 8*ne0);
+         REQUIRE(m.GetNBE() == 4*nbe0);
+         Mesh copy(m);
+         REQUIRE(copy.GetNE() == m.GetNE());
+      }
+
+      Mesh tris = Mesh::MakeCartesian2D(2, 2, Element::TRIANGLE);
+      tris.Finalize(true);
+      Array<int> marked(1);
+      marked[0] = 0;
+      const int ne0 = tris.GetNE();
+      tris.GeneralRefinement(marked, 0);
+      REQUIRE(tris.GetNE() > ne0);
+      REQUIRE(tris.Conforming());
+   }
+
+   SECTION("Refinement")
+   {
+      mesh.EnsureNCMesh();
+      mesh.UniformRefinement();
+      REQUIRE(mesh.GetNE() == 8*ne);
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         REQUIRE(mesh.GetElement(i)->GetGeometryType() == Geometry::CUBE);
+      }
+      mesh.UniformRefinement();
+      REQUIRE(mesh.GetNE() == 64*ne);
+   }
+}
+
+static void CompareTopology(Mesh &ref, Mesh &mesh)
+{
+   REQUIRE(mesh.GetNE() == ref.GetNE());
+   REQUIRE(mesh.GetNEdges() == ref.GetNEdges());
+   REQUIRE(mesh.GetNumFaces() == ref.GetNumFaces());
+   REQUIRE(mesh.GetNBE() == ref.GetNBE());
+
+   auto same = [](const Array<int> &a, const Array<int> &b)
+   {
+      if (a.Size() != b.Size()) { return false; }
+      for (int i = 0; i < a.Size(); i++)
+      {
+         if (a[i] != b[i]) { return false; }
+      }
+      return true;
+   };
+
+   Array<int> a1, a2, o1, o2;
+   for (int i = 0; i < ref.GetNE(); i++)
+   {
+      ref.GetElementEdges(i, a1, o1);
+      mesh.GetElementEdges(i, a2, o2);
+      REQUIRE(same(a1, a2));
+      REQUIRE(same(o1, o2));
+      if (ref.Dimension() == 3)
+      {
+         ref.GetElementFaces(i, a1, o1);
+         mesh.GetElementFaces(i, a2, o2);
+         REQUIRE(same(a1, a2));
+         REQUIRE(same(o1, o2));
+      }
+   }
+   for (int i = 0; i < ref.GetNBE(); i++)
+   {
+      REQUIRE(mesh.GetBdrElementFaceIndex(i) == ref.GetBdrElementFaceIndex(i));
+      if (ref.Dimension() == 3)
+      {
+         ref.GetBdrElementEdges(i, a1, o1);
+         mesh.GetBdrElementEdges(i, a2, o2);
+         REQUIRE(same(a1, a2));
+         REQUIRE(same(o1, o2));
+      }
+   }
+   for (int f = 0; f < ref.GetNumFaces(); f++)
+   {
+      int r1, r2, m1, m2, nc1, nc2;
+      ref.GetFaceElements(f, &r1, &r2);
+      mesh.GetFaceElements(f, &m1, &m2);
+      REQUIRE(m1 == r1);
+      REQUIRE(m2 == r2);
+      ref.GetFaceInfos(f, &r1, &r2, &nc1);
+      mesh.GetFaceInfos(f, &m1, &m2, &nc2);
+      REQUIRE(m1 == r1);
+      REQUIRE(m2 == r2);
+      REQUIRE(nc2 == nc1);
+      ref.GetFaceVertices(f, a1);
+      mesh.GetFaceVertices(f, a2);
+      REQUIRE(same(a1, a2));
+   }
+}
+
+TEST_CASE("Sort-based topology construction", "[Mesh]")
+{
+   auto fname = GENERATE("../../data/star-mixed.mesh",
+                         "../../data/square-disc.mesh",
+                         "../../data/mobius-strip.mesh",
+                         "../../data/fichera-mixed.mesh",
+                         "../../data/escher.mesh",
+                         "../../data/beam-wedge.mesh",
+                         "../../data/inline-pyramid.mesh",
+                         "../../data/amr-hex.mesh");
+   CAPTURE(fname);
+
+   // Restore the global setting also when a REQUIRE fails
+   struct SortBasedGuard
+   {
+      const bool sort_based = Mesh::sort_based_topology;
+      ~SortBasedGuard() { Mesh::sort_based_topology = sort_based; }
+   } guard;
+
+   Mesh::sort_based_topology = false;
+   Mesh ref(fname, 1, 1);
+   Mesh::sort_based_topology = true;
+   Mesh mesh(fname, 1, 1);
+   CompareTopology(ref, mesh);
+
+   // Refinement rebuilds the tables
+   Mesh::sort_based_topology = false;
+   ref.UniformRefinement();
+   Mesh::sort_based_topology = true;
+   mesh.UniformRefinement();
+   CompareTopology(ref, mesh);
+}
+
+static void CompareElements(const Element *el1, const Element *el2)
+{
+   REQUIRE(el1->GetGeometryType() == el2->GetGeometryType());
+   REQUIRE(el1->GetAttribute() == el2->GetAttribute());
+   REQUIRE(el1->GetNVertices() == el2->GetNVertices());
+   for (int j = 0; j < el1->GetNVertices(); j++)
+   {
+      REQUIRE(el1->GetVertices()[j] == el2->GetVertices()[j]);
+   }
+}
+
+TEST_CASE("Binary mesh format", "[Mesh]")
+{
+   auto fname = GENERATE("../../data/star-mixed.mesh",
+                         "../../data/inline-pyramid.mesh",
+                         "../../data/square-disc-p2.mesh",
+                         "../../data/fichera-mixed-p2.mesh",
+                         "../../data/escher-p2.mesh",
+                         "../../data/beam-wedge.mesh",
+                         "../../data/amr-quad.mesh",
+                         "../../data/fichera-amr.mesh");
+   CAPTURE(fname);
+
+   Mesh ref(fname, 1, 1);
+   const int dim = ref.Dimension(), sdim = ref.SpaceDimension();
+   Array<int> vdofs, ref_vdofs;
+   Vector vals, ref_vals;
+
+   SECTION("Stream round trip")
+   {
+      ref.attribute_sets.SetAttributeSet("All elements", ref.attributes);
+      ref.bdr_attribute_sets.SetAttributeSet("All boundary", ref.bdr_attributes);
+
+      std::stringstream ss;
+      ref.PrintBinary(ss);
+      Mesh mesh(ss, 1, 1);
+
+      REQUIRE(mesh.Dimension() == dim);
+      REQUIRE(mesh.SpaceDimension() == sdim);
+      REQUIRE(mesh.Nonconforming() == ref.Nonconforming());
+      REQUIRE(mesh.GetNV() == ref.GetNV());
+      REQUIRE(mesh.GetNE() == ref.GetNE());
+      REQUIRE(mesh.GetNBE() == ref.GetNBE());
+      for (int i = 0; i < ref.GetNE(); i++)
+      {
+         CompareElements(mesh.GetElement(i), ref.GetElement(i));
+      }
+      for (int i = 0; i < ref.GetNBE(); i++)
+      {
+         CompareElements(mesh.GetBdrElement(i), ref.GetBdrElement(i));
+      }
+      for (int i = 0; i < ref.GetNV(); i++)
+      {
+         for (int d = 0; d < sdim; d++)
+         {
+            REQUIRE(mesh.GetVertex(i)[d] == ref.GetVertex(i)[d]);
+         }
+      }
+      REQUIRE((mesh.GetNodes() != nullptr) == (ref.GetNodes() != nullptr));
+      if (ref.GetNodes())
+      {
+         REQUIRE(mesh.GetNodes()->Size() == ref.GetNodes()->Size());
+         Vector diff(*mesh.GetNodes());
+         diff -= *ref.GetNodes();
+         REQUIRE(diff.Normlinf() == 0.0);
+      }
+      REQUIRE(mesh.attribute_sets.GetAttributeSetNames() ==
+              ref.attribute_sets.GetAttributeSetNames());
+      for (const std::string &name : ref.attribute_sets.GetAttributeSetNames())
+      {
+         const Array<int> &set = mesh.attribute_sets.GetAttributeSet(name);
+         const Array<int> &ref_set = ref.attribute_sets.GetAttributeSet(name);
+         REQUIRE(set.Size() == ref_set.Size());
+         for (int j = 0; j < set.Size(); j++) { REQUIRE(set[j] == ref_set[j]); }
+      }
+      REQUIRE(mesh.bdr_attribute_sets.GetAttributeSetNames() ==
+              ref.bdr_attribute_sets.GetAttributeSetNames());
+   }
+
+   SECTION("Partitioned read")
+   {
+      if (ref.Nonconforming()) { return; }
+
+      const std::string binary_fname = "binary_mesh_test.mesh";
+      ref.SaveBinary(binary_fname);
+
+      Mesh whole = Mesh::LoadFromBinaryFile(binary_fname);
+      REQUIRE(whole.GetNE() == ref.GetNE());
+      REQUIRE(whole.GetNBE() == ref.GetNBE());
+      REQUIRE(whole.GetNV() == ref.GetNV());
+
+      const int num_parts = 3;
+      int ne = 0, nbe = 0;
+      for (int part = 0; part < num_parts; part++)
+      {
+         Mesh mesh = Mesh::LoadFromBinaryFile(binary_fname, part, num_parts);
+         REQUIRE(mesh.Dimension() == dim);
+         REQUIRE(mesh.SpaceDimension() == sdim);
+         const int e_begin = ref.GetNE()*part/num_parts;
+         REQUIRE(mesh.GetNE() == ref.GetNE()*(part+1)/num_parts - e_begin);
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            const Element *el = mesh.GetElement(i);
+            const Element *ref_el = ref.GetElement(e_begin + i);
+            REQUIRE(el->GetGeometryType() == ref_el->GetGeometryType());
+            REQUIRE(el->GetAttribute() == ref_el->GetAttribute());
+            for (int j = 0; j < el->GetNVertices(); j++)
+            {
+               const real_t *v = mesh.GetVertex(el->GetVertices()[j]);
+               const real_t *ref_v = ref.GetVertex(ref_el->GetVertices()[j]);
+               for (int d = 0; d < sdim; d++)
+               {
+                  REQUIRE(v[d] == MFEM_Approx(ref_v[d]));
+               }
+            }
+            if (ref.GetNodes())
+            {
+               mesh.GetNodes()->FESpace()->GetElementVDofs(i, vdofs);
+               ref.GetNodes()->FESpace()->GetElementVDofs(e_begin + i,
+                                                           ref_vdofs);
+               mesh.GetNodes()->GetSubVector(vdofs, vals);
+               ref.GetNodes()->GetSubVector(ref_vdofs, ref_vals);
+               vals -= ref_vals;
+               REQUIRE(vals.Normlinf() == 0.0);
+            }
+         }
+         ne += mesh.GetNE();
+         nbe += mesh.GetNBE();
+      }
+      REQUIRE(ne == ref.GetNE());
+      REQUIRE(nbe == ref.GetNBE());
+
+      REQUIRE(std::remove(binary_fname.c_str()) == 0);
+   }
+}
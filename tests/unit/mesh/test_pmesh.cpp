@@ -11,6 +11,9 @@
 
 #include "mfem.hpp"
 #include "unit_tests.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
 
 namespace mfem
 {
@@ -191,6 +194,210 @@ TEST_CASE("ParMeshMakeSimplicial", "[Parallel], [ParMesh]")
    REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
 }
 
+// Compare the local parts of two parallel meshes with the same partitioning
+// and the same local element order, allowing for different local vertex
+// numbers and a different order of the vertices within the elements.
+static void CompareParMeshes(ParMesh &pmesh, ParMesh &ref)
+{
+   REQUIRE(pmesh.GetNE() == ref.GetNE());
+   REQUIRE(pmesh.GetNBE() == ref.GetNBE());
+   REQUIRE(pmesh.GetNV() == ref.GetNV());
+   REQUIRE(pmesh.GetNSharedFaces() == ref.GetNSharedFaces());
+   REQUIRE(pmesh.GetNGroups() == ref.GetNGroups());
+
+   int nsvert = 0, nsedge = 0, ref_nsvert = 0, ref_nsedge = 0;
+   for (int g = 1; g < pmesh.GetNGroups(); g++)
+   {
+      nsvert += pmesh.GroupNVertices(g);
+      nsedge += pmesh.GroupNEdges(g);
+      ref_nsvert += ref.GroupNVertices(g);
+      ref_nsedge += ref.GroupNEdges(g);
+   }
+   REQUIRE(nsvert == ref_nsvert);
+   REQUIRE(nsedge == ref_nsedge);
+
+   const int sdim = ref.SpaceDimension();
+   std::vector<std::array<real_t,3>> verts, ref_verts;
+   auto get_verts = [sdim](Mesh &m, int e, std::vector<std::array<real_t,3>> &v)
+   {
+      const Element *el = m.GetElement(e);
+      v.assign(el->GetNVertices(), {0.0, 0.0, 0.0});
+      for (int j = 0; j < el->GetNVertices(); j++)
+      {
+         const real_t *x = m.GetVertex(el->GetVertices()[j]);
+         for (int d = 0; d < sdim; d++) { v[j][d] = x[d]; }
+      }
+      std::sort(v.begin(), v.end());
+   };
+   for (int e = 0; e < ref.GetNE(); e++)
+   {
+      REQUIRE(pmesh.GetElementGeometry(e) == ref.GetElementGeometry(e));
+      REQUIRE(pmesh.GetAttribute(e) == ref.GetAttribute(e));
+      get_verts(pmesh, e, verts);
+      get_verts(ref, e, ref_verts);
+      for (size_t j = 0; j < verts.size(); j++)
+      {
+         for (int d = 0; d < sdim; d++)
+         {
+            REQUIRE(verts[j][d] == MFEM_Approx(ref_verts[j][d]));
+         }
+      }
+   }
+
+   // The local true dofs are the shared dofs owned by the rank, so their
+   // numbers depend on the shared entities and on the groups they belong to.
+   H1_FECollection h1_fec(2, ref.Dimension());
+   ND_FECollection nd_fec(1, ref.Dimension());
+   ParFiniteElementSpace h1_pfes(&pmesh, &h1_fec), nd_pfes(&pmesh, &nd_fec);
+   ParFiniteElementSpace h1_ref(&ref, &h1_fec), nd_ref(&ref, &nd_fec);
+   REQUIRE(h1_pfes.GetVSize() == h1_ref.GetVSize());
+   REQUIRE(h1_pfes.GetTrueVSize() == h1_ref.GetTrueVSize());
+   REQUIRE(nd_pfes.GetTrueVSize() == nd_ref.GetTrueVSize());
+}
+
+TEST_CASE("ParMesh binary format", "[Parallel], [ParMesh]")
+{
+   // Read a binary mesh file with ParMesh::LoadFromBinaryFile and compare with
+   // the parallel mesh obtained by partitioning the serial mesh into the same
+   // contiguous ranges of elements, then write the parallel mesh with
+   // ParMesh::ParPrintBinary and read it back.
+   auto fname = GENERATE("../../data/star-mixed.mesh",
+                         "../../data/fichera-mixed-p2.mesh",
+                         "../../data/escher-p2.mesh",
+                         "../../data/beam-wedge.mesh",
+                         "../../data/inline-pyramid.mesh");
+   CAPTURE(fname);
+
+   int rank, nranks;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+
+   Mesh mesh(fname, 1, 1);
+   const std::string binary_fname = "binary_pmesh_test.mesh";
+   if (rank == 0) { mesh.SaveBinary(binary_fname); }
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   ParMesh pmesh = ParMesh::LoadFromBinaryFile(MPI_COMM_WORLD, binary_fname);
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (rank == 0) { REQUIRE(std::remove(binary_fname.c_str()) == 0); }
+
+   Array<int> partitioning(mesh.GetNE());
+   for (int r = 0; r < nranks; r++)
+   {
+      const int e_begin = mesh.GetNE()*r/nranks;
+      const int e_end = mesh.GetNE()*(r+1)/nranks;
+      for (int i = e_begin; i < e_end; i++) { partitioning[i] = r; }
+   }
+   ParMesh ref(MPI_COMM_WORLD, mesh, partitioning);
+
+   REQUIRE(pmesh.GetGlobalNE() == mesh.GetNE());
+   CompareParMeshes(pmesh, ref);
+
+   std::stringstream ss;
+   pmesh.ParPrintBinary(ss);
+   ParMesh pmesh2(MPI_COMM_WORLD, ss);
+   CompareParMeshes(pmesh2, pmesh);
+}
+
+TEST_CASE("ParMeshMakeCartesian", "[Parallel], [ParMesh]")
+{
+   // Compare the parallel Cartesian meshes generated locally on each rank with
+   // the serial meshes distributed with the same boxes of elements: the local
+   // elements, shared entities and true dofs must match, also after uniform
+   // refinement. Without the space-filling curve ordering, the elements within
+   // a box are in the same order in both meshes.
+   auto type = GENERATE(Element::QUADRILATERAL, Element::TRIANGLE,
+                        Element::HEXAHEDRON, Element::TETRAHEDRON);
+   CAPTURE(type);
+
+   const int nx = 7, ny = 5, nz = 4;
+   const real_t sx = 1.5, sy = 2.0, sz = 0.5;
+   const bool is_2d = (type == Element::QUADRILATERAL ||
+                       type == Element::TRIANGLE);
+   const int dim = is_2d ? 2 : 3;
+   Mesh mesh = is_2d ?
+               Mesh::MakeCartesian2D(nx, ny, type, false, sx, sy, false) :
+               Mesh::MakeCartesian3D(nx, ny, nz, type, sx, sy, sz, false);
+   ParMesh pmesh = is_2d ?
+                   ParMesh::MakeCartesian2D(MPI_COMM_WORLD, nx, ny, type,
+                                            sx, sy, false) :
+                   ParMesh::MakeCartesian3D(MPI_COMM_WORLD, nx, ny, nz, type,
+                                            sx, sy, sz, false);
+
+   // Find the box of each rank from the centers of its elements and assign the
+   // serial elements to the boxes containing their centers.
+   int nranks;
+   MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+   Vector box(2*dim), boxes(2*dim*nranks), center(dim);
+   for (int d = 0; d < dim; d++)
+   {
+      box(d) = infinity();
+      box(dim+d) = -infinity();
+   }
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      pmesh.GetElementCenter(i, center);
+      for (int d = 0; d < dim; d++)
+      {
+         box(d) = std::min(box(d), center(d));
+         box(dim+d) = std::max(box(dim+d), center(d));
+      }
+   }
+   MPI_Allgather(box.GetData(), 2*dim, MPITypeMap<real_t>::mpi_type,
+                 boxes.GetData(), 2*dim, MPITypeMap<real_t>::mpi_type,
+                 MPI_COMM_WORLD);
+   const real_t tol = 1e-8;
+   Array<int> partitioning(mesh.GetNE());
+   partitioning = -1;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      mesh.GetElementCenter(i, center);
+      for (int r = 0; r < nranks; r++)
+      {
+         const real_t *b = boxes.GetData() + 2*dim*r;
+         bool inside = true;
+         for (int d = 0; d < dim; d++)
+         {
+            inside = inside && center(d) >= b[d] - tol &&
+                     center(d) <= b[dim+d] + tol;
+         }
+         if (inside) { partitioning[i] = r; break; }
+      }
+      REQUIRE(partitioning[i] >= 0);
+   }
+   ParMesh ref(MPI_COMM_WORLD, mesh, partitioning);
+
+   // The space-filling curve ordering only permutes the local elements.
+   ParMesh pmesh_sfc = is_2d ?
+                       ParMesh::MakeCartesian2D(MPI_COMM_WORLD, nx, ny, type,
+                                                sx, sy) :
+                       ParMesh::MakeCartesian3D(MPI_COMM_WORLD, nx, ny, nz,
+                                                type, sx, sy, sz);
+   REQUIRE(pmesh_sfc.GetNE() == ref.GetNE());
+   REQUIRE(pmesh_sfc.GetNBE() == ref.GetNBE());
+   REQUIRE(pmesh_sfc.GetNV() == ref.GetNV());
+   REQUIRE(pmesh_sfc.GetNSharedFaces() == ref.GetNSharedFaces());
+
+   for (int level = 0; level < 2; level++)
+   {
+      REQUIRE(pmesh.GetGlobalNE() == ref.GetGlobalNE());
+      REQUIRE(pmesh.bdr_attributes.Size() == ref.bdr_attributes.Size());
+      CompareParMeshes(pmesh, ref);
+
+      real_t volume = 0.0;
+      for (int i = 0; i < pmesh.GetNE(); i++)
+      {
+         volume += pmesh.GetElementVolume(i);
+      }
+      MPI_Allreduce(MPI_IN_PLACE, &volume, 1, MPITypeMap<real_t>::mpi_type,
+                    MPI_SUM, MPI_COMM_WORLD);
+      REQUIRE(volume == MFEM_Approx(is_2d ? sx*sy : sx*sy*sz));
+
+      ref.UniformRefinement();
+      pmesh.UniformRefinement();
+   }
+}
+
 #endif // MFEM_USE_MPI
 
 } // namespace mfem
@@ -42,6 +42,54 @@ TEST_CASE("VTU XML Reader", "[Mesh][VTU][XML]")
    REQUIRE(mesh.GetNumGeometries(2) == 1);
 }
 
+TEST_CASE("VTU XML Round Trip", "[Mesh][VTU][XML]")
+{
+   std::vector<std::pair<VTKFormat,int>> formats =
+   {
+      {VTKFormat::ASCII, 0}, {VTKFormat::BINARY, 0}, {VTKFormat::BINARY32, 0}
+   };
+#ifdef MFEM_USE_ZLIB
+   formats.push_back({VTKFormat::BINARY, 6});
+   formats.push_back({VTKFormat::BINARY32, 6});
+#endif
+
+   const auto fname = GENERATE("../../data/star-mixed.mesh",
+                               "../../data/beam-hex.mesh",
+                               "../../data/beam-tet.mesh",
+                               "../../data/inline-pyramid.mesh",
+                               "../../data/beam-wedge.mesh");
+   const auto format = GENERATE_COPY(from_range(formats));
+   CAPTURE(fname, int(format.first), format.second);
+
+   Mesh orig(fname);
+   orig.PrintVTU("vtu_round_trip", format.first, false, format.second);
+   Mesh mesh = Mesh::LoadFromFile("vtu_round_trip.vtu");
+   REQUIRE(std::remove("vtu_round_trip.vtu") == 0);
+
+   // The points are written per element, so compare the vertex coordinates
+   // of each element.
+   const real_t tol = (format.first == VTKFormat::BINARY32) ? 1e-6 : 1e-12;
+   REQUIRE(mesh.Dimension() == orig.Dimension());
+   REQUIRE(mesh.GetNE() == orig.GetNE());
+   Array<int> v1, v2;
+   for (int i = 0; i < orig.GetNE(); i++)
+   {
+      REQUIRE(mesh.GetElementGeometry(i) == orig.GetElementGeometry(i));
+      REQUIRE(mesh.GetAttribute(i) == orig.GetAttribute(i));
+      orig.GetElementVertices(i, v1);
+      mesh.GetElementVertices(i, v2);
+      REQUIRE(v1.Size() == v2.Size());
+      for (int j = 0; j < v1.Size(); j++)
+      {
+         for (int d = 0; d < orig.SpaceDimension(); d++)
+         {
+            REQUIRE(mesh.GetVertex(v2[j])[d] ==
+                    MFEM_Approx(orig.GetVertex(v1[j])[d], tol, tol));
+         }
+      }
+   }
+}
+
 TEST_CASE("VTU Attributes", "[VTU][XML]")
 {
    // quad_attribute.vtu contains the attributes in a cell data array named